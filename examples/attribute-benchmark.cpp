@@ -0,0 +1,214 @@
+/***********************************************************************
+* attribute-benchmark.cpp - Compares the expansion of parameterized    *
+*                           capabilities by tparm() and by the         *
+*                           compiled capability templates              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <final/final.h>
+
+#include <term.h>  // tparm and tgoto
+
+#ifdef OK
+  #undef OK
+#endif
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+using finalcut::FTermcap;
+using finalcut::Termcap;
+
+namespace
+{
+
+// Constants
+constexpr int WIDTH{200};
+constexpr int HEIGHT{60};
+constexpr int SEGMENT_WIDTH{4};
+constexpr int FRAMES{100};
+
+struct Capabilities
+{
+  const char* address;
+  const char* foreground;
+  const char* background;
+  const char* attributes;
+};
+
+//----------------------------------------------------------------------
+auto getCapability (Termcap cap) -> const char*
+{
+  return FTermcap::strings[int(cap)].string.data;
+}
+
+//----------------------------------------------------------------------
+void expandWithTparm (const Capabilities& caps, std::string& output)
+{
+  // Parses the capability strings again for every expansion
+
+  for (int y{0}; y < HEIGHT; y++)
+  {
+    if ( caps.address )
+      output += ::tgoto(caps.address, 0, y);
+
+    for (int x{0}; x < WIDTH; x += SEGMENT_WIDTH)
+    {
+      const int n = x / SEGMENT_WIDTH + y;
+
+      if ( caps.attributes )
+        output += ::tparm ( caps.attributes
+                          , long(n & 1), long(n & 2), long(n & 4)
+                          , 0L, long(n & 8), long(n & 16), 0L, 0L, 0L );
+
+      if ( caps.foreground )
+        output += ::tparm (caps.foreground, long(n % 256), 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L);
+
+      if ( caps.background )
+        output += ::tparm (caps.background, long((n * 7) % 256), 0L, 0L, 0L, 0L, 0L, 0L, 0L, 0L);
+
+      output.append(std::size_t(SEGMENT_WIDTH), 'x');
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void expandWithTemplates (const Capabilities& caps, std::string& output)
+{
+  // Uses the compiled capability templates of FTermcap
+
+  auto append = [&output] (const FTermcap::TermcapString& str)
+  {
+    output.append(str.data, str.length);
+  };
+
+  const FTermcap::TermcapString address{caps.address, 0};
+  const FTermcap::TermcapString foreground{caps.foreground, 0};
+  const FTermcap::TermcapString background{caps.background, 0};
+  const FTermcap::TermcapString attributes{caps.attributes, 0};
+
+  for (int y{0}; y < HEIGHT; y++)
+  {
+    if ( address.data )
+      append (FTermcap::encodeMotionParameter(address, 0, y));
+
+    for (int x{0}; x < WIDTH; x += SEGMENT_WIDTH)
+    {
+      const int n = x / SEGMENT_WIDTH + y;
+
+      if ( attributes.data )
+        output += FTermcap::encodeParameter ( attributes, n & 1, n & 2, n & 4
+                                            , 0, n & 8, n & 16, 0, 0, 0 );
+
+      if ( foreground.data )
+        output += FTermcap::encodeParameter(foreground, n % 256);
+
+      if ( background.data )
+        output += FTermcap::encodeParameter(background, (n * 7) % 256);
+
+      output.append(std::size_t(SEGMENT_WIDTH), 'x');
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+template <typename ExpandFunction>
+auto measure ( ExpandFunction expand, const Capabilities& caps
+             , std::string& output ) -> double
+{
+  const auto start = steady_clock::now();
+
+  for (int n{0}; n < FRAMES; n++)
+  {
+    output.clear();
+    expand (caps, output);
+  }
+
+  const auto end = steady_clock::now();
+  const auto elapsed_us = duration_cast<microseconds>(end - start).count();
+  return double(elapsed_us) / 1000.0;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------
+//                               main part
+//----------------------------------------------------------------------
+auto main (int argc, char* argv[]) -> int
+{
+  using Args = std::vector<std::string>;
+  Args args(argv, std::next(argv, argc));
+
+  if ( args.size() > 1 && (args[1] == "--help" || args[1] == "-h") )
+  {
+    std::cout << "Attribute benchmark:\n"
+              << "  Expands the cursor address, the attributes and the colors\n"
+              << "  for " << FRAMES << " frames of " << WIDTH << "x" << HEIGHT
+              << " cells with tparm() and with\n"
+              << "  the compiled capability templates\n\n"
+              << "Usage: attribute-benchmark [terminal type]\n\n";
+    return 0;
+  }
+
+  const char* env_term = std::getenv("TERM");
+  const std::string termtype = ( args.size() > 1 ) ? args[1]
+                             : ( env_term ? env_term : "xterm-256color" );
+  finalcut::FTermData::getInstance().setTermType(termtype);
+  FTermcap::init();
+
+  const Capabilities caps
+  {
+    getCapability(Termcap::t_cursor_address),
+    getCapability(Termcap::t_set_a_foreground),
+    getCapability(Termcap::t_set_a_background),
+    getCapability(Termcap::t_set_attributes)
+  };
+
+  std::string tparm_output{};
+  std::string template_output{};
+  const auto tparm_ms = measure (expandWithTparm, caps, tparm_output);
+  const auto template_ms = measure (expandWithTemplates, caps, template_output);
+
+  if ( tparm_output != template_output )
+  {
+    std::cerr << "Error: The expanded output differs\n";
+    return 1;
+  }
+
+  std::cout << "Terminal: " << termtype << "\n"
+            << finalcut::FString{42, '-'} << "\n"
+            << "tparm()       Templates      Speedup\n"
+            << finalcut::FString{42, '-'} << "\n"
+            << std::fixed << std::setprecision(3)
+            << std::left << std::setw(9) << tparm_ms << "ms   "
+            << std::setw(9) << template_ms << "ms   "
+            << std::setprecision(2) << tparm_ms / std::max(template_ms, 0.001)
+            << "x\n\n"
+            << template_output.size() << " bytes per frame\n";
+  return 0;
+}
@@ -0,0 +1,208 @@
+/***********************************************************************
+* compositing-benchmark.cpp - Compares the transparency scan of the    *
+*                             FChar array with the flag plane          *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <final/final.h>
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+using FTermRegion = finalcut::FVTerm::FTermRegion;
+using FTermRegionPtr = std::unique_ptr<FTermRegion>;
+
+namespace
+{
+
+// Constants
+constexpr int WIDTH{200};
+constexpr int HEIGHT{60};
+constexpr int LOOPS{200};
+
+//----------------------------------------------------------------------
+auto createRegion (int layer) -> FTermRegionPtr
+{
+  // Creates an overlay region in which only every sixteenth
+  // character is opaque, while the bottom layer is fully opaque
+
+  auto region = std::make_unique<FTermRegion>();
+  const auto size = std::size_t(WIDTH * HEIGHT);
+  region->size.width = WIDTH;
+  region->size.height = HEIGHT;
+  region->layer = layer;
+  region->visible = true;
+  region->changes_in_line.resize(std::size_t(HEIGHT), { WIDTH, 0, 0, false });
+  region->data.resize(size);
+  region->flag_plane.resize(size);
+
+  for (std::size_t i{0}; i < size; i++)
+  {
+    auto& fchar = region->data[i];
+    fchar.ch[0] = L'x';
+
+    const auto pattern = (i + std::size_t(layer) * 3) % 16;
+
+    if ( layer == 1 || pattern == 0 )
+      continue;
+
+    if ( pattern % 2 == 0 )
+      fchar.attr.setBit(finalcut::FAttribute::set::color_overlay);
+    else
+      fchar.attr.setBit(finalcut::FAttribute::set::transparent);
+
+    region->flag_plane[i] = FTermRegion::getTransparencyFlags(fchar);
+  }
+
+  return region;
+}
+
+//----------------------------------------------------------------------
+auto scanFCharArray (const std::vector<FTermRegionPtr>& regions) -> std::size_t
+{
+  // Counts the layers that are visited until an opaque
+  // character covers the lower layers
+
+  std::size_t visited{0};
+
+  for (int y{0}; y < HEIGHT; y++)
+  {
+    std::vector<FTermRegion::FChar_const_iterator> lines{};
+
+    for (const auto& region : regions)
+      lines.emplace_back(region->getFCharIterator(0, y));
+
+    for (int x{0}; x < WIDTH; x++)
+    {
+      for (const auto& line : lines)
+      {
+        visited++;
+
+        if ( FTermRegion::getTransparencyFlags(line[x]) == 0 )
+          break;
+      }
+    }
+  }
+
+  return visited;
+}
+
+//----------------------------------------------------------------------
+auto scanFlagPlane (const std::vector<FTermRegionPtr>& regions) -> std::size_t
+{
+  // Counts the layers that are visited until an opaque
+  // character covers the lower layers
+
+  std::size_t visited{0};
+
+  for (int y{0}; y < HEIGHT; y++)
+  {
+    std::vector<FTermRegion::FFlagVec::const_iterator> lines{};
+
+    for (const auto& region : regions)
+      lines.emplace_back(region->flag_plane.cbegin() + y * WIDTH);
+
+    for (int x{0}; x < WIDTH; x++)
+    {
+      for (const auto& line : lines)
+      {
+        visited++;
+
+        if ( line[x] == 0 )
+          break;
+      }
+    }
+  }
+
+  return visited;
+}
+
+//----------------------------------------------------------------------
+template <typename ScanFunction>
+auto measure (ScanFunction scan, const std::vector<FTermRegionPtr>& regions
+             , std::size_t& result) -> double
+{
+  const auto start = steady_clock::now();
+
+  for (int n{0}; n < LOOPS; n++)
+    result += scan(regions);
+
+  const auto end = steady_clock::now();
+  const auto elapsed_us = duration_cast<microseconds>(end - start).count();
+  return double(elapsed_us) / 1000.0 / double(LOOPS);
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------
+//                               main part
+//----------------------------------------------------------------------
+auto main (int argc, char* argv[]) -> int
+{
+  using Args = std::vector<std::string>;
+  Args args(argv, std::next(argv, argc));
+
+  if ( args.size() > 1 && (args[1] == "--help" || args[1] == "-h") )
+  {
+    std::cout << "Compositing benchmark:\n"
+              << "  Compares the transparency scan over the FChar array\n"
+              << "  with the scan over the dense flag plane of "
+              << WIDTH << "x" << HEIGHT << " regions\n\n";
+    return 0;
+  }
+
+  std::cout << finalcut::FString{55, '-'} << "\n"
+            << "Windows  FChar array   Flag plane   Speedup\n"
+            << finalcut::FString{55, '-'} << "\n";
+
+  for (const auto count : { 1, 2, 4, 8, 16 })
+  {
+    std::vector<FTermRegionPtr> regions{};
+
+    for (int layer{count}; layer > 0; layer--)
+      regions.emplace_back(createRegion(layer));
+
+    std::size_t fchar_result{0};
+    std::size_t flag_result{0};
+    const auto fchar_ms = measure (scanFCharArray, regions, fchar_result);
+    const auto flag_ms = measure (scanFlagPlane, regions, flag_result);
+
+    if ( fchar_result != flag_result )
+    {
+      std::cerr << "Error: The scan results differ\n";
+      return 1;
+    }
+
+    std::cout << std::left << std::setw(9) << count
+              << std::fixed << std::setprecision(3)
+              << std::setw(8) << fchar_ms << "ms   "
+              << std::setw(8) << flag_ms << "ms   "
+              << std::setprecision(2) << fchar_ms / flag_ms << "x\n";
+  }
+
+  return 0;
+}
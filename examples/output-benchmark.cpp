@@ -0,0 +1,239 @@
+/***********************************************************************
+* output-benchmark.cpp - Compares the stdio and the direct writev()    *
+*                        terminal output mode                          *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <final/final.h>
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+using finalcut::FSystem;
+using finalcut::FTermcap;
+
+namespace
+{
+
+// Constants
+constexpr int WIDTH{200};
+constexpr int HEIGHT{60};
+constexpr int SEGMENT_WIDTH{8};
+constexpr int FRAMES{100};
+
+// Output slice like in FOutputBuffer
+struct Slice
+{
+  bool        control;
+  std::size_t offset;
+  uInt32      length;
+};
+
+struct Frame
+{
+  std::string        data{};
+  std::vector<Slice> slices{};
+};
+
+struct Result
+{
+  double    time_ms;
+  long long syscalls;
+};
+
+//----------------------------------------------------------------------
+void appendSlice (Frame& frame, bool control, const std::string& str)
+{
+  frame.slices.push_back({control, frame.data.size(), uInt32(str.size())});
+  frame.data += str;
+}
+
+//----------------------------------------------------------------------
+auto createFrame() -> Frame
+{
+  // A full screen update with a color change every eight characters
+
+  Frame frame{};
+
+  for (int y{1}; y <= HEIGHT; y++)
+  {
+    appendSlice (frame, true, CSI + std::to_string(y) + ";1H");
+
+    for (int x{0}; x < WIDTH; x += SEGMENT_WIDTH)
+    {
+      const auto color = 16 + (x / SEGMENT_WIDTH + y) % 216;
+      appendSlice (frame, true, CSI "38;5;" + std::to_string(color) + "m");
+      appendSlice (frame, false, std::string(SEGMENT_WIDTH, char('A' + y % 26)));
+    }
+  }
+
+  return frame;
+}
+
+//----------------------------------------------------------------------
+auto getWriteSyscalls() -> long long
+{
+  // Reads the number of write system calls of this process (Linux)
+
+  std::ifstream io_file{"/proc/self/io"};
+  std::string key{};
+  long long value{};
+
+  while ( io_file >> key >> value )
+    if ( key == "syscw:" )
+      return value;
+
+  return -1;
+}
+
+//----------------------------------------------------------------------
+void printFrame (const Frame& frame)
+{
+  // Stdio output mode of FTermOutput::flush()
+
+  const auto* data_ptr = frame.data.data();
+
+  for (const auto& slice : frame.slices)
+  {
+    if ( slice.control )
+      FTermcap::paddingPrint (data_ptr + slice.offset, slice.length, 1);
+    else
+      FTermcap::stringPrint (data_ptr + slice.offset, slice.length);
+  }
+
+  std::fflush(stdout);
+}
+
+//----------------------------------------------------------------------
+void writeFrame (Frame& frame)
+{
+  // Direct output mode of FTermOutput::flush()
+
+  static const auto& fsystem = FSystem::getInstance();
+  static FSystem::IOVector iov{};
+  auto* data_ptr = &frame.data[0];
+  iov.clear();
+
+  for (const auto& slice : frame.slices)
+  {
+    auto* str = data_ptr + slice.offset;
+
+    if ( ! iov.empty()
+      && static_cast<char*>(iov.back().iov_base) + iov.back().iov_len == str )
+      iov.back().iov_len += slice.length;
+    else
+      iov.push_back({str, slice.length});
+  }
+
+  fsystem->writeAll (STDOUT_FILENO, iov);
+}
+
+//----------------------------------------------------------------------
+template <typename OutputFunction>
+auto measure (OutputFunction output, Frame& frame) -> Result
+{
+  const auto syscalls_before = getWriteSyscalls();
+  const auto start = steady_clock::now();
+
+  for (int n{0}; n < FRAMES; n++)
+    output (frame);
+
+  const auto end = steady_clock::now();
+  const auto syscalls_after = getWriteSyscalls();
+  const auto elapsed_us = duration_cast<microseconds>(end - start).count();
+  const auto syscalls = ( syscalls_before < 0 ) ? -1
+                                                : syscalls_after - syscalls_before;
+  return { double(elapsed_us) / 1000.0, syscalls };
+}
+
+//----------------------------------------------------------------------
+void printResult (const std::string& name, const Result& result)
+{
+  std::cout << std::left << std::setw(16) << name
+            << std::right << std::fixed << std::setprecision(3)
+            << std::setw(10) << result.time_ms << " ms   ";
+
+  if ( result.syscalls < 0 )
+    std::cout << std::setw(10) << "n/a" << "\n";
+  else
+    std::cout << std::setw(10) << result.syscalls << "\n";
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------
+//                               main part
+//----------------------------------------------------------------------
+auto main (int argc, char* argv[]) -> int
+{
+  using Args = std::vector<std::string>;
+  Args args(argv, std::next(argv, argc));
+
+  if ( args.size() > 1 && (args[1] == "--help" || args[1] == "-h") )
+  {
+    std::cout << "Output benchmark:\n"
+              << "  Writes " << FRAMES << " full " << WIDTH << "x" << HEIGHT
+              << " frames to /dev/null via stdio\n"
+              << "  and via writev() and counts the write system calls\n\n";
+    return 0;
+  }
+
+  auto frame = createFrame();
+  FTermcap::setDefaultPutCharFunction();
+  FTermcap::setDefaultPutStringFunction();
+
+  // Redirect the standard output to /dev/null during the measurement
+  std::cout.flush();
+  const int null_fd = ::open("/dev/null", O_WRONLY);
+  const int stdout_fd = ::dup(STDOUT_FILENO);
+
+  if ( null_fd < 0 || stdout_fd < 0 )
+  {
+    std::cerr << "Error: Cannot redirect the standard output\n";
+    return 1;
+  }
+
+  ::dup2 (null_fd, STDOUT_FILENO);
+  const auto stdio_result = measure (printFrame, frame);
+  const auto direct_result = measure (writeFrame, frame);
+  ::dup2 (stdout_fd, STDOUT_FILENO);
+  ::close (stdout_fd);
+  ::close (null_fd);
+
+  std::cout << finalcut::FString{42, '-'} << "\n"
+            << "Output mode           Time        syscalls\n"
+            << finalcut::FString{42, '-'} << "\n";
+  printResult ("stdio", stdio_result);
+  printResult ("writev", direct_result);
+  std::cout << "\n" << frame.data.size() << " bytes and "
+            << frame.slices.size() << " slices per frame\n";
+  return 0;
+}
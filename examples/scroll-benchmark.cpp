@@ -0,0 +1,181 @@
+/***********************************************************************
+* scroll-benchmark.cpp - Compares scrolling by copying the lines       *
+*                        with scrolling by rotating the row table      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <final/final.h>
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+using FTermRegion = finalcut::FVTerm::FTermRegion;
+using FTermRegionPtr = std::unique_ptr<FTermRegion>;
+
+namespace
+{
+
+// Constants
+constexpr int WIDTH{200};
+constexpr int HEIGHT{60};
+constexpr int SCROLL_STEPS{10000};
+
+//----------------------------------------------------------------------
+auto createRegion (int shadow_width) -> FTermRegionPtr
+{
+  auto region = std::make_unique<FTermRegion>();
+  const auto full_width = WIDTH + shadow_width;
+  const auto size = std::size_t(full_width * HEIGHT);
+  region->size.width = WIDTH;
+  region->size.height = HEIGHT;
+  region->shadow.width = shadow_width;
+  region->changes_in_line.resize(std::size_t(HEIGHT), { WIDTH, 0, 0, false });
+  region->data.resize(size);
+  region->flag_plane.resize(size);
+
+  for (int y{0}; y < HEIGHT; y++)
+    for (int x{0}; x < full_width; x++)
+      region->getFChar(x, y).ch[0] = wchar_t(L'A' + (x + y) % 26);
+
+  return region;
+}
+
+//----------------------------------------------------------------------
+void insertLine (FTermRegion& region, int y, int step)
+{
+  // Fills the new line with the style of the line above
+
+  auto line = region.getFCharIterator(0, y);
+  auto fill_char = region.getFChar(0, y - 1);
+  fill_char.ch[0] = L' ';
+  std::fill (line, line + WIDTH, fill_char);
+  line->ch[0] = wchar_t(L'a' + step % 26);
+}
+
+//----------------------------------------------------------------------
+void scrollByCopy (FTermRegion& region, int step)
+{
+  // Moves every line one line up (previous implementation)
+
+  const auto full_width = std::size_t(WIDTH + region.shadow.width);
+  auto source = region.data.cbegin() + full_width;
+  auto destination = region.data.begin();
+
+  for (int y{0}; y < HEIGHT - 1; y++)
+  {
+    std::memcpy (&*destination, &*source, std::size_t(WIDTH) * sizeof(*source));
+    source += full_width;
+    destination += full_width;
+  }
+
+  insertLine (region, HEIGHT - 1, step);
+}
+
+//----------------------------------------------------------------------
+void scrollByRotation (FTermRegion& region, int step)
+{
+  // Rotates only the row table
+
+  region.rotateRows (0, HEIGHT - 1, 1);
+  insertLine (region, HEIGHT - 1, step);
+}
+
+//----------------------------------------------------------------------
+template <typename ScrollFunction>
+auto measure (ScrollFunction scroll, FTermRegion& region) -> double
+{
+  const auto start = steady_clock::now();
+
+  for (int step{0}; step < SCROLL_STEPS; step++)
+    scroll (region, step);
+
+  const auto end = steady_clock::now();
+  const auto elapsed_us = duration_cast<microseconds>(end - start).count();
+  return double(elapsed_us) / 1000.0;
+}
+
+//----------------------------------------------------------------------
+auto isEqual (const FTermRegion& lhs, const FTermRegion& rhs) -> bool
+{
+  const auto full_width = WIDTH + lhs.shadow.width;
+
+  for (int y{0}; y < HEIGHT; y++)
+    for (int x{0}; x < full_width; x++)
+      if ( lhs.getFChar(x, y).ch != rhs.getFChar(x, y).ch )
+        return false;
+
+  return true;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------
+//                               main part
+//----------------------------------------------------------------------
+auto main (int argc, char* argv[]) -> int
+{
+  using Args = std::vector<std::string>;
+  Args args(argv, std::next(argv, argc));
+
+  if ( args.size() > 1 && (args[1] == "--help" || args[1] == "-h") )
+  {
+    std::cout << "Scroll benchmark:\n"
+              << "  Scrolls a " << WIDTH << "x" << HEIGHT << " region "
+              << SCROLL_STEPS << " times by copying the lines\n"
+              << "  and by rotating the row table\n\n";
+    return 0;
+  }
+
+  std::cout << finalcut::FString{50, '-'} << "\n"
+            << "Shadow   Line copy     Row table    Speedup\n"
+            << finalcut::FString{50, '-'} << "\n";
+
+  for (const auto shadow_width : { 0, 1 })
+  {
+    auto copy_region = createRegion(shadow_width);
+    auto ring_region = createRegion(shadow_width);
+    const auto copy_ms = measure (scrollByCopy, *copy_region);
+    const auto ring_ms = measure (scrollByRotation, *ring_region);
+
+    if ( ! isEqual(*copy_region, *ring_region) )
+    {
+      std::cerr << "Error: The scrolled regions differ\n";
+      return 1;
+    }
+
+    std::cout << std::left << std::setw(9) << shadow_width
+              << std::fixed << std::setprecision(3)
+              << std::setw(9) << copy_ms << "ms   "
+              << std::setw(9) << ring_ms << "ms   "
+              << std::setprecision(2) << copy_ms / std::max(ring_ms, 0.001)
+              << "x\n";
+  }
+
+  return 0;
+}
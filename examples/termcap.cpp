@@ -51,13 +51,13 @@ struct Data
     const Termcap cap;
   };
 
-  static std::array<TermcapString, 86> strings;
+  static std::array<TermcapString, 91> strings;
 };
 
 //----------------------------------------------------------------------
 // struct data - string data array
 //----------------------------------------------------------------------
-std::array<Data::TermcapString, 86> Data::strings =
+std::array<Data::TermcapString, 91> Data::strings =
 {{
   { "t_bell", Termcap::t_bell },
   { "t_flash_screen", Termcap::t_flash_screen },
@@ -106,6 +106,11 @@ std::array<Data::TermcapString, 86> Data::strings =
   { "t_cursor_style", Termcap::t_cursor_style },
   { "t_scroll_forward", Termcap::t_scroll_forward },
   { "t_scroll_reverse", Termcap::t_scroll_reverse },
+  { "t_change_scroll_region", Termcap::t_change_scroll_region },
+  { "t_insert_line", Termcap::t_insert_line },
+  { "t_delete_line", Termcap::t_delete_line },
+  { "t_parm_insert_line", Termcap::t_parm_insert_line },
+  { "t_parm_delete_line", Termcap::t_parm_delete_line },
   { "t_enter_ca_mode", Termcap::t_enter_ca_mode },
   { "t_exit_ca_mode", Termcap::t_exit_ca_mode },
   { "t_enable_acs", Termcap::t_enable_acs },
@@ -0,0 +1,223 @@
+/***********************************************************************
+* window-index-benchmark.cpp - Compares the linear window list scan    *
+*                              with the spatial window index           *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <final/final.h>
+
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+using FTermRegion = finalcut::FVTerm::FTermRegion;
+using FTermRegionPtr = std::unique_ptr<FTermRegion>;
+using FTermRegionList = std::vector<FTermRegionPtr>;
+
+namespace
+{
+
+// Constants
+constexpr int WIDTH{200};
+constexpr int HEIGHT{60};
+constexpr int LOOPS{3};
+
+//----------------------------------------------------------------------
+auto createRegions (int count) -> FTermRegionList
+{
+  // Creates dialog-sized regions at pseudo-random positions.
+  // The list order corresponds to the window layer.
+
+  FTermRegionList regions{};
+  uInt32 seed{12345};
+
+  for (int layer{1}; layer <= count; layer++)
+  {
+    seed = seed * 1103515245U + 12345U;
+    auto region = std::make_unique<FTermRegion>();
+    region->size.width = 20 + int((seed >> 8) % 30);
+    region->size.height = 5 + int((seed >> 16) % 10);
+    region->shadow.width = 1;
+    region->shadow.height = 1;
+    region->position.x = int((seed >> 4) % uInt32(WIDTH - region->size.width));
+    region->position.y = int((seed >> 12) % uInt32(HEIGHT - region->size.height));
+    region->layer = layer;
+    region->visible = true;
+    regions.emplace_back(std::move(region));
+  }
+
+  return regions;
+}
+
+//----------------------------------------------------------------------
+inline auto contains (const FTermRegion* win, int x, int y) -> bool
+{
+  return x >= win->position.x
+      && y >= win->position.y
+      && x < win->position.x + win->size.width + win->shadow.width
+      && y < win->position.y + win->size.height + win->shadow.height;
+}
+
+//----------------------------------------------------------------------
+auto scanWindowList (const FTermRegionList& regions, const finalcut::FWindowIndex&) -> std::size_t
+{
+  // Counts the covered characters of all windows. Like
+  // FVTerm::isCovered(), the window list is walked through
+  // up to the window and then on with the windows above it.
+
+  std::size_t covered{0};
+
+  for (const auto& region : regions)
+  {
+    for (int y{0}; y < region->size.height; y++)
+    {
+      for (int x{0}; x < region->size.width; x++)
+      {
+        const int pos_x = region->position.x + x;
+        const int pos_y = region->position.y + y;
+        bool found{false};
+
+        for (const auto& win : regions)
+        {
+          if ( ! found )
+          {
+            found = ( win == region );
+            continue;
+          }
+
+          if ( contains(win.get(), pos_x, pos_y) )
+          {
+            covered++;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  return covered;
+}
+
+//----------------------------------------------------------------------
+auto scanWindowIndex (const FTermRegionList& regions, const finalcut::FWindowIndex& index) -> std::size_t
+{
+  // Counts the covered characters of all windows
+  // with the windows of the corresponding index tile
+
+  std::size_t covered{0};
+
+  for (const auto& region : regions)
+  {
+    for (int y{0}; y < region->size.height; y++)
+    {
+      for (int x{0}; x < region->size.width; x++)
+      {
+        const int pos_x = region->position.x + x;
+        const int pos_y = region->position.y + y;
+
+        for (const auto* win : index.getRegionsAt(pos_x, pos_y))
+        {
+          if ( win->layer > region->layer && contains(win, pos_x, pos_y) )
+          {
+            covered++;
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  return covered;
+}
+
+//----------------------------------------------------------------------
+template <typename ScanFunction>
+auto measure ( ScanFunction scan, const FTermRegionList& regions
+             , const finalcut::FWindowIndex& index, std::size_t& result ) -> double
+{
+  const auto start = steady_clock::now();
+
+  for (int n{0}; n < LOOPS; n++)
+    result += scan(regions, index);
+
+  const auto end = steady_clock::now();
+  const auto elapsed_us = duration_cast<microseconds>(end - start).count();
+  return double(elapsed_us) / 1000.0 / double(LOOPS);
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------
+//                               main part
+//----------------------------------------------------------------------
+auto main (int argc, char* argv[]) -> int
+{
+  using Args = std::vector<std::string>;
+  Args args(argv, std::next(argv, argc));
+
+  if ( args.size() > 1 && (args[1] == "--help" || args[1] == "-h") )
+  {
+    std::cout << "Window index benchmark:\n"
+              << "  Compares the coverage test of all window characters\n"
+              << "  on a " << WIDTH << "x" << HEIGHT
+              << " terminal with a walk through the window list\n"
+              << "  and with the spatial window index\n\n";
+    return 0;
+  }
+
+  std::cout << finalcut::FString{55, '-'} << "\n"
+            << "Windows  Window list   Window index   Speedup\n"
+            << finalcut::FString{55, '-'} << "\n";
+
+  for (const auto count : { 1, 10, 50, 100, 250, 500 })
+  {
+    const auto regions = createRegions(count);
+    finalcut::FWindowIndex index{};
+    index.setSize (finalcut::FSize{WIDTH, HEIGHT});
+
+    for (const auto& region : regions)
+      index.insert (region.get());
+
+    std::size_t list_result{0};
+    std::size_t index_result{0};
+    const auto list_ms = measure (scanWindowList, regions, index, list_result);
+    const auto index_ms = measure (scanWindowIndex, regions, index, index_result);
+
+    if ( list_result != index_result )
+    {
+      std::cerr << "Error: The coverage results differ\n";
+      return 1;
+    }
+
+    std::cout << std::left << std::setw(9) << count
+              << std::fixed << std::setprecision(3)
+              << std::setw(8) << list_ms << "ms   "
+              << std::setw(8) << index_ms << "ms     "
+              << std::setprecision(2) << list_ms / index_ms << "x\n";
+  }
+
+  return 0;
+}
@@ -496,18 +496,36 @@ void FApplication::setTerminalEncoding (const FString& enc_str)
   }
 }
 
+//----------------------------------------------------------------------
+void FApplication::setCompositorThreadCount (const FString& count_str)
+{
+  try
+  {
+    FVTerm::setCompositorThreads(count_str.toUInt());
+  }
+  catch (const std::exception&)
+  {
+    setExitMessage ( "Invalid compositor thread count \"" + count_str
+                   + "\"\n(Use 0 for one thread per CPU core)" );
+    exit(EXIT_FAILURE);
+  }
+}
+
 //----------------------------------------------------------------------
 inline auto FApplication::getLongOptions() -> const std::vector<CmdOption>&
 {
   static const std::vector<CmdOption>& long_options =
   {
     {"encoding",                 required_argument, nullptr,  'e' },
+    {"compositor-threads",       required_argument, nullptr,  'p' },
     {"log-file",                 required_argument, nullptr,  'l' },
     {"no-mouse",                 no_argument,       nullptr,  'm' },
     {"no-optimized-cursor",      no_argument,       nullptr,  'o' },
     {"no-terminal-detection",    no_argument,       nullptr,  'd' },
     {"no-terminal-data-request", no_argument,       nullptr,  'r' },
     {"no-terminal-focus-events", no_argument,       nullptr,  'f' },
+    {"no-bracketed-paste",       no_argument,       nullptr,  'b' },
+    {"terminal-cache",           no_argument,       nullptr,  'T' },
     {"no-color-change",          no_argument,       nullptr,  'c' },
     {"no-sgr-optimizer",         no_argument,       nullptr,  's' },
     {"vgafont",                  no_argument,       nullptr,  'v' },
@@ -531,10 +549,13 @@ inline void FApplication::setCmdOptionsMap (CmdMap& cmd_map)
 {
   auto enc = [] (const auto& s) { FApplication::setTerminalEncoding(s); };
   auto log = [] (const auto& s) { FApplication::setLogFile(s); };
+  auto thr = [] (const auto& s) { FApplication::setCompositorThreadCount(s); };
   auto opt = &FApplication::getStartOptions;
 
   // --encoding
   cmd_map['e'] = [enc] (const auto& arg) { enc(FString(arg)); };
+  // --compositor-threads
+  cmd_map['p'] = [thr] (const auto& arg) { thr(FString(arg)); };
   // --log-file
   cmd_map['l'] = [log] (const auto& arg) { log(FString(arg)); };
   // --no-mouse
@@ -547,6 +568,10 @@ inline void FApplication::setCmdOptionsMap (CmdMap& cmd_map)
   cmd_map['r'] = [opt] (const auto&) { opt().terminal_data_request = false; };
   // --no-terminal-focus-events
   cmd_map['f'] = [opt] (const auto&) { opt().terminal_focus_events = false; };
+  // --no-bracketed-paste
+  cmd_map['b'] = [opt] (const auto&) { opt().bracketed_paste = false; };
+  // --terminal-cache
+  cmd_map['T'] = [opt] (const auto&) { opt().terminal_profile_cache = true; };
   // --no-color-change
   cmd_map['c'] = [opt] (const auto&) { opt().color_change = false; };
   // --no-sgr-optimizer
@@ -627,6 +652,10 @@ void FApplication::showParameterUsage()
     << "    Sets the character encoding mode\n"
     << "                            "
     << "    {utf8, vt100, pc, ascii}\n"
+    << "  --compositor-threads=<N>  "
+    << "    Composites large updates with N threads\n"
+    << "                            "
+    << "    (0 = one per CPU core)\n"
     << "  --log-file=<FILE>         "
     << "    Writes log output to FILE\n"
     << "  --no-mouse                "
@@ -639,6 +668,10 @@ void FApplication::showParameterUsage()
     << "    Do not determine terminal font and title\n"
     << "  --no-terminal-focus-events"
     << "    Do not send focus-in and focus-out events\n"
+    << "  --no-bracketed-paste      "
+    << "    Deliver pasted text as single keystrokes\n"
+    << "  --terminal-cache          "
+    << "    Reuse the cached terminal profile\n"
     << "  --no-color-change         "
     << "    Do not redefine the color palette\n"
     << "  --no-sgr-optimizer        "
@@ -750,6 +783,10 @@ inline void FApplication::performKeyboardAction()
   {
     processTerminalFocus (keyboard.getKey());  // Term focus-in/focus-out
   }
+  else if ( keyboard.getKey() == FKey::Bracketed_paste )
+  {
+    processPaste();  // Text from a bracketed paste
+  }
   else
   {
     const bool acceptKeyDown = sendKeyDownEvent (keyboard_widget);
@@ -1019,6 +1056,36 @@ void FApplication::processTerminalFocus (const FKey& key) const
   sendEvent (root_widget, &tf_ev);
 }
 
+//----------------------------------------------------------------------
+void FApplication::processPaste() const
+{
+  static const auto& keyboard = FKeyboard::getInstance();
+
+  if ( ! keyboard_widget )
+    return;
+
+  // Terminals transmit line breaks in a paste as carriage returns
+  const FString text{keyboard.getPasteText()};
+  FPasteEvent paste_ev (Event::Paste, text.replace("\r\n", "\n").replace("\r", "\n"));
+  sendEvent (keyboard_widget, &paste_ev);
+
+  if ( paste_ev.isAccepted() )
+    return;
+
+  // Widgets without paste support receive the text as keystrokes
+  for (const auto& ch : paste_ev.getText())
+  {
+    const auto key = ( ch == L'\n' ) ? FKey::Return : FKey(ch);
+    FKeyEvent k_down_ev (Event::KeyDown, key);
+    sendEvent (keyboard_widget, &k_down_ev);
+    FKeyEvent k_press_ev (Event::KeyPress, key);
+    sendEvent (keyboard_widget, &k_press_ev);
+
+    if ( quit_now || internal::var::exit_loop )
+      break;
+  }
+}
+
 //----------------------------------------------------------------------
 void FApplication::determineClickedWidget (const FMouseData& md)
 {
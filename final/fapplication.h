@@ -3,7 +3,7 @@
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2013-2025 Markus Gans                                      *
+* Copyright 2013-2026 Markus Gans                                      *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -82,6 +82,7 @@ class FKeyEvent;
 class FLog;
 class FMouseData;
 class FMouseEvent;
+class FPasteEvent;
 class FStartOptions;
 class FTimerEvent;
 class FWheelEvent;
@@ -172,6 +173,7 @@ class FApplication : public FWidget
     // Methods
     void         init();
     static void  setTerminalEncoding (const FString&);
+    static void  setCompositorThreadCount (const FString&);
     static auto  getLongOptions() -> const std::vector<struct option>&;
     static void  setCmdOptionsMap (CmdMap&);
     static void  cmdOptions (const Args&);
@@ -201,6 +203,7 @@ class FApplication : public FWidget
     auto         processDialogSwitchAccelerator() const -> bool;
     auto         processAccelerator (const FWidget&) const -> bool;
     void         processTerminalFocus (const FKey&) const;
+    void         processPaste() const;
     static void  determineClickedWidget (const FMouseData&);
     static void  determineWheelWidget (const FMouseData&);
     static auto  isNonActivatingMouseEvent (const FMouseData&) -> bool;
@@ -57,6 +57,7 @@ enum class Event : uInt8
   KeyPress,          // Key pressed
   KeyUp,             // Key released
   KeyDown,           // Key pressed
+  Paste,             // Bracketed paste text
   MouseDown,         // Mouse button pressed
   MouseUp,           // Mouse button released
   MouseDoubleClick,  // Mouse button double click
@@ -705,6 +706,7 @@ enum class FKey : uInt32
   X11mouse                   = 0x02000020,  // Xterm mouse
   Extended_mouse             = 0x02000021,  // SGR extended mouse
   Urxvt_mouse                = 0x02000022,  // Urxvt mouse extension
+  Bracketed_paste            = 0x02000023,  // Bracketed paste text
   Meta_offset                = 0x020000e0,  // Meta key offset
   Meta_tab                   = 0x020000e9,  // M-tab
   Meta_enter                 = 0x020000ea,  // M-enter
@@ -1565,6 +1567,11 @@ enum class Termcap : uInt8
   t_cursor_style,
   t_scroll_forward,
   t_scroll_reverse,
+  t_change_scroll_region,
+  t_insert_line,
+  t_delete_line,
+  t_parm_insert_line,
+  t_parm_delete_line,
   t_enter_ca_mode,
   t_exit_ca_mode,
   t_enable_acs,
@@ -5,6 +5,9 @@
 /* config.h.  Generated from config.h.in by configure.  */
 /* config.h.in.  Generated from configure.ac by autoheader.  */
 
+/* Define to 1 to use the compact character cell layout */
+/* #undef COMPACT_FCHAR */
+
 /* Define to 1 if you have the <cmath> header file. */
 /* #undef HAVE_CMATH */
 
@@ -3,7 +3,7 @@
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2014-2025 Markus Gans                                      *
+* Copyright 2014-2026 Markus Gans                                      *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -73,6 +73,32 @@ void FKeyEvent::ignore() noexcept
 { accpt = false; }
 
 
+//----------------------------------------------------------------------
+// class FPasteEvent
+//----------------------------------------------------------------------
+
+FPasteEvent::FPasteEvent (Event ev_type, FString&& str)  // constructor
+  : FEvent{ev_type}
+  , text{std::move(str)}
+{ }
+
+//----------------------------------------------------------------------
+auto FPasteEvent::getText() const noexcept -> const FString&
+{ return text; }
+
+//----------------------------------------------------------------------
+auto FPasteEvent::isAccepted() const noexcept -> bool
+{ return accpt; }
+
+//----------------------------------------------------------------------
+void FPasteEvent::accept() noexcept
+{ accpt = true; }
+
+//----------------------------------------------------------------------
+void FPasteEvent::ignore() noexcept
+{ accpt = false; }
+
+
 //----------------------------------------------------------------------
 // class FMouseEvent
 //----------------------------------------------------------------------
@@ -4,7 +4,7 @@
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2014-2023 Markus Gans                                      *
+* Copyright 2014-2026 Markus Gans                                      *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -46,6 +46,7 @@
 #include <final/eventloop/signal_monitor.h>
 #include <final/eventloop/timer_monitor.h>
 #include <final/input/fkeyboard.h>
+#include <final/input/fkey_decoder.h>
 #include <final/input/fkey_map.h>
 #include <final/input/fmouse.h>
 #include <final/menu/fcheckmenuitem.h>
@@ -56,19 +57,23 @@
 #include <final/menu/fradiomenuitem.h>
 #include <final/output/fcolorpalette.h>
 #include <final/output/foutput.h>
+#include <final/output/tty/fbandwidthmonitor.h>
 #include <final/output/tty/fcharmap.h>
 #include <final/output/tty/foptiattr.h>
 #include <final/output/tty/foptimove.h>
+#include <final/output/tty/foutputwriter.h>
 #include <final/output/tty/ftermcap.h>
 #include <final/output/tty/ftermcapquirks.h>
+#include <final/output/tty/ftermcaptemplate.h>
 #include <final/output/tty/ftermdata.h>
 #include <final/output/tty/ftermdebugdata.h>
 #include <final/output/tty/ftermdetection.h>
 #include <final/output/tty/fterm.h>
 #include <final/output/tty/ftermios.h>
 #include <final/output/tty/ftermoutput.h>
+#include <final/output/tty/ftermprobe.h>
+#include <final/output/tty/ftermprofilecache.h>
 #include <final/output/tty/ftermxterminal.h>
-#include <final/output/tty/sgr_optimizer.h>
 #include <final/util/char_ringbuffer.h>
 #include <final/util/emptyfstring.h>
 #include <final/util/fdata.h>
@@ -79,10 +84,14 @@
 #include <final/util/fsize.h>
 #include <final/util/fstring.h>
 #include <final/util/fsystem.h>
+#include <final/util/fworkerpool.h>
 #include <final/vterm/fcolorpair.h>
+#include <final/vterm/fdamagelist.h>
 #include <final/vterm/fstyle.h>
 #include <final/vterm/fvtermbuffer.h>
 #include <final/vterm/fvterm.h>
+#include <final/vterm/fvterm_kernels.h>
+#include <final/vterm/fwindowindex.h>
 #include <final/widget/fbusyindicator.h>
 #include <final/widget/fbuttongroup.h>
 #include <final/widget/fbutton.h>
@@ -3,7 +3,7 @@
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2019-2025 Markus Gans                                      *
+* Copyright 2019-2026 Markus Gans                                      *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -53,6 +53,8 @@ FStartOptions::FStartOptions()
   , dark_theme{false}
   , color_change{true}
   , is_being_initialized{false}
+  , terminal_profile_cache{false}
+  , bracketed_paste{true}
 { }
 
 
@@ -77,6 +79,8 @@ void FStartOptions::setDefault()
   dark_theme = false;
   terminal_focus_events = true;
   is_being_initialized = false;
+  terminal_profile_cache = false;
+  bracketed_paste = true;
 
 #if defined(__FreeBSD__) || defined(__DragonFly__) || defined(UNIT_TEST)
   meta_sends_escape = true;
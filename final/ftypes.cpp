@@ -0,0 +1,127 @@
+/***********************************************************************
+* ftypes.cpp - Implementation of data types                            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "final/ftypes.h"
+
+namespace finalcut
+{
+
+#if defined(F_COMPACT_FCHAR)
+
+namespace internal
+{
+
+struct combining_table
+{
+  // Null-terminated code point sequences (index 0 is unused).
+  // The sequences are stored in fixed-size blocks that are never
+  // moved or freed, so pointers returned by getCombiningSequence()
+  // remain valid. Readers do not lock: a new sequence is published
+  // by the release store of the table size after it has been written.
+  // The mutex only serializes the interning of new sequences.
+  // The table holds at most COMBINING_SEQUENCE_MAX sequences.
+  using Sequence = std::array<wchar_t, UNICODE_MAX + 1>;
+  static constexpr std::size_t BLOCK_SIZE{256};
+  static constexpr std::size_t BLOCK_COUNT{(COMBINING_SEQUENCE_MAX + BLOCK_SIZE) / BLOCK_SIZE};
+  using Block = std::array<Sequence, BLOCK_SIZE>;
+
+  combining_table()
+  {
+    storage.emplace_back(std::make_unique<Block>());  // Contains the empty sequence 0
+    blocks[0].store(storage.back().get(), std::memory_order_relaxed);
+  }
+
+  static auto getInstance() -> combining_table&
+  {
+    static combining_table table{};
+    return table;
+  }
+
+  std::array<std::atomic<Block*>, BLOCK_COUNT> blocks{};
+  std::atomic<std::size_t> size{1};
+  std::vector<std::unique_ptr<Block>> storage{};
+  std::unordered_map<std::wstring, uInt32> index{};
+  std::mutex mutex{};
+};
+
+//----------------------------------------------------------------------
+auto getCombiningSequence (uInt32 idx) noexcept -> const wchar_t*
+{
+  static auto& table = combining_table::getInstance();
+  static constexpr auto block_size = combining_table::BLOCK_SIZE;
+
+  if ( idx >= table.size.load(std::memory_order_acquire) )
+    idx = 0;  // Unknown index: no combining characters
+
+  const auto* block = table.blocks[idx / block_size].load(std::memory_order_relaxed);
+  return (*block)[idx % block_size].data();
+}
+
+//----------------------------------------------------------------------
+auto internCombiningSequence (const std::array<wchar_t, UNICODE_MAX>& seq) -> uInt32
+{
+  // Returns the table index of the given code point sequence
+  // and adds it to the table if it is not yet present.
+  // Returns 0 (no combining characters) if the table is full.
+
+  static auto& table = combining_table::getInstance();
+  static constexpr auto block_size = combining_table::BLOCK_SIZE;
+  const auto seq_end = std::find(seq.cbegin(), seq.cend(), L'\0');
+  std::wstring key(seq.cbegin(), seq_end);
+  std::lock_guard<std::mutex> lock_guard(table.mutex);
+  const auto iter = table.index.find(key);
+
+  if ( iter != table.index.end() )
+    return iter->second;
+
+  const auto idx = table.size.load(std::memory_order_relaxed);
+
+  if ( idx > COMBINING_SEQUENCE_MAX )
+    return 0;
+
+  if ( idx % block_size == 0 )  // The last block is full
+  {
+    table.storage.emplace_back(std::make_unique<combining_table::Block>());
+    table.blocks[idx / block_size].store ( table.storage.back().get()
+                                         , std::memory_order_relaxed );
+  }
+
+  auto* block = table.blocks[idx / block_size].load(std::memory_order_relaxed);
+  std::copy (seq.cbegin(), seq_end, (*block)[idx % block_size].begin());
+  table.index.emplace(std::move(key), uInt32(idx));
+  table.size.store(idx + 1, std::memory_order_release);
+  return uInt32(idx);
+}
+
+}  // namespace internal
+
+#endif  // defined(F_COMPACT_FCHAR)
+
+}  // namespace finalcut
@@ -38,6 +38,7 @@
 #include <array>
 #include <chrono>
 #include <functional>
+#include <initializer_list>
 #include <limits>
 #include <memory>
 #include <string>
@@ -46,6 +47,7 @@
 #include <vector>
 
 #include "final/eventloop/pipedata.h"
+#include "final/fconfig.h"  // Supplies F_COMPACT_FCHAR if enabled
 
 #if (defined(__APPLE__) && defined(__MACH__)) || defined(__OpenBSD__)
   #define USE_KQUEUE_TIMER
@@ -805,6 +807,226 @@ struct FAttribute
 //----------------------------------------------------------------------
 static constexpr std::size_t UNICODE_MAX = 5;
 
+#if defined(F_COMPACT_FCHAR)
+
+// Compact layout: The first code point is stored inline. Combining
+// character sequences are interned in an out-of-line side table and
+// referenced by their table index.
+//
+// The table is shared by all threads. Lookups do not lock, only the
+// interning of a new sequence takes a mutex. Entries are never removed,
+// so a returned sequence pointer stays valid until the program ends. The number of interned sequences is limited to
+// COMBINING_SEQUENCE_MAX. When the table is full, new sequences keep
+// only their first code point.
+
+namespace internal
+{
+
+static constexpr std::size_t COMBINING_SEQUENCE_MAX = 65535;
+
+auto getCombiningSequence (uInt32) noexcept -> const wchar_t*;
+auto internCombiningSequence (const std::array<wchar_t, UNICODE_MAX>&) -> uInt32;
+
+}  // namespace internal
+
+struct FUnicode
+{
+  // Using-declarations
+  using iterator        = const wchar_t*;
+  using const_iterator  = const wchar_t*;
+  using pointer         = const wchar_t*;
+  using const_pointer   = const wchar_t*;
+  using const_reference = wchar_t;
+  using value_type      = wchar_t;
+
+  class reference
+  {
+    public:
+      // Constructor
+      constexpr reference (FUnicode& u, std::size_t i) noexcept
+        : unicode{u}
+        , index{i}
+      { }
+
+      // Overloaded operators
+      auto operator = (wchar_t ch) -> reference&
+      {
+        unicode.setChar (index, ch);
+        return *this;
+      }
+
+      auto operator = (const reference& ref) -> reference&
+      {
+        return *this = wchar_t(ref);
+      }
+
+      constexpr operator wchar_t () const noexcept
+      {
+        return static_cast<const FUnicode&>(unicode)[index];
+      }
+
+    private:
+      // Data members
+      FUnicode&   unicode;
+      std::size_t index;
+  };
+
+  // Constructors
+  constexpr FUnicode() noexcept = default;
+
+  constexpr FUnicode (std::initializer_list<wchar_t> list)
+  {
+    std::size_t n{0};
+
+    for (const auto& ch : list)
+    {
+      if ( n == 0 )
+        unicode_data[0] = ch;
+      else if ( ch != L'\0' )
+      {
+        assign (list.begin(), list.end());  // Combining character sequence
+        return;
+      }
+      else
+        return;
+
+      n++;
+    }
+  }
+
+  // Overloaded operators
+  auto operator [] (std::size_t index) noexcept -> reference
+  {
+    return {*this, index};
+  }
+
+  constexpr auto operator [] (std::size_t index) const noexcept -> const_reference
+  {
+    if ( index == 0 )
+      return unicode_data[0];
+
+    if ( unicode_data[1] == L'\0' )
+      return L'\0';
+
+#if defined(__clang__)
+  #pragma clang diagnostic push
+  #if __has_warning("-Wunsafe-buffer-usage")
+    #pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+  #endif
+#endif
+    return internal::getCombiningSequence(uInt32(unicode_data[1]))[index];
+#if defined(__clang__)
+  #pragma clang diagnostic pop
+#endif
+  }
+
+  // Methods
+  auto begin() const noexcept -> const_iterator
+  {
+    return data();
+  }
+
+  auto end() const noexcept -> const_iterator
+  {
+#if defined(__clang__)
+  #pragma clang diagnostic push
+  #if __has_warning("-Wunsafe-buffer-usage")
+    #pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+  #endif
+#endif
+    return data() + ( unicode_data[1] == L'\0' ? 1 : UNICODE_MAX );
+#if defined(__clang__)
+  #pragma clang diagnostic pop
+#endif
+  }
+
+  auto cbegin() const noexcept -> const_iterator
+  {
+    return begin();
+  }
+
+  auto cend() const noexcept -> const_iterator
+  {
+    return end();
+  }
+
+  auto data() const noexcept -> const_pointer
+  {
+    // A single code point is null-terminated by the empty table index
+    return ( unicode_data[1] == L'\0' )
+           ? &unicode_data[0]
+           : internal::getCombiningSequence(uInt32(unicode_data[1]));
+  }
+
+  template <typename InputIter>
+  void assign (InputIter first, InputIter last)
+  {
+    std::array<wchar_t, UNICODE_MAX> seq{};
+    std::size_t n{0};
+
+    while ( first != last && n < UNICODE_MAX )
+    {
+      seq[n] = *first;
+      ++first;
+      ++n;
+    }
+
+    setSequence (seq);
+  }
+
+  // Data member
+  // [0] = first code point, [1] = side table index (0 = no combining chars)
+  wchar_t unicode_data[2]{L'\0', L'\0'};
+
+  // Friend Non-member operator functions
+  friend constexpr auto operator == (const FUnicode& lhs, const FUnicode& rhs) noexcept -> bool
+  {
+    // Interned sequences are equal if their table indexes are equal
+    return lhs.unicode_data[0] == rhs.unicode_data[0]
+        && lhs.unicode_data[1] == rhs.unicode_data[1];
+  }
+
+  friend constexpr auto operator != (const FUnicode& lhs, const FUnicode& rhs) noexcept -> bool
+  {
+    return ! ( lhs == rhs );
+  }
+
+  private:
+    // Methods
+    void setChar (std::size_t index, wchar_t ch)
+    {
+      if ( index == 0 && unicode_data[1] == L'\0' )
+      {
+        unicode_data[0] = ch;
+        return;
+      }
+
+      if ( index > 0 && unicode_data[1] == L'\0' && ch == L'\0' )
+        return;  // No combining characters to remove
+
+      std::array<wchar_t, UNICODE_MAX> seq{};
+      const auto& self = *this;
+
+      for (std::size_t n{0}; n < UNICODE_MAX; n++)
+        seq[n] = self[n];
+
+      if ( index < UNICODE_MAX )
+        seq[index] = ch;
+
+      setSequence (seq);
+    }
+
+    void setSequence (const std::array<wchar_t, UNICODE_MAX>& seq)
+    {
+      unicode_data[0] = seq[0];
+      unicode_data[1] = ( seq[0] != L'\0' && seq[1] != L'\0' )
+                      ? wchar_t(internal::internCombiningSequence(seq))
+                      : L'\0';
+    }
+};
+
+#else  // Default layout
+
 struct FUnicode
 {
   // Using-declarations
@@ -913,6 +1135,22 @@ struct FUnicode
     return &unicode_data[0];
   }
 
+  template <typename InputIter>
+  void assign (InputIter first, InputIter last)
+  {
+    std::size_t n{0};
+
+    while ( first != last && n < UNICODE_MAX )
+    {
+      (*this)[n] = *first;
+      ++first;
+      ++n;
+    }
+
+    if ( n < UNICODE_MAX )
+      (*this)[n] = L'\0';
+  }
+
   // Data member
   wchar_t unicode_data[UNICODE_MAX]{L'\0', L'\0', L'\0', L'\0', L'\0'};
 
@@ -941,6 +1179,8 @@ struct FUnicode
   }
 };
 
+#endif  // defined(F_COMPACT_FCHAR)
+
 
 // FCellColor
 //----------------------------------------------------------------------
@@ -1080,6 +1320,27 @@ constexpr auto getCompareBitMask() noexcept -> uInt32
 
 struct FChar
 {
+  // Constructors
+  constexpr FChar() noexcept = default;
+
+  constexpr FChar ( const FUnicode& unicode
+                  , const FUnicode& encoded = {}
+                  , const FCellColor& cell_color = {}
+                  , const FAttribute& attribute = {} ) noexcept
+    : ch{unicode}
+    , color{cell_color}
+    , attr{attribute}
+#if !defined(F_COMPACT_FCHAR)
+    , encoded_char{encoded}
+#endif
+  {
+    // Takes the members in the order ch, encoded_char, color, attr.
+    // The compact layout computes the encoded character on output.
+#if defined(F_COMPACT_FCHAR)
+    static_cast<void>(encoded);
+#endif
+  }
+
   // Accessors
   constexpr auto getCharWidth() const noexcept -> uInt32
   {
@@ -1119,9 +1380,11 @@ struct FChar
 
   // Data member
   FUnicode   ch{};            // Character code
-  FUnicode   encoded_char{};  // Encoded output character
   FCellColor color{};         // Foreground and background color
   FAttribute attr{};          // Attributes
+#if !defined(F_COMPACT_FCHAR)
+  FUnicode   encoded_char{};  // Encoded output character
+#endif
 
   // Friend operator functions
 #if HAVE_BUILTIN(__builtin_bit_cast)
@@ -1139,6 +1402,9 @@ struct FChar
     if ( (lhs.attr.data & mask) != (rhs.attr.data & mask) )
       return false;
 
+#if defined(F_COMPACT_FCHAR)
+    return lhs.ch == rhs.ch;
+#else
 #if defined(__clang__)
   #pragma clang diagnostic push
   #if __has_warning("-Wunsafe-buffer-usage")
@@ -1153,6 +1419,7 @@ struct FChar
 #if defined(__clang__)
   #pragma clang diagnostic pop
 #endif
+#endif  // defined(F_COMPACT_FCHAR)
   }
 
 #if HAVE_BUILTIN(__builtin_bit_cast)
@@ -335,6 +335,7 @@ class FWidget : public FVTerm
     virtual void onKeyPress (FKeyEvent*);
     virtual void onKeyUp (FKeyEvent*);
     virtual void onKeyDown (FKeyEvent*);
+    virtual void onPaste (FPasteEvent*);
     virtual void onMouseDown (FMouseEvent*);
     virtual void onMouseUp (FMouseEvent*);
     virtual void onMouseDoubleClick (FMouseEvent*);
@@ -74,7 +74,6 @@ struct TransparentShadowData
   uInt         shadow_height{};
   FChar        transparent_char{};
   FChar        color_overlay_char{};
-  FChar*       region_ptr{};
 };
 
 
@@ -411,13 +410,13 @@ void drawTransparentShadow (FWidget* w)
       { L'\0', L'\0', L'\0', L'\0', L'\0' },
       { wc_shadow.fg, wc_shadow.bg },
       { 0x00004000U }  // color_overlay
-    },
-    &region.getFChar(region.size.width, 0)
+    }
   };
 
   drawRightShadow(data);
   drawBottomShadow(data);
   region.has_changes = true;
+  region.markFlagsChanged();
   // Update row changes
   auto last_row = uInt(data.height + data.shadow_height - 1);
   region.changes_in_row = {uInt(0), last_row};
@@ -436,27 +435,21 @@ inline void drawRightShadow (TransparentShadowData& d)
   const auto s_width = d.shadow_width;
   const auto width = d.width;
   const auto height = d.height;
-  auto* ptr = d.region_ptr;
   auto& changes_in_line = d.region.changes_in_line;
-  auto& changes_in_1st_line = changes_in_line[0];
+  const auto xmax = width + s_width - 1;
 
+  auto* ptr = &d.region.getFChar(int(width), 0);
   std::fill (ptr, std::next(ptr, s_width), d.transparent_char);
-  changes_in_1st_line.xmin = std::min(changes_in_1st_line.xmin, width);
-  changes_in_1st_line.xmax = width + s_width - 1;
-  changes_in_1st_line.trans_count += s_width;
-  const auto total_width = width + s_width;
+  d.region.addLineChanges (0, width, xmax);
+  changes_in_line[0].trans_count += s_width;
 
   for (std::size_t y{1}; y < height; y++)
   {
-    ptr = std::next(ptr, total_width);
-    auto& changes = changes_in_line[y];
-    changes.xmin = std::min(d.region.changes_in_line[y].xmin, width);
-    changes.xmax = width + s_width - 1;
-    changes.trans_count += s_width;
+    ptr = &d.region.getFChar(int(width), int(y));
+    d.region.addLineChanges (uInt(y), width, xmax);
+    changes_in_line[y].trans_count += s_width;
     std::fill (ptr, std::next(ptr, s_width), d.color_overlay_char);
   }
-
-  d.region_ptr = std::next(ptr, s_width);
 }
 
 //----------------------------------------------------------------------
@@ -473,19 +466,16 @@ inline void drawBottomShadow (TransparentShadowData& d)
   const auto s_height = d.shadow_height;
   const auto start_y = d.height;
   auto& changes_in_line = d.region.changes_in_line;
-  auto* ptr = d.region_ptr;
 
   for (std::size_t i{0}; i < s_height; i++)
   {
     const auto y = start_y + i;
-    auto& changes = changes_in_line[y];
-    changes.xmin = 0;
-    changes.xmax = xmax;
-    changes.trans_count += total_width;
+    d.region.addLineChanges (uInt(y), 0, xmax);
+    changes_in_line[y].trans_count += total_width;
+    auto* ptr = &d.region.getFChar(0, int(y));
     std::fill (ptr, std::next(ptr, s_width), d.transparent_char);
     ptr = std::next(ptr, s_width);
     std::fill (ptr, std::next(ptr, width), d.color_overlay_char);
-    ptr = std::next(ptr, width);
   }
 }
 
@@ -593,10 +583,8 @@ struct GenericBlockShadowData
 
   inline void updateChanges (uInt y, uInt xmin, uInt xmax, uInt tc = 0)
   {
-    auto& changes = region.changes_in_line[y];
-    changes.xmin = std::min(changes.xmin, xmin);
-    changes.xmax = std::max(changes.xmax, xmax);
-    changes.trans_count += tc + 1;
+    region.addLineChanges (y, xmin, xmax);
+    region.changes_in_line[y].trans_count += tc + 1;
   }
 
   // Data members
@@ -949,10 +937,8 @@ struct GenericBoxData
 
   inline void updateChanges (uInt y, uInt xmin, uInt xmax)
   {
-    auto& changes = region.changes_in_line[y];
-    changes.xmin = std::min(changes.xmin, xmin);
-    changes.xmax = std::min(max_width, std::max(changes.xmax, xmax));
-    changes.trans_count += trans_count_increment;
+    region.addLineChanges (y, xmin, std::min(max_width, xmax));
+    region.changes_in_line[y].trans_count += trans_count_increment;
   }
 
   // Data members
@@ -1046,6 +1032,7 @@ void drawGenericBox ( FWidget* w, const FRect& r
   drawBoxSides (box_data);
   drawBoxBottomLine (box_data);
   box_data.region.has_changes = true;  // Mark region as having changes
+  box_data.region.markFlagsChanged();
   // Update row changes
   auto& changes_in_row = box_data.region.changes_in_row;
   changes_in_row.ymin = std::min(changes_in_row.ymin, uInt(box_data.y1));
@@ -0,0 +1,250 @@
+/***********************************************************************
+* fkey_decoder.cpp - Incremental decoder for key and mouse sequences   *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "final/fc.h"
+#include "final/input/fkey_decoder.h"
+#include "final/input/fkey_map.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FKeyDecoder
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FKeyDecoder::FKeyDecoder()
+{
+  // Without termcap strings, only the known keys are decoded
+  build({});
+}
+
+
+// public methods of FKeyDecoder
+//----------------------------------------------------------------------
+auto FKeyDecoder::getKey() const noexcept -> FKey
+{
+  // Returns the key of the bytes fed so far, FKey::Incomplete if
+  // a longer sequence can still match, or FKey::None if not
+
+  if ( mouse_state == MouseState::X11 || mouse_state == MouseState::Sgr )
+    return FKey::Incomplete;
+
+  if ( mouse_state == MouseState::Complete )
+    return mouse_key;
+
+  if ( state != NO_STATE )
+  {
+    const auto& current = states[state];
+
+    if ( current.key != FKey::None )
+      return current.key;
+
+    if ( current.num_transitions > 0 )
+      return FKey::Incomplete;
+  }
+
+  if ( mouse_state != MouseState::Failed )
+    return FKey::Incomplete;
+
+  return FKey::None;
+}
+
+//----------------------------------------------------------------------
+void FKeyDecoder::reset() noexcept
+{
+  state = states.empty() ? NO_STATE : 0;
+  length = 0;
+  mouse_state = mouse_support ? MouseState::Escape : MouseState::Failed;
+  mouse_key = FKey::None;
+}
+
+//----------------------------------------------------------------------
+auto FKeyDecoder::feed (char ch) noexcept -> FKey
+{
+  // Advances the automaton by one byte
+
+  const auto byte = uChar(ch);
+  length++;
+
+  if ( state != NO_STATE )
+    state = nextState(state, byte);
+
+  if ( mouse_state != MouseState::Failed )
+    feedMouse(byte);
+
+  return getKey();
+}
+
+
+// private methods of FKeyDecoder
+//----------------------------------------------------------------------
+void FKeyDecoder::build (const std::vector<FKeyMap::KeyCapMap>& termcap_keys)
+{
+  // Builds a trie of all key strings and stores it as a flat state
+  // table with the sorted transitions of each state in sequence
+
+  std::vector<std::map<uChar, uInt32>> children(1);
+  std::vector<FKey> keys(1, FKey::None);
+
+  auto insert = [&children, &keys] (const char* string, std::size_t len, FKey num)
+  {
+    uInt32 node{0};
+
+    for (std::size_t i{0}; i < len; i++)
+    {
+      const auto byte = uChar(string[i]);
+      const auto iter = children[node].find(byte);
+
+      if ( iter != children[node].end() )
+      {
+        node = iter->second;
+        continue;
+      }
+
+      const auto next = uInt32(keys.size());
+      children[node][byte] = next;
+      children.emplace_back();
+      keys.push_back(FKey::None);
+      node = next;
+    }
+
+    keys[node] = num;
+  };
+
+  // Termcap strings take precedence over the known keys
+  for (const auto& entry : FKeyMap::getKeyMap())
+    if ( entry.length != 0 )
+      insert (entry.string.data(), entry.length, entry.num);
+
+  for (const auto& entry : termcap_keys)
+    insert (entry.string, entry.length, entry.num);
+
+  // Bracketed paste start marker
+  static constexpr char paste_start[] = "\033[200~";
+  insert (paste_start, sizeof(paste_start) - 1, FKey::Bracketed_paste);
+
+  states.assign(keys.size(), State{});
+  transitions.clear();
+  transitions.reserve(keys.size() - 1);
+
+  for (std::size_t node{0}; node < keys.size(); node++)
+  {
+    auto& entry = states[node];
+    entry.key = keys[node];
+    entry.first_transition = uInt32(transitions.size());
+    entry.num_transitions = uInt32(children[node].size());
+
+    for (const auto& child : children[node])
+      transitions.push_back(Transition{child.first, child.second});
+  }
+
+  reset();
+}
+
+//----------------------------------------------------------------------
+inline auto FKeyDecoder::nextState (uInt32 current, uChar byte) const noexcept -> uInt32
+{
+  const auto& entry = states[current];
+  const auto begin = transitions.cbegin() + entry.first_transition;
+  const auto end = begin + entry.num_transitions;
+  const auto iter = std::lower_bound ( begin, end, byte
+                                     , [] (const Transition& t, uChar b)
+                                       {
+                                         return t.byte < b;
+                                       } );
+
+  if ( iter == end || iter->byte != byte )
+    return NO_STATE;
+
+  return iter->next;
+}
+
+//----------------------------------------------------------------------
+inline void FKeyDecoder::feedMouse (uChar byte) noexcept
+{
+  // Mouse sequences have variable content and are therefore
+  // recognized by a small automaton parallel to the trie
+
+  switch ( mouse_state )
+  {
+    case MouseState::Escape:
+      mouse_state = ( byte == 0x1b ) ? MouseState::Bracket : MouseState::Failed;
+      break;
+
+    case MouseState::Bracket:
+      mouse_state = ( byte == '[' ) ? MouseState::Protocol : MouseState::Failed;
+      break;
+
+    case MouseState::Protocol:
+      if ( byte == 'M' )
+        mouse_state = MouseState::X11;
+      else if ( byte == '<' )
+        mouse_state = MouseState::Sgr;
+      else if ( byte >= '1' && byte <= '9' )
+        mouse_state = MouseState::UrxvtDigit;
+      else
+        mouse_state = MouseState::Failed;
+      break;
+
+    case MouseState::X11:  // Three data bytes follow ESC [ M
+      if ( length == 6 )
+      {
+        mouse_state = MouseState::Complete;
+        mouse_key = FKey::X11mouse;
+      }
+      break;
+
+    case MouseState::Sgr:
+      if ( length >= 9 && (byte == 'M' || byte == 'm') )
+      {
+        mouse_state = MouseState::Complete;
+        mouse_key = FKey::Extended_mouse;
+      }
+      break;
+
+    case MouseState::UrxvtDigit:
+      mouse_state = ( byte >= '0' && byte <= '9' ) ? MouseState::Urxvt
+                                                   : MouseState::Failed;
+      break;
+
+    case MouseState::Urxvt:
+      if ( length >= 9 && byte == 'M' )
+      {
+        mouse_state = MouseState::Complete;
+        mouse_key = FKey::Urxvt_mouse;
+      }
+      break;
+
+    default:
+      mouse_state = MouseState::Failed;
+      mouse_key = FKey::None;
+      break;
+  }
+}
+
+}  // namespace finalcut
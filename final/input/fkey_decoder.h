@@ -0,0 +1,156 @@
+/***********************************************************************
+* fkey_decoder.h - Incremental decoder for key and mouse sequences     *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FKeyDecoder ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FKEYDECODER_H
+#define FKEYDECODER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <vector>
+
+#include "final/fc.h"
+#include "final/ftypes.h"
+#include "final/input/fkey_map.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FKeyDecoder
+//----------------------------------------------------------------------
+
+class FKeyDecoder final
+{
+  public:
+    // Constructor
+    FKeyDecoder();
+
+    // Accessors
+    auto  getClassName() const -> FString;
+    auto  getKey() const noexcept -> FKey;
+    auto  getLength() const noexcept -> std::size_t;
+    auto  getNumberOfStates() const noexcept -> std::size_t;
+
+    // Mutators
+    template <typename IterT>
+    void  setKeyCapMap (IterT, IterT);
+    void  setMouseSequences (bool = true) noexcept;
+
+    // Methods
+    void  reset() noexcept;
+    auto  feed (char) noexcept -> FKey;
+
+  private:
+    // Constants
+    static constexpr uInt32 NO_STATE = static_cast<uInt32>(-1);
+
+    // Enumeration
+    enum class MouseState : uInt8
+    {
+      Escape,       // Waiting for ESC
+      Bracket,      // Waiting for [
+      Protocol,     // Waiting for the protocol character
+      X11,          // ESC [ M Cb Cx Cy
+      Sgr,          // ESC [ < Pb ; Px ; Py (M|m)
+      UrxvtDigit,   // ESC [ Pb (second digit)
+      Urxvt,        // ESC [ Pb ; Px ; Py M
+      Complete,     // Mouse sequence found
+      Failed        // No mouse sequence
+    };
+
+    struct Transition
+    {
+      uChar  byte{};
+      uInt32 next{NO_STATE};
+    };
+
+    struct State
+    {
+      FKey   key{FKey::None};
+      uInt32 first_transition{0};
+      uInt32 num_transitions{0};
+    };
+
+    // Methods
+    void  build (const std::vector<FKeyMap::KeyCapMap>&);
+    auto  nextState (uInt32, uChar) const noexcept -> uInt32;
+    void  feedMouse (uChar) noexcept;
+
+    // Data members
+    std::vector<State>       states{};
+    std::vector<Transition>  transitions{};
+    uInt32                   state{0};
+    std::size_t              length{0};
+    MouseState               mouse_state{MouseState::Escape};
+    FKey                     mouse_key{FKey::None};
+    bool                     mouse_support{true};
+};
+
+// FKeyDecoder inline functions
+//----------------------------------------------------------------------
+inline auto FKeyDecoder::getClassName() const -> FString
+{ return "FKeyDecoder"; }
+
+//----------------------------------------------------------------------
+inline auto FKeyDecoder::getLength() const noexcept -> std::size_t
+{ return length; }
+
+//----------------------------------------------------------------------
+inline auto FKeyDecoder::getNumberOfStates() const noexcept -> std::size_t
+{ return states.size(); }
+
+//----------------------------------------------------------------------
+template <typename IterT>
+void FKeyDecoder::setKeyCapMap (IterT begin, IterT end)
+{
+  // Generates the automaton with the terminal specific key strings
+
+  std::vector<FKeyMap::KeyCapMap> termcap_keys{};
+
+  for (auto iter{begin}; iter != end; ++iter)
+    if ( iter->string && iter->length != 0 )
+      termcap_keys.push_back(*iter);
+
+  build (termcap_keys);
+}
+
+//----------------------------------------------------------------------
+inline void FKeyDecoder::setMouseSequences (bool enable) noexcept
+{
+  mouse_support = enable;
+  reset();
+}
+
+}  // namespace finalcut
+
+#endif  // FKEYDECODER_H
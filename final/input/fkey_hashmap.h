@@ -20,6 +20,9 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+// FKeyboard decodes key sequences with FKeyDecoder. This hash map
+// lookup is no longer part of <final/final.h>.
+
 #ifndef FKEYHASHMAP_H
 #define FKEYHASHMAP_H
 
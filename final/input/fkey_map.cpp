@@ -3,7 +3,7 @@
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2018-2023 Markus Gans                                      *
+* Copyright 2018-2026 Markus Gans                                      *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -885,6 +885,7 @@ constexpr FKeyMap::KeyNameType FKeyMap::fkeyname =
   { FKey::X11mouse                  , {"xterm mouse"} },
   { FKey::Extended_mouse            , {"SGR extended mouse"} },
   { FKey::Urxvt_mouse               , {"urxvt mouse extension"} },
+  { FKey::Bracketed_paste           , {"bracketed paste"} },
   { FKey::Incomplete                , {"incomplete key string"} }
 }};
 
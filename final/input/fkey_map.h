@@ -3,7 +3,7 @@
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2015-2023 Markus Gans                                      *
+* Copyright 2015-2026 Markus Gans                                      *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -65,7 +65,7 @@ class FKeyMap final
     // Using-declaration
     using KeyCapMapType = std::array<KeyCapMap, 190>;
     using KeyMapType = std::array<KeyMap, 234>;
-    using KeyNameType = std::array<KeyName, 390>;
+    using KeyNameType = std::array<KeyName, 391>;
 
     // Constructors
     FKeyMap() = default;
@@ -49,6 +49,7 @@ namespace finalcut
 uInt64    FKeyboard::key_timeout{100'000};             // 100 ms  (10 Hz)
 uInt64    FKeyboard::read_blocking_time{100'000};      // 100 ms  (10 Hz)
 uInt64    FKeyboard::read_blocking_time_short{5'000};  //   5 ms (200 Hz)
+std::size_t FKeyboard::paste_size_limit{4 * 1024 * 1024};   // 4 MiB
 bool      FKeyboard::non_blocking_input_support{true};
 TimeValue FKeyboard::time_keypressed{};
 
@@ -144,7 +145,7 @@ void FKeyboard::setNonBlockingInput (bool enable)
 //----------------------------------------------------------------------
 auto FKeyboard::hasUnprocessedInput() const noexcept -> bool
 {
-  return fifo_buf.hasData();
+  return fifo_buf.hasData() || read_buf.hasData();
 }
 
 //----------------------------------------------------------------------
@@ -202,6 +203,18 @@ void FKeyboard::clearKeyBuffer() noexcept
   fkey = FKey::None;
   key = FKey::None;
   fifo_buf.clear();
+  key_decoder.reset();
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::clearPasteText() noexcept
+{
+  // Release the memory of the delivered paste text
+
+  paste_text.clear();
+  paste_text.shrink_to_fit();
+  // The next part starts with the held back incomplete character
+  paste_text.swap(paste_rest);
 }
 
 //----------------------------------------------------------------------
@@ -211,6 +224,19 @@ void FKeyboard::clearKeyBufferOnTimeout()
 
   if ( fifo_buf.hasData() && isKeypressTimeout() )
     clearKeyBuffer();
+
+  // A paste without end marker is delivered on timeout,
+  // after which the input is parsed as key strings again
+  if ( paste_in_progress
+    && ! paste_queued
+    && ! read_buf.hasData()
+    && ! fkey_queue.isFull()
+    && isKeypressTimeout() )
+  {
+    paste_end_match = 0;
+    paste_in_progress = false;
+    queuePasteText();
+  }
 }
 
 //----------------------------------------------------------------------
@@ -224,6 +250,7 @@ void FKeyboard::escapeKeyHandling()
     && isKeypressTimeout() )
   {
     fifo_buf.clear();
+    key_decoder.reset();
     escapeKeyPressedCommand();
   }
 
@@ -239,6 +266,9 @@ void FKeyboard::processQueuedInput()
     key = fkey_queue.front();
     fkey_queue.pop();
 
+    if ( key == FKey::Bracketed_paste )
+      paste_queued = false;
+
     if ( key > FKey::None )
     {
       keyPressedCommand();
@@ -248,6 +278,9 @@ void FKeyboard::processQueuedInput()
 
       keyReleasedCommand();
 
+      if ( key == FKey::Bracketed_paste )
+        clearPasteText();
+
       if ( FApplication::isQuit() )
         return;
 
@@ -258,87 +291,46 @@ void FKeyboard::processQueuedInput()
 
 // private methods of FKeyboard
 //----------------------------------------------------------------------
-inline auto FKeyboard::getMouseProtocolKey() const -> FKey
+inline auto FKeyboard::getSequenceKey() -> FKey
 {
-  // Looking for mouse string in the key buffer
-
-  if ( ! mouse_support )
-    return NOT_SET;
+  // Looking for mouse, termcap and known key strings in the buffer.
+  // Only the bytes added since the last call pass through the decoder.
 
+  static_assert ( FIFO_BUF_SIZE > 0, "FIFO buffer too small" );
   const auto buf_len = fifo_buf.getSize();
 
-  if ( buf_len < 3 || fifo_buf[1] != '[' )
-    return NOT_SET;
-
-  // x11 mouse tracking
-  if ( fifo_buf[2] == 'M' )
-    return ( buf_len < 6 ) ? FKey::Incomplete : FKey::X11mouse;
-
-  // SGR mouse tracking
-  if ( fifo_buf[2] == '<' )
-  {
-    if ( buf_len < 9 || (fifo_buf[buf_len - 1] != 'M' && fifo_buf[buf_len - 1] != 'm') )
-      return FKey::Incomplete;  // Incomplete mouse sequence
-
-    return FKey::Extended_mouse;
-  }
+  if ( key_decoder.getLength() > buf_len )
+    key_decoder.reset();
 
-  // urxvt mouse tracking
-  if ( fifo_buf[2] >= '1' && fifo_buf[2] <= '9'
-    && std::isdigit(fifo_buf[3]) && buf_len >= 9
-    && fifo_buf[buf_len - 1] == 'M' )
-    return FKey::Urxvt_mouse;
+  for (auto i = key_decoder.getLength(); i < buf_len; i++)
+    key_decoder.feed(fifo_buf[i]);
 
-  return NOT_SET;
-}
-
-//----------------------------------------------------------------------
-inline auto FKeyboard::getTermcapKey() -> FKey
-{
-  // Looking for termcap key strings in the buffer
-
-  static_assert ( FIFO_BUF_SIZE > 0, "FIFO buffer too small" );
+  const auto found_key = key_decoder.getKey();
 
-  if ( key_cap_ptr.use_count() == 0 )
+  if ( found_key == FKey::None || found_key == FKey::Incomplete )
     return NOT_SET;
 
-  const auto buf_len = fifo_buf.getSize();
-  auto found_key = fkeyhashmap::getTermcapKey(fifo_buf);
-
-  if ( found_key != FKey::None )  // found
+  // The mouse string is removed by the mouse tracking command
+  if ( found_key == FKey::X11mouse
+    || found_key == FKey::Extended_mouse
+    || found_key == FKey::Urxvt_mouse )
   {
-    fifo_buf.pop(buf_len);  // Remove founded entry
+    key_decoder.reset();
     return found_key;
   }
 
-  return NOT_SET;
-}
-
-//----------------------------------------------------------------------
-inline auto FKeyboard::getKnownKey() -> FKey
-{
-  // Looking for a known key strings in the buffer
-
-  static_assert ( FIFO_BUF_SIZE > 0, "FIFO buffer too small" );
-  const auto buf_len = fifo_buf.getSize();
-  auto found_key = fkeyhashmap::getKnownKey(fifo_buf);
-
-  if ( found_key != FKey::None )  // found
+  if ( buf_len == 2
+    && ( fifo_buf[1] == 'O'
+      || fifo_buf[1] == '['
+      || fifo_buf[1] == ']' )
+    && ! isKeypressTimeout() )
   {
-    if ( buf_len == 2
-      && ( fifo_buf[1] == 'O'
-        || fifo_buf[1] == '['
-        || fifo_buf[1] == ']' )
-      && ! isKeypressTimeout() )
-    {
-      return FKey::Incomplete;
-    }
-
-    fifo_buf.pop(buf_len);  // Remove founded entry
-    return found_key;
+    return FKey::Incomplete;
   }
 
-  return NOT_SET;
+  fifo_buf.pop(buf_len);  // Remove founded entry
+  key_decoder.reset();
+  return found_key;
 }
 
 //----------------------------------------------------------------------
@@ -386,6 +378,7 @@ inline auto FKeyboard::getSingleKey() -> FKey
     keycode = FKey(uChar(firstchar));
 
   fifo_buf.pop(len);  // Remove founded entry
+  key_decoder.reset();
 
   if ( keycode == FKey(0) )  // Ctrl+Space or Ctrl+@
     keycode = FKey::Ctrl_space;
@@ -450,47 +443,169 @@ auto FKeyboard::UTF8decode (const std::size_t len) const noexcept -> FKey
 //----------------------------------------------------------------------
 inline auto FKeyboard::readKey() -> ssize_t
 {
-  setNonBlockingInput();
-  const ssize_t bytes = read(FTermios::getStdIn(), &read_character, 1);
-  unsetNonBlockingInput();
-  return bytes;
+  // Reads all available characters up to the free capacity of the
+  // read buffer with one system call. stdin is not switched to
+  // non-blocking mode, because it shares the file status flags with
+  // stdout. Instead, select() ensures that the read does not block.
+
+  const auto stdin_no = FTermios::getStdIn();
+  return read_buf.fill ( [stdin_no] (char* data, std::size_t length)
+                         {
+                           fd_set ifds{};
+                           struct timeval tv{};
+                           FD_ZERO(&ifds);
+                           FD_SET(stdin_no, &ifds);
+
+                           if ( select(stdin_no + 1, &ifds, nullptr, nullptr, &tv) < 1
+                             || ! FD_ISSET(stdin_no, &ifds) )
+                             return ssize_t(0);
+
+                           return read(stdin_no, data, length);
+                         } );
 }
 
 //----------------------------------------------------------------------
 void FKeyboard::parseKeyBuffer()
 {
-  while ( readKey() > 0 )
+  while ( read_buf.hasData() || readKey() > 0 )
   {
     time_keypressed = FObjectTimer::getCurrentTime();
-    has_pending_input = false;
 
-    if ( ! fifo_buf.isFull() )
-      fifo_buf.push(read_character);
-
-    // Read the rest from the fifo buffer
-    while ( fifo_buf.hasData() && fkey != FKey::Incomplete )
+    // The key strings are recognized character by character
+    while ( read_buf.hasData() && ! fkey_queue.isFull() && ! paste_queued )
     {
-      fkey = parseKeyString();
-      fkey = keyCorrection(fkey);
-
-      if ( fkey == FKey::X11mouse
-        || fkey == FKey::Extended_mouse
-        || fkey == FKey::Urxvt_mouse )
+      if ( paste_in_progress )
       {
-        key = fkey;
-        mouseTrackingCommand();
-        break;
+        readPasteText();
+        continue;
       }
 
-      if ( fkey != FKey::Incomplete )
-        fkey_queue.emplace(fkey);
+      parseKeyCharacter (read_buf.front());
+      read_buf.pop();
     }
 
-    fkey = FKey::None;
+    // A paste text is delivered before the following input is parsed
+    if ( fkey_queue.isFull() || paste_queued )
+      break;
+  }
+
+  // Unparsed characters are processed in the next cycle
+  has_pending_input = read_buf.hasData();
+}
+
+//----------------------------------------------------------------------
+inline void FKeyboard::parseKeyCharacter (char ch)
+{
+  if ( ! fifo_buf.isFull() )
+    fifo_buf.push(ch);
+
+  // Read the rest from the fifo buffer
+  while ( fifo_buf.hasData() && fkey != FKey::Incomplete )
+  {
+    fkey = parseKeyString();
+    fkey = keyCorrection(fkey);
 
-    if ( fkey_queue.isFull() )
+    if ( fkey == FKey::X11mouse
+      || fkey == FKey::Extended_mouse
+      || fkey == FKey::Urxvt_mouse )
+    {
+      key = fkey;
+      mouseTrackingCommand();
       break;
+    }
+
+    if ( fkey == FKey::Bracketed_paste )
+    {
+      // The paste text follows in the read buffer
+      fifo_buf.clear();
+      key_decoder.reset();
+      paste_in_progress = true;
+      break;
+    }
+
+    if ( fkey != FKey::Incomplete )
+      fkey_queue.emplace(fkey);
   }
+
+  fkey = FKey::None;
+}
+
+//----------------------------------------------------------------------
+inline void FKeyboard::readPasteText()
+{
+  // Copies the pasted text up to the end marker (ESC [ 2 0 1 ~)
+  // without interpreting it as key strings
+
+  static constexpr std::array<char, 6> paste_end{{'\033', '[', '2', '0', '1', '~'}};
+
+  while ( read_buf.hasData() )
+  {
+    const char ch = read_buf.front();
+    read_buf.pop();
+    paste_text.push_back(ch);
+
+    if ( ch == paste_end[paste_end_match] )
+      paste_end_match++;
+    else
+      paste_end_match = ( ch == paste_end[0] ) ? 1 : 0;
+
+    if ( paste_end_match == paste_end.size() )
+    {
+      paste_text.resize (paste_text.size() - paste_end.size());
+      paste_end_match = 0;
+      paste_in_progress = false;
+      queuePasteText();
+      return;
+    }
+
+    // A paste above the size limit is delivered in several parts
+    if ( paste_end_match == 0 && paste_text.size() >= paste_size_limit )
+    {
+      const auto length = getCompleteUTF8Length();
+
+      if ( length == 0 )  // Wait for the rest of the first character
+        continue;
+
+      paste_rest.assign(paste_text, length, std::string::npos);
+      paste_text.resize(length);
+      queuePasteText();
+      return;
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+inline auto FKeyboard::getCompleteUTF8Length() const noexcept -> std::size_t
+{
+  // Returns the paste text length without an incomplete
+  // UTF-8 sequence at the end
+
+  const auto size = paste_text.size();
+
+  if ( ! utf8_input )
+    return size;
+
+  for (std::size_t n{1}; n <= std::min(size, std::size_t(4)); n++)
+  {
+    const auto byte = uChar(paste_text[size - n]);
+
+    if ( (byte & 0xc0) == 0x80 )  // Continuation byte
+      continue;
+
+    const std::size_t seq_length = ( byte >= 0xf0 ) ? 4
+                                 : ( byte >= 0xe0 ) ? 3
+                                 : ( byte >= 0xc0 ) ? 2 : 1;
+    return ( seq_length > n ) ? size - n : size;
+  }
+
+  return size;  // No lead byte found
+}
+
+//----------------------------------------------------------------------
+inline void FKeyboard::queuePasteText()
+{
+  paste_queued = true;
+  fkey_queue.emplace(FKey::Bracketed_paste);
 }
 
 //----------------------------------------------------------------------
@@ -504,17 +619,7 @@ auto FKeyboard::parseKeyString() -> FKey
   if ( fifo_buf.getSize() == 1 )
     return isKeypressTimeout() ? getSingleKey() : FKey::Incomplete;
 
-  FKey keycode = getMouseProtocolKey();
-
-  if ( keycode != NOT_SET )
-    return keycode;
-
-  keycode = getTermcapKey();
-
-  if ( keycode != NOT_SET )
-    return keycode;
-
-  keycode = getKnownKey();
+  const FKey keycode = getSequenceKey();
 
   if ( keycode != NOT_SET )
     return keycode;
@@ -564,6 +669,7 @@ void FKeyboard::substringKeyHandling()
 
     fkey_queue.emplace(fkey);
     fifo_buf.clear();
+    key_decoder.reset();
   }
 }
 
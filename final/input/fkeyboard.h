@@ -3,7 +3,7 @@
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2018-2023 Markus Gans                                      *
+* Copyright 2018-2026 Markus Gans                                      *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -45,7 +45,7 @@
 #include <utility>
 
 #include "final/ftypes.h"
-#include "final/input/fkey_hashmap.h"
+#include "final/input/fkey_decoder.h"
 #include "final/input/fkey_map.h"
 #include "final/util/char_ringbuffer.h"
 #include "final/util/fstring.h"
@@ -91,9 +91,11 @@ class FKeyboard final
   public:
     // Constants
     static constexpr std::size_t FIFO_BUF_SIZE{512};
+    static constexpr std::size_t READ_BUF_SIZE{4096};
 
     // Using-declaration
     using keybuffer = CharRingBuffer<FIFO_BUF_SIZE>;
+    using readbuffer = CharRingBuffer<READ_BUF_SIZE>;
 
     // Constructor
     FKeyboard();
@@ -116,9 +118,11 @@ class FKeyboard final
     auto  getKey() const noexcept -> FKey;
     auto  getKeyName (const FKey) const -> FString;
     auto  getKeyBuffer() & noexcept -> keybuffer&;
+    auto  getPasteText() const & noexcept -> const std::string&;
     auto  getKeyPressedTime() const noexcept -> TimeValue;
     static auto  getKeypressTimeout() noexcept -> uInt64;
     static auto  getReadBlockingTime() noexcept -> uInt64;
+    static auto  getPasteSizeLimit() noexcept -> std::size_t;
 
     // Mutators
     template <typename T>
@@ -127,6 +131,7 @@ class FKeyboard final
     static void  setKeypressTimeout (const uInt64) noexcept;
     static void  setReadBlockingTime (const uInt64) noexcept;
     static void  setNonBlockingInputSupport (bool = true) noexcept;
+    static void  setPasteSizeLimit (const std::size_t) noexcept;
     void  setNonBlockingInput (bool = true);
     void  unsetNonBlockingInput() noexcept;
     void  enableUTF8() noexcept;
@@ -146,6 +151,7 @@ class FKeyboard final
     auto  hasUnprocessedInput() const noexcept -> bool;
     auto  isKeyPressed (uInt64 = read_blocking_time) -> bool;
     void  clearKeyBuffer() noexcept;
+    void  clearPasteText() noexcept;
     void  clearKeyBufferOnTimeout();
     void  fetchKeyCode();
     void  escapeKeyHandling();
@@ -162,9 +168,7 @@ class FKeyboard final
     using KeyQueue = FRingBuffer<FKey, MAX_QUEUE_SIZE>;
 
     // Accessors
-    auto  getMouseProtocolKey() const -> FKey;
-    auto  getTermcapKey() -> FKey;
-    auto  getKnownKey() -> FKey;
+    auto  getSequenceKey() -> FKey;
     auto  getSingleKey() -> FKey;
 
     // Predicate
@@ -175,6 +179,10 @@ class FKeyboard final
     auto  UTF8decode (const std::size_t) const noexcept -> FKey;
     auto  readKey() -> ssize_t;
     void  parseKeyBuffer();
+    void  parseKeyCharacter (char);
+    void  readPasteText();
+    auto  getCompleteUTF8Length() const noexcept -> std::size_t;
+    void  queuePasteText();
     auto  parseKeyString() -> FKey;
     auto  keyCorrection (const FKey&) const -> FKey;
     void  substringKeyHandling();
@@ -193,20 +201,26 @@ class FKeyboard final
     static uInt64     read_blocking_time;
     static uInt64     read_blocking_time_short;
     static uInt64     key_timeout;
+    static std::size_t paste_size_limit;
     static bool       non_blocking_input_support;
     FKeyMapPtr        key_cap_ptr{};
     KeyMapEnd         key_cap_end{};
     keybuffer         fifo_buf{};
+    readbuffer        read_buf{};
+    FKeyDecoder       key_decoder{};
     KeyQueue          fkey_queue{};
+    std::string       paste_text{};
+    std::string       paste_rest{};
+    std::size_t       paste_end_match{0};
     FKey              fkey{FKey::None};
     FKey              key{FKey::None};
     int               stdin_status_flags{0};
-    char              read_character{};
     bool              has_pending_input{false};
     bool              fifo_in_use{false};
     bool              utf8_input{false};
-    bool              mouse_support{true};
     bool              non_blocking_stdin{false};
+    bool              paste_in_progress{false};
+    bool              paste_queued{false};
 };
 
 // FKeyboard inline functions
@@ -222,6 +236,10 @@ inline auto FKeyboard::getKey() const noexcept -> FKey
 inline auto FKeyboard::getKeyBuffer() & noexcept -> keybuffer&
 { return fifo_buf; }
 
+//----------------------------------------------------------------------
+inline auto FKeyboard::getPasteText() const & noexcept -> const std::string&
+{ return paste_text; }
+
 //----------------------------------------------------------------------
 inline auto FKeyboard::getKeyPressedTime() const noexcept -> TimeValue
 { return time_keypressed; }
@@ -234,13 +252,17 @@ inline auto FKeyboard::getKeypressTimeout() noexcept -> uInt64
 inline auto FKeyboard::getReadBlockingTime() noexcept -> uInt64
 { return read_blocking_time; }
 
+//----------------------------------------------------------------------
+inline auto FKeyboard::getPasteSizeLimit() noexcept -> std::size_t
+{ return paste_size_limit; }
+
 //----------------------------------------------------------------------
 template <typename T>
 inline void FKeyboard::setTermcapMap (const T& keymap)
 {
   key_cap_ptr = std::make_shared<T>(keymap);
   key_cap_end = key_cap_ptr->cend();
-  fkeyhashmap::setKeyCapMap<keybuffer>(key_cap_ptr->cbegin(), key_cap_end);
+  key_decoder.setKeyCapMap(key_cap_ptr->cbegin(), key_cap_end);
 }
 
 //----------------------------------------------------------------------
@@ -254,7 +276,7 @@ inline void FKeyboard::setTermcapMap()
                              , [] (const FKeyMap::KeyCapMap& entry)
                                { return entry.length == 0; }
                              );
-  fkeyhashmap::setKeyCapMap<keybuffer>(key_cap_ptr->cbegin(), key_cap_end);
+  key_decoder.setKeyCapMap(key_cap_ptr->cbegin(), key_cap_end);
 }
 
 //----------------------------------------------------------------------
@@ -269,6 +291,10 @@ inline void FKeyboard::setReadBlockingTime (const uInt64 blocking_time) noexcept
 inline void FKeyboard::setNonBlockingInputSupport (bool enable) noexcept
 { non_blocking_input_support = enable; }
 
+//----------------------------------------------------------------------
+inline void FKeyboard::setPasteSizeLimit (const std::size_t size) noexcept
+{ paste_size_limit = std::max(size, std::size_t(1)); }
+
 //----------------------------------------------------------------------
 inline void FKeyboard::unsetNonBlockingInput() noexcept
 { setNonBlockingInput(false); }
@@ -291,11 +317,11 @@ inline void FKeyboard::disableUTF8() noexcept
 
 //----------------------------------------------------------------------
 inline void FKeyboard::enableMouseSequences() noexcept
-{ mouse_support = true; }
+{ key_decoder.setMouseSequences(true); }
 
 //----------------------------------------------------------------------
 inline void FKeyboard::disableMouseSequences() noexcept
-{ mouse_support = false; }
+{ key_decoder.setMouseSequences(false); }
 
 //----------------------------------------------------------------------
 inline void FKeyboard::setPressCommand (const FKeyboardCommand& cmd)
@@ -116,11 +116,12 @@ class FOutput : public std::enable_shared_from_this<FOutput>
     virtual void initScreenSettings() = 0;
     virtual auto scrollTerminalForward() -> bool = 0;
     virtual auto scrollTerminalReverse() -> bool = 0;
+    virtual auto scrollTerminalLines (int, int, int) -> bool = 0;
     virtual void clearTerminalAttributes() = 0;
     virtual void clearTerminalState() = 0;
     virtual auto clearTerminal (wchar_t = L' ') -> bool = 0;
     virtual void flush() = 0;
-    virtual void beep() const = 0;
+    virtual void beep() = 0;
 
   private:
     // Accessors
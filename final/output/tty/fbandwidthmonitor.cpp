@@ -0,0 +1,148 @@
+/***********************************************************************
+* fbandwidthmonitor.cpp - Measures the load of the terminal connection *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+
+#include "final/output/tty/fbandwidthmonitor.h"
+
+namespace finalcut
+{
+
+// static class attributes
+constexpr uInt   FBandwidthMonitor::DEFAULT_THRESHOLD;
+constexpr uInt   FBandwidthMonitor::MAX_LOAD;
+constexpr uInt64 FBandwidthMonitor::MEASURE_INTERVAL;
+constexpr uInt64 FBandwidthMonitor::RECOVERY_TIME;
+
+//----------------------------------------------------------------------
+// class FBandwidthMonitor
+//----------------------------------------------------------------------
+
+// public methods of FBandwidthMonitor
+//----------------------------------------------------------------------
+auto FBandwidthMonitor::getTransferTime (uInt64 bytes) const noexcept -> uInt64
+{
+  // Estimated time in microseconds to send the given number of bytes
+
+  if ( throughput == 0 )
+    return 0;
+
+  return bytes * 1'000'000 / throughput;
+}
+
+//----------------------------------------------------------------------
+void FBandwidthMonitor::setThreshold (uInt percent) noexcept
+{
+  threshold = std::max(1U, std::min(percent, MAX_LOAD));
+}
+
+//----------------------------------------------------------------------
+void FBandwidthMonitor::addWrite (uInt64 bytes, uInt64 duration_us) noexcept
+{
+  // Adds a terminal write with its duration in microseconds
+
+  interval_bytes += bytes;
+  interval_write_time += duration_us;
+}
+
+//----------------------------------------------------------------------
+auto FBandwidthMonitor::update (uInt64 now_us) noexcept -> bool
+{
+  // Evaluates the measurement interval and returns true
+  // if the output quality has changed
+
+  if ( interval_start == 0 || now_us < interval_start )
+  {
+    interval_start = now_us;  // Start of the first interval
+    return false;
+  }
+
+  const auto elapsed_us = now_us - interval_start;
+
+  if ( elapsed_us < MEASURE_INTERVAL )
+    return false;
+
+  measure (elapsed_us);
+  interval_start = now_us;
+  interval_bytes = 0;
+  interval_write_time = 0;
+  return adjustQuality (now_us);
+}
+
+//----------------------------------------------------------------------
+void FBandwidthMonitor::reset() noexcept
+{
+  const auto limit = threshold;
+  *this = {};
+  threshold = limit;
+}
+
+
+// private methods of FBandwidthMonitor
+//----------------------------------------------------------------------
+void FBandwidthMonitor::measure (uInt64 elapsed_us) noexcept
+{
+  if ( interval_write_time > 0 && interval_bytes > 0 )
+  {
+    // Bytes per second during the write calls, smoothed
+    // with the previous value to compensate for outliers
+    const auto sample = interval_bytes * 1'000'000 / interval_write_time;
+    throughput = ( throughput == 0 ) ? sample : (3 * throughput + sample) / 4;
+  }
+
+  // The link is busy while writing and while sending the queued bytes
+  const auto busy_us = interval_write_time + getTransferTime(queue_depth);
+  load = uInt(std::min(busy_us * 100 / elapsed_us, uInt64(MAX_LOAD)));
+}
+
+//----------------------------------------------------------------------
+auto FBandwidthMonitor::adjustQuality (uInt64 now_us) noexcept -> bool
+{
+  auto next = quality;
+
+  if ( load >= threshold )
+  {
+    // Overload: Lower the quality by one step per interval
+    if ( quality == Quality::Full )
+      next = Quality::Reduced;
+    else
+      next = Quality::Minimal;
+  }
+  else if ( load < threshold / 2
+         && now_us - time_quality_change >= RECOVERY_TIME )
+  {
+    // Enough free bandwidth for the next higher quality
+    if ( quality == Quality::Minimal )
+      next = Quality::Reduced;
+    else
+      next = Quality::Full;
+  }
+
+  if ( next == quality )
+    return false;
+
+  quality = next;
+  time_quality_change = now_us;
+  return true;
+}
+
+}  // namespace finalcut
@@ -0,0 +1,138 @@
+/***********************************************************************
+* fbandwidthmonitor.h - Measures the load of the terminal connection   *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FBandwidthMonitor ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+// The monitor collects the written bytes and the time spent in the
+// write calls. At the end of each measurement interval, it estimates
+// the achieved throughput and the link load, i.e. the share of time
+// the connection is busy with the output, including the queued bytes.
+// A load above the threshold lowers the output quality step by step.
+// The quality rises again one step at a time when the load has been
+// below half the threshold for the recovery time.
+
+#ifndef FBANDWIDTHMONITOR_H
+#define FBANDWIDTHMONITOR_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FBandwidthMonitor
+//----------------------------------------------------------------------
+
+class FBandwidthMonitor final
+{
+  public:
+    // Enumeration
+    enum class Quality : uInt8
+    {
+      Full,     // Every update is presented with all colors
+      Reduced,  // Coalesced updates, intermediate animation frames are dropped
+      Minimal   // Basic colors only, erase and repeat are preferred
+    };
+
+    // Constants
+    static constexpr uInt   DEFAULT_THRESHOLD = 70;         // Load in percent
+    static constexpr uInt   MAX_LOAD          = 1'000;      // Load limit in percent
+    static constexpr uInt64 MEASURE_INTERVAL  = 250'000;    // 250 ms
+    static constexpr uInt64 RECOVERY_TIME     = 2'000'000;  //   2 s
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getQuality() const noexcept -> Quality;
+    auto getThreshold() const noexcept -> uInt;
+    auto getLoad() const noexcept -> uInt;
+    auto getThroughput() const noexcept -> uInt64;
+    auto getQueueDepth() const noexcept -> uInt64;
+    auto getTransferTime (uInt64) const noexcept -> uInt64;
+
+    // Mutators
+    void setThreshold (uInt) noexcept;
+    void setQueueDepth (uInt64) noexcept;
+
+    // Methods
+    void addWrite (uInt64, uInt64) noexcept;
+    auto update (uInt64) noexcept -> bool;
+    void reset() noexcept;
+
+  private:
+    // Methods
+    void measure (uInt64) noexcept;
+    auto adjustQuality (uInt64) noexcept -> bool;
+
+    // Data members
+    Quality quality{Quality::Full};
+    uInt    threshold{DEFAULT_THRESHOLD};
+    uInt    load{0};
+    uInt64  throughput{0};        // Bytes per second (0 = unknown)
+    uInt64  queue_depth{0};       // Bytes not yet sent
+    uInt64  interval_start{0};
+    uInt64  interval_bytes{0};
+    uInt64  interval_write_time{0};
+    uInt64  time_quality_change{0};
+};
+
+// FBandwidthMonitor inline functions
+//----------------------------------------------------------------------
+inline auto FBandwidthMonitor::getClassName() const -> FString
+{ return "FBandwidthMonitor"; }
+
+//----------------------------------------------------------------------
+inline auto FBandwidthMonitor::getQuality() const noexcept -> Quality
+{ return quality; }
+
+//----------------------------------------------------------------------
+inline auto FBandwidthMonitor::getThreshold() const noexcept -> uInt
+{ return threshold; }
+
+//----------------------------------------------------------------------
+inline auto FBandwidthMonitor::getLoad() const noexcept -> uInt
+{ return load; }
+
+//----------------------------------------------------------------------
+inline auto FBandwidthMonitor::getThroughput() const noexcept -> uInt64
+{ return throughput; }
+
+//----------------------------------------------------------------------
+inline auto FBandwidthMonitor::getQueueDepth() const noexcept -> uInt64
+{ return queue_depth; }
+
+//----------------------------------------------------------------------
+inline void FBandwidthMonitor::setQueueDepth (uInt64 bytes) noexcept
+{ queue_depth = bytes; }
+
+}  // namespace finalcut
+
+#endif  // FBANDWIDTHMONITOR_H
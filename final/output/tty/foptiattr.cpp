@@ -22,6 +22,7 @@
 
 #include <strings.h>  // need for ffs()
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <functional>
@@ -113,11 +114,38 @@ auto has_background_changes (const FChar&, FColor, bool) noexcept -> bool;
 // class FOptiAttr
 //----------------------------------------------------------------------
 
+// static class attributes
+constexpr std::size_t FOptiAttr::TRANSITION_CACHE_SIZE;
+constexpr std::size_t FOptiAttr::MAX_SGR_PARAMETERS;
+
 // constructors and destructor
 //----------------------------------------------------------------------
 FOptiAttr::FOptiAttr()
 {
-  attr_buf.reserve(SGRoptimizer::ATTR_BUF_SIZE);
+  attr_buf.reserve(ATTR_BUF_SIZE);
+}
+
+
+// public methods of FOptiAttr::TransitionKeyHash
+//----------------------------------------------------------------------
+auto FOptiAttr::TransitionKeyHash::operator () (const TransitionKey& key) const noexcept -> std::size_t
+{
+  const auto term = uInt64(key.term_color) << 32U | key.term_attr;
+  const auto next = uInt64(key.next_color) << 32U | key.next_attr;
+  const auto hash = std::hash<uInt64>{}(term);
+  return hash ^ (std::hash<uInt64>{}(next) + 0x9e3779b9U + (hash << 6U) + (hash >> 2U));
+}
+
+
+// public methods of FOptiAttr::TransitionKeyEqual
+//----------------------------------------------------------------------
+auto FOptiAttr::TransitionKeyEqual::operator () ( const TransitionKey& lhs
+                                                , const TransitionKey& rhs ) const noexcept -> bool
+{
+  return lhs.term_color == rhs.term_color
+      && lhs.term_attr == rhs.term_attr
+      && lhs.next_color == rhs.next_color
+      && lhs.next_attr == rhs.next_attr;
 }
 
 
@@ -411,6 +439,7 @@ void FOptiAttr::initialize()
   init_reset_attribute (F_dbl_underline.off);
   init_reset_attribute (F_standout.off, all_tests & ~same_like_se);
   alt_equal_pc_charset = hasCharsetEquivalence();
+  clearTransitionCache();
 }
 
 //----------------------------------------------------------------------
@@ -457,42 +486,50 @@ auto FOptiAttr::vga2ansi (FColor color) noexcept -> FColor
 //----------------------------------------------------------------------
 auto FOptiAttr::changeAttribute (FChar& term, FChar& next) -> FTermcap::TermcapString
 {
-  const bool next_has_color = hasColor(next);
-  fake_reverse = false;
-  attr_buf.clear();
-  prevent_no_color_video_attributes (term, next_has_color);
-  prevent_no_color_video_attributes (next);
-  detectSwitchOn (term, next);
-  detectSwitchOff (term, next);
+  // The result depends only on the (term, next) attributes and colors
+  // and on the terminal capabilities. Therefore, recurring transitions
+  // are taken from the transition cache.
 
-  // Simulate invisible characters
-  if ( ! F_secure.on.cap.data && next.isBitSet(FAttribute::set::invisible) )
-    next.encoded_char.unicode_data[0] = ' ';
-
-  // Look for no changes
-  if ( ! (switchOn() || switchOff() || hasColorChanged(term, next)) )
-    return {nullptr, 0};
+  static const auto& start_options = FStartOptions::getInstance();
 
-  if ( hasNoAttribute(next) )
+  if ( cached_sgr_optimizer != start_options.sgr_optimizer )
   {
-    deactivateAttributes (term, next);
+    clearTransitionCache();
+    cached_sgr_optimizer = start_options.sgr_optimizer;
   }
-  else if ( F_attributes.on.cap.data
-         && (! term.isBitSet(FAttribute::set::pc_charset) || alt_equal_pc_charset) )
+
+  const TransitionKey key { term.color.data, term.attr.data
+                          , next.color.data, next.attr.data };
+  const auto iter = transition_cache.find(key);
+  FTermcap::TermcapString sequence{nullptr, 0};
+
+  if ( iter != transition_cache.end() )
   {
-    changeAttributeSGR (term, next);
+    const auto& transition = iter->second;
+    term.color.data = transition.term_color;
+    term.attr.data = transition.term_attr;
+    next.color.data = transition.next_color;
+    next.attr.data = transition.next_attr;
+    transition_cache_hits++;
+
+    if ( transition.changed )
+      sequence = { transition.sequence.data()
+                 , uInt32(transition.sequence.length()) };
   }
   else
   {
-    changeAttributeSeparately (term, next);
+    sequence = computeAttributeChange (term, next);
+    addTransition (key, term, next, sequence);
+    transition_cache_misses++;
   }
 
-  static const auto& start_options = FStartOptions::getInstance();
-
-  if ( start_options.sgr_optimizer )
-    sgr_optimizer.optimize();
+#if !defined(F_COMPACT_FCHAR)
+  // Simulate invisible characters
+  if ( isInvisibleSimulated(next) )
+    next.encoded_char.unicode_data[0] = ' ';
+#endif
 
-  return {attr_buf.data(), uInt32(attr_buf.length())};
+  return sequence;
 }
 
 
@@ -500,19 +537,20 @@ auto FOptiAttr::changeAttribute (FChar& term, FChar& next) -> FTermcap::TermcapS
 //----------------------------------------------------------------------
 inline void FOptiAttr::set_mode ( Capability& capability
                                 , const FTermcap::TermcapString& cap
-                                , bool caused_reset ) const noexcept
+                                , bool caused_reset ) noexcept
 {
   if ( cap.data )
   {
     capability.cap = cap;
     capability.caused_reset = caused_reset;
+    clearTransitionCache();
   }
 }
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::set_mode_on ( TextStyle& style
                                    , const FTermcap::TermcapString& cap
-                                   , bool caused_reset ) const noexcept
+                                   , bool caused_reset ) noexcept
 {
   set_mode (style.on, cap, caused_reset);
 }
@@ -520,7 +558,7 @@ inline void FOptiAttr::set_mode_on ( TextStyle& style
 //----------------------------------------------------------------------
 inline void FOptiAttr::set_mode_off ( TextStyle& style
                                     , const FTermcap::TermcapString& cap
-                                    , bool caused_reset ) const noexcept
+                                    , bool caused_reset ) noexcept
 {
   set_mode (style.off, cap, caused_reset);
 }
@@ -962,6 +1000,62 @@ inline auto FOptiAttr::hasColorChanged ( const FChar& term
           || changes.off.isBitSet(fake_reverse_mask) ) );
 }
 
+//----------------------------------------------------------------------
+auto FOptiAttr::computeAttributeChange (FChar& term, FChar& next) -> FTermcap::TermcapString
+{
+  const bool next_has_color = hasColor(next);
+  fake_reverse = false;
+  attr_buf.clear();
+  sgr_end = 0;
+  sgr_parameters = 0;
+  prevent_no_color_video_attributes (term, next_has_color);
+  prevent_no_color_video_attributes (next);
+  detectSwitchOn (term, next);
+  detectSwitchOff (term, next);
+
+  // Look for no changes
+  if ( ! (switchOn() || switchOff() || hasColorChanged(term, next)) )
+    return {nullptr, 0};
+
+  if ( hasNoAttribute(next) )
+  {
+    deactivateAttributes (term, next);
+  }
+  else if ( F_attributes.on.cap.data
+         && (! term.isBitSet(FAttribute::set::pc_charset) || alt_equal_pc_charset) )
+  {
+    changeAttributeSGR (term, next);
+  }
+  else
+  {
+    changeAttributeSeparately (term, next);
+  }
+
+  return {attr_buf.data(), uInt32(attr_buf.length())};
+}
+
+//----------------------------------------------------------------------
+void FOptiAttr::addTransition ( const TransitionKey& key
+                              , const FChar& term, const FChar& next
+                              , const FTermcap::TermcapString& sequence )
+{
+  // The cache holds only a few dozen entries in a normal application.
+  // If it ever reaches its limit, it will start over again.
+
+  if ( transition_cache.size() >= TRANSITION_CACHE_SIZE )
+    clearTransitionCache();
+
+  auto& transition = transition_cache[key];
+  transition.term_color = term.color.data;
+  transition.term_attr = term.attr.data;
+  transition.next_color = next.color.data;
+  transition.next_attr = next.attr.data;
+  transition.changed = bool(sequence.data);
+
+  if ( sequence.data )
+    transition.sequence.assign(sequence.data, sequence.length);
+}
+
 //----------------------------------------------------------------------
 inline void FOptiAttr::resetColor (FChar& ch) const noexcept
 {
@@ -1402,7 +1496,7 @@ inline auto FOptiAttr::append_sequence (const FTermcap::TermcapString& seq) noex
   if ( ! seq.data )
     return false;
 
-  attr_buf.append(seq.data);
+  emit_sequence (seq.data, std::strlen(seq.data));
   return true;
 }
 
@@ -1412,10 +1506,145 @@ inline auto FOptiAttr::append_sequence (const std::string& seq) noexcept -> bool
   if ( seq.empty() )
     return false;
 
-  attr_buf.append(seq);
+  emit_sequence (seq.data(), seq.length());
   return true;
 }
 
+//----------------------------------------------------------------------
+void FOptiAttr::emit_sequence (const char* seq, std::size_t length) noexcept
+{
+  // With the SGR optimization enabled, SGR (Select Graphic Rendition)
+  // strings are combined directly while they are appended,
+  // e.g. "Esc [ 1 m" + "Esc [ 3 4 m" = "Esc [ 1 ; 3 4 m"
+
+  if ( ! cached_sgr_optimizer )
+  {
+    attr_buf.append(seq, length);
+    return;
+  }
+
+  std::size_t pos{0};
+
+  while ( pos < length )
+  {
+    const auto sgr_length = getSGRLength(seq + pos, length - pos);
+
+    if ( sgr_length > 0 )
+    {
+      combine_sgr (seq + pos, sgr_length);
+      pos += sgr_length;
+      continue;
+    }
+
+    // Copy all characters up to the next escape character
+    const auto* esc = static_cast<const char*> \
+        (std::memchr(seq + pos + 1, ESC[0], length - pos - 1));
+    const auto end = esc ? std::size_t(esc - seq) : length;
+    attr_buf.append(seq + pos, end - pos);
+    pos = end;
+  }
+}
+
+//----------------------------------------------------------------------
+void FOptiAttr::combine_sgr (const char* sgr, std::size_t length) noexcept
+{
+  std::size_t parameters{0};
+  const bool complete = isCompleteSGR(sgr, length, parameters);
+
+  if ( sgr_end == 0
+    || sgr_end != attr_buf.length()
+    || sgr_parameters + parameters > MAX_SGR_PARAMETERS )  // Linux console limit
+  {
+    // No directly preceding SGR string
+    attr_buf.append(sgr, length);
+    sgr_parameters = parameters;
+  }
+  else
+  {
+    // Replace the final 'm' of the preceding SGR string with ';'
+    attr_buf.pop_back();
+
+    if ( attr_buf.back() == '[' )  // Esc [ m
+      attr_buf.push_back('0');
+
+    attr_buf.push_back(';');
+
+    if ( length == 3 )  // Esc [ m
+      attr_buf.push_back('0');
+    else
+      attr_buf.append(sgr + 2, length - 3);
+
+    attr_buf.push_back('m');
+    sgr_parameters += parameters;
+  }
+
+  // A following parameter must not become a part of an incomplete color
+  sgr_end = complete ? attr_buf.length() : 0;
+}
+
+//----------------------------------------------------------------------
+inline auto FOptiAttr::getSGRLength (const char* seq, std::size_t length) noexcept -> std::size_t
+{
+  // Returns the length of an SGR string at the beginning of seq
+  // or 0 if there is none
+
+  if ( length < 3 || seq[0] != ESC[0] || seq[1] != '[' )
+    return 0;
+
+  for (std::size_t index{2}; index < length; index++)
+  {
+    const char ch = seq[index];
+
+    if ( ch == 'm' )
+      return index + 1;
+
+    if ( (ch < '0' || ch > '9') && ch != ';' )
+      return 0;
+  }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FOptiAttr::isCompleteSGR ( const char* sgr, std::size_t length
+                              , std::size_t& parameters ) noexcept -> bool
+{
+  // Counts the parameters of an SGR string and checks whether
+  // an extended color (38;5;n, 38;2;r;g;b, 48;..., 58;...) is complete
+
+  int value{0};
+  int outstanding{0};  // Remaining parameters of an extended color
+  bool color_mode{false};  // The next parameter is the color mode
+  parameters = 0;
+
+  for (std::size_t index{2}; index < length; index++)
+  {
+    const char ch = sgr[index];
+
+    if ( ch >= '0' && ch <= '9' )
+    {
+      value = value * 10 + (ch - '0');
+      continue;
+    }
+
+    parameters++;
+
+    if ( color_mode )
+    {
+      color_mode = false;
+      outstanding = ( value == 5 ) ? 1 : ( value == 2 ) ? 3 : -1;
+    }
+    else if ( outstanding > 0 )
+      outstanding--;
+    else if ( value == 38 || value == 48 || value == 58 )
+      color_mode = true;
+
+    value = 0;
+  }
+
+  return ! color_mode && outstanding == 0;
+}
+
 
 // non-member functions
 //----------------------------------------------------------------------
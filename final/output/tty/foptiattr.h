@@ -23,9 +23,9 @@
 /*  Standalone class
  *  ════════════════
  *
- *   ▕▔▔▔▔▔▔▔▔▔▔▔▏1     1▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
- *   ▕ FOptiAttr ▏- - - -▕ SGRoptimizer ▏
- *   ▕▁▁▁▁▁▁▁▁▁▁▁▏       ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FOptiAttr ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▏
  */
 
 #ifndef FOPTIATTR_H
@@ -39,10 +39,10 @@
 #include <algorithm>  // need for std::swap
 #include <array>
 #include <string>
+#include <unordered_map>
 
 #include "final/ftypes.h"
 #include "final/output/tty/ftermcap.h"
-#include "final/output/tty/sgr_optimizer.h"
 #include "final/util/fstring.h"
 
 
@@ -101,6 +101,9 @@ class FOptiAttr final
     // Accessors
     auto        getClassName() const -> FString;
     static auto getInstance() -> FOptiAttr&;
+    auto        getTransitionCacheHits() const noexcept -> uInt64;
+    auto        getTransitionCacheMisses() const noexcept -> uInt64;
+    auto        getTransitionCacheSize() const noexcept -> std::size_t;
 
     // Mutators
     void        setTermEnvironment (const TermEnv&);
@@ -146,11 +149,13 @@ class FOptiAttr final
 
     // Predicate
     static auto isNormal (const FChar&) noexcept -> bool;
+    auto        isInvisibleSimulated (const FChar&) const noexcept -> bool;
 
     // Methods
     void        initialize();
     static auto vga2ansi (FColor) noexcept -> FColor;
     auto        changeAttribute (FChar&, FChar&) -> FTermcap::TermcapString;
+    void        clearTransitionCache() noexcept;
 
   private:
     struct Capability
@@ -186,6 +191,34 @@ class FOptiAttr final
       FChar off{};
     };
 
+    struct TransitionKey
+    {
+      uInt32 term_color;
+      uInt32 term_attr;
+      uInt32 next_color;
+      uInt32 next_attr;
+    };
+
+    struct TransitionKeyHash
+    {
+      auto operator () (const TransitionKey&) const noexcept -> std::size_t;
+    };
+
+    struct TransitionKeyEqual
+    {
+      auto operator () (const TransitionKey&, const TransitionKey&) const noexcept -> bool;
+    };
+
+    struct Transition
+    {
+      std::string sequence{};    // Optimized escape sequence
+      uInt32      term_color{};  // Resulting terminal state
+      uInt32      term_attr{};
+      uInt32      next_color{};  // Resulting state of the next character
+      uInt32      next_attr{};
+      bool        changed{};     // false = no escape sequence required
+    };
+
     // Using-declarations
     using SetFunctionCall = std::function<bool(FOptiAttr*, FChar&)>;
 
@@ -198,6 +231,14 @@ class FOptiAttr final
     using AttributeHandlers = std::array<AttributeHandlerEntry, 13>;
     using NoColorVideoHandler = std::function<void(FOptiAttr*, FChar&)>;
     using NoColorVideoHandlerTable = std::array<NoColorVideoHandler, 18>;
+    using TransitionCache = std::unordered_map< TransitionKey, Transition
+                                              , TransitionKeyHash
+                                              , TransitionKeyEqual >;
+
+    // Constants
+    static constexpr std::size_t ATTR_BUF_SIZE{8192};
+    static constexpr std::size_t TRANSITION_CACHE_SIZE{1024};
+    static constexpr std::size_t MAX_SGR_PARAMETERS{16};
 
     // Enumerations
     enum init_reset_tests : uInt8
@@ -212,9 +253,9 @@ class FOptiAttr final
     };
 
     // Mutators
-    void        set_mode (Capability&, const FTermcap::TermcapString&, bool) const noexcept;
-    void        set_mode_on (TextStyle&, const FTermcap::TermcapString&, bool) const noexcept;
-    void        set_mode_off (TextStyle&, const FTermcap::TermcapString&, bool) const noexcept;
+    void        set_mode (Capability&, const FTermcap::TermcapString&, bool) noexcept;
+    void        set_mode_on (TextStyle&, const FTermcap::TermcapString&, bool) noexcept;
+    void        set_mode_off (TextStyle&, const FTermcap::TermcapString&, bool) noexcept;
     auto        setTermBold (FChar&) noexcept -> bool;
     auto        unsetTermBold (FChar&) noexcept -> bool;
     auto        setTermDim (FChar&) noexcept -> bool;
@@ -260,6 +301,8 @@ class FOptiAttr final
     auto        hasColorChanged (const FChar&, const FChar&) const noexcept -> bool;
 
     // Methods
+    auto        computeAttributeChange (FChar&, FChar&) -> FTermcap::TermcapString;
+    void        addTransition (const TransitionKey&, const FChar&, const FChar&, const FTermcap::TermcapString&);
     void        resetColor (FChar&) const noexcept ;
     void        prevent_no_color_video_attributes (FChar&, bool = false);
     void        deactivateAttributes (FChar&, FChar&);
@@ -293,6 +336,10 @@ class FOptiAttr final
     auto        append_sequence (CharT) noexcept -> bool;
     auto        append_sequence (const FTermcap::TermcapString&) noexcept -> bool;
     auto        append_sequence (const std::string&) noexcept -> bool;
+    void        emit_sequence (const char*, std::size_t) noexcept;
+    void        combine_sgr (const char*, std::size_t) noexcept;
+    static auto getSGRLength (const char*, std::size_t) noexcept -> std::size_t;
+    static auto isCompleteSGR (const char*, std::size_t, std::size_t&) noexcept -> bool;
 
     // Data members
     TextStyle        F_bold{};
@@ -313,9 +360,14 @@ class FOptiAttr final
 
     AttributeChanges changes{};
     std::string      attr_buf{};
-    SGRoptimizer     sgr_optimizer{attr_buf};
+    std::size_t      sgr_end{0};         // attr_buf position after the last SGR
+    std::size_t      sgr_parameters{0};  // Number of parameters in the last SGR
+    TransitionCache  transition_cache{};
+    uInt64           transition_cache_hits{0};
+    uInt64           transition_cache_misses{0};
     bool             alt_equal_pc_charset{false};
     bool             fake_reverse{false};
+    bool             cached_sgr_optimizer{false};
 };
 
 
@@ -324,21 +376,53 @@ class FOptiAttr final
 inline auto FOptiAttr::getClassName() const -> FString
 { return "FOptiAttr"; }
 
+//----------------------------------------------------------------------
+inline auto FOptiAttr::getTransitionCacheHits() const noexcept -> uInt64
+{ return transition_cache_hits; }
+
+//----------------------------------------------------------------------
+inline auto FOptiAttr::getTransitionCacheMisses() const noexcept -> uInt64
+{ return transition_cache_misses; }
+
+//----------------------------------------------------------------------
+inline auto FOptiAttr::getTransitionCacheSize() const noexcept -> std::size_t
+{ return transition_cache.size(); }
+
 //----------------------------------------------------------------------
 inline void FOptiAttr::setMaxColor (int c) noexcept
-{ F_color.max_color = c; }
+{
+  F_color.max_color = c;
+  clearTransitionCache();
+}
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::setNoColorVideo (int attr) noexcept
-{ F_color.attr_without_color = attr; }
+{
+  F_color.attr_without_color = attr;
+  clearTransitionCache();
+}
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::setDefaultColorSupport() noexcept
-{ F_color.ansi_default_color = true; }
+{
+  F_color.ansi_default_color = true;
+  clearTransitionCache();
+}
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::unsetDefaultColorSupport() noexcept
-{ F_color.ansi_default_color = false; }
+{
+  F_color.ansi_default_color = false;
+  clearTransitionCache();
+}
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::clearTransitionCache() noexcept
+{ transition_cache.clear(); }
+
+//----------------------------------------------------------------------
+inline auto FOptiAttr::isInvisibleSimulated (const FChar& fchar) const noexcept -> bool
+{ return ! F_secure.on.cap.data && fchar.isBitSet(FAttribute::set::invisible); }
 
 //----------------------------------------------------------------------
 template <typename CharT
@@ -623,6 +623,15 @@ auto FOptiMove::capDuration (const FTermcap::TermcapString& cap, int affcnt) con
   return int(ms);
 }
 
+//----------------------------------------------------------------------
+auto FOptiMove::capDuration (const std::string& sequence, int affcnt) const noexcept -> int
+{
+  if ( sequence.empty() )
+    return LONG_DURATION;
+
+  return capDuration (FTermcap::TermcapString{sequence.data(), uInt32(sequence.length())}, affcnt);
+}
+
 //----------------------------------------------------------------------
 auto FOptiMove::capDurationToLength (int duration) const noexcept -> int
 {
@@ -632,6 +641,19 @@ auto FOptiMove::capDurationToLength (int duration) const noexcept -> int
   return LONG_DURATION;
 }
 
+//----------------------------------------------------------------------
+inline auto FOptiMove::getDuration ( const Capability& capability
+                                   , const std::string& sequence ) const noexcept -> int
+{
+  // With cost calibration, the duration of the actually expanded
+  // sequence is used instead of the duration of a sample expansion
+
+  if ( ! cost_calibration )
+    return capability.duration;
+
+  return capDuration (sequence, 1);
+}
+
 //----------------------------------------------------------------------
 auto FOptiMove::repeatedAppend ( std::string& dst
                                , const Capability& o
@@ -701,8 +723,8 @@ inline auto FOptiMove::verticalMove (std::string& move, int from_y, int to_y) co
   if ( parm_cursor.row_address.cap.data )
   {
     // Move to fixed row position
-    move = FTermcap::encodeParameter(parm_cursor.row_address.cap, to_y).data;
-    vtime = parm_cursor.row_address.duration;
+    move = FTermcap::encodeParameter(parm_cursor.row_address.cap, to_y);
+    vtime = getDuration(parm_cursor.row_address, move);
   }
 
   if ( to_y > from_y )
@@ -719,10 +741,16 @@ inline void FOptiMove::downMove ( std::string& move, int& vtime
 {
   const int num = to_y - from_y;
 
-  if ( parm_cursor.down.cap.data && parm_cursor.down.duration < vtime )
+  if ( parm_cursor.down.cap.data )
   {
-    move = FTermcap::encodeParameter(parm_cursor.down.cap, num).data;
-    vtime = parm_cursor.down.duration;
+    std::string parm_down = FTermcap::encodeParameter(parm_cursor.down.cap, num);
+    const int parm_down_time = getDuration(parm_cursor.down, parm_down);
+
+    if ( parm_down_time < vtime )
+    {
+      move = std::move(parm_down);
+      vtime = parm_down_time;
+    }
   }
 
   if ( cursor.down.cap.data && (num * cursor.down.duration < vtime) )
@@ -740,10 +768,16 @@ inline void FOptiMove::upMove ( std::string& move, int& vtime
 {
   const int num = from_y - to_y;
 
-  if ( parm_cursor.up.cap.data && parm_cursor.up.duration < vtime )
+  if ( parm_cursor.up.cap.data )
   {
-    move = FTermcap::encodeParameter(parm_cursor.up.cap, num).data;
-    vtime = parm_cursor.up.duration;
+    std::string parm_up = FTermcap::encodeParameter(parm_cursor.up.cap, num);
+    const int parm_up_time = getDuration(parm_cursor.up, parm_up);
+
+    if ( parm_up_time < vtime )
+    {
+      move = std::move(parm_up);
+      vtime = parm_up_time;
+    }
   }
 
   if ( cursor.up.cap.data && (num * cursor.up.duration < vtime) )
@@ -763,8 +797,8 @@ inline auto FOptiMove::horizontalMove (std::string& hmove, int from_x, int to_x)
   if ( parm_cursor.column_address.cap.data )
   {
     // Move to fixed column position
-    hmove = FTermcap::encodeParameter(parm_cursor.column_address.cap, to_x).data;
-    htime = parm_cursor.column_address.duration;
+    hmove = FTermcap::encodeParameter(parm_cursor.column_address.cap, to_x);
+    htime = getDuration(parm_cursor.column_address, hmove);
   }
 
   if ( to_x > from_x )
@@ -780,8 +814,14 @@ inline void FOptiMove::moveWithParmRightCursor ( std::string& hmove
                                                , int& htime, int num ) const
 {
   // Use parameterized cursor right capability
-  hmove = FTermcap::encodeParameter(parm_cursor.right.cap, num).data;
-  htime = parm_cursor.right.duration;
+  std::string parm_right = FTermcap::encodeParameter(parm_cursor.right.cap, num);
+  const int parm_right_time = getDuration(parm_cursor.right, parm_right);
+
+  if ( parm_right_time < htime )
+  {
+    hmove = std::move(parm_right);
+    htime = parm_right_time;
+  }
 }
 
 //----------------------------------------------------------------------
@@ -830,7 +870,7 @@ inline void FOptiMove::rightMove ( std::string& hmove, int& htime
   if ( num == 0 )
     return;
 
-  if ( parm_cursor.right.cap.data && parm_cursor.right.duration < htime )
+  if ( parm_cursor.right.cap.data )
     moveWithParmRightCursor (hmove, htime, num);
 
   if ( cursor.right.cap.data )
@@ -841,9 +881,15 @@ inline void FOptiMove::rightMove ( std::string& hmove, int& htime
 inline void FOptiMove::moveWithParmLeftCursor ( std::string& hmove
                                               , int& htime, int num ) const
 {
-  // Use parameterized cursor right capability
-  hmove = FTermcap::encodeParameter(parm_cursor.left.cap, num).data;
-  htime = parm_cursor.left.duration;
+  // Use parameterized cursor left capability
+  std::string parm_left = FTermcap::encodeParameter(parm_cursor.left.cap, num);
+  const int parm_left_time = getDuration(parm_cursor.left, parm_left);
+
+  if ( parm_left_time < htime )
+  {
+    hmove = std::move(parm_left);
+    htime = parm_left_time;
+  }
 }
 
 //----------------------------------------------------------------------
@@ -892,7 +938,7 @@ inline void FOptiMove::leftMove ( std::string& hmove, int& htime
   if ( num == 0 )
     return;
 
-  if ( parm_cursor.left.cap.data && parm_cursor.left.duration < htime )
+  if ( parm_cursor.left.cap.data )
     moveWithParmLeftCursor (hmove, htime, num);
 
   if ( cursor.left.cap.data )
@@ -923,7 +969,7 @@ inline auto FOptiMove::isMethod0Faster ( int& move_time
   if ( move_xy.data )
   {
     move_buf = std::string(move_xy.data, move_xy.length);
-    move_time = parm_cursor.address.duration;
+    move_time = getDuration(parm_cursor.address, move_buf);
     return true;
   }
 
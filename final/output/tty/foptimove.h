@@ -108,6 +108,7 @@ class FOptiMove final
     // Accessors
     auto  getClassName() const -> FString;
     static auto  getInstance() -> FOptiMove&;
+    auto  getBaudRate() const noexcept -> int;
     auto  getCursorHomeLength() const noexcept -> uInt;
     auto  getCarriageReturnLength() const noexcept -> uInt;
     auto  getCursorToLLLength() const noexcept -> uInt;
@@ -157,6 +158,10 @@ class FOptiMove final
     void  set_clr_eol (const FTermcap::TermcapString&);
     void  set_auto_left_margin (bool = true) noexcept;
     void  set_eat_newline_glitch (bool = true) noexcept;
+    void  setCostCalibration (bool = true) noexcept;
+
+    // Inquiry
+    auto  isCostCalibrated() const noexcept -> bool;
 
     // Methods
     void  check_boundaries (int&, int&, int&, int&) const noexcept;
@@ -221,7 +226,9 @@ class FOptiMove final
     // Methods
     void  calculateCharDuration() noexcept;
     auto  capDuration (const FTermcap::TermcapString&, int) const noexcept -> int;
+    auto  capDuration (const std::string&, int) const noexcept -> int;
     auto  capDurationToLength (int) const noexcept -> int;
+    auto  getDuration (const Capability&, const std::string&) const noexcept -> int;
     auto  repeatedAppend (std::string&, const Capability&, int) const -> int;
     auto  relativeMove (std::string&, int, int, int, int) const -> int;
     auto  verticalMove (std::string&, int, int) const -> int;
@@ -260,6 +267,7 @@ class FOptiMove final
     std::string temp_result{};
     bool        automatic_left_margin{false};
     bool        eat_nl_glitch{false};
+    bool        cost_calibration{false};
 
     // Friend function
     friend void printDurations (const FOptiMove&);
@@ -271,6 +279,10 @@ class FOptiMove final
 inline auto FOptiMove::getClassName() const -> FString
 { return "FOptiMove"; }
 
+//----------------------------------------------------------------------
+inline auto FOptiMove::getBaudRate() const noexcept -> int
+{ return baudrate; }
+
 //----------------------------------------------------------------------
 inline auto FOptiMove::getCursorHomeLength() const noexcept -> uInt
 { return static_cast<uInt>(cursor.home.length); }
@@ -359,6 +371,14 @@ inline void FOptiMove::set_auto_left_margin (bool bcap) noexcept
 inline void FOptiMove::set_eat_newline_glitch (bool bcap) noexcept
 { eat_nl_glitch = bcap; }
 
+//----------------------------------------------------------------------
+inline void FOptiMove::setCostCalibration (bool enable) noexcept
+{ cost_calibration = enable; }
+
+//----------------------------------------------------------------------
+inline auto FOptiMove::isCostCalibrated() const noexcept -> bool
+{ return cost_calibration; }
+
 
 // FOptiMove non-member function forward declaration
 //----------------------------------------------------------------------
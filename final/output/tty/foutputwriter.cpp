@@ -0,0 +1,156 @@
+/***********************************************************************
+* foutputwriter.cpp - Writes terminal output frames in its own thread  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <chrono>
+#include <utility>
+
+#include "final/output/tty/foutputwriter.h"
+
+namespace finalcut
+{
+
+// static class attribute
+constexpr std::size_t FOutputWriter::QUEUE_SIZE;
+
+//----------------------------------------------------------------------
+// class FOutputWriter
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FOutputWriter::FOutputWriter (FWriteFunction&& function)
+  : write_function{std::move(function)}
+{
+  writer = std::thread([this] () { writerLoop(); });
+}
+
+//----------------------------------------------------------------------
+FOutputWriter::~FOutputWriter()  // destructor
+{
+  // The writer thread writes all queued frames before it ends
+
+  {
+    std::lock_guard<std::mutex> lock_guard(mutex);
+    stop = true;
+  }
+
+  frame_condition.notify_one();
+  writer.join();
+}
+
+
+// public methods of FOutputWriter
+//----------------------------------------------------------------------
+void FOutputWriter::push (std::string& frame)
+{
+  // Swaps the frame into the queue. In return, the caller gets the
+  // emptied string of a written frame with its allocated memory.
+  // Only a full queue blocks the caller until a slot is free again.
+
+  if ( isFull() )
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    done_condition.wait (lock, [this] () { return ! isFull(); });
+  }
+
+  const auto index = tail.load(std::memory_order_relaxed);
+  pending_bytes.fetch_add(frame.size(), std::memory_order_relaxed);
+  frames[index % QUEUE_SIZE].swap(frame);
+  frame.clear();
+  tail.store(index + 1, std::memory_order_release);
+
+  {
+    // Prevents a lost wake-up between the check and the wait
+    std::lock_guard<std::mutex> lock_guard(mutex);
+  }
+
+  frame_condition.notify_one();
+}
+
+//----------------------------------------------------------------------
+void FOutputWriter::waitUntilIdle()
+{
+  // Blocks until all queued frames are written
+
+  if ( ! isBusy() )
+    return;
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done_condition.wait (lock, [this] () { return ! isBusy(); });
+}
+
+
+// private methods of FOutputWriter
+//----------------------------------------------------------------------
+void FOutputWriter::writerLoop()
+{
+  while ( waitForFrame() )
+  {
+    const auto index = head.load(std::memory_order_relaxed);
+    auto& frame = frames[index % QUEUE_SIZE];
+    const auto start = std::chrono::steady_clock::now();
+
+    if ( ! write_function(frame) )
+      write_errors.fetch_add(1, std::memory_order_relaxed);
+
+    const auto duration = std::chrono::steady_clock::now() - start;
+    const auto duration_us = std::chrono::duration_cast<std::chrono::microseconds>(duration);
+    write_time_us.fetch_add(uInt64(duration_us.count()), std::memory_order_relaxed);
+    written_bytes.fetch_add(frame.size(), std::memory_order_relaxed);
+    pending_bytes.fetch_sub(frame.size(), std::memory_order_relaxed);
+    frame.clear();  // Keeps the capacity for the next frame
+    written_frames.fetch_add(1, std::memory_order_relaxed);
+    head.store(index + 1, std::memory_order_release);
+    notifyProducer();
+  }
+}
+
+//----------------------------------------------------------------------
+auto FOutputWriter::waitForFrame() -> bool
+{
+  // Returns false when the writer is stopped and the queue is empty
+
+  auto hasFrame = [this] ()
+  {
+    return head.load(std::memory_order_relaxed)
+        != tail.load(std::memory_order_acquire);
+  };
+
+  if ( hasFrame() )
+    return true;
+
+  std::unique_lock<std::mutex> lock(mutex);
+  frame_condition.wait (lock, [this, &hasFrame] () { return stop || hasFrame(); });
+  return hasFrame();
+}
+
+//----------------------------------------------------------------------
+inline void FOutputWriter::notifyProducer()
+{
+  {
+    std::lock_guard<std::mutex> lock_guard(mutex);
+  }
+
+  done_condition.notify_all();
+}
+
+}  // namespace finalcut
@@ -0,0 +1,171 @@
+/***********************************************************************
+* foutputwriter.h - Writes terminal output frames in its own thread    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FOutputWriter ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+// The UI thread (producer) hands completed output frames over to
+// the writer thread (consumer) through a single-producer single-
+// consumer ring with atomic head and tail indexes. The frames are
+// swapped without a lock. The mutex and the condition variables
+// put an idle thread to sleep and wake it up again, so every push
+// and every written frame briefly takes the mutex.
+
+#ifndef FOUTPUTWRITER_H
+#define FOUTPUTWRITER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FOutputWriter
+//----------------------------------------------------------------------
+
+class FOutputWriter final
+{
+  public:
+    // Using-declaration
+    using FWriteFunction = std::function<bool(const std::string&)>;
+
+    // Constant
+    static constexpr std::size_t QUEUE_SIZE{8};  // Power of two
+
+    // Constructor
+    explicit FOutputWriter (FWriteFunction&&);
+
+    // Disable copy constructor
+    FOutputWriter (const FOutputWriter&) = delete;
+
+    // Disable move constructor
+    FOutputWriter (FOutputWriter&&) noexcept = delete;
+
+    // Destructor
+    ~FOutputWriter();
+
+    // Disable copy assignment operator (=)
+    auto operator = (const FOutputWriter&) -> FOutputWriter& = delete;
+
+    // Disable move assignment operator (=)
+    auto operator = (FOutputWriter&&) noexcept -> FOutputWriter& = delete;
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getPendingFrames() const noexcept -> std::size_t;
+    auto getWrittenFrames() const noexcept -> uInt64;
+    auto getWrittenBytes() const noexcept -> uInt64;
+    auto getWriteTime() const noexcept -> uInt64;
+    auto getPendingBytes() const noexcept -> uInt64;
+    auto getWriteErrors() const noexcept -> uInt64;
+
+    // Inquiries
+    auto isBusy() const noexcept -> bool;
+    auto isFull() const noexcept -> bool;
+
+    // Methods
+    void push (std::string&);
+    void waitUntilIdle();
+
+  private:
+    // Methods
+    void writerLoop();
+    auto waitForFrame() -> bool;
+    void notifyProducer();
+
+    // Data members
+    std::array<std::string, QUEUE_SIZE> frames{};
+    std::atomic<std::size_t> head{0};  // Next frame of the writer thread
+    std::atomic<std::size_t> tail{0};  // Next free slot of the producer
+    std::atomic<uInt64>      written_frames{0};
+    std::atomic<uInt64>      written_bytes{0};
+    std::atomic<uInt64>      write_time_us{0};  // Time spent in the write function
+    std::atomic<uInt64>      pending_bytes{0};
+    std::atomic<uInt64>      write_errors{0};   // Failed write function calls
+    FWriteFunction           write_function{};
+    std::mutex               mutex{};
+    std::condition_variable  frame_condition{};
+    std::condition_variable  done_condition{};
+    bool                     stop{false};
+    std::thread              writer{};
+};
+
+// FOutputWriter inline functions
+//----------------------------------------------------------------------
+inline auto FOutputWriter::getClassName() const -> FString
+{ return "FOutputWriter"; }
+
+//----------------------------------------------------------------------
+inline auto FOutputWriter::getPendingFrames() const noexcept -> std::size_t
+{
+  // Queued frames including the frame that is currently written
+  return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+}
+
+//----------------------------------------------------------------------
+inline auto FOutputWriter::getWrittenFrames() const noexcept -> uInt64
+{ return written_frames.load(std::memory_order_relaxed); }
+
+//----------------------------------------------------------------------
+inline auto FOutputWriter::getWrittenBytes() const noexcept -> uInt64
+{ return written_bytes.load(std::memory_order_relaxed); }
+
+//----------------------------------------------------------------------
+inline auto FOutputWriter::getWriteTime() const noexcept -> uInt64
+{ return write_time_us.load(std::memory_order_relaxed); }
+
+//----------------------------------------------------------------------
+inline auto FOutputWriter::getPendingBytes() const noexcept -> uInt64
+{ return pending_bytes.load(std::memory_order_relaxed); }
+
+//----------------------------------------------------------------------
+inline auto FOutputWriter::getWriteErrors() const noexcept -> uInt64
+{ return write_errors.load(std::memory_order_relaxed); }
+
+//----------------------------------------------------------------------
+inline auto FOutputWriter::isBusy() const noexcept -> bool
+{ return getPendingFrames() > 0; }
+
+//----------------------------------------------------------------------
+inline auto FOutputWriter::isFull() const noexcept -> bool
+{ return getPendingFrames() >= QUEUE_SIZE; }
+
+}  // namespace finalcut
+
+#endif  // FOUTPUTWRITER_H
@@ -45,6 +45,7 @@
 #include "final/output/tty/ftermdetection.h"
 #include "final/output/tty/fterm.h"
 #include "final/output/tty/ftermios.h"
+#include "final/output/tty/ftermprofilecache.h"
 #include "final/output/tty/ftermxterminal.h"
 #include "final/util/flog.h"
 #include "final/util/fstring.h"
@@ -609,6 +610,7 @@ void FTerm::resetColorMap()
     paddingPrint (op);
 
   std::fflush(stdout);
+  FOptiAttr::getInstance().clearTransitionCache();
 }
 
 //----------------------------------------------------------------------
@@ -646,7 +648,7 @@ void FTerm::setPalette (FColor index, int r, int g, int b)
     const int gg = (g * 1001) / 256;
     const int bb = (b * 1001) / 256;
 
-    const FTermcap::TermcapString& color_str = \
+    const auto color_str = \
         [&index, &rr, &gg, &bb, &Ic, &Ip] ()
         {
           if ( Ic.data )
@@ -655,12 +657,12 @@ void FTerm::setPalette (FColor index, int r, int g, int b)
           if ( Ip.data )
             return FTermcap::encodeParameter(Ip, uInt16(index), 0, 0, 0, rr, gg, bb);
 
-          return FTermcap::TermcapString{nullptr, 0};
+          return std::string{};
         }();
 
-    if ( color_str.data )
+    if ( ! color_str.empty() )
     {
-      paddingPrint (color_str.data, color_str.length);
+      paddingPrint (color_str.data(), uInt32(color_str.length()));
       state = true;
     }
   }
@@ -672,7 +674,10 @@ void FTerm::setPalette (FColor index, int r, int g, int b)
 #endif
 
   if ( state )
+  {
     std::fflush(stdout);
+    FOptiAttr::getInstance().clearTransitionCache();
+  }
 }
 
 //----------------------------------------------------------------------
@@ -911,6 +916,9 @@ void FTerm::init_global_values()
   {
     FTermDetection::getInstance().setTerminalDetection (false);
   }
+
+  FTermProfileCache::getInstance() \
+      .setEnabled (getStartOptions().terminal_profile_cache);
 }
 
 //----------------------------------------------------------------------
@@ -1223,6 +1231,7 @@ void FTerm::init_optiMove()
 
   static auto& opti_move = FOptiMove::getInstance();
   opti_move.setTermEnvironment(optimove_env);
+  opti_move.setCostCalibration();  // Use the byte costs of the actual moves
 }
 
 //----------------------------------------------------------------------
@@ -1825,14 +1834,27 @@ void FTerm::init()
   if ( ! init_terminal() )
     return;
 
-  // Set maximum number of colors for detected terminals
-  init_fixed_max_color();
+  static auto& profile_cache = FTermProfileCache::getInstance();
 
-  // Initializes variables for the current terminal
-  init_termcap();
+  if ( profile_cache.isLoaded() )
+  {
+    // Capabilities and quirks from the cached terminal profile
+    profile_cache.restoreCapabilities();
+  }
+  else
+  {
+    // Set maximum number of colors for detected terminals
+    init_fixed_max_color();
 
-  // Initialize terminal quirks
-  init_quirks();
+    // Initializes variables for the current terminal
+    init_termcap();
+
+    // Initialize terminal quirks
+    init_quirks();
+
+    // Store the result for the next program start
+    profile_cache.save();
+  }
 
   // Initialize cursor movement optimization
   init_optiMove();
@@ -1856,12 +1878,16 @@ void FTerm::init()
   enableMouse();
 
   // Activate meta key sends escape + terminal focus event
+  // + bracketed paste
   if ( FTermData::getInstance().isTermType(FTermType::xterm) )
   {
     FTermXTerminal::getInstance().metaSendsESC(true);
 
     if ( getStartOptions().terminal_focus_events )
       FTermXTerminal::getInstance().setFocusSupport(true);
+
+    if ( getStartOptions().bracketed_paste )
+      FTermXTerminal::getInstance().setBracketedPasteSupport(true);
   }
 
   // switch to application escape key mode
@@ -1948,9 +1974,12 @@ auto FTerm::init_terminal() const -> bool
   // Get output baud rate
   initBaudRate();
 
-  // Terminal detection
+  // Terminal detection (skipped with a matching cached profile)
   static auto& term_detection = FTermDetection::getInstance();
-  term_detection.detect();
+
+  if ( ! FTermProfileCache::getInstance().load() )
+    term_detection.detect();
+
   const auto& termtype = term_detection.getTermType();
   setTermType(termtype.toString());
   return true;
@@ -2065,12 +2094,16 @@ void FTerm::finish() const
   if ( getStartOptions().mouse_support )
     disableMouse();
 
-  // Deactivate terminal focus event + meta key sends escape
+  // Deactivate terminal focus event + bracketed paste
+  // + meta key sends escape
   if ( data.isTermType(FTermType::xterm) )
   {
     if ( getStartOptions().terminal_focus_events )
       xterm.setFocusSupport(false);
 
+    if ( getStartOptions().bracketed_paste )
+      xterm.setBracketedPasteSupport(false);
+
     xterm.metaSendsESC(false);
   }
 
@@ -276,6 +276,55 @@ auto rgb2ColorIndex (uInt8 r, uInt8 g, uInt8 b) -> FColor
   return FColor(16 + ri * 36 + gi * 6 + bi);
 }
 
+//----------------------------------------------------------------------
+auto reduceToBasicColor (FColor color) -> FColor
+{
+  // Converts a 256-color index to the nearest of the 16 basic colors
+
+  if ( color == FColor::Default || color < 16 )
+    return color;
+
+  const auto index = uInt16(color);
+
+  if ( index >= 232 )  // Grayscale ramp from #080808 to #eeeeee
+  {
+    const auto level = index - 232;
+
+    if ( level < 6 )
+      return FColor::Black;
+
+    if ( level < 12 )
+      return FColor::DarkGray;
+
+    return ( level < 20 ) ? FColor::LightGray : FColor::White;
+  }
+
+  // 6 x 6 x 6 color cube
+  const auto r = (index - 16) / 36;
+  const auto g = ((index - 16) / 6) % 6;
+  const auto b = (index - 16) % 6;
+  const auto max = std::max({r, g, b});
+
+  if ( r == g && g == b )  // Gray
+  {
+    if ( max == 0 )
+      return FColor::Black;
+
+    if ( max < 3 )
+      return FColor::DarkGray;
+
+    return ( max < 5 ) ? FColor::LightGray : FColor::White;
+  }
+
+  // A channel is set if it reaches half of the strongest channel
+  const auto limit = (max + 1) / 2;
+  const auto red   = ( r >= limit ) ? 4 : 0;
+  const auto green = ( g >= limit ) ? 2 : 0;
+  const auto blue  = ( b >= limit ) ? 1 : 0;
+  const auto intensity = ( max >= 4 ) ? 8 : 0;
+  return FColor(intensity | red | green | blue);
+}
+
 //----------------------------------------------------------------------
 auto isReverseNewFontchar (wchar_t wchar) -> bool
 {
@@ -693,7 +742,7 @@ void addColumnWidth (FChar& term_char, std::size_t char_width)
   if ( char_width == 2
     && fterm_data.getTerminalEncoding() != Encoding::UTF8 )
   {
-    term_char.ch.unicode_data[0] = '.';
+    term_char.ch[0] = L'.';
     term_char.setCharWidth(1);
   }
   else
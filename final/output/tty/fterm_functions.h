@@ -52,6 +52,7 @@ auto env2uint (const std::string&) -> uInt;
 auto getExitMessage() -> std::string&;
 void setExitMessage (const FString&);
 auto rgb2ColorIndex (uInt8, uInt8, uInt8) -> FColor;
+auto reduceToBasicColor (FColor) -> FColor;
 auto isReverseNewFontchar (wchar_t) -> bool;
 auto hasFullWidthSupports() -> bool;
 auto cp437_to_unicode (uChar) -> wchar_t;
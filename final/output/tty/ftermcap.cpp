@@ -45,12 +45,15 @@
 #endif
 
 #include <algorithm>
+#include <cstring>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "final/fc.h"
 #include "final/input/fkey_map.h"
 #include "final/output/tty/ftermcap.h"
+#include "final/output/tty/ftermcaptemplate.h"
 #include "final/output/tty/ftermdata.h"
 #include "final/output/tty/ftermdetection.h"
 #include "final/output/tty/fterm.h"
@@ -81,6 +84,13 @@ static auto getMoveCache() noexcept -> std::unordered_map<std::uint32_t, std::st
   return *move_cache;
 }
 
+static auto getTemplateCache() noexcept -> std::unordered_map<const char*, FTermcapTemplate>&
+{
+  using template_cache_type = std::unordered_map<const char*, FTermcapTemplate>;
+  static const auto& template_cache = std::make_unique<template_cache_type>();
+  return *template_cache;
+}
+
 }  // namespace internal
 
 // Function prototypes
@@ -200,15 +210,38 @@ auto FTermcap::getString (const std::string& cap) -> char*
 //----------------------------------------------------------------------
 auto FTermcap::encodeMotionParameter (const TermcapString& cap, int col, int row) -> TermcapString
 {
+  // The returned string stays valid until the motion cache is cleared
+  // or a different capability string is encoded
+
+  if ( ! cap.data )
+    return {};
+
   const std::uint32_t key = (std::uint32_t(col) << 16) | std::uint16_t(row);
+  static auto& move_cache = internal::getMoveCache();
+  static std::string move_cache_source{};
+
+  if ( move_cache_source != cap.data )  // Cached for another string
+  {
+    move_cache.clear();
+    move_cache_source = cap.data;
+  }
 
   // Cache search
-  static auto& move_cache = internal::getMoveCache();
   auto iter = move_cache.find(key);
 
   if ( iter != move_cache.end() )
     return {iter->second.data(), uInt32(iter->second.size())};
 
+  const auto& compiled_template = getTemplate(cap.data);
+
+  if ( compiled_template.isCompiled() )
+  {
+    // Terminfo string: the row is the first parameter
+    auto& motion_string = move_cache[key];
+    compiled_template.expand ({{row, col}}, motion_string);
+    return {motion_string.data(), uInt32(motion_string.length())};
+  }
+
   // Cache-Miss: call tgoto
   if ( const char* res = ::tgoto(C_STR(cap.data), col, row) )
   {
@@ -280,12 +313,48 @@ auto FTermcap::stringPrint (const char* string, uInt32 len) -> Status
   return outs(string, len) >= 0 ? Status::OK : Status::Error;
 }
 
+//----------------------------------------------------------------------
+auto FTermcap::hasPadding (const char* string, uInt32 len) noexcept -> bool
+{
+  // Checks whether the string contains a padding specification "$<..>"
+  // that must be processed by paddingPrint()
+
+  if ( ! string || len < 2 )
+    return false;
+
+  const auto end = std::next(string, len);
+  const auto iter = std::adjacent_find ( string, end
+                                       , [] (char c1, char c2)
+                                         {
+                                           return c1 == '$' && c2 == '<';
+                                         } );
+  return iter != end;
+}
+
 //----------------------------------------------------------------------
 void FTermcap::init()
 {
   buffer = internal::getStringBuffer();
   buffer_addr = &buffer;
   termcap();
+  compileParameterStrings();
+  setDefaultPutCharFunction();
+  setDefaultPutStringFunction();
+}
+
+//----------------------------------------------------------------------
+void FTermcap::restore()
+{
+  // Initialization with capability strings from a cached
+  // terminal profile (without termcap database access)
+
+  buffer = internal::getStringBuffer();
+  buffer_addr = &buffer;
+  initialized = true;
+  baudrate = int(FTermData::getInstance().getBaudrate());
+  const auto& pc = TCAP(t_pad_char);
+  PC = pc.data ? pc.data[0] : '\0';
+  compileParameterStrings();
   setDefaultPutCharFunction();
   setDefaultPutStringFunction();
 }
@@ -317,6 +386,24 @@ void FTermcap::clearMotionCache()
   move_cache.clear();
 }
 
+//----------------------------------------------------------------------
+void FTermcap::compileParameterStrings()
+{
+  // Compiles all parameterized capability strings in advance,
+  // so that the output does not have to parse them again
+
+  static auto& template_cache = internal::getTemplateCache();
+  template_cache.clear();
+
+  for (const auto& entry : strings)
+  {
+    const auto* string = entry.string.data;
+
+    if ( string && std::strchr(string, '%') )
+      template_cache[string].compile(string);
+  }
+}
+
 
 // private methods of FTermcap
 //----------------------------------------------------------------------
@@ -529,12 +616,54 @@ void FTermcap::termcapKeys()
 
 //----------------------------------------------------------------------
 auto FTermcap::encodeParams ( const TermcapString& cap
-                            , const std::array<int, 9>& params ) -> TermcapString
+                            , const std::array<int, 9>& params ) -> std::string
 {
+  if ( ! cap.data )
+    return {};
+
+  const auto& compiled_template = getTemplate(cap.data);
+  std::string parameter_string{};
+
+  if ( compiled_template.isCompiled() )
+  {
+    compiled_template.expand (params, parameter_string);
+    return parameter_string;
+  }
+
+  // Strings with string parameters or in termcap style
   const auto str = ::tparm ( C_STR(cap.data), params[0], params[1]
                            , params[2], params[3], params[4], params[5]
                            , params[6], params[7], params[8] );
-  return {str, uInt32(finalcut::stringLength(str))};
+
+  if ( str )
+    parameter_string = str;
+
+  return parameter_string;
+}
+
+//----------------------------------------------------------------------
+auto FTermcap::getTemplate (const char* string) -> const FTermcapTemplate&
+{
+  // Returns the compiled template of the string. The cache key is
+  // the string address, so a changed string content must be compiled
+  // again.
+
+  // Room for all capabilities plus strings from other sources
+  static constexpr std::size_t max_cache_size{2 * std::tuple_size<TCapMapType>::value};
+  static auto& template_cache = internal::getTemplateCache();
+  const auto iter = template_cache.find(string);
+
+  if ( iter != template_cache.end() )
+  {
+    if ( std::strcmp(iter->second.getSource().data(), string) == 0 )
+      return iter->second;
+  }
+  else if ( template_cache.size() >= max_cache_size )
+    template_cache.erase(template_cache.begin());  // Evicts a single entry
+
+  auto& compiled_template = template_cache[string];
+  compiled_template.compile(string);
+  return compiled_template;
 }
 
 //----------------------------------------------------------------------
@@ -681,6 +810,11 @@ FTermcap::TCapMapType FTermcap::strings =
   { {nullptr, 0}, {"Ss"} },  // set cursor style       -> Select the DECSCUSR cursor style
   { {nullptr, 0}, {"sf"} },  // scroll_forward         -> scroll text up (P)
   { {nullptr, 0}, {"sr"} },  // scroll_reverse         -> scroll text down (P)
+  { {nullptr, 0}, {"cs"} },  // change_scroll_region   -> change region to line #1 to line #2 (P)
+  { {nullptr, 0}, {"al"} },  // insert_line            -> insert line (P*)
+  { {nullptr, 0}, {"dl"} },  // delete_line            -> delete line (P*)
+  { {nullptr, 0}, {"AL"} },  // parm_insert_line       -> insert #1 lines (P*)
+  { {nullptr, 0}, {"DL"} },  // parm_delete_line       -> delete #1 lines (P*)
   { {nullptr, 0}, {"ti"} },  // enter_ca_mode          -> string to start programs using cup
   { {nullptr, 0}, {"te"} },  // exit_ca_mode           -> strings to end programs using cup
   { {nullptr, 0}, {"eA"} },  // enable_acs             -> enable alternate char set
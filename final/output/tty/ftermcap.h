@@ -52,6 +52,9 @@
 namespace finalcut
 {
 
+// class forward declaration
+class FTermcapTemplate;
+
 //----------------------------------------------------------------------
 // class FTermcap
 //----------------------------------------------------------------------
@@ -82,7 +85,7 @@ class FTermcap final
     };
 
     // Using-declaration
-    using TCapMapType = std::array<TCapMap, 86>;
+    using TCapMapType = std::array<TCapMap, 91>;
     using PutCharFunc = std::decay_t<int(int)>;
     using PutStringFunc = std::decay_t<int(const char*, uInt32)>;
 
@@ -96,12 +99,13 @@ class FTermcap final
     static auto  getString (const std::string&) -> char*;
     static auto  encodeMotionParameter (const TermcapString&, int, int) -> TermcapString;
     template <typename... Args>
-    static auto  encodeParameter (const TermcapString&, Args&&...) -> TermcapString;
+    static auto  encodeParameter (const TermcapString&, Args&&...) -> std::string;
     static auto  paddingPrint (const char*, uInt32, int) -> Status;
     static auto  stringPrint (const char*, uInt32) -> Status;
 
-    // Predicate
+    // Predicates
     static auto  isInitialized() noexcept -> bool;
+    static auto  hasPadding (const char*, uInt32) noexcept -> bool;
 
     // Mutator
     template<typename PutChar>
@@ -115,6 +119,8 @@ class FTermcap final
 
     // Methods
     static void  init();
+    static void  restore();
+    static void  compileParameterStrings();
 
     // Data members
     static bool         background_color_erase;
@@ -147,7 +153,8 @@ class FTermcap final
     static void  termcapStrings();
     static void  termcapKeys();
     static auto  encodeParams ( const TermcapString&
-                              , const std::array<int, 9>& ) -> TermcapString;
+                              , const std::array<int, 9>& ) -> std::string;
+    static auto  getTemplate (const char*) -> const FTermcapTemplate&;
     static auto  hasDelay (const std::string&) noexcept -> bool;
     static void  delayOutput (int) noexcept;
     static auto  readNumber (const char*&, int, bool&) noexcept -> int;
@@ -172,7 +179,7 @@ inline auto FTermcap::getClassName() const -> FString
 
 //----------------------------------------------------------------------
 template <typename... Args>
-auto FTermcap::encodeParameter (const TermcapString& cap, Args&&... args) -> TermcapString
+auto FTermcap::encodeParameter (const TermcapString& cap, Args&&... args) -> std::string
 {
   std::array<int, 9> attr {{static_cast<int>(args)...}};
   return encodeParams(cap, attr);
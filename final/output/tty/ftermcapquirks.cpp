@@ -141,6 +141,8 @@ void FTermcapQuirks::terminalFixup()
   repeatLastChar();
   // ECMA-48 (ANSI X3.64) compatible terminal
   ecma48();
+  // Compile the changed parameterized strings
+  FTermcap::compileParameterStrings();
 }
 
 
@@ -0,0 +1,604 @@
+/***********************************************************************
+* ftermcaptemplate.cpp - Compiled parameterized terminal capabilities  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "final/output/tty/ftermcaptemplate.h"
+
+namespace finalcut
+{
+
+// static class attributes
+constexpr std::size_t FTermcapTemplate::STACK_SIZE;
+constexpr std::size_t FTermcapTemplate::VARIABLE_COUNT;
+
+//----------------------------------------------------------------------
+// class FTermcapTemplate
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FTermcapTemplate::FTermcapTemplate (const char* string)
+{
+  compile(string);
+}
+
+
+// public methods of FTermcapTemplate
+//----------------------------------------------------------------------
+auto FTermcapTemplate::compile (const char* string) -> bool
+{
+  clear();
+
+  if ( ! string )
+    return false;
+
+  source = string;
+  std::vector<Condition> conditions{};
+  const char* iter = string;
+  bool valid{true};
+
+  while ( valid && *iter != '\0' )
+  {
+    if ( *iter != '%' )
+    {
+      const char* text_end = iter;
+
+      while ( *text_end != '\0' && *text_end != '%' )
+        ++text_end;
+
+      addText (iter, std::size_t(text_end - iter));
+      iter = text_end;
+      continue;
+    }
+
+    ++iter;  // Skip '%'
+    valid = compileEscape(iter, conditions);
+  }
+
+  // Without %p references tparm() pushes the parameters implicitly
+  // onto the stack (termcap style), which is not supported here
+  const bool has_parameter = \
+      std::any_of ( instructions.cbegin(), instructions.cend()
+                  , [] (const auto& instruction)
+                    {
+                      return instruction.code == Opcode::Param
+                          || instruction.code == Opcode::ParamDecimal
+                          || instruction.code == Opcode::ParamJumpIfFalse;
+                    } );
+  const bool only_text = \
+      std::all_of ( instructions.cbegin(), instructions.cend()
+                  , [] (const auto& instruction)
+                    {
+                      return instruction.code == Opcode::Text;
+                    } );
+
+  if ( ! valid || ! conditions.empty() || ( ! has_parameter && ! only_text ) )
+  {
+    // Not compilable - keep only the source for comparison
+    strings.clear();
+    instructions.clear();
+    return false;
+  }
+
+  compiled = true;
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FTermcapTemplate::clear()
+{
+  source.clear();
+  strings.clear();
+  instructions.clear();
+  compiled = false;
+}
+
+//----------------------------------------------------------------------
+auto FTermcapTemplate::expand ( const Parameters& parameters
+                              , std::string& output ) const -> bool
+{
+  output.clear();
+
+  if ( ! compiled )
+    return false;
+
+  auto params = parameters;
+  std::array<int, STACK_SIZE> stack;
+  std::size_t top{0};
+  Variables dynamic_variables{};
+  auto& static_variables = getStaticVariables();
+
+  auto push = [&stack, &top] (int value) noexcept
+  {
+    if ( top < STACK_SIZE )
+      stack[top++] = value;
+  };
+
+  auto pop = [&stack, &top] () noexcept
+  {
+    return ( top > 0 ) ? stack[--top] : 0;
+  };
+
+  const auto count = instructions.size();
+  std::size_t pc{0};
+
+  while ( pc < count )
+  {
+    const auto& instruction = instructions[pc];
+    ++pc;
+
+    switch ( instruction.code )
+    {
+      case Opcode::Text:
+        output.append(strings.data() + instruction.offset, instruction.length);
+        break;
+
+      case Opcode::Param:
+        push (params[std::size_t(instruction.arg)]);
+        break;
+
+      case Opcode::Constant:
+        push (instruction.arg);
+        break;
+
+      case Opcode::SetVariable:
+        if ( std::size_t(instruction.arg) < VARIABLE_COUNT )
+          dynamic_variables[std::size_t(instruction.arg)] = pop();
+        else
+          static_variables[std::size_t(instruction.arg) - VARIABLE_COUNT] = pop();
+        break;
+
+      case Opcode::GetVariable:
+        if ( std::size_t(instruction.arg) < VARIABLE_COUNT )
+          push (dynamic_variables[std::size_t(instruction.arg)]);
+        else
+          push (static_variables[std::size_t(instruction.arg) - VARIABLE_COUNT]);
+        break;
+
+      case Opcode::Decimal:
+        appendDecimal (output, pop());
+        break;
+
+      case Opcode::Format:
+      {
+        std::array<char, 64> buffer{};
+        const auto len = std::snprintf ( buffer.data(), buffer.size()
+                                       , strings.data() + instruction.offset
+                                       , pop() );
+
+        if ( len > 0 )
+          output.append(buffer.data(), std::min(std::size_t(len), buffer.size() - 1));
+
+        break;
+      }
+
+      case Opcode::Character:
+      {
+        // Like tparm(), the value 0 is output as 0x80. Since tparm()
+        // returns a C string, any other null character ends the result.
+        const int value = pop();
+        const auto ch = ( value == 0 ) ? char(0x80) : char(value);
+
+        if ( ch == '\0' )
+          return true;
+
+        output.push_back(ch);
+        break;
+      }
+
+      case Opcode::Increment:
+        params[0]++;
+        params[1]++;
+        break;
+
+      case Opcode::Not:
+        push (int(! pop()));
+        break;
+
+      case Opcode::Complement:
+        push (~pop());
+        break;
+
+      case Opcode::JumpIfFalse:
+        if ( pop() == 0 )
+          pc = std::size_t(instruction.arg);
+        break;
+
+      case Opcode::Jump:
+        pc = std::size_t(instruction.arg);
+        break;
+
+      case Opcode::ParamDecimal:
+        appendDecimal (output, params[instruction.offset]);
+        break;
+
+      case Opcode::ParamJumpIfFalse:
+        if ( params[instruction.offset] == 0 )
+          pc = std::size_t(instruction.arg);
+        break;
+
+      default:  // Binary operators
+      {
+        const int y = pop();
+        const int x = pop();
+        push (calculate(instruction.code, x, y));
+        break;
+      }
+    }
+  }
+
+  return true;
+}
+
+
+// private methods of FTermcapTemplate
+//----------------------------------------------------------------------
+auto FTermcapTemplate::compileEscape ( const char*& iter
+                                     , std::vector<Condition>& conditions ) -> bool
+{
+  // Compiles the escape sequence after a '%' character
+
+  const char ch = *iter;
+  Opcode op{};
+
+  switch ( ch )
+  {
+    case '%':
+      addText (iter, 1);
+      ++iter;
+      return true;
+
+    case 'p':
+      if ( iter[1] < '1' || iter[1] > '9' )
+        return false;
+
+      addInstruction (Opcode::Param, iter[1] - '1');
+      iter += 2;
+      return true;
+
+    case '{':
+    {
+      int number{0};
+      ++iter;
+
+      while ( std::isdigit(uChar(*iter)) && number < 100000000 )
+      {
+        number = number * 10 + (*iter - '0');
+        ++iter;
+      }
+
+      if ( *iter != '}' )
+        return false;
+
+      addInstruction (Opcode::Constant, number);
+      ++iter;
+      return true;
+    }
+
+    case '\'':
+      if ( iter[1] == '\0' || iter[2] != '\'' )
+        return false;
+
+      addInstruction (Opcode::Constant, int(uChar(iter[1])));
+      iter += 3;
+      return true;
+
+    case 'P':
+    case 'g':
+    {
+      const auto code = ( ch == 'P' ) ? Opcode::SetVariable : Opcode::GetVariable;
+
+      if ( std::islower(uChar(iter[1])) )
+        addInstruction (code, iter[1] - 'a');
+      else if ( std::isupper(uChar(iter[1])) )
+        addInstruction (code, int(VARIABLE_COUNT) + iter[1] - 'A');
+      else
+        return false;
+
+      iter += 2;
+      return true;
+    }
+
+    case 'i':
+      addInstruction (Opcode::Increment);
+      ++iter;
+      return true;
+
+    case 'c':
+      addInstruction (Opcode::Character);
+      ++iter;
+      return true;
+
+    case 'd':
+      addInstruction (Opcode::Decimal);
+      ++iter;
+      return true;
+
+    case '?':
+      conditions.emplace_back();
+      ++iter;
+      return true;
+
+    case 't':
+    case 'e':
+    case ';':
+      ++iter;
+      return compileCondition (ch, conditions);
+
+    case '!':
+      addInstruction (Opcode::Not);
+      ++iter;
+      return true;
+
+    case '~':
+      addInstruction (Opcode::Complement);
+      ++iter;
+      return true;
+
+    default:
+      break;
+  }
+
+  if ( getOperator(ch, op) )
+  {
+    addInstruction (op);
+    ++iter;
+    return true;
+  }
+
+  return compileFormat(iter);
+}
+
+//----------------------------------------------------------------------
+auto FTermcapTemplate::compileFormat (const char*& iter) -> bool
+{
+  // Compiles a printf-like number format %[[:]flags][width[.precision]][doxX]
+
+  static constexpr std::size_t max_format_length{16};
+  std::string format{"%"};
+  bool allow_minus{false};
+  bool has_dot{false};
+
+  while ( *iter != '\0' && format.length() < max_format_length )
+  {
+    const char ch = *iter;
+
+    if ( ch == ':' )
+      allow_minus = true;
+    else if ( ch == '#' || ch == ' ' || (ch == '-' && allow_minus) )
+      format.push_back(ch);
+    else if ( ch == '.' && ! has_dot )
+    {
+      has_dot = true;
+      format.push_back(ch);
+    }
+    else if ( std::isdigit(uChar(ch)) )
+      format.push_back(ch);
+    else
+      break;
+
+    ++iter;
+  }
+
+  if ( *iter != 'd' && *iter != 'o' && *iter != 'x' && *iter != 'X' )
+    return false;
+
+  format.push_back(*iter);
+  ++iter;
+  const auto offset = uInt32(strings.length());
+  strings.append(format);
+  strings.push_back('\0');  // Null-terminated for snprintf
+  instructions.push_back({Opcode::Format, 0, offset, uInt32(format.length())});
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FTermcapTemplate::compileCondition ( char ch
+                                        , std::vector<Condition>& conditions ) -> bool
+{
+  // Translates %t, %e and %; into jump instructions
+
+  if ( conditions.empty() && ch != ';' )
+    conditions.emplace_back();  // %t or %e without %?
+
+  if ( ch == 't' )
+  {
+    auto& condition = conditions.back();
+
+    if ( condition.has_false_jump )
+      return false;
+
+    addInstruction (Opcode::JumpIfFalse);
+    condition.false_jump = instructions.size() - 1;
+    condition.has_false_jump = true;
+    return true;
+  }
+
+  if ( ch == 'e' )
+  {
+    auto& condition = conditions.back();
+    condition.end_jumps.push_back(instructions.size());
+    addInstruction (Opcode::Jump);
+
+    if ( condition.has_false_jump )
+    {
+      // The false branch continues behind the %e
+      instructions[condition.false_jump].arg = int(instructions.size());
+      condition.has_false_jump = false;
+    }
+
+    return true;
+  }
+
+  // ch == ';'
+  if ( conditions.empty() )
+    return false;
+
+  const auto& condition = conditions.back();
+  const auto end = int(instructions.size());
+
+  if ( condition.has_false_jump )
+    instructions[condition.false_jump].arg = end;
+
+  for (const auto index : condition.end_jumps)
+    instructions[index].arg = end;
+
+  conditions.pop_back();
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FTermcapTemplate::addText (const char* text, std::size_t length)
+{
+  if ( length == 0 )
+    return;
+
+  const auto offset = uInt32(strings.length());
+  strings.append(text, length);
+
+  // Merge adjacent text if no jump leads between them
+  if ( ! instructions.empty()
+    && ! isJumpTarget(instructions.size())
+    && instructions.back().code == Opcode::Text
+    && instructions.back().offset + instructions.back().length == offset )
+  {
+    instructions.back().length += uInt32(length);
+    return;
+  }
+
+  instructions.push_back({Opcode::Text, 0, offset, uInt32(length)});
+}
+
+//----------------------------------------------------------------------
+void FTermcapTemplate::addInstruction (Opcode code, int arg)
+{
+  // A parameter followed by %d or %t is fused into one instruction
+
+  if ( (code == Opcode::Decimal || code == Opcode::JumpIfFalse)
+    && ! instructions.empty()
+    && instructions.back().code == Opcode::Param
+    && ! isJumpTarget(instructions.size()) )
+  {
+    auto& last = instructions.back();
+    last.offset = uInt32(last.arg);
+    last.arg = arg;
+    last.code = ( code == Opcode::Decimal ) ? Opcode::ParamDecimal
+                                            : Opcode::ParamJumpIfFalse;
+    return;
+  }
+
+  instructions.push_back({code, arg, 0, 0});
+}
+
+//----------------------------------------------------------------------
+auto FTermcapTemplate::isJumpTarget (std::size_t position) const -> bool
+{
+  return std::any_of ( instructions.cbegin(), instructions.cend()
+                     , [position] (const auto& instruction)
+                       {
+                         return ( instruction.code == Opcode::Jump
+                               || instruction.code == Opcode::JumpIfFalse
+                               || instruction.code == Opcode::ParamJumpIfFalse )
+                             && std::size_t(instruction.arg) == position;
+                       } );
+}
+
+//----------------------------------------------------------------------
+auto FTermcapTemplate::getOperator (char ch, Opcode& op) noexcept -> bool
+{
+  switch ( ch )
+  {
+    case '+': op = Opcode::Add; break;
+    case '-': op = Opcode::Subtract; break;
+    case '*': op = Opcode::Multiply; break;
+    case '/': op = Opcode::Divide; break;
+    case 'm': op = Opcode::Modulo; break;
+    case '&': op = Opcode::BitAnd; break;
+    case '|': op = Opcode::BitOr; break;
+    case '^': op = Opcode::BitXor; break;
+    case '=': op = Opcode::Equal; break;
+    case '>': op = Opcode::Greater; break;
+    case '<': op = Opcode::Less; break;
+    case 'A': op = Opcode::LogicalAnd; break;
+    case 'O': op = Opcode::LogicalOr; break;
+    default: return false;
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FTermcapTemplate::calculate (Opcode op, int x, int y) noexcept -> int
+{
+  switch ( op )
+  {
+    case Opcode::Add: return x + y;
+    case Opcode::Subtract: return x - y;
+    case Opcode::Multiply: return x * y;
+    case Opcode::Divide: return ( y != 0 ) ? x / y : 0;
+    case Opcode::Modulo: return ( y != 0 ) ? x % y : 0;
+    case Opcode::BitAnd: return x & y;
+    case Opcode::BitOr: return x | y;
+    case Opcode::BitXor: return x ^ y;
+    case Opcode::Equal: return int(x == y);
+    case Opcode::Greater: return int(x > y);
+    case Opcode::Less: return int(x < y);
+    case Opcode::LogicalAnd: return int(x && y);
+    case Opcode::LogicalOr: return int(x || y);
+    default: return 0;
+  }
+}
+
+//----------------------------------------------------------------------
+void FTermcapTemplate::appendDecimal (std::string& output, int value)
+{
+  std::array<char, 12> digits{};
+  auto pos = digits.size();
+  auto number = ( value < 0 ) ? 0u - uInt(value) : uInt(value);
+
+  do
+  {
+    digits[--pos] = char('0' + number % 10);
+    number /= 10;
+  }
+  while ( number > 0 );
+
+  if ( value < 0 )
+    digits[--pos] = '-';
+
+  output.append(digits.data() + pos, digits.size() - pos);
+}
+
+//----------------------------------------------------------------------
+auto FTermcapTemplate::getStaticVariables() -> Variables&
+{
+  // Static variables %[PA-Z] keep their values between the expansions
+  static Variables static_variables{};
+  return static_variables;
+}
+
+}  // namespace finalcut
@@ -0,0 +1,175 @@
+/***********************************************************************
+* ftermcaptemplate.h - Compiled parameterized terminal capabilities    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FTermcapTemplate ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+// A parameterized terminfo string (see man 5 terminfo) is translated
+// once into a list of stack machine instructions. The expansion then
+// only executes these instructions and does not parse the string again.
+// Strings that use string parameters (%s, %l) cannot be compiled and
+// must be expanded with tparm().
+
+#ifndef FTERMCAPTEMPLATE_H
+#define FTERMCAPTEMPLATE_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "final/ftypes.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FTermcapTemplate
+//----------------------------------------------------------------------
+
+class FTermcapTemplate final
+{
+  public:
+    // Using-declaration
+    using Parameters = std::array<int, 9>;
+
+    // Constructors
+    FTermcapTemplate() = default;
+    explicit FTermcapTemplate (const char*);
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getSource() const noexcept -> const std::string&;
+    auto getInstructionCount() const noexcept -> std::size_t;
+
+    // Inquiry
+    auto isCompiled() const noexcept -> bool;
+
+    // Methods
+    auto compile (const char*) -> bool;
+    void clear();
+    auto expand (const Parameters&, std::string&) const -> bool;
+
+  private:
+    // Enumeration
+    enum class Opcode : uInt8
+    {
+      Text,              // Literal text
+      Param,             // %p[1-9]
+      Constant,          // %{nn} and %'c'
+      SetVariable,       // %P[a-z] and %P[A-Z]
+      GetVariable,       // %g[a-z] and %g[A-Z]
+      Decimal,           // %d
+      Format,            // %[[:]flags][width[.precision]][doxX]
+      Character,         // %c
+      Increment,         // %i
+      Add,               // %+
+      Subtract,          // %-
+      Multiply,          // %*
+      Divide,            // %/
+      Modulo,            // %m
+      BitAnd,            // %&
+      BitOr,             // %|
+      BitXor,            // %^
+      Equal,             // %=
+      Greater,           // %>
+      Less,              // %<
+      LogicalAnd,        // %A
+      LogicalOr,         // %O
+      Not,               // %!
+      Complement,        // %~
+      JumpIfFalse,       // %t
+      Jump,              // %e
+      ParamDecimal,      // %p[1-9]%d
+      ParamJumpIfFalse   // %p[1-9]%t
+    };
+
+    // Constants
+    static constexpr std::size_t STACK_SIZE{20};
+    static constexpr std::size_t VARIABLE_COUNT{26};
+
+    struct Instruction
+    {
+      Opcode code;
+      int    arg{};     // Parameter, constant, variable, jump target
+      uInt32 offset{};  // Text or format string position, fused parameter
+      uInt32 length{};  // Text or format string length
+    };
+
+    struct Condition
+    {
+      std::size_t false_jump{};  // Unresolved %t jump
+      bool        has_false_jump{false};
+      std::vector<std::size_t> end_jumps{};  // Unresolved %e jumps
+    };
+
+    // Using-declaration
+    using Variables = std::array<int, VARIABLE_COUNT>;
+
+    // Methods
+    auto compileEscape (const char*&, std::vector<Condition>&) -> bool;
+    auto compileFormat (const char*&) -> bool;
+    auto compileCondition (char, std::vector<Condition>&) -> bool;
+    void addText (const char*, std::size_t);
+    void addInstruction (Opcode, int = 0);
+    auto isJumpTarget (std::size_t) const -> bool;
+    static auto getOperator (char, Opcode&) noexcept -> bool;
+    static auto calculate (Opcode, int, int) noexcept -> int;
+    static void appendDecimal (std::string&, int);
+    static auto getStaticVariables() -> Variables&;
+
+    // Data members
+    std::string              source{};
+    std::string              strings{};
+    std::vector<Instruction> instructions{};
+    bool                     compiled{false};
+};
+
+// FTermcapTemplate inline functions
+//----------------------------------------------------------------------
+inline auto FTermcapTemplate::getClassName() const -> FString
+{ return "FTermcapTemplate"; }
+
+//----------------------------------------------------------------------
+inline auto FTermcapTemplate::getSource() const noexcept -> const std::string&
+{ return source; }
+
+//----------------------------------------------------------------------
+inline auto FTermcapTemplate::getInstructionCount() const noexcept -> std::size_t
+{ return instructions.size(); }
+
+//----------------------------------------------------------------------
+inline auto FTermcapTemplate::isCompiled() const noexcept -> bool
+{ return compiled; }
+
+}  // namespace finalcut
+
+#endif  // FTERMCAPTEMPLATE_H
@@ -40,6 +40,7 @@
 #include "final/output/tty/fterm_functions.h"
 #include "final/output/tty/fterm.h"
 #include "final/output/tty/ftermios.h"
+#include "final/output/tty/ftermprobe.h"
 #include "final/util/emptyfstring.h"
 #include "final/util/flog.h"
 #include "final/util/fsystem.h"
@@ -335,6 +336,9 @@ void FTermDetection::detectTerminal()
     // Initialize 256 colors terminals
     new_term_type = init_256colorTerminal();
 
+    // Query the terminal capabilities in a single round trip
+    probeTerminal();
+
     // Identify the terminal via the answerback-message
     new_term_type = parseAnswerbackMsg (new_term_type);
 
@@ -381,6 +385,36 @@ void FTermDetection::detectTerminal()
 #endif
 }
 
+//----------------------------------------------------------------------
+void FTermDetection::probeTerminal()
+{
+  // Sends the enquiry character (ENQ) and all device attribute
+  // requests at once and reads the responses until the primary
+  // device attributes (DA1) arrive
+
+  static const auto& fterm_data = FTermData::getInstance();
+  FTermProbe probe{};
+  probe.addQuery (FTermProbe::Query::Answerback);
+
+  // The Linux console and older cygwin terminals knows no Sec_DA
+  // and print unknown sequences with intermediate bytes
+  if ( ! fterm_data.isTermType(FTermType::linux_con | FTermType::cygwin) )
+  {
+    probe.addQuery (FTermProbe::Query::SecondaryDA);
+    probe.addQuery (FTermProbe::Query::XTVersion);
+    probe.addQuery (FTermProbe::Query::SyncOutput);
+  }
+
+  probe.run();
+  answer_back = probe.getAnswerback();
+
+  if ( probe.hasQuery(FTermProbe::Query::SecondaryDA) )
+    sec_da = getSecDA(probe.getSecDA());
+
+  xtversion = probe.getXTVersion();
+  sync_output_support = probe.hasSyncOutputSupport();
+}
+
 //----------------------------------------------------------------------
 auto FTermDetection::init_256colorTerminal() -> FString
 {
@@ -547,11 +581,6 @@ auto FTermDetection::getXTermColorName (FColor color) const -> FString
 auto FTermDetection::parseAnswerbackMsg (const FString& current_term_type) -> FString
 {
   FString new_term_type{current_term_type};
-  static auto& keyboard = FKeyboard::getInstance();
-  keyboard.setNonBlockingInput();
-  // send ENQ and read the answerback message
-  answer_back = getAnswerbackMsg();
-  keyboard.unsetNonBlockingInput();
 
   if ( answer_back == "PuTTY" )
   {
@@ -579,21 +608,6 @@ auto FTermDetection::parseAnswerbackMsg (const FString& current_term_type) -> FS
   return new_term_type;
 }
 
-//----------------------------------------------------------------------
-auto FTermDetection::getAnswerbackMsg() const -> FString
-{
-  // Send enquiry character
-  std::putchar (ENQ[0]);
-  std::fflush(stdout);
-  std::array<char, 10> temp{};
-  auto pos = captureTerminalInput(temp, 150'000);
-
-  if ( pos > 0 )
-    return temp.data();
-
-  return {};
-}
-
 //----------------------------------------------------------------------
 auto FTermDetection::parseSecDA (const FString& current_term_type) -> FString
 {
@@ -605,8 +619,6 @@ auto FTermDetection::parseSecDA (const FString& current_term_type) -> FString
     return current_term_type;
 
   // Secondary device attributes (SEC_DA) <- decTerminalID string
-  sec_da = getSecDA();
-
   if ( sec_da.getLength() < 6 )
     return current_term_type;
 
@@ -676,26 +688,18 @@ auto FTermDetection::str2int (const FString& s) const -> int
 }
 
 //----------------------------------------------------------------------
-auto FTermDetection::getSecDA() const -> FString
+auto FTermDetection::getSecDA (const FString& response) const -> FString
 {
-  const auto& stdout_no{FTermios::getStdOut()};
-  const std::string SECDA{ESC "[>c"};
-
-  // Get the secondary device attributes
-  if ( write(stdout_no, SECDA.data(), SECDA.length()) == -1 )
-    return {};
+  // Get the secondary device attributes from the terminal response
 
-  std::fflush(stdout);
-  std::array<char, 40> temp{};
-  auto isWithout_c = [] (const auto& t) { return ! std::strchr(t.data(), 'c'); };
-  auto pos = captureTerminalInput(temp, 600'000, isWithout_c);
   static constexpr auto parse = "\033[>%10d;%10d;%10dc";
   FString sec_da_str{""};
   int a{0};
   int b{0};
   int c{0};
 
-  if ( pos > 3 && std::sscanf(temp.data(), parse, &a, &b, &c) == 3 )
+  if ( response.getLength() > 3
+    && std::sscanf(response.c_str(), parse, &a, &b, &c) == 3 )
     sec_da_str.sprintf("\033[>%d;%d;%dc", a, b, c);
 
   return sec_da_str;
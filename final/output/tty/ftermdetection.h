@@ -3,7 +3,7 @@
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2018-2024 Markus Gans                                      *
+* Copyright 2018-2026 Markus Gans                                      *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -60,6 +60,7 @@ class FTermDetection final
     auto  getClassName() const -> FString;
     static auto  getInstance() -> FTermDetection&;
     auto  getTermType() const & -> const FString&;
+    auto  getXTVersionString() const & -> const FString&;
 
 #if DEBUG
     auto  getAnswerbackString() const & -> const FString&;
@@ -73,6 +74,7 @@ class FTermDetection final
     auto  canDisplay256Colors() const noexcept -> bool;
     auto  hasTerminalDetection() const noexcept -> bool;
     auto  hasSetCursorStyleSupport() const noexcept -> bool;
+    auto  hasSyncOutputSupport() const noexcept -> bool;
 
     // Mutators
     void  setTerminalDetection (bool = true) noexcept;
@@ -118,16 +120,16 @@ class FTermDetection final
     auto  isTerminalWithoutDetection() const -> bool;
     void  handleScreenAndTmux() const;
     void  detectTerminal();
+    void  probeTerminal();
     auto  init_256colorTerminal() -> FString;
     auto  get256colorEnvString() -> bool;
     auto  termtype_256color_quirks() -> FString;
     auto  determineMaxColor (const FString&) -> FString;
     auto  getXTermColorName (FColor) const -> FString;
     auto  parseAnswerbackMsg (const FString&) -> FString;
-    auto  getAnswerbackMsg() const -> FString;
     auto  parseSecDA (const FString&) -> FString;
     auto  str2int (const FString&) const -> int;
-    auto  getSecDA() const -> FString;
+    auto  getSecDA (const FString&) const -> FString;
     auto  secDA_Analysis (const FString&) -> FString;
     auto  secDA_Analysis_0 (const FString&) const -> FString;
     auto  secDA_Analysis_1 (const FString&) -> FString;
@@ -155,10 +157,15 @@ class FTermDetection final
     bool         decscusr_support{false};      // Preset to false
     bool         terminal_detection{true};     // Preset to true
     bool         color256{};
+    bool         sync_output_support{false};
     FString      answer_back{};
     FString      sec_da{};
+    FString      xtversion{};
     colorEnv     color_env{};
     secondaryDA  secondary_da{};
+
+    // Friend class
+    friend class FTermProfileCache;
 };
 
 
@@ -185,6 +192,10 @@ inline auto FTermDetection::getTermType_SecDA() const & -> const FString&
 { return term_type_SecDA; }
 #endif
 
+//----------------------------------------------------------------------
+inline auto FTermDetection::getXTVersionString() const & -> const FString&
+{ return xtversion; }
+
 //----------------------------------------------------------------------
 inline auto FTermDetection::canDisplay256Colors() const noexcept -> bool
 { return color256; }
@@ -193,6 +204,10 @@ inline auto FTermDetection::canDisplay256Colors() const noexcept -> bool
 inline auto FTermDetection::hasSetCursorStyleSupport() const noexcept -> bool
 { return decscusr_support; }
 
+//----------------------------------------------------------------------
+inline auto FTermDetection::hasSyncOutputSupport() const noexcept -> bool
+{ return sync_output_support; }
+
 //----------------------------------------------------------------------
 inline auto FTermDetection::hasTerminalDetection() const noexcept -> bool
 { return terminal_detection; }
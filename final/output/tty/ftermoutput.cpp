@@ -21,8 +21,15 @@
 ***********************************************************************/
 
 #include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <sys/ioctl.h>
 #include <unistd.h>
+#include <string>
 #include <unordered_map>
+#include <utility>
 
 #include "final/fobject.h"
 #include "final/fstartoptions.h"
@@ -30,8 +37,10 @@
 #include "final/input/fmouse.h"
 #include "final/output/tty/foptiattr.h"
 #include "final/output/tty/foptimove.h"
+#include "final/output/tty/foutputwriter.h"
 #include "final/output/tty/ftermcap.h"
 #include "final/output/tty/ftermdata.h"
+#include "final/output/tty/ftermdetection.h"
 #include "final/output/tty/ftermfreebsd.h"
 #include "final/output/tty/ftermios.h"
 #include "final/output/tty/ftermoutput.h"
@@ -39,6 +48,8 @@
 #include "final/util/char_ringbuffer.h"
 #include "final/util/fpoint.h"
 #include "final/util/fsize.h"
+#include "final/util/fsystem.h"
+#include "final/vterm/fvterm_kernels.h"
 
 namespace finalcut
 {
@@ -73,6 +84,10 @@ struct var
   static bool has_sub_map;
 };
 
+// Synchronized output (DEC private mode 2026)
+constexpr char sync_update_begin[] = CSI "?2026h";
+constexpr char sync_update_end[] = CSI "?2026l";
+
 Encoding terminal::encoding{Encoding::Unknown};
 bool var::is_new_font{false};
 bool var::has_sub_map{false};
@@ -84,6 +99,11 @@ FVTerm::FTermRegion* FTermOutput::vterm{nullptr};
 FTermData*           FTermOutput::fterm_data{nullptr};
 constexpr uInt64     FTermOutput::MIN_FLUSH_WAIT;
 constexpr uInt64     FTermOutput::MAX_FLUSH_WAIT;
+constexpr uInt64     FTermOutput::REDUCED_FLUSH_WAIT;
+constexpr uInt64     FTermOutput::MAX_DEGRADED_FLUSH_WAIT;
+constexpr uInt       FTermOutput::MIN_FRAME_RATE;
+constexpr uInt       FTermOutput::MAX_FRAME_RATE;
+constexpr int        FTermOutput::MAX_LINE_SHIFT;
 
 //----------------------------------------------------------------------
 // class FTermOutput
@@ -107,12 +127,27 @@ FTermOutput::~FTermOutput() noexcept = default;  // destructor
 //----------------------------------------------------------------------
 auto FTermOutput::isFlushTimeout() const noexcept -> bool
 {
-  const auto now_us = uInt64(duration_cast<microseconds>( clock::now()
-                                                         .time_since_epoch()).count() );
+  // While the output thread still writes, the changes are collected
+  // and reach the terminal later as a single update
+  if ( output_writer && output_writer->isBusy() )
+    return false;
+
+  if ( presentation_policy == PresentationPolicy::LatencyFirst )
+    return true;  // Present every update without delay
+
+  const auto now_us = getTimeStamp();
+
   if ( now_us < time_last_flush_us )
     return false;
 
   const auto diff_us = now_us - time_last_flush_us;
+
+  if ( diff_us < getQualityFlushWait() )
+    return false;  // Coalesces the updates on a slow connection
+
+  if ( presentation_policy == PresentationPolicy::FixedRate )
+    return diff_us >= frame_interval;
+
   return diff_us > flush_wait;
 }
 
@@ -140,6 +175,8 @@ void FTermOutput::setCursor (FPoint p)
 //----------------------------------------------------------------------
 void FTermOutput::setCursor (CursorMode mode)
 {
+  waitForOutputThread();
+
   if ( mode == CursorMode::Insert )
     FTerm::setInsertCursor();
   else if ( mode == CursorMode::Overwrite )
@@ -186,6 +223,67 @@ void FTermOutput::setNonBlockingRead (bool enable)
   FKeyboard::setReadBlockingTime (blocking_time);
 }
 
+//----------------------------------------------------------------------
+void FTermOutput::setFrameRate (uInt fps) noexcept
+{
+  // Sets the frame rate of the fixed rate presentation policy
+
+  const auto rate = internal::clampValue(fps, MIN_FRAME_RATE, MAX_FRAME_RATE);
+  frame_interval = 1'000'000 / rate;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::setOutputThread (bool enable)
+{
+  // Writes the output buffer in a separate thread, so that a slow
+  // terminal connection does not block the event processing
+
+  if ( enable == hasOutputThread() )
+    return;
+
+  if ( ! enable )
+  {
+    output_writer.reset();  // Writes the remaining frames
+    return;
+  }
+
+  std::fflush(stdout);  // Keeps the order to earlier stdio output
+  writer_bytes = 0;
+  writer_time_us = 0;
+  writer_errors = 0;
+  output_writer = std::make_unique<FOutputWriter>
+  (
+    [] (const std::string& frame)
+    {
+      static const auto& fsystem = FSystem::getInstance();
+      FSystem::IOVector iov{{const_cast<char*>(frame.data()), frame.size()}};
+      return fsystem->writeAll (FTermios::getStdOut(), iov);
+    }
+  );
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::setAdaptiveQuality (bool enable)
+{
+  // Adapts the output quality to the load of the terminal connection
+
+  adaptive_quality = enable;
+
+  if ( enable )
+  {
+    if ( output_writer )  // Only writes from now on are measured
+    {
+      writer_bytes = output_writer->getWrittenBytes();
+      writer_time_us = output_writer->getWriteTime();
+    }
+
+    return;
+  }
+
+  bandwidth_monitor.reset();
+  applyOutputQuality (OutputQuality::Full);
+}
+
 //----------------------------------------------------------------------
 void FTermOutput::initTerminal (FVTerm::FTermRegion* virtual_terminal)
 {
@@ -199,6 +297,7 @@ void FTermOutput::initTerminal (FVTerm::FTermRegion* virtual_terminal)
 
   vterm         = virtual_terminal;
   output_buffer = std::make_shared<FOutputBuffer>();
+  scratch_buffer = std::make_shared<FOutputBuffer>();
   term_pos      = std::make_shared<FPoint>(-1, -1);
 
   // Hide the input cursor
@@ -211,6 +310,9 @@ void FTermOutput::initTerminal (FVTerm::FTermRegion* virtual_terminal)
   // Check for support for combined characters
   init_combined_character();
 
+  // Check for support for synchronized output
+  init_synchronized_output();
+
   // Resetting the status of terminal attributes
   clearTerminalState();
 
@@ -240,20 +342,58 @@ auto FTermOutput::updateTerminal() -> bool
   int changedlines{0};
   const auto first_row = vterm->changes_in_row.ymin;
   const auto last_row  = vterm->changes_in_row.ymax;
+  const auto bytes_before_update = queued_bytes;
+  const auto start_us = getTimeStamp();
+  const bool synchronized = synchronized_output && first_row <= last_row;
+
+  if ( synchronized )  // The terminal holds back the frame until the end
+    appendOutputBuffer (FTermControl{{ internal::sync_update_begin
+                                     , sizeof(internal::sync_update_begin) - 1 }});
+
+  if ( write_failed )
+    restoreTerminalState();
+
+  // Reset the strategy statistics of the last update
+  statistics.run_line_bytes = 0;
+  statistics.rewrite_line_bytes = 0;
+  statistics.erase_line_bytes = 0;
+  statistics.shift_bytes = 0;
+  statistics.shifted_lines = 0;
+  statistics.shifted_blocks = 0;
+
+  // A repaint does not rely on the content of the last frame
+  const bool repaint = full_repaint;
+  full_repaint = false;
+
+  if ( frame_planner && ! repaint )
+    shiftTerminalBlocks();
 
   for (uInt y{first_row}; y <= last_row; y++)
   {
-    FVTerm::reduceTerminalLineUpdates(y);
+    if ( ! repaint )
+      FVTerm::reduceTerminalLineUpdates(y);
 
     if ( updateTerminalLine(y) )
       changedlines++;
   }
 
   vterm->changes_in_row = {uInt(vterm->size.height), 0};  // Reset row changes
+  vterm->resetDamage();
   vterm->has_changes = false;
 
   // sets the new input cursor position
   const auto& cursor_update = updateTerminalCursor();
+
+  if ( synchronized )
+    appendOutputBuffer (FTermControl{{ internal::sync_update_end
+                                     , sizeof(internal::sync_update_end) - 1 }});
+
+  // Update the output statistics
+  statistics.frames++;
+  statistics.frame_bytes = queued_bytes - bytes_before_update;
+  statistics.total_frame_bytes += statistics.frame_bytes;
+  statistics.compose_time_us = FVTerm::getComposeTime();
+  statistics.encode_time_us = getTimeStamp() - start_us;
   return cursor_update || changedlines > 0;
 }
 
@@ -263,6 +403,8 @@ auto FTermOutput::scrollTerminalForward() -> bool
   if ( ! TCAP(t_scroll_forward).data )
     return false;
 
+  waitForOutputThread();
+
   FTerm::scrollTermForward();
   return true;
 }
@@ -273,10 +415,36 @@ auto FTermOutput::scrollTerminalReverse() -> bool
   if ( ! TCAP(t_scroll_reverse).data )
     return false;
 
+  waitForOutputThread();
+
   FTerm::scrollTermReverse();
   return true;
 }
 
+//----------------------------------------------------------------------
+auto FTermOutput::scrollTerminalLines (int top, int bottom, int lines) -> bool
+{
+  // Scrolls the full-width terminal lines from top to bottom by the
+  // given number of lines (> 0 = up, < 0 = down). Only top and bottom
+  // margins are set, because left and right margins (DECSLRM) are
+  // not available on many terminals.
+
+  const auto height = int(getLineNumber());
+
+  if ( lines == 0 || top < 0 || bottom >= height
+    || bottom - top < std::abs(lines) )
+    return false;
+
+  const auto sequence = getScrollRegionSequence({top, bottom, lines});
+
+  if ( sequence.empty() )
+    return false;
+
+  appendOutputBuffer (FTermControl{{sequence.data(), uInt32(sequence.length())}});
+  term_pos->setPoint(-1, -1);  // The cursor position is undefined after csr
+  return true;
+}
+
 //----------------------------------------------------------------------
 void FTermOutput::clearTerminalState()
 {
@@ -339,36 +507,39 @@ void FTermOutput::flush()
 {
   // Flush the output buffer
 
-  flushTimeAdjustment();
-
-  if ( ! output_buffer || output_buffer->isEmpty()
-    || ! (isFlushTimeout() || getFVTerm().isTerminalUpdateForced()) )
+  if ( measuring_line )  // The scratch buffer is never written
     return;
 
-  const auto* data_ptr = output_buffer->data.data();
-  std::size_t offset = 0;  // The read position in the string
+  if ( presentation_policy == PresentationPolicy::Adaptive )
+    flushTimeAdjustment();
 
-  while ( ! output_buffer->isEmpty() )
-  {
-    const auto& first = output_buffer->slices.front();
-    const auto& type = first.type;
-    const auto& length = first.length;
+  if ( adaptive_quality )
+    updateOutputQuality();
 
-    if ( type == FOutputBuffer::OutputType::String )
-      FTerm::stringPrint (data_ptr + offset, length);
-    else if ( type == FOutputBuffer::OutputType::Control )
-      FTerm::paddingPrint (data_ptr + offset, length);
+  const bool forced = getFVTerm().isTerminalUpdateForced();
 
-    offset += length;
-    output_buffer->slices.pop();
-  }
+  if ( ! output_buffer || output_buffer->isEmpty()
+    || ! (isFlushTimeout() || forced || output_buffer->slices.isFull()) )
+    return;
+
+  const auto start_us = getTimeStamp();
+  const auto start_bytes = statistics.written_bytes;
+  writeOrQueueOutputBuffer();
+
+  if ( output_writer && forced )  // A forced update is on the terminal on return
+    output_writer->waitUntilIdle();
 
-  output_buffer->data.clear();
-  std::fflush(stdout);
   static auto& mouse = FMouseControl::getInstance();
   mouse.drawPointer();
-  time_last_flush_us = uInt64(duration_cast<microseconds>( clock::now()
-                                                          .time_since_epoch()).count() );
+  time_last_flush_us = getTimeStamp();
+  statistics.write_time_us = time_last_flush_us - start_us;
+
+  // The output thread measures its own writes
+  if ( adaptive_quality && ! output_writer )
+  {
+    const auto bytes = statistics.written_bytes - start_bytes;
+    bandwidth_monitor.addWrite (bytes, statistics.write_time_us);
+  }
 }
 
 
@@ -415,6 +586,7 @@ void FTermOutput::redefineColorPalette()
   if ( ! (canChangeColorPalette() && getStartOptions().color_change) )
     return;
 
+  waitForOutputThread();
   FTerm::resetColorMap();
   FTerm::saveColorMap();
 
@@ -445,6 +617,8 @@ void FTermOutput::restoreColorPalette()
   if ( ! (canChangeColorPalette() && getStartOptions().color_change) )
     return;
 
+  waitForOutputThread();
+
   // Reset screen settings
   FColorPalette::getInstance()->resetColorPalette();
   FTermXTerminal::getInstance().resetColorMap();
@@ -498,6 +672,17 @@ void FTermOutput::init_combined_character()
   }
 }
 
+//----------------------------------------------------------------------
+void FTermOutput::init_synchronized_output()
+{
+  // Terminals with synchronized output (DEC private mode 2026)
+  // display a frame only after it has been received completely.
+  // The support is reported by the DECRQM reply of the terminal.
+
+  static const auto& term_detection = FTermDetection::getInstance();
+  synchronized_output = term_detection.hasSyncOutputSupport();
+}
+
 //----------------------------------------------------------------------
 auto FTermOutput::canClearToEOL (uInt xmin, uInt y) const -> bool
 {
@@ -510,7 +695,7 @@ auto FTermOutput::canClearToEOL (uInt xmin, uInt y) const -> bool
     return false;
 
   const auto width = uInt(vterm->size.width);
-  const auto* row_begin = &vterm->data[std::size_t(y) * width];
+  const auto* row_begin = &vterm->getFChar(0, int(y));
   const auto* row_end = std::next(row_begin, width);
   const auto* min_char = std::next(row_begin, xmin);
 
@@ -545,7 +730,7 @@ auto FTermOutput::canClearLeadingWS (uInt& xmin, uInt y) const -> bool
     return false;
 
   const auto width = uInt(vterm->size.width);
-  const auto* row_begin = &vterm->data[std::size_t(y) * width];
+  const auto* row_begin = &vterm->getFChar(0, int(y));
   const auto* row_end = std::next(row_begin, width);
   const auto& first_char = *row_begin;
 
@@ -585,7 +770,7 @@ auto FTermOutput::canClearTrailingWS (uInt& xmax, uInt y) const -> bool
     return false;
 
   const int width = vterm->size.width;
-  const auto* row_begin = &vterm->data[std::size_t(y) * unsigned(width)];
+  const auto* row_begin = &vterm->getFChar(0, int(y));
   const auto* row_end = std::next(row_begin, width);
   const auto* last_char = std::prev(row_end);
 
@@ -627,33 +812,65 @@ auto FTermOutput::skipUnchangedCharacters ( uInt& x, uInt xmax, uInt y
   if ( ! iter->isBitSet(mask) )
     return false;
 
-  auto ch = iter + 1;  // Skip first unchanged character
-  const auto end = ch + xmax - x;
+  // Number of unchanged characters
+  const auto count = uInt(getAttributeRunLength(&*iter, xmax - x + 1, mask, true));
+  static const auto& opti_move = FOptiMove::getInstance();
 
-  // Unroll the loop for better performance
-  while ( ch + 4 <= end
-       && ch[0].isBitSet(mask) && ch[1].isBitSet(mask)
-       && ch[2].isBitSet(mask) && ch[3].isBitSet(mask) )
+  if ( opti_move.isCostCalibrated() )
   {
-    ch += 4;
+    if ( isPrintOverCheaper(x, y, count, iter) )
+      return false;
   }
+  else if ( count <= cursor_address_length )
+    return false;
 
-  // Handle the remaining elements
-  while ( ch < end && ch->isBitSet(mask) )
-  {
-    ++ch;
-  }
+  x += count;  // Add unchanged number of characters to the pointer
+  setCursor (FPoint{int(x), int(y)});
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::isPrintOverCheaper ( uInt x, uInt y, uInt count
+                                     , FChar_const_iterator iter ) const -> bool
+{
+  // Compares the byte costs of the cursor movement over unchanged
+  // characters with the reprinting of these characters. Reprinting
+  // is only possible from the current cursor position and without
+  // attribute changes, so the terminal state after both alternatives
+  // is the same and the decision for each gap is optimal for the line.
+
+  if ( term_pos->getX() != int(x) || term_pos->getY() != int(y) )
+    return false;
 
-  auto count = uInt(ch - iter);  // Number of unchanged characters
+  const auto& move = FTerm::moveCursor ( int(x), int(y)
+                                       , int(x + count), int(y) );
+  const auto move_length = move.data ? uInt(move.length) : 0;
+  const bool utf8 = internal::terminal::encoding == Encoding::UTF8
+                 && ! internal::var::is_new_font;
+  uInt print_length{0};
 
-  if ( count > cursor_address_length )
+  for (uInt n{0}; n < count; n++, ++iter)
   {
-    x += count;  // Add unchanged number of characters to the pointer
-    setCursor (FPoint{int(x), int(y)});
-    return true;
+    const auto ch = iter->ch.unicode_data[0];
+
+    if ( iter->ch.unicode_data[1] != L'\0'
+      || isFullWidthChar(*iter) || isFullWidthPaddingChar(*iter)
+      || term_attribute.color.data != iter->color.data
+      || (term_attribute.attr.data & 0x0000ffffU) != (iter->attr.data & 0x0000ffffU) )
+      return false;
+
+    if ( ch >= L' ' && ch < L'\x7f' )
+      print_length++;
+    else if ( utf8 && ch >= L'\xa0' )
+      print_length += ( ch < 0x800 ) ? 2 : ( ch < 0x10000 ) ? 3 : 4;
+    else
+      return false;
+
+    if ( print_length >= move_length )
+      return false;
   }
 
-  return false;
+  return true;
 }
 
 //----------------------------------------------------------------------
@@ -681,6 +898,13 @@ void FTermOutput::printRange (uInt xmin, uInt xmax, uInt y)
     if ( skipUnchangedCharacters(x, xmax, y, iter) )
       continue;
 
+    // Contiguous text with the same attributes
+    if ( printTextRun(x, xmax, y, iter) )
+    {
+      ++x;
+      continue;
+    }
+
     // Erase character
     if ( ec.data && iter->ch.unicode_data[0] == L' ' )
     {
@@ -880,7 +1104,7 @@ auto FTermOutput::eraseCharacters (uInt& x, uInt xmax, uInt y, const FChar_itera
   {
     appendAttributes (*iter);
     const auto term_ctrl = FTermcap::encodeParameter(ec, whitespace);
-    appendOutputBuffer (FTermControl{term_ctrl});
+    appendOutputBuffer (FTermControl{{term_ctrl.data(), uInt32(term_ctrl.length())}});
 
     if ( end_pos <= xmax )
       setCursor (FPoint{static_cast<int>(x + whitespace), static_cast<int>(y)});
@@ -925,14 +1149,14 @@ auto FTermOutput::repeatCharacter (uInt& x, uInt xmax, uInt y, const FChar_itera
     charsetChanges (*iter);
     appendAttributes (*iter);
     const auto term_ctrl = FTermcap::encodeParameter(rp, iter->ch.unicode_data[0], repetitions);
-    appendOutputBuffer (FTermControl{term_ctrl});
+    appendOutputBuffer (FTermControl{{term_ctrl.data(), uInt32(term_ctrl.length())}});
     term_pos->x_ref() += static_cast<int>(repetitions);
   }
   else if ( lr.data && repetition_type == Repetition::UTF8 )
   {
     appendChar (*iter);
     const auto term_ctrl = FTermcap::encodeParameter(lr, repetitions);
-    appendOutputBuffer (FTermControl{term_ctrl});
+    appendOutputBuffer (FTermControl{{term_ctrl.data(), uInt32(term_ctrl.length())}});
     term_pos->x_ref() += static_cast<int>(repetitions);
   }
   else
@@ -944,6 +1168,119 @@ auto FTermOutput::repeatCharacter (uInt& x, uInt xmax, uInt y, const FChar_itera
   return PrintState::RepeatCharacterPrinted;
 }
 
+//----------------------------------------------------------------------
+auto FTermOutput::printTextRun (uInt& x, uInt xmax, uInt y, const FChar_iterator& iter) -> bool
+{
+  // Appends contiguous single-width characters with the same
+  // attributes as one block. Unchanged characters, repeatable
+  // characters and the special cases of the general character
+  // output end the run.
+
+  if ( ! canPrintTextRun() || ! isTextRunCharacter(x, xmax, y, iter) )
+    return false;
+
+  appendAttributes (*iter);
+  const auto& term_color = term_attribute.color.data;
+  const auto term_attr = term_attribute.attr.data & 0x0000ffffU;
+  uInt32 bytes = getUTF8Length(iter->ch.unicode_data[0]);
+  uInt length{1};
+
+  while ( x + length <= xmax )
+  {
+    const auto& fchar = iter[length];
+
+    if ( fchar.color.data != term_color
+      || (fchar.attr.data & 0x0000ffffU) != term_attr
+      || ! isTextRunCharacter(x + length, xmax, y, iter + length) )
+      break;
+
+    bytes += getUTF8Length(fchar.ch.unicode_data[0]);
+    ++length;
+  }
+
+  // Encodes the characters directly into the output buffer
+  auto& data = output_buffer->data;
+  const auto offset = data.size();
+  data.expand(bytes);
+  auto* dest = data.data() + offset;
+
+  for (uInt n{0}; n < length; n++)
+  {
+    const auto ch = iter[n].ch.unicode_data[0];
+
+    if ( ch < 0x80 )  // ASCII
+    {
+      *dest = char(ch);
+      ++dest;
+    }
+    else
+    {
+      std::array<char, 4> utf8{};
+      const auto len = UTF8::encode(ch, utf8);
+      std::memcpy (dest, utf8.data(), len);
+      dest += len;
+    }
+  }
+
+  addOutputSlice (FOutputBuffer::OutputType::String, bytes);
+  term_pos->x_ref() += static_cast<int>(length);
+  const uInt end_pos = x + length - 1;
+  markAsPrinted (x, end_pos, y);
+  x = end_pos;
+  return true;
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::canPrintTextRun() const noexcept -> bool
+{
+  // Only UTF-8 output without character substitutions
+  // prints the unchanged code points of the cells
+
+  return text_runs
+      && internal::terminal::encoding == Encoding::UTF8
+      && ! internal::var::is_new_font
+      && ! internal::var::has_sub_map
+      && ! basic_colors;
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::isTextRunCharacter ( uInt x, uInt xmax, uInt y
+                                            , FChar_const_iterator iter ) const noexcept -> bool
+{
+  const auto& ch = iter->ch;
+  const auto last_column = uInt(vterm->size.width - 1);
+
+  if ( iter->isBitSet(FAttribute::set::no_changes)
+    || ch.unicode_data[0] == L'\0'
+    || ch.unicode_data[1] != L'\0'
+    || iter->getCharWidth() != 1
+    || isFullWidthPaddingChar(*iter)
+    || (x > 0 && isFullWidthChar(iter[-1]))  // Half-covered full-width character
+    || (x == last_column && y == uInt(vterm->size.height - 1)) )
+    return false;
+
+  if ( x == xmax || iter[1] != *iter )
+    return true;
+
+  // Repeated characters that are cheaper to erase or to repeat
+  const auto repetitions = countRepetitions(iter, x, xmax);
+
+  if ( TCAP(t_erase_chars).data && ch.unicode_data[0] == L' ' )
+    return ! canUseEraseCharacters(*iter, repetitions);
+
+  const auto repetition_type = getRepetitionType(*iter, repetitions);
+  return ! ( (TCAP(t_repeat_char).data && repetition_type == Repetition::ASCII)
+          || (TCAP(t_repeat_last_char).data && repetition_type == Repetition::UTF8) );
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::getUTF8Length (wchar_t ucs) noexcept -> uInt32
+{
+  return ( ucs < 0x80 ) ? 1
+       : ( ucs < 0x800 ) ? 2
+       : ( ucs < 0x10000 ) ? 3 : 4;
+}
+
 //----------------------------------------------------------------------
 inline auto FTermOutput::countRepetitions ( FChar_const_iterator iter
                                           , uInt from, uInt to ) const noexcept -> uInt
@@ -972,15 +1309,18 @@ inline auto FTermOutput::canUseEraseCharacters ( const FChar& print_char
   const auto ut = FTermcap::background_color_erase;
   const uInt total_length_required = erase_char_length
                                    + cursor_address_length;
+  // With minimal output quality, a tie is enough
+  const uInt bias = ( output_quality == OutputQuality::Minimal ) ? 1 : 0;
 
-  return whitespace > total_length_required && (ut || normal);
+  return whitespace + bias > total_length_required && (ut || normal);
 }
 
 //----------------------------------------------------------------------
 inline auto FTermOutput::canUseCharacterRepetitions ( const FChar& print_char
                                                     , uInt repetitions ) const noexcept -> bool
 {
-  return repetitions > repeat_char_length
+  const uInt bias = ( output_quality == OutputQuality::Minimal ) ? 1 : 0;
+  return repetitions + bias > repeat_char_length
       && print_char.ch[0] != L'\0'
       && print_char.ch[1] == L'\0';
 }
@@ -1076,6 +1416,27 @@ inline auto FTermOutput::updateTerminalLine (uInt y) -> bool
   if ( xmin > xmax )  // This line has no changes
     return false;
 
+  const auto strategy = frame_planner ? planLine(y) : LineStrategy::Runs;
+  const auto bytes_before_line = queued_bytes;
+  encodeLine (strategy, y);
+  addLineStatistics (strategy, queued_bytes - bytes_before_line);
+
+  // Reset line changes and wrap the cursor
+  xmin = uInt(vterm->size.width);
+  xmax = 0;
+  cursorWrap();
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::printLineRuns (uInt y)
+{
+  // Optimizes each character run of the line separately
+
+  auto& vterm_changes = vterm->changes_in_line[y];
+  uInt& xmin = vterm_changes.xmin;
+  uInt& xmax = vterm_changes.xmax;
+
   // Clear rest of line
   if ( canClearToEOL (xmin, y) )
   {
@@ -1109,124 +1470,811 @@ inline auto FTermOutput::updateTerminalLine (uInt y) -> bool
       markAsPrinted (xmax + 1, uInt(vterm->size.width - 1), y);
     }
   }
-
-  // Reset line changes and wrap the cursor
-  xmin = uInt(vterm->size.width);
-  xmax = 0;
-  cursorWrap();
-  return true;
 }
 
 //----------------------------------------------------------------------
-auto FTermOutput::updateTerminalCursor() -> bool
+void FTermOutput::rewriteLine (uInt y)
 {
-  // Updates the input cursor visibility and the position
-
-  if ( isInputCursorInsideTerminal() )
-  {
-    setCursor (FPoint{vterm->input_cursor.x, vterm->input_cursor.y});
-    showCursor();
-    return true;
-  }
+  // Prints all characters of the change range, including
+  // the unchanged characters between the changes
 
-  hideCursor();
-  return false;
+  const auto& vterm_changes = vterm->changes_in_line[y];
+  const auto begin = vterm->getFCharIterator(int(vterm_changes.xmin), int(y));
+  const auto end = begin + (vterm_changes.xmax - vterm_changes.xmin + 1);
+  std::for_each ( begin, end
+                , [] (FChar& fchar)
+                  {
+                    fchar.unsetBit(FAttribute::unset::no_changes);
+                  } );
+  printLineRuns (y);
 }
 
 //----------------------------------------------------------------------
-inline void FTermOutput::flushTimeAdjustment() noexcept
+void FTermOutput::eraseLine (uInt y)
 {
-  const auto now_us = uInt64(duration_cast<microseconds>( clock::now()
-                                                         .time_since_epoch()).count() );
-  const auto diff_us = now_us - time_last_flush_us;
+  // Clears the line from xmin to the end and prints only
+  // the characters that differ from the erased character
 
-  if ( diff_us > RESET_THRESHOLD )
+  const auto xmin = vterm->changes_in_line[y].xmin;
+  const auto width = uInt(vterm->size.width);
+  const auto row = vterm->getFCharIterator(0, int(y));
+  auto erase_char = *(row + (width - 1));
+  setCursor (FPoint{int(xmin), int(y)});
+  appendAttributes (erase_char);
+  appendOutputBuffer (FTermControl{TCAP(t_clr_eol)});
+  uInt xmax{xmin};
+  bool has_text{false};
+
+  for (auto x{xmin}; x < width; x++)
   {
-    flush_wait    = MIN_FLUSH_WAIT;  // Reset to minimum values after 400 ms
-    flush_average = MIN_FLUSH_WAIT;
-    flush_median  = MIN_FLUSH_WAIT;
-    return;
+    auto& fchar = *(row + x);
+
+    if ( fchar == erase_char )  // Already displayed by clearing
+    {
+      fchar.setBit(FAttribute::set::no_changes);
+    }
+    else
+    {
+      fchar.unsetBit(FAttribute::unset::no_changes);
+      xmax = x;
+      has_text = true;
+    }
   }
 
-  const uInt64 us = internal::clampValue(diff_us, MIN_FLUSH_WAIT, MAX_FLUSH_WAIT);
-  const uInt64 avg = flush_average;
-  const uInt64 delta_avg = ( us > avg ) ? (us - avg) / 10
-                                        : (avg - us) / 10;
-  flush_average = internal::adjustValue (us, avg, delta_avg, MIN_FLUSH_WAIT);
-  const uInt64 med  = flush_median;
-  const uInt64 step = flush_average / 5;
-  flush_median  = internal::adjustValue (us, med, step, MIN_FLUSH_WAIT);
-  flush_wait = flush_median;
+  markAsPrinted (xmin, width - 1, y);
+
+  if ( has_text )
+    printRange (xmin, xmax, y);
 }
 
 //----------------------------------------------------------------------
-inline void FTermOutput::markAsPrinted (uInt x, uInt y) const noexcept
+inline void FTermOutput::encodeLine (LineStrategy strategy, uInt y)
 {
-  // Marks a character as printed
-
-  vterm->getFChar(int(x), int(y)).setBit(FAttribute::set::printed);
+  if ( strategy == LineStrategy::Rewrite )
+    rewriteLine (y);
+  else if ( strategy == LineStrategy::Erase )
+    eraseLine (y);
+  else
+    printLineRuns (y);
 }
 
 //----------------------------------------------------------------------
-inline void FTermOutput::markAsPrinted (uInt from, uInt to, uInt y) const noexcept
+auto FTermOutput::planLine (uInt y) -> LineStrategy
 {
-  // Marks characters in the specified range [from .. to] as printed
+  // Selects the line strategy with the smallest number of bytes.
+  // Alternatives whose lower byte limit cannot beat the per-run
+  // optimization are not encoded.
 
-  auto iter = vterm->getFCharIterator(int(from), int(y));
-  const auto end = iter + to - from + 1;
+  const auto& vterm_changes = vterm->changes_in_line[y];
+  const auto xmin = vterm_changes.xmin;
+  const auto xmax = vterm_changes.xmax;
+  const bool can_rewrite = hasUnchangedCharacters(xmin, xmax, y);
+  const bool can_erase = canEraseLine(xmin, y);
 
-  // Unroll the loop for better performance
-  while ( iter + 4 <= end )
+  if ( ! can_rewrite && ! can_erase )
+    return LineStrategy::Runs;
+
+  saveLineState (y);
+  auto strategy = LineStrategy::Runs;
+  auto min_bytes = measureLine(LineStrategy::Runs, y);
+
+  if ( can_rewrite && uInt64(xmax - xmin + 1) < min_bytes )
   {
-    iter[0].setBit(FAttribute::set::printed);
-    iter[1].setBit(FAttribute::set::printed);
-    iter[2].setBit(FAttribute::set::printed);
-    iter[3].setBit(FAttribute::set::printed);
-    iter += 4;
+    const auto bytes = measureLine(LineStrategy::Rewrite, y);
+
+    if ( bytes < min_bytes )
+    {
+      strategy = LineStrategy::Rewrite;
+      min_bytes = bytes;
+    }
   }
 
-  // Handle the remaining elements
-  while ( iter < end )
+  if ( can_erase && getEraseLowerBound(xmin, y) < min_bytes )
   {
-    iter->setBit(FAttribute::set::printed);
-    ++iter;
+    const auto bytes = measureLine(LineStrategy::Erase, y);
+
+    if ( bytes < min_bytes )
+      strategy = LineStrategy::Erase;
   }
+
+  return strategy;
 }
 
 //----------------------------------------------------------------------
-inline void FTermOutput::newFontChanges (FChar& next_char) const
+auto FTermOutput::measureLine (LineStrategy strategy, uInt y) -> uInt64
 {
-  // NewFont special cases
-  if ( ! internal::var::is_new_font )
-    return;
+  // Encodes the line into the scratch buffer and restores
+  // the line state afterwards. Flushing is blocked while the
+  // scratch buffer takes the place of the output buffer.
 
-  if ( next_char.ch.unicode_data[0] == UniChar::LowerHalfBlock )
-  {
-    next_char.ch.unicode_data[0] = wchar_t(UniChar::UpperHalfBlock);
-    next_char.setBit(FAttribute::set::reverse);
-  }
-  else if ( isReverseNewFontchar(next_char.ch.unicode_data[0]) )
+  const auto bytes_before = queued_bytes;
+  std::swap (output_buffer, scratch_buffer);
+  measuring_line = true;
+  encodeLine (strategy, y);
+  measuring_line = false;
+  std::swap (output_buffer, scratch_buffer);
+  const auto bytes = queued_bytes - bytes_before;
+  queued_bytes = bytes_before;
+  scratch_buffer->slices.clear();
+  scratch_buffer->data.clear();
+  restoreLineState (y);
+  return bytes;
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutput::saveLineState (uInt y)
+{
+  const auto row = vterm->getFCharIterator(0, int(y));
+  saved_line.chars.assign (row, row + vterm->size.width);
+  saved_line.changes = vterm->changes_in_line[y];
+  saved_line.cursor = *term_pos;
+  saved_line.attribute = term_attribute;
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutput::restoreLineState (uInt y)
+{
+  const auto row = vterm->getFCharIterator(0, int(y));
+  std::copy (saved_line.chars.cbegin(), saved_line.chars.cend(), row);
+  vterm->changes_in_line[y] = saved_line.changes;
+  *term_pos = saved_line.cursor;
+  term_attribute = saved_line.attribute;
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::hasUnchangedCharacters ( uInt xmin, uInt xmax
+                                                , uInt y ) const -> bool
+{
+  const auto begin = vterm->getFCharIterator(int(xmin), int(y));
+  const auto end = begin + (xmax - xmin + 1);
+  return std::any_of ( begin, end
+                     , [] (const FChar& fchar)
+                       {
+                         return fchar.isBitSet(FAttribute::set::no_changes);
+                       } );
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::canEraseLine (uInt xmin, uInt y) const -> bool
+{
+  // The line end must be a space that can be erased with clr_eol
+
+  if ( ! TCAP(t_clr_eol).data || xmin >= uInt(vterm->size.width) )
+    return false;
+
+  const auto& last_char = vterm->getFChar(vterm->size.width - 1, int(y));
+
+  if ( last_char.ch.unicode_data[0] != L' '
+    || last_char.ch.unicode_data[1] != L'\0' )
+    return false;
+
+  return FTermcap::background_color_erase || FOptiAttr::isNormal(last_char);
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::getEraseLowerBound (uInt xmin, uInt y) const -> uInt64
+{
+  // clr_eol and one byte for each character that is not erased
+
+  const auto row = vterm->getFCharIterator(0, int(y));
+  const auto& erase_char = *(row + (vterm->size.width - 1));
+  const auto count = std::count_if ( row + xmin, row + vterm->size.width
+                                   , [&erase_char] (const FChar& fchar)
+                                     {
+                                       return fchar != erase_char;
+                                     } );
+  return uInt64(clr_eol_length) + uInt64(count);
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutput::addLineStatistics ( LineStrategy strategy
+                                           , uInt64 bytes ) noexcept
+{
+  if ( strategy == LineStrategy::Rewrite )
+    statistics.rewrite_line_bytes += bytes;
+  else if ( strategy == LineStrategy::Erase )
+    statistics.erase_line_bytes += bytes;
+  else
+    statistics.run_line_bytes += bytes;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::shiftTerminalBlocks()
+{
+  // Moves vertically shifted blocks of lines with the terminal if
+  // this is shorter than repainting the lines. Blocks are found by
+  // comparing the hash values of the current and the last lines
+  // (like the hash-based scroll optimization of ncurses).
+
+  const auto* vterm_old = FVTerm::getLastVirtualTerminal();
+  const auto first = int(vterm->changes_in_row.ymin);
+  const auto last = int(vterm->changes_in_row.ymax);
+
+  if ( ! vterm_old || first >= last || last >= vterm->size.height )
+    return;
+
+  updateLineHashes (first, last);
+
+  for (auto n{0}; n < MAX_SHIFTED_BLOCKS; n++)
+  {
+    const auto shift = findLineShift(first, last);
+
+    if ( shift.distance == 0 )
+      return;
+
+    const auto sequence = getShiftSequence(shift);
+
+    if ( sequence.empty() || getLineShiftGain(shift) <= sequence.length() )
+      return;
+
+    appendOutputBuffer (FTermControl{{sequence.data(), uInt32(sequence.length())}});
+    term_pos->setPoint(-1, -1);  // Force an absolute cursor movement
+    FVTerm::shiftLastTerminalLines (shift.top, shift.bottom, shift.distance);
+    updateLineHashes (shift.top, shift.bottom);
+    const auto count = std::abs(shift.distance);
+    statistics.shift_bytes += sequence.length();
+    statistics.shifted_lines += uInt64(shift.bottom - shift.top + 1 - count);
+    statistics.shifted_blocks++;
+  }
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::updateLineHashes (int first, int last)
+{
+  const auto* vterm_old = FVTerm::getLastVirtualTerminal();
+  const auto width = std::size_t(vterm->size.width);
+  const auto height = std::size_t(vterm->size.height);
+
+  if ( line_hashes.size() != height )
+  {
+    line_hashes.assign(height, 0);
+    old_line_hashes.assign(height, 0);
+  }
+
+  for (auto y{first}; y <= last; y++)
+  {
+    line_hashes[std::size_t(y)] = getLineHash(&*vterm->getFCharIterator(0, y), width);
+    old_line_hashes[std::size_t(y)] = getLineHash(&*vterm_old->getFCharIterator(0, y), width);
+  }
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::findLineShift (int first, int last) const -> LineShift
+{
+  // A changed line whose hash value matches a last line a few lines
+  // below or above is the anchor of a block. The block grows around
+  // the anchor as long as the lines match with the same distance.
+
+  const auto* vterm_old = FVTerm::getLastVirtualTerminal();
+  const auto width = std::size_t(vterm->size.width);
+  LineShift best{};
+  uInt64 best_gain{0};
+
+  auto isLineMoved = [this, vterm_old, width] (int y, int old_y)
+  {
+    // A line also counts as moved if only a few characters
+    // differ (e.g. a scrollbar at the edge of the moved content)
+    const auto* line = &*vterm->getFCharIterator(0, y);
+    const auto shifted = getChangeCount ( line
+                                        , &*vterm_old->getFCharIterator(0, old_y)
+                                        , width );
+    return shifted == 0
+        || shifted < getChangeCount ( line
+                                    , &*vterm_old->getFCharIterator(0, y)
+                                    , width );
+  };
+
+  auto y{first};
+
+  while ( y <= last )
+  {
+    const auto distance = findHashShift(y, first, last);
+
+    if ( distance == 0 )
+    {
+      y++;
+      continue;
+    }
+
+    auto isInBlock = [first, last, distance] (int line)
+    {
+      return line >= first && line <= last
+          && line + distance >= first && line + distance <= last;
+    };
+
+    auto top{y};
+    auto end{y};
+
+    while ( isInBlock(top - 1) && isLineMoved(top - 1, top - 1 + distance) )
+      top--;
+
+    while ( isInBlock(end + 1) && isLineMoved(end + 1, end + 1 + distance) )
+      end++;
+
+    const LineShift shift
+    {
+      ( distance > 0 ) ? top : top + distance,  // top
+      ( distance > 0 ) ? end + distance : end,  // bottom
+      distance
+    };
+    const auto gain = getLineShiftGain(shift);
+
+    if ( gain > best_gain )
+    {
+      best = shift;
+      best_gain = gain;
+    }
+
+    y = end + 1;
+  }
+
+  return best;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::findHashShift (int y, int first, int last) const noexcept -> int
+{
+  // Returns the distance to the nearest last line with the hash
+  // value of the changed line y, or 0 if there is no such line
+
+  const auto hash = line_hashes[std::size_t(y)];
+
+  if ( hash == old_line_hashes[std::size_t(y)] )
+    return 0;
+
+  const auto max_shift = std::min(MAX_LINE_SHIFT, last - first);
+
+  for (auto distance{1}; distance <= max_shift; distance++)
+  {
+    if ( y + distance <= last
+      && old_line_hashes[std::size_t(y + distance)] == hash )
+      return distance;
+
+    if ( y - distance >= first
+      && old_line_hashes[std::size_t(y - distance)] == hash )
+      return -distance;
+  }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::getShiftSequence (const LineShift& shift) -> std::string
+{
+  // Returns the shorter sequence of delete/insert line
+  // and scrolling in a scrolling region
+
+  auto sequence = getInsertDeleteSequence(shift);
+  auto scroll_sequence = getScrollRegionSequence(shift);
+
+  if ( ! scroll_sequence.empty()
+    && ( sequence.empty() || scroll_sequence.length() < sequence.length() ) )
+    return scroll_sequence;
+
+  return sequence;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::getInsertDeleteSequence (const LineShift& shift) -> std::string
+{
+  // Deletes the lines at one end of the block and inserts empty
+  // lines at the other end. At the bottom of the screen, the lines
+  // are pushed out, so the second operation is not required.
+
+  const auto& dl = TCAP(t_delete_line);
+  const auto& DL = TCAP(t_parm_delete_line);
+  const auto& il = TCAP(t_insert_line);
+  const auto& IL = TCAP(t_parm_insert_line);
+
+  if ( ! (dl.data || DL.data) || ! (il.data || IL.data) )
+    return {};
+
+  const auto count = std::abs(shift.distance);
+  const auto last_line = vterm->size.height - 1;
+  std::string sequence{};
+
+  auto moveTo = [this, &sequence] (int y)
+  {
+    const auto pos = *term_pos;
+    const auto& move = FTerm::moveCursor (pos.getX(), pos.getY(), 0, y);
+
+    if ( ! move.data )
+      return false;
+
+    sequence.append(move.data, move.length);
+    term_pos->setPoint(-1, -1);  // il and dl can change the column
+    return true;
+  };
+
+  auto appendLines = [&sequence, count] ( const FTermcap::TermcapString& single
+                                        , const FTermcap::TermcapString& parm )
+  {
+    if ( parm.data && (count > 1 || ! single.data) )
+    {
+      sequence.append(FTermcap::encodeParameter(parm, count));
+    }
+    else
+    {
+      for (auto n{0}; n < count; n++)
+        sequence.append(single.data, single.length);
+    }
+  };
+
+  const auto saved_pos = *term_pos;
+  const auto delete_y = ( shift.distance > 0 ) ? shift.top : shift.bottom - count + 1;
+  const auto insert_y = ( shift.distance > 0 ) ? shift.bottom - count + 1 : shift.top;
+  const bool to_bottom = shift.bottom == last_line;
+
+  if ( shift.distance > 0 || ! to_bottom )
+  {
+    if ( moveTo(delete_y) )
+      appendLines (dl, DL);
+    else
+      sequence.clear();
+  }
+
+  if ( ! sequence.empty() || shift.distance < 0 )
+  {
+    if ( (shift.distance < 0 || ! to_bottom) && moveTo(insert_y) )
+      appendLines (il, IL);
+  }
+
+  *term_pos = saved_pos;
+  return sequence;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::getScrollRegionSequence (const LineShift& shift) const -> std::string
+{
+  // Sets the scrolling margins to the block, scrolls it with ind at
+  // the bottom margin or with ri at the top margin, and resets the
+  // margins to the full screen
+
+  const auto& cs = TCAP(t_change_scroll_region);
+  const auto& sc = ( shift.distance > 0 ) ? TCAP(t_scroll_forward)
+                                          : TCAP(t_scroll_reverse);
+
+  if ( ! cs.data || ! sc.data )
+    return {};
+
+  std::string sequence{};
+
+  auto append = [&sequence] (const std::string& str)
+  {
+    if ( str.empty() )
+      return false;
+
+    sequence.append(str);
+    return true;
+  };
+
+  if ( ! append(FTermcap::encodeParameter(cs, shift.top, shift.bottom)) )
+    return {};
+
+  // csr moves the cursor to an undefined position
+  const auto margin_y = ( shift.distance > 0 ) ? shift.bottom : shift.top;
+  const auto& move = FTerm::moveCursor(-1, -1, 0, margin_y);
+
+  if ( ! move.data )
+    return {};
+
+  sequence.append(move.data, move.length);
+
+  for (auto n{0}; n < std::abs(shift.distance); n++)
+    sequence.append(sc.data, sc.length);
+
+  if ( ! append(FTermcap::encodeParameter(cs, 0, vterm->size.height - 1)) )
+    return {};
+
+  return sequence;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::getLineShiftGain (const LineShift& shift) const -> uInt64
+{
+  // Estimates the saved bytes by the number of changed characters
+  // before and after the shift (at least one byte per character)
+
+  const auto* vterm_old = FVTerm::getLastVirtualTerminal();
+  const auto width = std::size_t(vterm->size.width);
+  uInt64 before{0};
+  uInt64 after{0};
+
+  for (auto y{shift.top}; y <= shift.bottom; y++)
+  {
+    const auto* line = &*vterm->getFCharIterator(0, y);
+    const auto old_y = y + shift.distance;
+    before += getChangeCount(line, &*vterm_old->getFCharIterator(0, y), width);
+
+    if ( old_y >= shift.top && old_y <= shift.bottom )
+      after += getChangeCount(line, &*vterm_old->getFCharIterator(0, old_y), width);
+    else
+      after += width;  // Inserted empty line
+  }
+
+  return ( before > after ) ? before - after : 0;
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::getChangeCount ( const FChar* line
+                                        , const FChar* line_old
+                                        , std::size_t width ) noexcept -> uInt64
+{
+  // Counts the changed characters of a line. Unlike the changed
+  // range, the count is not affected by single changed characters
+  // at the line edges (e.g. a frame or a scrollbar).
+
+  const auto first = findFirstChange(line, line_old, width);
+
+  if ( first == width )
+    return 0;
+
+  const auto last = findLastChange(line, line_old, width);
+  uInt64 count{0};
+
+  for (auto x{first}; x < last; x++)
+    if ( line[x] != line_old[x] )
+      count++;
+
+  return count;
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::getLineHash ( const FChar* line
+                                     , std::size_t width ) noexcept -> uInt64
+{
+  // Rolling hash (FNV-1a) over the characters, the colors and the
+  // compared attributes of a line. The character set bits are not
+  // included, because they are only set by the output of a character.
+
+  constexpr uInt64 offset_basis{0xcbf29ce484222325};
+  constexpr uInt64 prime{0x100000001b3};
+  constexpr auto attr_mask = getCompareBitMask()
+                           & ~(FAttribute::set::alt_charset | FAttribute::set::pc_charset);
+  uInt64 hash{offset_basis};
+
+  for (const auto* fchar = line; fchar < line + width; ++fchar)
+  {
+    hash = (hash ^ uInt64(fchar->ch[0])) * prime;
+    hash = (hash ^ uInt64(fchar->color.data)) * prime;
+    hash = (hash ^ uInt64(fchar->attr.data & attr_mask)) * prime;
+  }
+
+  return hash;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::updateTerminalCursor() -> bool
+{
+  // Updates the input cursor visibility and the position
+
+  if ( isInputCursorInsideTerminal() )
+  {
+    setCursor (FPoint{vterm->input_cursor.x, vterm->input_cursor.y});
+    showCursor();
+    return true;
+  }
+
+  hideCursor();
+  return false;
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutput::flushTimeAdjustment() noexcept
+{
+  const auto now_us = getTimeStamp();
+  const auto diff_us = now_us - time_last_flush_us;
+
+  if ( diff_us > RESET_THRESHOLD )
+  {
+    flush_wait    = MIN_FLUSH_WAIT;  // Reset to minimum values after 400 ms
+    flush_average = MIN_FLUSH_WAIT;
+    flush_median  = MIN_FLUSH_WAIT;
+    return;
+  }
+
+  const uInt64 us = internal::clampValue(diff_us, MIN_FLUSH_WAIT, MAX_FLUSH_WAIT);
+  const uInt64 avg = flush_average;
+  const uInt64 delta_avg = ( us > avg ) ? (us - avg) / 10
+                                        : (avg - us) / 10;
+  flush_average = internal::adjustValue (us, avg, delta_avg, MIN_FLUSH_WAIT);
+  const uInt64 med  = flush_median;
+  const uInt64 step = flush_average / 5;
+  flush_median  = internal::adjustValue (us, med, step, MIN_FLUSH_WAIT);
+  flush_wait = flush_median;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::updateOutputQuality()
+{
+  // Measures the throughput and the queue depth of the terminal
+  // connection and lowers the output quality under overload
+
+  auto queue_depth = getTerminalQueueDepth();
+
+  if ( output_writer )
+  {
+    const auto bytes = output_writer->getWrittenBytes();
+    const auto write_time = output_writer->getWriteTime();
+    bandwidth_monitor.addWrite (bytes - writer_bytes, write_time - writer_time_us);
+    writer_bytes = bytes;
+    writer_time_us = write_time;
+    queue_depth += output_writer->getPendingBytes();
+  }
+
+  bandwidth_monitor.setQueueDepth (queue_depth);
+
+  if ( bandwidth_monitor.update(getTimeStamp()) )
+    applyOutputQuality (bandwidth_monitor.getQuality());
+
+  statistics.throughput = bandwidth_monitor.getThroughput();
+  statistics.link_load = bandwidth_monitor.getLoad();
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::applyOutputQuality (OutputQuality quality)
+{
+  if ( quality == output_quality )
+    return;
+
+  static auto& opti_move = FOptiMove::getInstance();
+
+  if ( output_quality == OutputQuality::Full )
+    line_baudrate = opti_move.getBaudRate();
+
+  if ( quality == OutputQuality::Full )
+  {
+    opti_move.setBaudRate(line_baudrate);
+  }
+  else if ( bandwidth_monitor.getThroughput() > 0 )
+  {
+    // The cursor movement costs follow the measured rate (8N1 = 10 bits)
+    const auto max_baud = uInt64(std::numeric_limits<int>::max());
+    const auto baud = std::min(bandwidth_monitor.getThroughput() * 10, max_baud);
+    opti_move.setBaudRate(int(baud));
+  }
+
+  const bool had_basic_colors = basic_colors;
+  basic_colors = quality == OutputQuality::Minimal
+              && getMaxColor() > 16;
+  output_quality = quality;
+  statistics.quality_changes++;
+
+  if ( had_basic_colors && ! basic_colors )
+    repaintTerminal();  // Restores the full colors
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::getQualityFlushWait() const noexcept -> uInt64
+{
+  // Minimum time between two updates for the current output quality
+
+  if ( output_quality == OutputQuality::Full )
+    return 0;
+
+  // Leaves the connection time to send the last update
+  const auto min_wait = ( output_quality == OutputQuality::Reduced )
+                        ? REDUCED_FLUSH_WAIT
+                        : MAX_FLUSH_WAIT;
+  const auto transfer_us = 2 * bandwidth_monitor.getTransferTime(statistics.frame_bytes);
+  return internal::clampValue(transfer_us, min_wait, MAX_DEGRADED_FLUSH_WAIT);
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::getTerminalQueueDepth() const -> uInt64
+{
+  // Returns the number of bytes in the output queue of the terminal
+
+#if defined(TIOCOUTQ)
+  static const auto& fsystem = FSystem::getInstance();
+  int queued{0};
+
+  if ( fsystem->ioctl(FTermios::getStdOut(), TIOCOUTQ, &queued) == 0
+    && queued > 0 )
+    return uInt64(queued);
+#endif
+
+  return 0;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::repaintTerminal() noexcept
+{
+  // Marks all characters of the virtual terminal for the next update
+
+  if ( ! vterm || vterm->data.empty() )
+    return;
+
+  const auto xmax = vterm->size.width - 1;
+  const auto ymax = vterm->size.height - 1;
+
+  for (auto& fchar : vterm->data)
+    fchar.unsetBit(FAttribute::unset::no_changes);
+
+  vterm->addBlockChanges (FRect{FPoint{0, 0}, FPoint{xmax, ymax}});
+  vterm->changes_in_row = {0, uInt(ymax)};
+  vterm->has_changes = true;
+  full_repaint = true;
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::getTimeStamp() noexcept -> uInt64
+{
+  return uInt64(duration_cast<microseconds>( clock::now()
+                                            .time_since_epoch()).count() );
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutput::markAsPrinted (uInt x, uInt y) const noexcept
+{
+  // Marks a character as printed
+
+  vterm->getFChar(int(x), int(y)).setBit(FAttribute::set::printed);
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutput::markAsPrinted (uInt from, uInt to, uInt y) const noexcept
+{
+  // Marks characters in the specified range [from .. to] as printed
+
+  auto iter = vterm->getFCharIterator(int(from), int(y));
+  const auto end = iter + to - from + 1;
+
+  // Unroll the loop for better performance
+  while ( iter + 4 <= end )
+  {
+    iter[0].setBit(FAttribute::set::printed);
+    iter[1].setBit(FAttribute::set::printed);
+    iter[2].setBit(FAttribute::set::printed);
+    iter[3].setBit(FAttribute::set::printed);
+    iter += 4;
+  }
+
+  // Handle the remaining elements
+  while ( iter < end )
+  {
+    iter->setBit(FAttribute::set::printed);
+    ++iter;
+  }
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutput::newFontChanges (FChar& next_char) const
+{
+  // NewFont special cases
+  if ( ! internal::var::is_new_font )
+    return;
+
+  if ( next_char.ch.unicode_data[0] == UniChar::LowerHalfBlock )
+  {
+    next_char.ch[0] = wchar_t(UniChar::UpperHalfBlock);
+    next_char.setBit(FAttribute::set::reverse);
+  }
+  else if ( isReverseNewFontchar(next_char.ch.unicode_data[0]) )
     next_char.setBit(FAttribute::set::reverse);  // Show in reverse video
 }
 
 //----------------------------------------------------------------------
-inline void FTermOutput::charsetChanges (FChar& next_char) const
+inline void FTermOutput::charsetChanges (FChar& next_char)
 {
   if ( internal::terminal::encoding == Encoding::UTF8 )
     return;
 
+  const auto& ch = next_char.ch.unicode_data[0];
+  auto& first_enc_char = getEncodedChar(next_char);
+#if defined(F_COMPACT_FCHAR)
+  // Only the first code point is encoded for output
+  first_enc_char = ch;
+#else
   std::memcpy( next_char.encoded_char.data(),
                next_char.ch.data(),
                sizeof(wchar_t) * UNICODE_MAX );
-
-  const auto& ch = next_char.ch.unicode_data[0];
+#endif
   const auto& ch_enc = FTerm::charEncode(ch);
 
   if ( ch_enc == ch )
     return;
 
-  auto& first_enc_char = next_char.encoded_char.unicode_data[0];
-
   if ( ch_enc == 0 )
   {
     first_enc_char = wchar_t(FTerm::charEncode(ch, Encoding::ASCII));
@@ -1261,6 +2309,19 @@ inline void FTermOutput::charsetChanges (FChar& next_char) const
   }
 }
 
+//----------------------------------------------------------------------
+inline auto FTermOutput::getEncodedChar (FChar& fchar) noexcept -> wchar_t&
+{
+#if defined(F_COMPACT_FCHAR)
+  // The compact cell layout has no encoded character field,
+  // so the encoded character is computed per output character
+  (void)fchar;
+  return encoded_char;
+#else
+  return fchar.encoded_char.unicode_data[0];
+#endif
+}
+
 //----------------------------------------------------------------------
 inline void FTermOutput::appendCharacter (const FChar_iterator& next_char_iter)
 {
@@ -1307,13 +2368,31 @@ inline void FTermOutput::appendChar (FChar& next_char)
   else  // ASCII, VT100, or PC encoding
   {
     appendOutputBuffer ( FOutputBuffer::OutputType::String
-                       , reinterpret_cast<char*>(&next_char.encoded_char.unicode_data[0])
+                       , reinterpret_cast<char*>(&getEncodedChar(next_char))
                        , 1 );
   }
 }
 
 //----------------------------------------------------------------------
 inline void FTermOutput::appendAttributes (FChar& next_attr)
+{
+  if ( ! basic_colors )
+  {
+    appendAttributeChange (next_attr);
+    return;
+  }
+
+  // Limits the color changes on a slow connection to the 16 basic
+  // colors, but keeps the colors of the virtual terminal unchanged
+  const auto color = next_attr.color;
+  next_attr.color = FCellColor{ reduceToBasicColor(color.getFgColor())
+                              , reduceToBasicColor(color.getBgColor()) };
+  appendAttributeChange (next_attr);
+  next_attr.color = color;
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutput::appendAttributeChange (FChar& next_attr)
 {
   // generate attribute string for the next character
 
@@ -1323,6 +2402,10 @@ inline void FTermOutput::appendAttributes (FChar& next_attr)
 
   static auto& opti_attr = FOptiAttr::getInstance();
   const auto change_attribute = opti_attr.changeAttribute (term_attribute, next_attr);
+#if defined(F_COMPACT_FCHAR)
+  if ( opti_attr.isInvisibleSimulated(next_attr) )
+    getEncodedChar(next_attr) = L' ';
+#endif
 
   if ( ! change_attribute.data )
     return;
@@ -1366,7 +2449,7 @@ void FTermOutput::appendLowerRight (const FChar_iterator& last_char_iter)
     if ( IC.data )
     {
       const auto term_ctrl = FTermcap::encodeParameter(IC, 1);
-      appendOutputBuffer (FTermControl{term_ctrl});
+      appendOutputBuffer (FTermControl{{term_ctrl.data(), uInt32(term_ctrl.length())}});
       appendChar (*second_last);
     }
     else if ( im.data && ei.data )
@@ -1397,7 +2480,7 @@ inline void FTermOutput::characterFilter (FChar& next_char)
     return;
 
   static const auto& sub_map = getFTerm().getCharSubstitutionMap();
-  auto& first_enc_char = next_char.encoded_char.unicode_data[0];
+  auto& first_enc_char = getEncodedChar(next_char);
   const auto& entry = sub_map.getMappedChar(first_enc_char);
 
   if ( entry )
@@ -1416,7 +2499,7 @@ inline auto FTermOutput::moveCursorLeft() -> CursorMoved
   else if ( LE.data )
   {
     const auto term_ctrl = FTermcap::encodeParameter(LE, 1);
-    appendOutputBuffer (FTermControl{term_ctrl});
+    appendOutputBuffer (FTermControl{{term_ctrl.data(), uInt32(term_ctrl.length())}});
   }
   else
     return CursorMoved::No;  // Cursor could not be moved
@@ -1427,7 +2510,16 @@ inline auto FTermOutput::moveCursorLeft() -> CursorMoved
 //----------------------------------------------------------------------
 inline void FTermOutput::checkFreeBufferSize()
 {
-  if ( output_buffer->slices.isFull() )
+  if ( ! output_buffer->slices.isFull() )
+    return;
+
+  if ( measuring_line )
+  {
+    // A trial encoding only counts its bytes
+    output_buffer->slices.clear();
+    output_buffer->data.clear();
+  }
+  else
     flush();
 }
 
@@ -1447,12 +2539,15 @@ inline void FTermOutput::appendOutputBuffer (wchar_t ucs)
 
   if ( ! slices.isEmpty() && last.type == type )
   {
-    last.length += output_buffer->data.appendUnicode(ucs);
+    const auto length = output_buffer->data.appendUnicode(ucs);
+    last.length += length;
+    queued_bytes += length;
   }
   else
   {
     const auto length = output_buffer->data.appendUnicode(ucs);
     slices.emplace(type, length);
+    queued_bytes += length;
     checkFreeBufferSize();
   }
 }
@@ -1468,20 +2563,214 @@ inline void FTermOutput::appendOutputBuffer ( FOutputBuffer::OutputType type
                                             , const char* data
                                             , uInt32 length )
 {
+  output_buffer->data.append(data, length);
+  addOutputSlice (type, length);
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutput::addOutputSlice ( FOutputBuffer::OutputType type
+                                        , uInt32 length )
+{
+  // Assigns the last appended bytes of the data buffer to a slice
+
   auto& slices = output_buffer->slices;
   auto& last = slices.back();
+  queued_bytes += length;
 
   if ( ! slices.isEmpty() && last.type == type )
   {
-    output_buffer->data.append(data, length);
     last.length += length;
   }
   else
   {
-    slices.emplace(type, uInt32(length));
-    output_buffer->data.append(data, length);
+    slices.emplace(type, length);
     checkFreeBufferSize();
   }
 }
 
+//----------------------------------------------------------------------
+void FTermOutput::printOutputBuffer()
+{
+  // Prints the output buffer via the C standard library
+
+  const auto* data_ptr = output_buffer->data.data();
+  std::size_t offset = 0;  // The read position in the string
+
+  while ( ! output_buffer->isEmpty() )
+  {
+    const auto& first = output_buffer->slices.front();
+    const auto& type = first.type;
+    const auto& length = first.length;
+
+    if ( type == FOutputBuffer::OutputType::String )
+      FTerm::stringPrint (data_ptr + offset, length);
+    else if ( type == FOutputBuffer::OutputType::Control )
+      FTerm::paddingPrint (data_ptr + offset, length);
+
+    offset += length;
+    output_buffer->slices.pop();
+  }
+
+  statistics.written_bytes += offset;
+  std::fflush(stdout);
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::writeOutputBuffer()
+{
+  // Writes the output buffer directly to the terminal file descriptor.
+  // Strings and padding-free control strings are gathered into one
+  // writev() call. Adjacent slices lie one after the other in the
+  // buffer and share an I/O vector. Control strings with padding
+  // continue to be printed by FTermcap because of their delays.
+
+  static const auto& fsystem = FSystem::getInstance();
+  static FSystem::IOVector iov{};
+  const auto fd = FTermios::getStdOut();
+  auto* data_ptr = const_cast<char*>(output_buffer->data.data());
+  std::size_t offset = 0;  // The read position in the string
+  iov.clear();
+  std::fflush(stdout);  // Keeps the order to earlier stdio output
+
+  while ( ! output_buffer->isEmpty() )
+  {
+    const auto& first = output_buffer->slices.front();
+    const auto& length = first.length;
+    auto* str = data_ptr + offset;
+
+    if ( first.type == FOutputBuffer::OutputType::Control
+      && FTermcap::hasPadding(str, length) )
+    {
+      if ( ! fsystem->writeAll (fd, iov) )
+        handleWriteErrors (1);
+
+      iov.clear();
+      FTerm::paddingPrint (str, length);
+      std::fflush(stdout);
+    }
+    else if ( ! iov.empty()
+           && static_cast<char*>(iov.back().iov_base) + iov.back().iov_len == str )
+      iov.back().iov_len += length;
+    else
+      iov.push_back({str, length});
+
+    offset += length;
+    output_buffer->slices.pop();
+  }
+
+  if ( ! fsystem->writeAll (fd, iov) )
+    handleWriteErrors (1);
+
+  statistics.written_bytes += offset;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::queueOutputBuffer()
+{
+  // Hands the output buffer over to the output thread. Control
+  // strings with padding need delays and are therefore written
+  // directly after all queued frames.
+
+  if ( hasPaddedControlString() )
+  {
+    output_writer->waitUntilIdle();
+    writeOutputBuffer();
+    return;
+  }
+
+  std::size_t length{0};
+
+  while ( ! output_buffer->isEmpty() )
+  {
+    length += output_buffer->slices.front().length;
+    output_buffer->slices.pop();
+  }
+
+  output_frame.assign(output_buffer->data.data(), length);
+  output_writer->push(output_frame);  // Returns an empty string
+  statistics.written_bytes += length;
+  const auto errors = output_writer->getWriteErrors();
+
+  if ( errors != writer_errors )
+  {
+    handleWriteErrors (errors - writer_errors);
+    writer_errors = errors;
+  }
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::handleWriteErrors (uInt64 count)
+{
+  // Data that could not be written leaves the terminal screen in an
+  // unknown state. The next update therefore repaints the whole screen.
+
+  statistics.write_errors += count;
+  write_failed = true;
+  repaintTerminal();
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::restoreTerminalState()
+{
+  // Brings the terminal into a known state after a failed write
+
+  const auto& me = TCAP(t_exit_attribute_mode);
+
+  if ( me.data )
+    appendOutputBuffer (FTermControl{me});
+
+  clearTerminalState();
+  term_pos->setPoint(-1, -1);  // Force an absolute cursor movement
+  write_failed = false;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::hasPaddedControlString() const -> bool
+{
+  const auto* data_ptr = output_buffer->data.data();
+  std::size_t offset = 0;
+
+  for (const auto& slice : output_buffer->slices)
+  {
+    if ( slice.type == FOutputBuffer::OutputType::Control
+      && FTermcap::hasPadding(data_ptr + offset, slice.length) )
+      return true;
+
+    offset += slice.length;
+  }
+
+  return false;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::writeOrQueueOutputBuffer()
+{
+  // Writes the output buffer to the terminal or hands it over
+  // to the output thread
+
+  static const auto& fsystem = FSystem::getInstance();
+
+  if ( output_writer )
+    queueOutputBuffer();
+  else if ( fsystem->getOutputMode() == FSystem::OutputMode::Direct )
+    writeOutputBuffer();
+  else
+    printOutputBuffer();
+
+  output_buffer->data.clear();
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::waitForOutputThread()
+{
+  // Direct terminal output must not overtake the buffered
+  // or the queued frames
+
+  if ( output_buffer && ! output_buffer->isEmpty() )
+    writeOrQueueOutputBuffer();
+
+  if ( output_writer )
+    output_writer->waitUntilIdle();
+}
+
 }  // namespace finalcut
@@ -44,8 +44,10 @@
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "final/output/foutput.h"
+#include "final/output/tty/fbandwidthmonitor.h"
 #include "final/output/tty/fterm.h"
 #include "final/util/char_ringbuffer.h"
 
@@ -63,6 +65,7 @@ struct terminal
 }  // namespace internal
 
 // class forward declaration
+class FOutputWriter;
 class FStartOptions;
 class FTermData;
 template <typename T, std::size_t Capacity>
@@ -89,6 +92,11 @@ class FCharBuffer
       return UTF8::encode(ucs, buffer);
     }
 
+    inline char* data() noexcept
+    {
+      return buffer.data();
+    }
+
     inline const char* data() const noexcept
     {
       return buffer.data();
@@ -166,6 +174,38 @@ struct FOutputBuffer
 class FTermOutput final : public FOutput
 {
   public:
+    // Using-declaration
+    using OutputQuality = FBandwidthMonitor::Quality;
+
+    // Enumeration
+    enum class PresentationPolicy : uInt8
+    {
+      Adaptive,     // Flush interval follows the update rate (default)
+      FixedRate,    // Flush at most with the set frame rate
+      LatencyFirst  // Flush every update immediately (e.g. input echo)
+    };
+
+    struct FOutputStatistics
+    {
+      uInt64 frames{0};              // Number of terminal updates
+      uInt64 frame_bytes{0};         // Bytes queued by the last update
+      uInt64 total_frame_bytes{0};   // Bytes queued by all updates
+      uInt64 written_bytes{0};       // Bytes written to the terminal
+      uInt64 write_errors{0};        // Failed terminal writes
+      uInt64 compose_time_us{0};     // Composition time of the last update
+      uInt64 encode_time_us{0};      // Encoding time of the last update
+      uInt64 write_time_us{0};       // Time of the last terminal write
+      uInt64 run_line_bytes{0};      // Bytes of run-optimized lines of the last update
+      uInt64 rewrite_line_bytes{0};  // Bytes of rewritten lines of the last update
+      uInt64 erase_line_bytes{0};    // Bytes of erased and sparse lines of the last update
+      uInt64 shift_bytes{0};         // Bytes of line shifts of the last update
+      uInt64 shifted_lines{0};       // Lines moved by the last update
+      uInt64 shifted_blocks{0};      // Blocks moved by the last update
+      uInt64 throughput{0};          // Achieved bytes per second of the terminal writes
+      uInt   link_load{0};           // Busy share of the terminal connection in percent
+      uInt64 quality_changes{0};     // Number of output quality changes
+    };
+
     // Constructor
     FTermOutput() = default;
 
@@ -183,6 +223,11 @@ class FTermOutput final : public FOutput
     auto getMaxColor() const -> int override;
     auto getEncoding() const -> Encoding override;
     auto getKeyName (FKey) const -> FString override;
+    auto getStatistics() const noexcept -> const FOutputStatistics&;
+    auto getPresentationPolicy() const noexcept -> PresentationPolicy;
+    auto getFrameRate() const noexcept -> uInt;
+    auto getOutputQuality() const noexcept -> OutputQuality;
+    auto getQualityThreshold() const noexcept -> uInt;
 
     // Mutators
     void setCursor (FPoint) override;
@@ -193,6 +238,19 @@ class FTermOutput final : public FOutput
     auto setVGAFont() -> bool override;
     auto setNewFont() -> bool override;
     void setNonBlockingRead (bool = true) override;
+    void setPresentationPolicy (PresentationPolicy) noexcept;
+    void setFrameRate (uInt) noexcept;
+    void setSynchronizedOutput (bool = true) noexcept;
+    void unsetSynchronizedOutput() noexcept;
+    void setFramePlanner (bool = true) noexcept;
+    void unsetFramePlanner() noexcept;
+    void setTextRuns (bool = true) noexcept;
+    void unsetTextRuns() noexcept;
+    void setOutputThread (bool = true);
+    void unsetOutputThread();
+    void setAdaptiveQuality (bool = true);
+    void unsetAdaptiveQuality();
+    void setQualityThreshold (uInt) noexcept;
 
     // Predicates
     auto isCursorHideable() const noexcept -> bool override;
@@ -200,6 +258,11 @@ class FTermOutput final : public FOutput
     auto isNewFont() const -> bool override;
     auto isEncodable (const wchar_t&) const -> bool override;
     auto isFlushTimeout() const noexcept -> bool override;
+    auto hasSynchronizedOutput() const noexcept -> bool;
+    auto hasFramePlanner() const noexcept -> bool;
+    auto hasTextRuns() const noexcept -> bool;
+    auto hasOutputThread() const noexcept -> bool;
+    auto hasAdaptiveQuality() const noexcept -> bool;
     auto hasTerminalResized() const -> bool override;
     auto allowsTerminalSizeManipulation() const -> bool override;
     auto canChangeColorPalette() const -> bool override;
@@ -216,11 +279,13 @@ class FTermOutput final : public FOutput
     void initScreenSettings() override;
     auto scrollTerminalForward() -> bool override;
     auto scrollTerminalReverse() -> bool override;
+    auto scrollTerminalLines (int, int, int) -> bool override;
     void clearTerminalAttributes() override;
     void clearTerminalState() override;
     auto clearTerminal (wchar_t = L' ') -> bool override;
     void flush() override;
-    void beep() const override;
+    void beep() override;
+    void resetStatistics() noexcept;
 
   private:
     // Constants
@@ -247,11 +312,44 @@ class FTermOutput final : public FOutput
 
     enum class CursorMoved : bool { No, Yes };
 
+    enum class LineStrategy : uInt8
+    {
+      Runs,     // Greedy optimization of each character run
+      Rewrite,  // Output of all characters in the change range
+      Erase     // Clear to end of line and print the remaining characters
+    };
+
+    struct LineShift
+    {
+      int top{0};       // First line of the block
+      int bottom{0};    // Last line of the block
+      int distance{0};  // > 0 = up, < 0 = down
+    };
+
+    struct LineState
+    {
+      std::vector<FChar>                chars{};
+      FVTerm::FTermRegion::FLineChanges changes{};
+      FPoint                            cursor{};
+      FChar                             attribute{};
+    };
+
     // Constants
     //   Upper and lower flush limit
     static constexpr uInt64 MIN_FLUSH_WAIT   = 16'667;   //  16.6 ms = 60 Hz
     static constexpr uInt64 MAX_FLUSH_WAIT   = 200'000;  // 200.0 ms = 5 Hz
     static constexpr uInt64 RESET_THRESHOLD  = 400'000;  // 400.0 ms = 2.5 Hz
+    //   Flush limits of the reduced output qualities
+    static constexpr uInt64 REDUCED_FLUSH_WAIT     = 100'000;    // 100 ms
+    static constexpr uInt64 MAX_DEGRADED_FLUSH_WAIT = 1'000'000;  //   1 s
+    //   Frame rates of the fixed rate policy
+    static constexpr uInt   MIN_FRAME_RATE     = 1;
+    static constexpr uInt   MAX_FRAME_RATE     = 1'000;
+    static constexpr uInt   DEFAULT_FRAME_RATE = 60;
+    //   Maximum line distance of a block shift
+    static constexpr int    MAX_LINE_SHIFT     = 16;
+    //   Maximum number of block shifts per update
+    static constexpr int    MAX_SHIFTED_BLOCKS = 4;
 
     // Using-declaration
     using clock = std::chrono::steady_clock;
@@ -269,10 +367,12 @@ class FTermOutput final : public FOutput
     void restoreColorPalette() override;
     void init_characterLengths();
     void init_combined_character();
+    void init_synchronized_output();
     auto canClearToEOL (uInt, uInt) const -> bool;
     auto canClearLeadingWS (uInt&, uInt) const -> bool;
     auto canClearTrailingWS (uInt&, uInt) const -> bool;
     auto skipUnchangedCharacters (uInt&, uInt, uInt, FChar_iterator) -> bool;
+    auto isPrintOverCheaper (uInt, uInt, uInt, FChar_const_iterator) const -> bool;
     void printRange (uInt, uInt, uInt);
     void replaceNonPrintableFullwidth (uInt, uInt, FChar&) const noexcept;
     void printCharacter (uInt&, uInt, bool, const FChar_iterator&);
@@ -283,6 +383,10 @@ class FTermOutput final : public FOutput
     void skipPaddingCharacter (uInt&, uInt, const FChar&) const noexcept;
     auto eraseCharacters (uInt&, uInt, uInt, const FChar_iterator&) -> PrintState;
     auto repeatCharacter (uInt&, uInt, uInt, const FChar_iterator&) -> PrintState;
+    auto printTextRun (uInt&, uInt, uInt, const FChar_iterator&) -> bool;
+    auto canPrintTextRun() const noexcept -> bool;
+    auto isTextRunCharacter (uInt, uInt, uInt, FChar_const_iterator) const noexcept -> bool;
+    static auto getUTF8Length (wchar_t) noexcept -> uInt32;
     auto countRepetitions (FChar_const_iterator, uInt, uInt) const noexcept -> uInt;
     auto canUseEraseCharacters (const FChar&, uInt) const noexcept -> bool;
     auto canUseCharacterRepetitions (const FChar&, uInt) const noexcept -> bool;
@@ -292,16 +396,46 @@ class FTermOutput final : public FOutput
     void cursorWrap() const noexcept;
     void adjustCursorPosition (FPoint&) const noexcept;
     auto updateTerminalLine (uInt) -> bool;
+    void printLineRuns (uInt);
+    void rewriteLine (uInt);
+    void eraseLine (uInt);
+    void encodeLine (LineStrategy, uInt);
+    auto planLine (uInt) -> LineStrategy;
+    auto measureLine (LineStrategy, uInt) -> uInt64;
+    void saveLineState (uInt);
+    void restoreLineState (uInt);
+    auto hasUnchangedCharacters (uInt, uInt, uInt) const -> bool;
+    auto canEraseLine (uInt, uInt) const -> bool;
+    auto getEraseLowerBound (uInt, uInt) const -> uInt64;
+    void addLineStatistics (LineStrategy, uInt64) noexcept;
+    void shiftTerminalBlocks();
+    void updateLineHashes (int, int);
+    auto findLineShift (int, int) const -> LineShift;
+    auto findHashShift (int, int, int) const noexcept -> int;
+    auto getShiftSequence (const LineShift&) -> std::string;
+    auto getInsertDeleteSequence (const LineShift&) -> std::string;
+    auto getScrollRegionSequence (const LineShift&) const -> std::string;
+    auto getLineShiftGain (const LineShift&) const -> uInt64;
+    static auto getChangeCount (const FChar*, const FChar*, std::size_t) noexcept -> uInt64;
+    static auto getLineHash (const FChar*, std::size_t) noexcept -> uInt64;
     auto updateTerminalCursor() -> bool;
     void flushTimeAdjustment() noexcept;
+    void updateOutputQuality();
+    void applyOutputQuality (OutputQuality);
+    auto getQualityFlushWait() const noexcept -> uInt64;
+    auto getTerminalQueueDepth() const -> uInt64;
+    void repaintTerminal() noexcept;
+    static auto getTimeStamp() noexcept -> uInt64;
     void markAsPrinted (uInt, uInt) const noexcept;
     void markAsPrinted (uInt, uInt, uInt) const noexcept;
     void newFontChanges (FChar&) const;
-    void charsetChanges (FChar&) const;
+    void charsetChanges (FChar&);
+    auto getEncodedChar (FChar&) noexcept -> wchar_t&;
     void appendCharacter (const FChar_iterator&);
     void appendCharacter_n (const FChar_iterator&, uInt);
     void appendChar (FChar&);
     void appendAttributes (FChar&);
+    void appendAttributeChange (FChar&);
     void appendLowerRight (const FChar_iterator&);
     void characterFilter (FChar&);
     auto moveCursorLeft() -> CursorMoved;
@@ -310,14 +444,32 @@ class FTermOutput final : public FOutput
     void appendOutputBuffer (wchar_t);
     void appendOutputBuffer (const UniChar&);
     void appendOutputBuffer (FOutputBuffer::OutputType, const char*, uInt32);
+    void addOutputSlice (FOutputBuffer::OutputType, uInt32);
+    void printOutputBuffer();
+    void writeOutputBuffer();
+    void queueOutputBuffer();
+    void handleWriteErrors (uInt64);
+    void restoreTerminalState();
+    auto hasPaddedControlString() const -> bool;
+    void writeOrQueueOutputBuffer();
+    void waitForOutputThread();
 
     // Data members
     FTerm                          fterm{};
     static FVTerm::FTermRegion*    vterm;
     static FTermData*              fterm_data;
     std::shared_ptr<FOutputBuffer> output_buffer{};
+    std::shared_ptr<FOutputBuffer> scratch_buffer{};  // Measures line strategies
+    std::vector<uInt64>            line_hashes{};      // Hash values of the vterm lines
+    std::vector<uInt64>            old_line_hashes{};  // Hash values of the last lines
+    std::unique_ptr<FOutputWriter> output_writer{};    // Optional output thread
+    std::string                    output_frame{};     // Next frame of the output thread
+    FBandwidthMonitor              bandwidth_monitor{};
     std::shared_ptr<FPoint>        term_pos{};  // terminal cursor position
     FChar                          term_attribute{};
+#if defined(F_COMPACT_FCHAR)
+    wchar_t                        encoded_char{L'\0'};  // Lazily encoded
+#endif
     bool                           cursor_hideable{false};
     bool                           combined_char_support{false};
     uInt                           erase_char_length{};
@@ -325,10 +477,28 @@ class FTermOutput final : public FOutput
     uInt                           clr_bol_length{};
     uInt                           clr_eol_length{};
     uInt                           cursor_address_length{};
+    uInt64                         queued_bytes{};  // Monotonic byte counter
+    uInt64                         writer_bytes{};    // Last byte count of the output thread
+    uInt64                         writer_time_us{};  // Last write time of the output thread
+    uInt64                         writer_errors{};   // Last error count of the output thread
+    int                            line_baudrate{};   // Baud rate before the degradation
+    FOutputStatistics              statistics{};
     uInt64                         time_last_flush_us{};
     uInt64                         flush_wait{MIN_FLUSH_WAIT};
     uInt64                         flush_average{MIN_FLUSH_WAIT};
     uInt64                         flush_median{MIN_FLUSH_WAIT};
+    uInt64                         frame_interval{1'000'000 / DEFAULT_FRAME_RATE};
+    PresentationPolicy             presentation_policy{PresentationPolicy::Adaptive};
+    bool                           synchronized_output{false};
+    bool                           frame_planner{false};
+    bool                           measuring_line{false};  // Trial encoding
+    bool                           text_runs{true};
+    bool                           adaptive_quality{false};
+    bool                           basic_colors{false};  // Minimal output quality
+    bool                           write_failed{false};  // Terminal state unknown
+    bool                           full_repaint{false};  // Ignore the last frame
+    OutputQuality                  output_quality{OutputQuality::Full};
+    LineState                      saved_line{};
 };
 
 // FTermOutput inline functions
@@ -340,6 +510,30 @@ inline auto FTermOutput::getClassName() const -> FString
 inline auto FTermOutput::getFTerm() noexcept -> FTerm&
 { return fterm; }
 
+//----------------------------------------------------------------------
+inline auto FTermOutput::getStatistics() const noexcept -> const FOutputStatistics&
+{ return statistics; }
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::getPresentationPolicy() const noexcept -> PresentationPolicy
+{ return presentation_policy; }
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::getFrameRate() const noexcept -> uInt
+{ return uInt(1'000'000 / frame_interval); }
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::getOutputQuality() const noexcept -> OutputQuality
+{ return output_quality; }
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::getQualityThreshold() const noexcept -> uInt
+{ return bandwidth_monitor.getThreshold(); }
+
+//----------------------------------------------------------------------
+inline void FTermOutput::resetStatistics() noexcept
+{ statistics = {}; }
+
 //----------------------------------------------------------------------
 inline auto FTermOutput::getColumnNumber() const -> std::size_t
 { return FTerm::getColumnNumber(); }
@@ -380,6 +574,46 @@ inline auto FTermOutput::setVGAFont() -> bool
 inline auto FTermOutput::setNewFont() -> bool
 { return FTerm::setNewFont(); }
 
+//----------------------------------------------------------------------
+inline void FTermOutput::setPresentationPolicy (PresentationPolicy policy) noexcept
+{ presentation_policy = policy; }
+
+//----------------------------------------------------------------------
+inline void FTermOutput::setSynchronizedOutput (bool enable) noexcept
+{ synchronized_output = enable; }
+
+//----------------------------------------------------------------------
+inline void FTermOutput::unsetSynchronizedOutput() noexcept
+{ setSynchronizedOutput(false); }
+
+//----------------------------------------------------------------------
+inline void FTermOutput::setFramePlanner (bool enable) noexcept
+{ frame_planner = enable; }
+
+//----------------------------------------------------------------------
+inline void FTermOutput::unsetFramePlanner() noexcept
+{ setFramePlanner(false); }
+
+//----------------------------------------------------------------------
+inline void FTermOutput::setTextRuns (bool enable) noexcept
+{ text_runs = enable; }
+
+//----------------------------------------------------------------------
+inline void FTermOutput::unsetTextRuns() noexcept
+{ setTextRuns(false); }
+
+//----------------------------------------------------------------------
+inline void FTermOutput::unsetOutputThread()
+{ setOutputThread(false); }
+
+//----------------------------------------------------------------------
+inline void FTermOutput::unsetAdaptiveQuality()
+{ setAdaptiveQuality(false); }
+
+//----------------------------------------------------------------------
+inline void FTermOutput::setQualityThreshold (uInt percent) noexcept
+{ bandwidth_monitor.setThreshold(percent); }
+
 //----------------------------------------------------------------------
 inline auto FTermOutput::isCursorHideable() const noexcept -> bool
 { return cursor_hideable; }
@@ -395,6 +629,26 @@ inline auto FTermOutput::isNewFont() const -> bool
 inline auto FTermOutput::isEncodable (const wchar_t& wide_char) const -> bool
 { return FTerm::isEncodable(wide_char); }
 
+//----------------------------------------------------------------------
+inline auto FTermOutput::hasSynchronizedOutput() const noexcept -> bool
+{ return synchronized_output; }
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::hasFramePlanner() const noexcept -> bool
+{ return frame_planner; }
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::hasTextRuns() const noexcept -> bool
+{ return text_runs; }
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::hasOutputThread() const noexcept -> bool
+{ return bool(output_writer); }
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::hasAdaptiveQuality() const noexcept -> bool
+{ return adaptive_quality; }
+
 //----------------------------------------------------------------------
 inline auto FTermOutput::hasTerminalResized() const -> bool
 { return FTerm::hasChangedTermSize(); }
@@ -433,11 +687,18 @@ inline void FTermOutput::initScreenSettings()
 
 //----------------------------------------------------------------------
 inline void FTermOutput::clearTerminalAttributes()
-{ FTerm::clearTerminalAttributes(); }
+{
+  waitForOutputThread();
+  FTerm::clearTerminalAttributes();
+}
 
 //----------------------------------------------------------------------
-inline void FTermOutput::beep() const
-{ return FTerm::beep(); }
+inline void FTermOutput::beep()
+{
+  // The bell must not overtake the buffered output
+  waitForOutputThread();
+  FTerm::beep();
+}
 
 //----------------------------------------------------------------------
 inline auto FTermOutput::getFSetPaletteRef() const & -> const FSetPalette&
@@ -0,0 +1,380 @@
+/***********************************************************************
+* ftermprobe.cpp - Pipelined query of the terminal capabilities        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <sys/select.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "final/fc.h"
+#include "final/output/tty/ftermdata.h"
+#include "final/output/tty/ftermios.h"
+#include "final/output/tty/ftermprobe.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+//----------------------------------------------------------------------
+inline auto getMultiplexerPrefix() -> const char*
+{
+  // The font query is passed through screen and tmux
+  // to the outer terminal
+
+  static const auto& fterm_data = FTermData::getInstance();
+
+  if ( fterm_data.isTermType(FTermType::tmux) )
+    return ESC "Ptmux;" ESC;  // tmux device control string
+
+  if ( fterm_data.isTermType(FTermType::screen) )
+    return ESC "P";  // GNU Screen device control string
+
+  return "";
+}
+
+//----------------------------------------------------------------------
+inline auto getMultiplexerPostfix() -> const char*
+{
+  static const auto& fterm_data = FTermData::getInstance();
+
+  if ( fterm_data.isTermType(FTermType::screen | FTermType::tmux) )
+    return ESC "\\";  // GNU Screen/tmux string terminator
+
+  return "";
+}
+
+}  // namespace internal
+
+// static class attributes
+constexpr uInt64      FTermProbe::DEFAULT_TIMEOUT;
+constexpr std::size_t FTermProbe::MAX_REPLY_SIZE;
+
+//----------------------------------------------------------------------
+// class FTermProbe
+//----------------------------------------------------------------------
+
+// public methods of FTermProbe
+//----------------------------------------------------------------------
+auto FTermProbe::getRequest() const -> std::string
+{
+  // All queries in one string, terminated by the DA1 sentinel
+
+  std::string request{};
+
+  if ( hasQuery(Query::Answerback) )
+    request += ENQ;
+
+  if ( hasQuery(Query::SecondaryDA) )
+    request += CSI ">c";
+
+  if ( hasQuery(Query::XTVersion) )
+    request += CSI ">0q";
+
+  if ( hasQuery(Query::SyncOutput) )
+    request += CSI "?2026$p";
+
+  if ( hasQuery(Query::XTermTitle) )
+    request += CSI "21t";
+
+  if ( hasQuery(Query::XTermFont) )
+  {
+    // A multiplexer forwards the font query to the outer terminal.
+    // The sentinel takes the same way, so that it is answered
+    // after the font query.
+    const std::string prefix{internal::getMultiplexerPrefix()};
+    const std::string postfix{internal::getMultiplexerPostfix()};
+    request += prefix + OSC "50;?" BEL + postfix;
+    request += prefix + CSI "c" + postfix;
+  }
+  else
+    request += CSI "c";
+
+  return request;
+}
+
+//----------------------------------------------------------------------
+auto FTermProbe::run() -> bool
+{
+  // Sends the request and reads the responses until
+  // the DA1 sentinel arrives or the time is up
+
+  using namespace std::chrono;
+  const auto request = getRequest();
+  const auto stdin_no = FTermios::getStdIn();
+  const auto start = steady_clock::now();
+  std::fflush(stdout);
+
+  if ( write(FTermios::getStdOut(), request.data(), request.length()) == -1 )
+    return false;
+
+  std::array<char, 512> buffer{};
+
+  while ( ! complete )
+  {
+    const auto elapsed = duration_cast<microseconds>(steady_clock::now() - start);
+    const auto elapsed_us = uInt64(elapsed.count());
+
+    if ( elapsed_us >= timeout )
+      break;
+
+    const auto remaining_us = timeout - elapsed_us;
+    fd_set ifds{};
+    struct timeval tv{};
+    FD_ZERO(&ifds);
+    FD_SET(stdin_no, &ifds);
+    tv.tv_sec  = time_t(remaining_us / 1'000'000);
+    tv.tv_usec = suseconds_t(remaining_us % 1'000'000);
+    const int result = select (stdin_no + 1, &ifds, nullptr, nullptr, &tv);
+
+    if ( result < 0 && errno == EINTR )
+      continue;
+
+    if ( result < 1 )
+      break;
+
+    const ssize_t bytes = read(stdin_no, buffer.data(), buffer.size());
+
+    if ( bytes <= 0 )
+      break;
+
+    parse (buffer.data(), std::size_t(bytes));
+  }
+
+  const auto duration = duration_cast<microseconds>(steady_clock::now() - start);
+  round_trip_time = uInt64(duration.count());
+  return complete;
+}
+
+//----------------------------------------------------------------------
+auto FTermProbe::parse (const char* data, std::size_t length) -> bool
+{
+  // Processes the received bytes and returns true
+  // when the sentinel has been received
+
+  if ( complete || ! data )
+    return complete;
+
+  if ( input.length() + length > MAX_REPLY_SIZE )
+    input.clear();  // Discard an unusable response
+
+  input.append(data, std::min(length, MAX_REPLY_SIZE));
+  std::size_t pos{0};
+
+  while ( pos < input.length() && ! complete )
+  {
+    if ( input[pos] == ESC[0] )
+    {
+      const auto length_of_sequence = parseSequence(pos);
+
+      if ( length_of_sequence == 0 )
+        break;  // Incomplete sequence, wait for more data
+
+      pos += length_of_sequence;
+    }
+    else
+    {
+      const auto end = std::min(input.find(ESC[0], pos), input.length());
+      parseAnswerback (pos, end);
+      pos = end;
+    }
+  }
+
+  input.erase(0, pos);
+  return complete;
+}
+
+//----------------------------------------------------------------------
+void FTermProbe::clear()
+{
+  const auto query_list = queries;
+  const auto timeout_us = timeout;
+  *this = {};
+  queries = query_list;
+  timeout = timeout_us;
+}
+
+
+// private methods of FTermProbe
+//----------------------------------------------------------------------
+auto FTermProbe::parseSequence (std::size_t pos) -> std::size_t
+{
+  if ( pos + 1 >= input.length() )
+    return 0;
+
+  const auto type = input[pos + 1];
+
+  if ( type == '[' )  // Control sequence introducer
+    return parseCSI(pos);
+
+  if ( type == ']' || type == 'P' )  // Operating system command or DCS
+    return parseString(pos);
+
+  return 2;  // Skip unknown escape sequences
+}
+
+//----------------------------------------------------------------------
+auto FTermProbe::parseCSI (std::size_t pos) -> std::size_t
+{
+  for (auto i = pos + 2; i < input.length(); i++)
+  {
+    const auto ch = uChar(input[i]);
+
+    if ( ch == uChar(ESC[0]) )
+      return i - pos;  // Discard an interrupted sequence
+
+    if ( ch < 0x40 || ch > 0x7e )
+      continue;  // Parameter or intermediate byte
+
+    const auto sequence = input.substr(pos, i - pos + 1);
+
+    if ( ch == 'c' )
+      handleDeviceAttributes(sequence);
+    else if ( ch == 'y' && input[i - 1] == '$' )
+      handleModeReport(sequence);
+
+    return sequence.length();
+  }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FTermProbe::parseString (std::size_t pos) -> std::size_t
+{
+  // Reads an OSC or DCS string up to the string terminator
+
+  for (auto i = pos + 2; i < input.length(); i++)
+  {
+    const auto ch = input[i];
+
+    if ( ch != BEL[0] && ch != ESC[0] )
+      continue;
+
+    std::size_t length = i - pos;
+
+    if ( ch == BEL[0] )
+      length++;
+    else if ( i + 1 >= input.length() )
+      return 0;  // Wait for the next byte
+    else if ( input[i + 1] == '\\' )
+      length += 2;  // ST = ESC + \ = string terminator
+
+    // Without a string terminator, the string
+    // ends with the next escape sequence
+    const auto body = input.substr(pos + 2, i - pos - 2);
+
+    if ( input[pos + 1] == ']' )
+      handleOSC(body);
+    else
+      handleDCS(body);
+
+    return length;
+  }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------
+void FTermProbe::parseAnswerback (std::size_t pos, std::size_t end)
+{
+  // The answerback message is the only response without
+  // an escape sequence and arrives first
+
+  if ( ! hasQuery(Query::Answerback)
+    || (replies & ~uInt8(Query::Answerback)) != 0 )
+    return;
+
+  answerback += FString(input.substr(pos, end - pos));
+  setReply (Query::Answerback);
+}
+
+//----------------------------------------------------------------------
+void FTermProbe::handleDeviceAttributes (const std::string& sequence)
+{
+  if ( sequence.length() > 2 && sequence[2] == '>' )
+  {
+    // Secondary device attributes (SEC_DA)
+    sec_da = sequence;
+    setReply (Query::SecondaryDA);
+    return;
+  }
+
+  // The primary device attributes (DA1) complete the probe.
+  // Terminals that answer the SEC_DA request with a copy of DA1
+  // leave the real DA1 response in the input queue.
+  complete = true;
+}
+
+//----------------------------------------------------------------------
+void FTermProbe::handleModeReport (const std::string& sequence)
+{
+  // DECRPM - CSI ? Pd ; Ps $ y
+
+  int mode{0};
+  int value{0};
+
+  if ( std::sscanf(sequence.c_str(), "\033[?%10d;%10d$y", &mode, &value) != 2 )
+    return;
+
+  if ( mode == 2026 )  // Synchronized output
+  {
+    sync_output_mode = value;
+    setReply (Query::SyncOutput);
+  }
+}
+
+//----------------------------------------------------------------------
+void FTermProbe::handleOSC (const std::string& body)
+{
+  if ( body.compare(0, 3, "50;") == 0 )
+  {
+    // Font name - OSC 50 ; Pt ST
+    xterm_font = body.substr(3);
+    setReply (Query::XTermFont);
+  }
+  else if ( body.compare(0, 1, "l") == 0 )
+  {
+    // Window title - OSC l Pt ST
+    xterm_title = body.substr(1);
+    setReply (Query::XTermTitle);
+  }
+}
+
+//----------------------------------------------------------------------
+void FTermProbe::handleDCS (const std::string& body)
+{
+  if ( body.compare(0, 2, ">|") == 0 )
+  {
+    // Terminal name and version - DCS > | Pt ST
+    xtversion = body.substr(2);
+    setReply (Query::XTVersion);
+  }
+}
+
+}  // namespace finalcut
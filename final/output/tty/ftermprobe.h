@@ -0,0 +1,200 @@
+/***********************************************************************
+* ftermprobe.h - Pipelined query of the terminal capabilities          *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FTermProbe ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+// The probe sends all queries in a single write, followed by a request
+// for the primary device attributes (DA1). Every terminal answers its
+// queries in the order received, and DA1 is answered by practically
+// all of them. The DA1 response therefore acts as a sentinel: When it
+// arrives, all other responses are in, and unanswered queries are not
+// supported. This replaces the individual fixed waiting times with a
+// single round trip. The timeout only applies to terminals that do not
+// respond to DA1.
+
+#ifndef FTERMPROBE_H
+#define FTERMPROBE_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <string>
+
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FTermProbe
+//----------------------------------------------------------------------
+
+class FTermProbe final
+{
+  public:
+    // Enumeration
+    enum class Query : uInt8
+    {
+      Answerback  = 0x01,  // ENQ
+      SecondaryDA = 0x02,  // CSI > c
+      XTVersion   = 0x04,  // CSI > 0 q
+      SyncOutput  = 0x08,  // CSI ? 2026 $ p (DECRQM)
+      XTermFont   = 0x10,  // OSC 50 ; ? BEL
+      XTermTitle  = 0x20   // CSI 21 t
+    };
+
+    // Constants
+    static constexpr uInt64 DEFAULT_TIMEOUT = 600'000;  // 600 ms
+    static constexpr std::size_t MAX_REPLY_SIZE = 4'096;
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getRequest() const -> std::string;
+    auto getTimeout() const noexcept -> uInt64;
+    auto getAnswerback() const & -> const FString&;
+    auto getSecDA() const & -> const FString&;
+    auto getXTVersion() const & -> const FString&;
+    auto getSyncOutputMode() const noexcept -> int;
+    auto getXTermFont() const & -> const FString&;
+    auto getXTermTitle() const & -> const FString&;
+    auto getRoundTripTime() const noexcept -> uInt64;
+
+    // Mutators
+    void addQuery (Query) noexcept;
+    void setTimeout (uInt64) noexcept;
+
+    // Inquiries
+    auto hasQuery (Query) const noexcept -> bool;
+    auto hasReply (Query) const noexcept -> bool;
+    auto hasSyncOutputSupport() const noexcept -> bool;
+    auto isComplete() const noexcept -> bool;
+
+    // Methods
+    auto run() -> bool;
+    auto parse (const char*, std::size_t) -> bool;
+    void clear();
+
+  private:
+    // Methods
+    auto parseSequence (std::size_t) -> std::size_t;
+    auto parseCSI (std::size_t) -> std::size_t;
+    auto parseString (std::size_t) -> std::size_t;
+    void parseAnswerback (std::size_t, std::size_t);
+    void handleDeviceAttributes (const std::string&);
+    void handleModeReport (const std::string&);
+    void handleOSC (const std::string&);
+    void handleDCS (const std::string&);
+    void setReply (Query) noexcept;
+
+    // Data members
+    std::string  input{};
+    FString      answerback{};
+    FString      sec_da{};
+    FString      xtversion{};
+    FString      xterm_font{};
+    FString      xterm_title{};
+    uInt64       timeout{DEFAULT_TIMEOUT};
+    uInt64       round_trip_time{0};
+    int          sync_output_mode{-1};  // -1 = no reply
+    uInt8        queries{0};
+    uInt8        replies{0};
+    bool         complete{false};
+};
+
+// FTermProbe inline functions
+//----------------------------------------------------------------------
+inline auto FTermProbe::getClassName() const -> FString
+{ return "FTermProbe"; }
+
+//----------------------------------------------------------------------
+inline auto FTermProbe::getTimeout() const noexcept -> uInt64
+{ return timeout; }
+
+//----------------------------------------------------------------------
+inline auto FTermProbe::getAnswerback() const & -> const FString&
+{ return answerback; }
+
+//----------------------------------------------------------------------
+inline auto FTermProbe::getSecDA() const & -> const FString&
+{ return sec_da; }
+
+//----------------------------------------------------------------------
+inline auto FTermProbe::getXTVersion() const & -> const FString&
+{ return xtversion; }
+
+//----------------------------------------------------------------------
+inline auto FTermProbe::getSyncOutputMode() const noexcept -> int
+{ return sync_output_mode; }
+
+//----------------------------------------------------------------------
+inline auto FTermProbe::getXTermFont() const & -> const FString&
+{ return xterm_font; }
+
+//----------------------------------------------------------------------
+inline auto FTermProbe::getXTermTitle() const & -> const FString&
+{ return xterm_title; }
+
+//----------------------------------------------------------------------
+inline auto FTermProbe::getRoundTripTime() const noexcept -> uInt64
+{ return round_trip_time; }
+
+//----------------------------------------------------------------------
+inline void FTermProbe::addQuery (Query query) noexcept
+{ queries |= uInt8(query); }
+
+//----------------------------------------------------------------------
+inline void FTermProbe::setTimeout (uInt64 timeout_us) noexcept
+{ timeout = timeout_us; }
+
+//----------------------------------------------------------------------
+inline auto FTermProbe::hasQuery (Query query) const noexcept -> bool
+{ return (queries & uInt8(query)) != 0; }
+
+//----------------------------------------------------------------------
+inline auto FTermProbe::hasReply (Query query) const noexcept -> bool
+{ return (replies & uInt8(query)) != 0; }
+
+//----------------------------------------------------------------------
+inline auto FTermProbe::hasSyncOutputSupport() const noexcept -> bool
+{
+  // DECRPM: 1 = set, 2 = reset, 3 = permanently set
+  return sync_output_mode >= 1 && sync_output_mode <= 3;
+}
+
+//----------------------------------------------------------------------
+inline auto FTermProbe::isComplete() const noexcept -> bool
+{ return complete; }
+
+//----------------------------------------------------------------------
+inline void FTermProbe::setReply (Query query) noexcept
+{ replies |= uInt8(query); }
+
+}  // namespace finalcut
+
+#endif  // FTERMPROBE_H
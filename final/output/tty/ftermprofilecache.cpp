@@ -0,0 +1,700 @@
+/***********************************************************************
+* ftermprofilecache.cpp - Persistent cache for the terminal profile    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <pwd.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "final/fc.h"
+#include "final/input/fkeyboard.h"
+#include "final/input/fkey_map.h"
+#include "final/output/tty/ftermcap.h"
+#include "final/output/tty/ftermdata.h"
+#include "final/output/tty/ftermdetection.h"
+#include "final/output/tty/ftermios.h"
+#include "final/output/tty/ftermprobe.h"
+#include "final/output/tty/ftermprofilecache.h"
+#include "final/util/fsystem.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+//----------------------------------------------------------------------
+inline auto getEnvironment (const char* name) -> std::string
+{
+  const auto* value = std::getenv(name);
+  return value ? value : "";
+}
+
+//----------------------------------------------------------------------
+auto getHomeDirectory() -> std::string
+{
+  auto home = getEnvironment("HOME");
+
+  if ( ! home.empty() )
+    return home;
+
+  struct passwd pwd{};
+  struct passwd* pwd_ptr{};
+  std::array<char, 1024> buf{};
+  const auto& fsystem = FSystem::getInstance();
+  const uid_t euid = fsystem->geteuid();
+
+  if ( fsystem->getpwuid_r(euid, &pwd, buf.data(), buf.size(), &pwd_ptr)
+    || ! pwd_ptr || ! pwd.pw_dir )
+    return {};
+
+  return pwd.pw_dir;
+}
+
+//----------------------------------------------------------------------
+auto getTerminfoFileName (const std::string& term) -> std::string
+{
+  // Searches the compiled terminfo file in the same directories
+  // as ncurses
+
+  if ( term.empty() || term.find('/') != std::string::npos )
+    return {};
+
+  std::vector<std::string> directories{};
+  const auto terminfo = getEnvironment("TERMINFO");
+  const auto home = getEnvironment("HOME");
+
+  if ( ! terminfo.empty() )
+    directories.emplace_back(terminfo);
+
+  if ( ! home.empty() )
+    directories.emplace_back(home + "/.terminfo");
+
+  std::istringstream terminfo_dirs{getEnvironment("TERMINFO_DIRS")};
+  std::string directory{};
+
+  while ( std::getline(terminfo_dirs, directory, ':') )
+    if ( ! directory.empty() )
+      directories.emplace_back(directory);
+
+  for (const auto& dir : { "/etc/terminfo", "/lib/terminfo"
+                         , "/usr/share/terminfo", "/usr/lib/terminfo"
+                         , "/usr/share/lib/terminfo" })
+    directories.emplace_back(dir);
+
+  // Subdirectory by the first letter or its hex code (macOS)
+  std::array<char, 3> hex{};
+  std::snprintf (hex.data(), hex.size(), "%02x", uInt(uChar(term[0])));
+  const std::array<std::string, 2> subdirectories{{ {term[0]}, hex.data() }};
+
+  for (const auto& dir : directories)
+  {
+    for (const auto& subdir : subdirectories)
+    {
+      auto file_name = dir + '/' + subdir + '/' + term;
+      struct stat file_stat{};
+
+      if ( stat(file_name.c_str(), &file_stat) == 0
+        && S_ISREG(file_stat.st_mode) )
+        return file_name;
+    }
+  }
+
+  return {};
+}
+
+//----------------------------------------------------------------------
+auto getModificationTime (const std::string& file_name) -> std::string
+{
+  struct stat file_stat{};
+
+  if ( file_name.empty() || stat(file_name.c_str(), &file_stat) != 0 )
+    return "0";
+
+  return std::to_string(file_stat.st_mtime);
+}
+
+//----------------------------------------------------------------------
+auto makeDirectory (const std::string& path) -> bool
+{
+  struct stat dir_stat{};
+
+  if ( stat(path.c_str(), &dir_stat) == 0 )
+    return S_ISDIR(dir_stat.st_mode);
+
+  return mkdir(path.c_str(), 0700) == 0;
+}
+
+//----------------------------------------------------------------------
+constexpr auto hashFNV1a (const char* str, uInt64 hash = 0xcbf29ce484222325) -> uInt64
+{
+  // 64-bit Fowler–Noll–Vo hash (FNV-1a)
+  return *str
+       ? hashFNV1a (str + 1, (hash ^ uInt64(uChar(*str))) * 0x100000001b3)
+       : hash;
+}
+
+//----------------------------------------------------------------------
+auto escape (const std::string& str) -> std::string
+{
+  // Control characters, the space and the backslash are stored
+  // as hex escapes, so each value is a single word in one line
+
+  std::string escaped{};
+  escaped.reserve(str.length());
+  std::array<char, 5> hex{};
+
+  for (const auto ch : str)
+  {
+    const auto uch = uChar(ch);
+
+    if ( uch <= 0x20 || uch == 0x7f || uch == '\\' )
+    {
+      std::snprintf (hex.data(), hex.size(), "\\x%02x", uInt(uch));
+      escaped += hex.data();
+    }
+    else
+      escaped += ch;
+  }
+
+  return escaped;
+}
+
+//----------------------------------------------------------------------
+auto unescape (const std::string& str) -> std::string
+{
+  std::string unescaped{};
+  unescaped.reserve(str.length());
+  std::size_t pos{0};
+
+  while ( pos < str.length() )
+  {
+    if ( str[pos] == '\\' && pos + 3 < str.length() && str[pos + 1] == 'x' )
+    {
+      unescaped += char(std::strtoul(str.substr(pos + 2, 2).c_str(), nullptr, 16));
+      pos += 4;
+    }
+    else
+    {
+      unescaped += str[pos];
+      pos++;
+    }
+  }
+
+  return unescaped;
+}
+
+//----------------------------------------------------------------------
+inline auto encodeCapability (const char* string) -> std::string
+{
+  // "-" = not available, "=" = string value
+  return string ? '=' + escape(string) : "-";
+}
+
+}  // namespace internal
+
+// static class attributes
+constexpr int FTermProfileCache::FORMAT_VERSION;
+
+
+//----------------------------------------------------------------------
+// class FTermProfileCache
+//----------------------------------------------------------------------
+
+// public methods of FTermProfileCache
+//----------------------------------------------------------------------
+auto FTermProfileCache::getInstance() -> FTermProfileCache&
+{
+  static const auto& profile_cache = std::make_unique<FTermProfileCache>();
+  return *profile_cache;
+}
+
+//----------------------------------------------------------------------
+auto FTermProfileCache::getCacheDirectory() const -> std::string
+{
+  auto cache_home = internal::getEnvironment("XDG_CACHE_HOME");
+
+  // The XDG base directory specification only allows absolute paths
+  if ( cache_home.empty() || cache_home[0] != '/' )
+  {
+    const auto home = internal::getHomeDirectory();
+
+    if ( home.empty() )
+      return {};
+
+    cache_home = home + "/.cache";
+  }
+
+  return cache_home + "/finalcut";
+}
+
+//----------------------------------------------------------------------
+auto FTermProfileCache::getFileName() const -> std::string
+{
+  const auto directory = getCacheDirectory();
+
+  if ( directory.empty() || key.empty() )
+    return {};
+
+  std::array<char, 17> hash{};
+  std::snprintf ( hash.data(), hash.size(), "%016llx"
+                , static_cast<unsigned long long>(internal::hashFNV1a(key.c_str())) );
+  return directory + "/terminal-" + hash.data() + ".profile";
+}
+
+//----------------------------------------------------------------------
+auto FTermProfileCache::load() -> bool
+{
+  // Identifies the terminal and restores the detection results
+  // of the cached profile
+
+  clear();
+
+  if ( ! enabled )
+    return false;
+
+  // The environment-based part of the detection selects the queries
+  static auto& term_detection = FTermDetection::getInstance();
+  term_detection.getSystemTermType();
+  term_detection.termtypeAnalysis();
+  FString sec_da{};
+
+  if ( ! queryIdentity(sec_da) )
+    return false;  // No reliable terminal response
+
+  identified = true;
+  key = createKey(sec_da);
+
+  if ( ! readProfile(getFileName()) )
+    return false;
+
+  restoreDetection();
+  loaded = true;
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FTermProfileCache::restoreCapabilities()
+{
+  // Replaces the termcap database access and the terminal quirks
+
+  if ( ! loaded )
+    return;
+
+  restoreTermData();
+  restoreTermcap();
+  restoreKeyCapMap();
+}
+
+//----------------------------------------------------------------------
+auto FTermProfileCache::save() -> bool
+{
+  // Stores the profile after the termcap initialization
+  // and the terminal quirks
+
+  if ( ! enabled || loaded || ! identified )
+    return false;
+
+  const auto directory = getCacheDirectory();
+  const auto file_name = getFileName();
+
+  if ( file_name.empty()
+    || ! internal::makeDirectory(directory.substr(0, directory.rfind('/')))
+    || ! internal::makeDirectory(directory) )
+    return false;
+
+  static const auto& term_detection = FTermDetection::getInstance();
+  static const auto& fterm_data = FTermData::getInstance();
+  std::ostringstream out{};
+  out << "# FINAL CUT terminal profile\n"
+      << "version " << FORMAT_VERSION << '\n'
+      << "key " << internal::escape(key) << '\n'
+      // Terminal detection
+      << "term_type " << internal::escape(term_detection.term_type.toString()) << '\n'
+      << "answerback " << internal::escape(term_detection.answer_back.toString()) << '\n'
+      << "sec_da " << internal::escape(term_detection.sec_da.toString()) << '\n'
+      << "xtversion " << internal::escape(term_detection.xtversion.toString()) << '\n'
+#if DEBUG
+      << "term_type_256color " << internal::escape(term_detection.term_type_256color.toString()) << '\n'
+      << "term_type_answerback " << internal::escape(term_detection.term_type_Answerback.toString()) << '\n'
+      << "term_type_sec_da " << internal::escape(term_detection.term_type_SecDA.toString()) << '\n'
+#endif
+      << "color256 " << term_detection.color256 << '\n'
+      << "decscusr_support " << term_detection.decscusr_support << '\n'
+      << "sync_output_support " << term_detection.sync_output_support << '\n'
+      << "terminal_detection " << term_detection.terminal_detection << '\n'
+      // Terminal data
+      << "termtype " << internal::escape(fterm_data.getTermType()) << '\n'
+      << "gnome_terminal_id " << fterm_data.getGnomeTerminalID() << '\n'
+      << "kitty_version_primary " << fterm_data.getKittyVersion().primary << '\n'
+      << "kitty_version_secondary " << fterm_data.getKittyVersion().secondary << '\n';
+
+  FTermTypeT termtype_flags{0};
+
+  for (FTermTypeT bit{1}; bit != 0; bit <<= 1)
+    if ( fterm_data.isTermType(bit) )
+      termtype_flags |= bit;
+
+  out << "termtype_flags " << termtype_flags << '\n'
+      // Termcap booleans and numerics
+      << "background_color_erase " << FTermcap::background_color_erase << '\n'
+      << "can_change_color_palette " << FTermcap::can_change_color_palette << '\n'
+      << "automatic_left_margin " << FTermcap::automatic_left_margin << '\n'
+      << "automatic_right_margin " << FTermcap::automatic_right_margin << '\n'
+      << "eat_nl_glitch " << FTermcap::eat_nl_glitch << '\n'
+      << "has_ansi_escape_sequences " << FTermcap::has_ansi_escape_sequences << '\n'
+      << "ansi_default_color " << FTermcap::ansi_default_color << '\n'
+      << "osc_support " << FTermcap::osc_support << '\n'
+      << "no_utf8_acs_chars " << FTermcap::no_utf8_acs_chars << '\n'
+      << "no_padding_char " << FTermcap::no_padding_char << '\n'
+      << "xon_xoff_flow_control " << FTermcap::xon_xoff_flow_control << '\n'
+      << "max_color " << FTermcap::max_color << '\n'
+      << "tabstop " << FTermcap::tabstop << '\n'
+      << "padding_baudrate " << FTermcap::padding_baudrate << '\n'
+      << "attr_without_color " << FTermcap::attr_without_color << '\n';
+
+  // Termcap strings in table order (the names are not unique)
+  for (const auto& entry : FTermcap::strings)
+    out << "tcap " << entry.tname.data() << ' '
+        << internal::encodeCapability(entry.string.data) << '\n';
+
+  // Termcap keys in the sorted order of the key map
+  for (const auto& entry : FKeyMap::getKeyCapMap())
+    out << "keycap " << uInt32(entry.num) << ' ' << entry.tname.data() << ' '
+        << internal::encodeCapability(entry.string) << '\n';
+
+  // Write to a temporary file first, so that a concurrently
+  // starting program never reads an incomplete profile
+  const auto temp_file_name = file_name + '.' + std::to_string(getpid());
+  std::ofstream file{temp_file_name, std::ofstream::out | std::ofstream::trunc};
+
+  if ( ! file )
+    return false;
+
+  file << out.str();
+  file.close();
+
+  if ( file.fail() || std::rename(temp_file_name.c_str(), file_name.c_str()) != 0 )
+  {
+    std::remove(temp_file_name.c_str());
+    return false;
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FTermProfileCache::clear()
+{
+  key.clear();
+  fields.clear();
+  termcap_strings.clear();
+  key_caps.clear();
+  loaded = false;
+  identified = false;
+}
+
+
+// private methods of FTermProfileCache
+//----------------------------------------------------------------------
+auto FTermProfileCache::createKey (const FString& sec_da) const -> std::string
+{
+  static const auto& term_detection = FTermDetection::getInstance();
+  const auto term = internal::getEnvironment("TERM");
+  const auto terminfo = internal::getTerminfoFileName(term);
+  std::string env_flags{};
+
+  // Environment variables whose presence influences the detection
+  for (const auto& name : { "VTE_VERSION", "XTERM_VERSION", "ROXTERM_ID"
+                          , "KONSOLE_DBUS_SESSION", "KONSOLE_DCOP"
+                          , "COLORFGBG", "KITTY_WINDOW_ID", "TMUX" })
+    env_flags += internal::getEnvironment(name).empty() ? '0' : '1';
+
+  std::string profile_key = std::string("FINALCUT=") + fc_release + '\n'
+                          + "TERM=" + term + '\n'
+                          + "TERM_PROGRAM=" + internal::getEnvironment("TERM_PROGRAM") + '\n'
+                          + "COLORTERM=" + internal::getEnvironment("COLORTERM") + '\n'
+                          + "ENV=" + env_flags + '\n'
+                          + "TERMINFO=" + terminfo + ':'
+                          + internal::getModificationTime(terminfo) + '\n'
+                          + "DETECTION=" + ( term_detection.hasTerminalDetection() ? '1' : '0' ) + '\n'
+                          + "SEC_DA=" + sec_da.toString();
+
+  // Without TERM, the terminal type comes from the tty device name
+  if ( term.empty() )
+    profile_key += "\nTTY=" + FTermData::getInstance().getTermFileName();
+
+  return profile_key;
+}
+
+//----------------------------------------------------------------------
+auto FTermProfileCache::queryIdentity (FString& sec_da) const -> bool
+{
+  // Requests the secondary device attributes as a quick check
+  // of the terminal identity
+
+  static const auto& term_detection = FTermDetection::getInstance();
+  static const auto& fterm_data = FTermData::getInstance();
+
+  if ( ! term_detection.hasTerminalDetection() )
+    return true;  // Terminals without detection are identified by TERM
+
+  FTermProbe probe{};
+
+  // Same restriction as in the terminal detection
+  if ( ! fterm_data.isTermType(FTermType::linux_con | FTermType::cygwin) )
+    probe.addQuery (FTermProbe::Query::SecondaryDA);
+
+  FTermios::setCaptureSendCharacters();
+  static auto& keyboard = FKeyboard::getInstance();
+  keyboard.setNonBlockingInput();
+  probe.run();
+  keyboard.unsetNonBlockingInput();
+  FTermios::unsetCaptureSendCharacters();
+
+  if ( ! probe.isComplete() )
+    return false;
+
+  if ( probe.hasQuery(FTermProbe::Query::SecondaryDA) )
+    sec_da = term_detection.getSecDA(probe.getSecDA());
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FTermProfileCache::readProfile (const std::string& file_name) -> bool
+{
+  std::ifstream file{file_name};
+
+  if ( file_name.empty() || ! file )
+    return false;
+
+  std::string line{};
+
+  while ( std::getline(file, line) )
+  {
+    if ( line.empty() || line[0] == '#' )
+      continue;
+
+    std::istringstream stream{line};
+    std::string name{};
+    stream >> name;
+
+    if ( name == "tcap" )
+    {
+      std::string tname{};
+      std::string value{};
+      stream >> tname >> value;
+      termcap_strings.emplace_back(tname, value);
+    }
+    else if ( name == "keycap" )
+    {
+      KeyCapEntry entry{};
+      stream >> entry.num >> entry.tname >> entry.value;
+      key_caps.emplace_back(std::move(entry));
+    }
+    else
+    {
+      const auto pos = line.find(' ');
+      fields[name] = ( pos == std::string::npos ) ? "" : line.substr(pos + 1);
+    }
+  }
+
+  // A profile of another format version, another key or another
+  // key map layout is not usable
+  const auto& cap_map = FKeyMap::getKeyCapMap();
+  const bool valid = getNumber("version") == FORMAT_VERSION
+                  && getField("key") == key
+                  && termcap_strings.size() == FTermcap::strings.size()
+                  && std::equal ( termcap_strings.cbegin(), termcap_strings.cend()
+                                , FTermcap::strings.cbegin()
+                                , [] (const auto& cap, const auto& entry)
+                                  {
+                                    return cap.first == entry.tname.data()
+                                        && ! cap.second.empty();
+                                  } )
+                  && key_caps.size() == cap_map.size()
+                  && std::all_of ( key_caps.cbegin(), key_caps.cend()
+                                 , [] (const auto& entry)
+                                   {
+                                     return ! entry.num.empty()
+                                         && entry.tname.length() < 4
+                                         && ! entry.value.empty();
+                                   } );
+
+  if ( ! valid )
+  {
+    fields.clear();
+    termcap_strings.clear();
+    key_caps.clear();
+  }
+
+  return valid;
+}
+
+//----------------------------------------------------------------------
+void FTermProfileCache::restoreDetection()
+{
+  static auto& term_detection = FTermDetection::getInstance();
+  term_detection.term_type = getField("term_type");
+  term_detection.answer_back = getField("answerback");
+  term_detection.sec_da = getField("sec_da");
+  term_detection.xtversion = getField("xtversion");
+#if DEBUG
+  term_detection.term_type_256color = getField("term_type_256color");
+  term_detection.term_type_Answerback = getField("term_type_answerback");
+  term_detection.term_type_SecDA = getField("term_type_sec_da");
+#endif
+  term_detection.color256 = getFlag("color256");
+  term_detection.decscusr_support = getFlag("decscusr_support");
+  term_detection.sync_output_support = getFlag("sync_output_support");
+  term_detection.terminal_detection = getFlag("terminal_detection");
+
+  // The detection passes the resolved terminal type to child processes
+  if ( ! term_detection.term_type.isEmpty() )
+    setenv("TERM", term_detection.term_type.c_str(), 1);
+}
+
+//----------------------------------------------------------------------
+void FTermProfileCache::restoreTermData()
+{
+  static auto& fterm_data = FTermData::getInstance();
+  const auto termtype_flags = FTermTypeT(std::strtoul(getField("termtype_flags").c_str(), nullptr, 10));
+
+  for (FTermTypeT bit{1}; bit != 0; bit <<= 1)
+    if ( termtype_flags & bit )
+      fterm_data.setTermType(FTermType(bit));
+
+  fterm_data.setTermType(getField("termtype"));
+  fterm_data.setGnomeTerminalID(getNumber("gnome_terminal_id"));
+  fterm_data.setKittyVersion ({ getNumber("kitty_version_primary")
+                              , getNumber("kitty_version_secondary") });
+}
+
+//----------------------------------------------------------------------
+void FTermProfileCache::restoreTermcap()
+{
+  FTermcap::background_color_erase = getFlag("background_color_erase");
+  FTermcap::can_change_color_palette = getFlag("can_change_color_palette");
+  FTermcap::automatic_left_margin = getFlag("automatic_left_margin");
+  FTermcap::automatic_right_margin = getFlag("automatic_right_margin");
+  FTermcap::eat_nl_glitch = getFlag("eat_nl_glitch");
+  FTermcap::has_ansi_escape_sequences = getFlag("has_ansi_escape_sequences");
+  FTermcap::ansi_default_color = getFlag("ansi_default_color");
+  FTermcap::osc_support = getFlag("osc_support");
+  FTermcap::no_utf8_acs_chars = getFlag("no_utf8_acs_chars");
+  FTermcap::no_padding_char = getFlag("no_padding_char");
+  FTermcap::xon_xoff_flow_control = getFlag("xon_xoff_flow_control");
+  FTermcap::max_color = getNumber("max_color");
+  FTermcap::tabstop = getNumber("tabstop");
+  FTermcap::padding_baudrate = getNumber("padding_baudrate");
+  FTermcap::attr_without_color = getNumber("attr_without_color");
+  FTermData::getInstance().setMonochron(FTermcap::max_color < 8);
+
+  // The termcap strings are stored in table order
+  auto iter = termcap_strings.cbegin();
+
+  for (auto&& entry : FTermcap::strings)
+  {
+    entry.string = { nullptr, 0 };
+
+    if ( iter->second[0] == '=' )
+    {
+      const auto* string = storeString(internal::unescape(iter->second.substr(1)));
+      entry.string = { string, uInt32(std::strlen(string)) };
+    }
+
+    ++iter;
+  }
+
+  FTermcap::restore();
+}
+
+//----------------------------------------------------------------------
+void FTermProfileCache::restoreKeyCapMap()
+{
+  // The key map is stored in its sorted order
+
+  auto& cap_map = FKeyMap::getKeyCapMap();
+  auto iter = key_caps.cbegin();
+
+  for (auto&& entry : cap_map)
+  {
+    entry.num = FKey(std::strtoul(iter->num.c_str(), nullptr, 10));
+    entry.tname = {};
+    std::memcpy (entry.tname.data(), iter->tname.data(), iter->tname.length());
+
+    if ( iter->value[0] == '=' )
+    {
+      entry.string = storeString(internal::unescape(iter->value.substr(1)));
+      entry.length = uInt8(std::strlen(entry.string));
+    }
+    else
+    {
+      entry.string = nullptr;
+      entry.length = 0;
+    }
+
+    ++iter;
+  }
+}
+
+//----------------------------------------------------------------------
+auto FTermProfileCache::storeString (const std::string& string) -> const char*
+{
+  // The termcap strings and key sequences point into this storage
+  // for the rest of the program runtime
+
+  string_storage.emplace_back(string);
+  return string_storage.back().c_str();
+}
+
+//----------------------------------------------------------------------
+auto FTermProfileCache::getField (const std::string& name) const -> std::string
+{
+  const auto iter = fields.find(name);
+  return ( iter != fields.end() ) ? internal::unescape(iter->second) : "";
+}
+
+//----------------------------------------------------------------------
+auto FTermProfileCache::getNumber (const std::string& name) const -> int
+{
+  return int(std::strtol(getField(name).c_str(), nullptr, 10));
+}
+
+//----------------------------------------------------------------------
+auto FTermProfileCache::getFlag (const std::string& name) const -> bool
+{
+  return getNumber(name) != 0;
+}
+
+}  // namespace finalcut
@@ -0,0 +1,147 @@
+/***********************************************************************
+* ftermprofilecache.h - Persistent cache for the terminal profile      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FTermProfileCache ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+// The terminal profile is the result of the terminal detection,
+// the termcap database and the terminal quirks. It is stored in
+// $XDG_CACHE_HOME/finalcut (default: ~/.cache/finalcut) under a key
+// made of TERM, TERM_PROGRAM, the detection-relevant environment,
+// the modification time of the terminfo file and the secondary
+// device attributes (SEC_DA). Only the SEC_DA query has to be sent
+// on startup to select the profile, all other detection queries and
+// the termcap database access are omitted.
+
+#ifndef FTERMPROFILECACHE_H
+#define FTERMPROFILECACHE_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FTermProfileCache
+//----------------------------------------------------------------------
+
+class FTermProfileCache final
+{
+  public:
+    // Constant
+    static constexpr int FORMAT_VERSION = 1;
+
+    // Accessors
+    auto getClassName() const -> FString;
+    static auto getInstance() -> FTermProfileCache&;
+    auto getCacheDirectory() const -> std::string;
+    auto getFileName() const -> std::string;
+    auto getKey() const & -> const std::string&;
+
+    // Inquiries
+    auto isEnabled() const noexcept -> bool;
+    auto isLoaded() const noexcept -> bool;
+
+    // Mutator
+    void setEnabled (bool = true) noexcept;
+
+    // Methods
+    auto load() -> bool;
+    void restoreCapabilities();
+    auto save() -> bool;
+    void clear();
+
+  private:
+    struct KeyCapEntry
+    {
+      std::string num{};
+      std::string tname{};
+      std::string value{};
+    };
+
+    // Using-declarations
+    using FieldMap = std::unordered_map<std::string, std::string>;
+    using TermcapList = std::vector<std::pair<std::string, std::string>>;
+    using KeyCapList = std::vector<KeyCapEntry>;
+
+    // Methods
+    auto createKey (const FString&) const -> std::string;
+    auto queryIdentity (FString&) const -> bool;
+    auto readProfile (const std::string&) -> bool;
+    void restoreDetection();
+    void restoreTermData();
+    void restoreTermcap();
+    void restoreKeyCapMap();
+    auto storeString (const std::string&) -> const char*;
+    auto getField (const std::string&) const -> std::string;
+    auto getNumber (const std::string&) const -> int;
+    auto getFlag (const std::string&) const -> bool;
+
+    // Data members
+    std::string              key{};
+    FieldMap                 fields{};
+    TermcapList              termcap_strings{};
+    KeyCapList               key_caps{};
+    std::deque<std::string>  string_storage{};  // Stable addresses
+    bool                     enabled{false};
+    bool                     loaded{false};
+    bool                     identified{false};
+};
+
+// FTermProfileCache inline functions
+//----------------------------------------------------------------------
+inline auto FTermProfileCache::getClassName() const -> FString
+{ return "FTermProfileCache"; }
+
+//----------------------------------------------------------------------
+inline auto FTermProfileCache::getKey() const & -> const std::string&
+{ return key; }
+
+//----------------------------------------------------------------------
+inline auto FTermProfileCache::isEnabled() const noexcept -> bool
+{ return enabled; }
+
+//----------------------------------------------------------------------
+inline auto FTermProfileCache::isLoaded() const noexcept -> bool
+{ return loaded; }
+
+//----------------------------------------------------------------------
+inline void FTermProfileCache::setEnabled (bool enable) noexcept
+{ enabled = enable; }
+
+}  // namespace finalcut
+
+#endif  // FTERMPROFILECACHE_H
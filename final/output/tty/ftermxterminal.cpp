@@ -20,7 +20,6 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
-#include <array>
 #include <memory>
 #include <string>
 
@@ -33,6 +32,7 @@
 #include "final/output/tty/ftermfreebsd.h"
 #include "final/output/tty/fterm.h"
 #include "final/output/tty/ftermios.h"
+#include "final/output/tty/ftermprobe.h"
 #include "final/output/tty/ftermxterminal.h"
 #include "final/util/flog.h"
 #include "final/util/fsize.h"
@@ -170,6 +170,17 @@ void FTermXTerminal::setFocusSupport (bool enable)
     disableXTermFocus();
 }
 
+//----------------------------------------------------------------------
+void FTermXTerminal::setBracketedPasteSupport (bool enable)
+{
+  // activate/deactivate the bracketed paste mode
+
+  if ( enable )
+    enableXTermBracketedPaste();
+  else
+    disableXTermBracketedPaste();
+}
+
 //----------------------------------------------------------------------
 void FTermXTerminal::metaSendsESC (bool enable)
 {
@@ -296,8 +307,7 @@ void FTermXTerminal::captureFontAndTitle()
     FTermios::setCaptureSendCharacters();
     static auto& keyboard = FKeyboard::getInstance();
     keyboard.setNonBlockingInput();
-    xterm_font  = captureXTermFont();
-    xterm_title = captureXTermTitle();
+    captureXTermFontAndTitle();
     keyboard.unsetNonBlockingInput();
     FTermios::unsetCaptureSendCharacters();
   }
@@ -827,39 +837,6 @@ inline auto FTermXTerminal::canCaptureXTermFont() const -> bool
         && ! fterm_data.isTermType(FTermType::kitty) );
 }
 
-//----------------------------------------------------------------------
-auto FTermXTerminal::captureXTermFont() const -> FString
-{
-  if ( ! canCaptureXTermFont() )
-    return {};
-
-  // Querying the terminal font
-  oscPrefix();
-  FTerm::paddingPrint (OSC "50;?" BEL);
-  oscPostfix();
-  std::fflush(stdout);
-  std::array<char, 150> temp{};
-  // BEL = \a = bell character
-  auto isWithout_BEL = [] (const auto& t) { return ! std::strchr(t.data(), '\a'); };
-  auto pos = captureTerminalInput(temp, 150'000, isWithout_BEL);
-
-  if ( pos > 5 && temp[0] == ESC[0] && temp[1] == ']' && temp[2] == '5'
-               && temp[3] == '0' && temp[4] == ';' )
-  {
-    // Skip leading Esc ] 5 0 ;
-    std::string str = &temp[5];
-    const std::size_t n = str.length();
-
-    // BEL + '\0' = string terminator
-    if ( n >= 5 && str[n - 1] == BEL[0] && str[n] == '\0' )
-      str.erase(n - 1);
-
-    return {str};
-  }
-
-  return {};
-}
-
 //----------------------------------------------------------------------
 inline auto FTermXTerminal::canCaptureXTermTitle() const -> bool
 {
@@ -869,37 +846,28 @@ inline auto FTermXTerminal::canCaptureXTermTitle() const -> bool
 }
 
 //----------------------------------------------------------------------
-auto FTermXTerminal::captureXTermTitle() const -> FString
+void FTermXTerminal::captureXTermFontAndTitle()
 {
-  if ( ! canCaptureXTermTitle() )
-    return {};
+  // Querying the terminal font and the window title together
 
-  // Report window title
-  FTerm::paddingPrint (CSI "21t");
-  std::fflush(stdout);
-  std::array<char, 512> temp{};
-  // ST = ESC + \ = string terminator
-  auto isWithout_ST  = [] (const auto& t) { return ! std::strstr(t.data(), ESC "\\"); };
-  auto pos = captureTerminalInput(temp, 150'000, isWithout_ST);
+  FTermProbe probe{};
 
-  if ( pos > 6 && temp[0] == ESC[0] && temp[1] == ']' && temp[2] == 'l' )
-  {
-    // Skip leading Esc + ] + l = OSC l
-    std::string str = &temp[3];
-    const std::size_t n = str.length();
+  if ( canCaptureXTermFont() )
+    probe.addQuery (FTermProbe::Query::XTermFont);
 
-    // Esc + \ = OSC string terminator
-    if ( n >= 2 && str[n - 2] == ESC[0] && str[n - 1] == '\\' )
-    {
-      if ( n < 4 )
-        return {};
+  if ( canCaptureXTermTitle() )
+    probe.addQuery (FTermProbe::Query::XTermTitle);
 
-      str.erase(n - 2);
-      return {str};
-    }
-  }
+  if ( ! probe.hasQuery(FTermProbe::Query::XTermFont)
+    && ! probe.hasQuery(FTermProbe::Query::XTermTitle) )
+    return;
 
-  return {};
+  // Without a response from the multiplexer passthrough, the wait
+  // does not exceed the two former individual waiting times
+  probe.setTimeout (300'000);  // 300 ms
+  probe.run();
+  xterm_font  = probe.getXTermFont();
+  xterm_title = probe.getXTermTitle();
 }
 
 //----------------------------------------------------------------------
@@ -962,6 +930,32 @@ void FTermXTerminal::disableXTermFocus()
   focus_support = false;
 }
 
+//----------------------------------------------------------------------
+void FTermXTerminal::enableXTermBracketedPaste()
+{
+  // Activate the bracketed paste mode
+
+  if ( bracketed_paste_support )
+    return;  // The bracketed paste mode is already activated
+
+  FTerm::paddingPrint (CSI "?2004h");  // enable bracketed paste
+  std::fflush(stdout);
+  bracketed_paste_support = true;
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::disableXTermBracketedPaste()
+{
+  // Deactivate the bracketed paste mode
+
+  if ( ! bracketed_paste_support )
+    return;  // The bracketed paste mode was already deactivated
+
+  FTerm::paddingPrint (CSI "?2004l");  // disable bracketed paste
+  std::fflush(stdout);
+  bracketed_paste_support = false;
+}
+
 //----------------------------------------------------------------------
 inline auto FTermXTerminal::canUseXTermMetaSendsESC() const -> bool
 {
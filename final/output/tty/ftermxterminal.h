@@ -3,7 +3,7 @@
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2018-2024 Markus Gans                                      *
+* Copyright 2018-2026 Markus Gans                                      *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -69,6 +69,8 @@ class FTermXTerminal final
     void  unsetMouseSupport();
     void  setFocusSupport (bool enable = true);
     void  unsetFocusSupport();
+    void  setBracketedPasteSupport (bool enable = true);
+    void  unsetBracketedPasteSupport();
     void  metaSendsESC (bool = true);
 
     // Accessors
@@ -145,13 +147,14 @@ class FTermXTerminal final
     void  oscPrefix() const;
     void  oscPostfix() const;
     auto  canCaptureXTermFont() const -> bool;
-    auto  captureXTermFont() const -> FString;
     auto  canCaptureXTermTitle() const -> bool;
-    auto  captureXTermTitle() const -> FString;
+    void  captureXTermFontAndTitle();
     void  enableXTermMouse();
     void  disableXTermMouse();
     void  enableXTermFocus();
     void  disableXTermFocus();
+    void  enableXTermBracketedPaste();
+    void  disableXTermBracketedPaste();
     auto  canUseXTermMetaSendsESC() const -> bool;
     void  enableXTermMetaSendsESC();
     void  disableXTermMetaSendsESC();
@@ -159,6 +162,7 @@ class FTermXTerminal final
     // Data members
     bool              mouse_support{false};
     bool              focus_support{false};
+    bool              bracketed_paste_support{false};
     bool              meta_sends_esc{false};
     bool              xterm_default_colors{false};
     bool              title_was_changed{false};
@@ -237,6 +241,10 @@ inline void FTermXTerminal::unsetMouseSupport()
 inline void FTermXTerminal::unsetFocusSupport()
 { setFocusSupport (false); }
 
+//----------------------------------------------------------------------
+inline void FTermXTerminal::unsetBracketedPasteSupport()
+{ setBracketedPasteSupport (false); }
+
 }  // namespace finalcut
 
 #endif  // FTERMXTERMINAL_H
@@ -404,6 +404,9 @@ class CharRingBuffer final : public FRingBuffer<char, Capacity>
     using FRingBuffer<char, Capacity>::buffer;
     using FRingBuffer<char, Capacity>::tail;
     using FRingBuffer<char, Capacity>::head;
+    using FRingBuffer<char, Capacity>::last_index;
+    using FRingBuffer<char, Capacity>::elements;
+    using FRingBuffer<char, Capacity>::isFull;
 
     // Accessor
     inline auto getClassName() const -> FString override
@@ -444,6 +447,38 @@ class CharRingBuffer final : public FRingBuffer<char, Capacity>
 #endif
     }
 
+    template <typename ReadFunc>
+    auto fill (ReadFunc&& read_func) -> std::ptrdiff_t
+    {
+      // Appends up to the free capacity directly into the buffer memory.
+      // read_func(char* data, std::size_t length) returns the number
+      // of characters written or a value < 1 if no more data is available.
+      // Returns the number of appended characters or the last result
+      // of read_func if nothing was appended.
+
+      std::ptrdiff_t total{0};
+
+      while ( ! isFull() )
+      {
+        // Contiguous free space behind the tail
+        const auto length = ( tail < head ) ? head - tail : Capacity - tail;
+        const auto bytes = std::ptrdiff_t(read_func(buffer.data() + tail, length));
+
+        if ( bytes < 1 )
+          return ( total > 0 ) ? total : bytes;
+
+        const auto count = std::min(std::size_t(bytes), length);
+        last_index = tail + count - 1;
+        tail = FRingBuffer<char, Capacity>::template ring_index<>::add(tail, count);
+        elements += count;
+        total += std::ptrdiff_t(count);
+
+        if ( count < length )  // No more data available
+          break;
+      }
+
+      return total;
+    }
 };
 
 }  // namespace finalcut
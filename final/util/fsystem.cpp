@@ -3,7 +3,7 @@
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2019-2021 Markus Gans                                      *
+* Copyright 2019-2026 Markus Gans                                      *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -20,6 +20,12 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <poll.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+
 #include "final/util/fsystem.h"
 #include "final/util/fsystemimpl.h"
 
@@ -43,5 +49,84 @@ auto FSystem::getInstance() -> std::unique_ptr<FSystem>&
   return *fsys;
 }
 
+//----------------------------------------------------------------------
+auto FSystem::writev (int fd, const struct iovec* iov, int iovcnt) -> ssize_t
+{
+  // Default implementation for system abstractions
+  // that do not replace the gathered write
+  return ::writev(fd, iov, iovcnt);
+}
+
+//----------------------------------------------------------------------
+auto FSystem::writeAll (int fd, IOVector& iov) -> bool
+{
+  // Writes all buffers of iov with as few writev() calls as possible.
+  // A partial write continues with the remaining data, and a write
+  // that would block waits until the file descriptor is writable.
+  // If no data can be written for max_wait_count poll intervals,
+  // the write is aborted with errno EAGAIN. The buffer entries of
+  // iov are consumed in the process.
+
+#if defined(IOV_MAX)
+  constexpr std::ptrdiff_t max_count = IOV_MAX;
+#else
+  constexpr std::ptrdiff_t max_count = 1024;
+#endif
+  constexpr int poll_interval = 100;  // ms
+  constexpr int max_wait_count = 50;  // 5 seconds without progress
+  int wait_count{0};
+  auto iter = iov.begin();
+  const auto end = iov.end();
+
+  while ( iter != end )
+  {
+    if ( iter->iov_len == 0 )  // Skip empty buffers
+    {
+      ++iter;
+      continue;
+    }
+
+    const auto count = std::min(std::distance(iter, end), max_count);
+    const auto written = writev(fd, &*iter, int(count));
+
+    if ( written < 0 && errno == EINTR )
+      continue;
+
+    if ( written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK) )
+    {
+      if ( wait_count >= max_wait_count )
+      {
+        errno = EAGAIN;
+        return false;  // The terminal does not accept any more data
+      }
+
+      struct pollfd pfd{fd, POLLOUT, 0};
+      ::poll (&pfd, 1, poll_interval);  // Waits for free buffer space
+      wait_count++;
+      continue;
+    }
+
+    if ( written <= 0 )
+      return false;
+
+    wait_count = 0;
+    auto remaining = std::size_t(written);
+
+    while ( iter != end && remaining >= iter->iov_len )
+    {
+      remaining -= iter->iov_len;
+      ++iter;
+    }
+
+    if ( remaining > 0 )  // Partially written buffer
+    {
+      iter->iov_base = static_cast<char*>(iter->iov_base) + remaining;
+      iter->iov_len -= remaining;
+    }
+  }
+
+  return true;
+}
+
 }  // namespace finalcut
 
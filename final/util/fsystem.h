@@ -3,7 +3,7 @@
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2019-2025 Markus Gans                                      *
+* Copyright 2019-2026 Markus Gans                                      *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -39,8 +39,11 @@
   using timer_t = void*;
 #endif
 
+#include <sys/uio.h>
+
 #include <memory>
 #include <pwd.h>
+#include <vector>
 
 #include "final/ftypes.h"
 
@@ -57,14 +60,28 @@ namespace finalcut
 class FSystem
 {
   public:
+    // Enumeration
+    enum class OutputMode : uInt8
+    {
+      Stdio,  // Buffered output via the C standard library (default)
+      Direct  // Unbuffered writev() on the terminal file descriptor
+    };
+
+    // Using-declaration
+    using IOVector = std::vector<struct iovec>;
+
     // Constructor
     FSystem() = default;
 
     // Destructor
     virtual ~FSystem() noexcept;
 
-    // Accessor
+    // Accessors
     static auto   getInstance() -> std::unique_ptr<FSystem>&;
+    auto          getOutputMode() const noexcept -> OutputMode;
+
+    // Mutator
+    void          setOutputMode (OutputMode) noexcept;
 
     // Methods
     virtual auto inPortByte (uShort) -> uChar = 0;
@@ -79,6 +96,7 @@ class FSystem
     virtual auto fputs (const char*, FILE*) -> int = 0;
     virtual auto putchar (int) -> int = 0;
     virtual auto putstring (const char* str, std::size_t len) noexcept -> int = 0;
+    virtual auto writev (int, const struct iovec*, int) -> ssize_t;
     virtual auto sigaction ( int, const struct sigaction*
                            , struct sigaction* ) -> int = 0;
     virtual auto timer_create ( clockid_t, struct sigevent*
@@ -96,8 +114,22 @@ class FSystem
     virtual auto getpwuid_r ( uid_t, struct passwd*, char*
                             , size_t, struct passwd**) -> int = 0;
     virtual auto realpath (const char*, char*) -> char* = 0;
+    auto         writeAll (int, IOVector&) -> bool;
+
+  private:
+    // Data member
+    OutputMode output_mode{OutputMode::Stdio};
 };
 
+// FSystem inline functions
+//----------------------------------------------------------------------
+inline auto FSystem::getOutputMode() const noexcept -> OutputMode
+{ return output_mode; }
+
+//----------------------------------------------------------------------
+inline void FSystem::setOutputMode (OutputMode mode) noexcept
+{ output_mode = mode; }
+
 }  // namespace finalcut
 
 #endif  // FSYSTEM_H
@@ -60,6 +60,7 @@
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 #include <cstdarg>
 #include <fcntl.h>
@@ -172,6 +173,11 @@ class FSystemImpl : public FSystem
       return int(std::fwrite(str, 1, len, stdout));
     }
 
+    inline auto writev (int fd, const struct iovec* iov, int iovcnt) noexcept -> ssize_t override
+    {
+      return ::writev(fd, iov, iovcnt);
+    }
+
     auto sigaction ( int, const struct sigaction*
                    , struct sigaction* ) noexcept -> int override;
     auto timer_create ( clockid_t, struct sigevent*
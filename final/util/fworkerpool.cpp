@@ -0,0 +1,151 @@
+/***********************************************************************
+* fworkerpool.cpp - Fork-join pool of worker threads                   *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include "final/util/fworkerpool.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FWorkerPool
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FWorkerPool::FWorkerPool (std::size_t thread_count)
+{
+  // The calling thread of run() is one of the threads
+
+  for (std::size_t i{1}; i < thread_count; i++)
+    workers.emplace_back([this] () { workerLoop(); });
+}
+
+//----------------------------------------------------------------------
+FWorkerPool::~FWorkerPool()  // destructor
+{
+  {
+    std::lock_guard<std::mutex> lock_guard(mutex);
+    stop = true;
+  }
+
+  start_condition.notify_all();
+
+  for (auto& worker : workers)
+    worker.join();
+}
+
+
+// public methods of FWorkerPool
+//----------------------------------------------------------------------
+void FWorkerPool::run (std::size_t count, const FTask& task)
+{
+  // Calls task(0) … task(count - 1) distributed over all threads
+  // and returns after the last task is finished. The tasks must
+  // not throw exceptions.
+
+  if ( count == 0 )
+    return;
+
+  if ( workers.empty() || count == 1 )
+  {
+    for (std::size_t i{0}; i < count; i++)
+      task(i);
+
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock_guard(mutex);
+    current_task = &task;
+    task_count = count;
+    next_task = 0;
+    active_workers = workers.size();
+    generation++;
+  }
+
+  start_condition.notify_all();
+  processTasks (task, count);
+
+  // Wait until every worker has left this generation,
+  // so that the task object can be safely destroyed
+  std::unique_lock<std::mutex> lock(mutex);
+  done_condition.wait (lock, [this] () { return active_workers == 0; });
+  current_task = nullptr;
+}
+
+
+// private methods of FWorkerPool
+//----------------------------------------------------------------------
+void FWorkerPool::workerLoop()
+{
+  std::size_t seen_generation{0};
+
+  while ( true )
+  {
+    const FTask* task{nullptr};
+    std::size_t count{0};
+
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      start_condition.wait ( lock
+                           , [this, seen_generation] ()
+                             {
+                               return stop || generation != seen_generation;
+                             } );
+
+      if ( stop )
+        return;
+
+      seen_generation = generation;
+      task = current_task;
+      count = task_count;
+    }
+
+    processTasks (*task, count);
+
+    {
+      std::lock_guard<std::mutex> lock_guard(mutex);
+      active_workers--;
+
+      if ( active_workers == 0 )
+        done_condition.notify_one();
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+inline void FWorkerPool::processTasks (const FTask& task, std::size_t count)
+{
+  // Takes the next unprocessed task until all are assigned
+
+  while ( true )
+  {
+    const auto index = next_task.fetch_add(1);
+
+    if ( index >= count )
+      return;
+
+    task(index);
+  }
+}
+
+}  // namespace finalcut
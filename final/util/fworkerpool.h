@@ -0,0 +1,114 @@
+/***********************************************************************
+* fworkerpool.h - Fork-join pool of worker threads                     *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FWorkerPool ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FWORKERPOOL_H
+#define FWORKERPOOL_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FWorkerPool
+//----------------------------------------------------------------------
+
+class FWorkerPool final
+{
+  public:
+    // Using-declaration
+    using FTask = std::function<void(std::size_t)>;
+
+    // Constructor
+    explicit FWorkerPool (std::size_t);
+
+    // Disable copy constructor
+    FWorkerPool (const FWorkerPool&) = delete;
+
+    // Disable move constructor
+    FWorkerPool (FWorkerPool&&) noexcept = delete;
+
+    // Destructor
+    ~FWorkerPool();
+
+    // Disable copy assignment operator (=)
+    auto operator = (const FWorkerPool&) -> FWorkerPool& = delete;
+
+    // Disable move assignment operator (=)
+    auto operator = (FWorkerPool&&) noexcept -> FWorkerPool& = delete;
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getThreadCount() const noexcept -> std::size_t;
+
+    // Method
+    void run (std::size_t, const FTask&);
+
+  private:
+    // Methods
+    void workerLoop();
+    void processTasks (const FTask&, std::size_t);
+
+    // Data members
+    std::vector<std::thread> workers{};
+    std::mutex               mutex{};
+    std::condition_variable  start_condition{};
+    std::condition_variable  done_condition{};
+    std::atomic<std::size_t> next_task{0};
+    const FTask*             current_task{nullptr};
+    std::size_t              task_count{0};
+    std::size_t              active_workers{0};
+    std::size_t              generation{0};
+    bool                     stop{false};
+};
+
+// FWorkerPool inline functions
+//----------------------------------------------------------------------
+inline auto FWorkerPool::getClassName() const -> FString
+{ return "FWorkerPool"; }
+
+//----------------------------------------------------------------------
+inline auto FWorkerPool::getThreadCount() const noexcept -> std::size_t
+{ return workers.size() + 1; }  // The calling thread also works
+
+}  // namespace finalcut
+
+#endif  // FWORKERPOOL_H
@@ -0,0 +1,197 @@
+/***********************************************************************
+* fdamagelist.cpp - List of merged dirty rectangles                    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <limits>
+
+#include "final/vterm/fdamagelist.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+//----------------------------------------------------------------------
+constexpr auto getArea (const FRect& r) noexcept -> sInt64
+{
+  return sInt64(r.getX2() - r.getX1() + 1) * sInt64(r.getY2() - r.getY1() + 1);
+}
+
+//----------------------------------------------------------------------
+constexpr auto getCombinedArea (const FRect& r1, const FRect& r2) noexcept -> sInt64
+{
+  return sInt64(std::max(r1.getX2(), r2.getX2()) - std::min(r1.getX1(), r2.getX1()) + 1)
+       * sInt64(std::max(r1.getY2(), r2.getY2()) - std::min(r1.getY1(), r2.getY1()) + 1);
+}
+
+//----------------------------------------------------------------------
+constexpr auto getUnionArea (const FRect& r1, const FRect& r2) noexcept -> sInt64
+{
+  // Cells covered by both rectangles are only counted once
+  const auto width = std::min(r1.getX2(), r2.getX2())
+                   - std::max(r1.getX1(), r2.getX1()) + 1;
+  const auto height = std::min(r1.getY2(), r2.getY2())
+                    - std::max(r1.getY1(), r2.getY1()) + 1;
+  const auto intersection = ( width > 0 && height > 0 )
+                          ? sInt64(width) * sInt64(height)
+                          : 0;
+  return getArea(r1) + getArea(r2) - intersection;
+}
+
+}  // namespace internal
+
+//----------------------------------------------------------------------
+// class FDamageList
+//----------------------------------------------------------------------
+
+// public methods of FDamageList
+//----------------------------------------------------------------------
+auto FDamageList::getLineSpans (int y, FSpanVec& spans) const -> bool
+{
+  // Collects the sorted and merged column spans of all rectangles
+  // that cross line y. Returns false if the line is not damaged.
+
+  spans.clear();
+
+  for (const auto& rect : *this)
+    if ( y >= rect.getY1() && y <= rect.getY2() )
+      spans.push_back({rect.getX1(), rect.getX2()});
+
+  if ( spans.empty() )
+    return false;
+
+  std::sort ( spans.begin(), spans.end()
+            , [] (const FSpan& lhs, const FSpan& rhs)
+              {
+                return lhs.xmin < rhs.xmin;
+              } );
+  auto last = spans.begin();
+
+  for (auto iter = spans.begin() + 1; iter != spans.end(); ++iter)
+  {
+    if ( iter->xmin <= last->xmax + 1 )  // Overlapping or adjacent
+      last->xmax = std::max(last->xmax, iter->xmax);
+    else
+      *(++last) = *iter;
+  }
+
+  spans.erase (last + 1, spans.end());
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FDamageList::add (const FRect& rect) noexcept
+{
+  // Adds a dirty rectangle and merges it with the existing rectangles
+  // if this does not enlarge the damaged area
+
+  if ( rect.getX2() < rect.getX1() || rect.getY2() < rect.getY1() )
+    return;
+
+  if ( absorb(rect) )
+    return;
+
+  if ( count == MAX_RECTS )
+    mergeClosestPair();
+
+  rects[count] = rect;
+  count++;
+}
+
+
+// private methods of FDamageList
+//----------------------------------------------------------------------
+auto FDamageList::absorb (const FRect& rect) noexcept -> bool
+{
+  // Tries to merge the rectangle into an existing one.
+  // A merged rectangle can in turn absorb other rectangles.
+
+  auto merged = rect;
+  bool has_merged{false};
+  std::size_t i{0};
+
+  while ( i < count )
+  {
+    const auto& current = rects[i];
+    const auto combined_area = internal::getCombinedArea(current, merged);
+
+    if ( combined_area <= internal::getUnionArea(current, merged) )
+    {
+      merged = current.combined(merged);
+      erase(i);
+      has_merged = true;
+      i = 0;  // Restart with the enlarged rectangle
+      continue;
+    }
+
+    i++;
+  }
+
+  if ( has_merged )
+  {
+    rects[count] = merged;
+    count++;
+  }
+
+  return has_merged;
+}
+
+//----------------------------------------------------------------------
+void FDamageList::mergeClosestPair() noexcept
+{
+  // Merges the two rectangles whose bounding box adds
+  // the smallest undamaged area
+
+  auto best_growth = std::numeric_limits<sInt64>::max();
+  std::size_t best_i{0};
+  std::size_t best_j{1};
+
+  for (std::size_t i{0}; i < count; i++)
+  {
+    for (std::size_t j{i + 1}; j < count; j++)
+    {
+      const auto growth = internal::getCombinedArea(rects[i], rects[j])
+                        - internal::getUnionArea(rects[i], rects[j]);
+
+      if ( growth < best_growth )
+      {
+        best_growth = growth;
+        best_i = i;
+        best_j = j;
+      }
+    }
+  }
+
+  rects[best_i] = rects[best_i].combined(rects[best_j]);
+  erase(best_j);
+}
+
+//----------------------------------------------------------------------
+inline void FDamageList::erase (std::size_t index) noexcept
+{
+  // The order of the rectangles is irrelevant
+  count--;
+  rects[index] = rects[count];
+}
+
+}  // namespace finalcut
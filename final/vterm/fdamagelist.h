@@ -0,0 +1,126 @@
+/***********************************************************************
+* fdamagelist.h - List of merged dirty rectangles                      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏1     *▕▔▔▔▔▔▔▔▏
+ * ▕ FDamageList ▏- - - -▕ FRect ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏       ▕▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FDAMAGELIST_H
+#define FDAMAGELIST_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <array>
+#include <vector>
+
+#include "final/ftypes.h"
+#include "final/util/frect.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FDamageList
+//----------------------------------------------------------------------
+
+class FDamageList
+{
+  public:
+    struct FSpan
+    {
+      int xmin;  // First damaged column
+      int xmax;  // Last damaged column
+    };
+
+    // Constants
+    static constexpr std::size_t MAX_RECTS{16};
+
+    // Using-declarations
+    using FRectArray = std::array<FRect, MAX_RECTS>;
+    using const_iterator = FRectArray::const_iterator;
+    using FSpanVec = std::vector<FSpan>;
+
+    // Constructor
+    FDamageList() = default;
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getCount() const noexcept -> std::size_t;
+    auto getLineSpans (int, FSpanVec&) const -> bool;
+
+    // Inquiry
+    auto isEmpty() const noexcept -> bool;
+
+    // Iterators
+    auto begin() const noexcept -> const_iterator;
+    auto end() const noexcept -> const_iterator;
+
+    // Methods
+    void add (const FRect&) noexcept;
+    void clear() noexcept;
+
+  private:
+    // Methods
+    auto absorb (const FRect&) noexcept -> bool;
+    void mergeClosestPair() noexcept;
+    void erase (std::size_t) noexcept;
+
+    // Data members
+    FRectArray  rects{};
+    std::size_t count{0};
+};
+
+// FDamageList inline functions
+//----------------------------------------------------------------------
+inline auto FDamageList::getClassName() const -> FString
+{ return "FDamageList"; }
+
+//----------------------------------------------------------------------
+inline auto FDamageList::getCount() const noexcept -> std::size_t
+{ return count; }
+
+//----------------------------------------------------------------------
+inline auto FDamageList::isEmpty() const noexcept -> bool
+{ return count == 0; }
+
+//----------------------------------------------------------------------
+inline auto FDamageList::begin() const noexcept -> const_iterator
+{ return rects.cbegin(); }
+
+//----------------------------------------------------------------------
+inline auto FDamageList::end() const noexcept -> const_iterator
+{ return rects.cbegin() + std::ptrdiff_t(count); }
+
+//----------------------------------------------------------------------
+inline void FDamageList::clear() noexcept
+{ count = 0; }
+
+}  // namespace finalcut
+
+#endif  // FDAMAGELIST_H
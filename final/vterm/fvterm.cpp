@@ -21,8 +21,11 @@
 ***********************************************************************/
 
 #include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <numeric>
 #include <string>
+#include <thread>
 #include <unordered_set>
 #include <vector>
 
@@ -35,9 +38,12 @@
 #include "final/util/frect.h"
 #include "final/util/fsize.h"
 #include "final/util/fsystem.h"
+#include "final/util/fworkerpool.h"
 #include "final/vterm/fcolorpair.h"
 #include "final/vterm/fstyle.h"
 #include "final/vterm/fvterm.h"
+#include "final/vterm/fvterm_kernels.h"
+#include "final/vterm/fwindowindex.h"
 
 namespace finalcut
 {
@@ -87,13 +93,73 @@ constexpr auto getColorOverlayResetMask() noexcept -> uInt32
 struct var
 {
   static bool fvterm_initialized;  // Global init state
+  static std::unique_ptr<FWorkerPool> compositor_pool;  // Parallel compositing
   static constexpr auto transparent_mask = getTransparentMask();
   static constexpr auto print_transparent_mask = getPrintTransparentMask();
   static constexpr auto print_reset_mask = getResetMask();
   static constexpr auto color_overlay_reset_mask = getColorOverlayResetMask();
 };
 
+//----------------------------------------------------------------------
+inline auto findFirstSpanChange ( const FChar* line, const FChar* line_old
+                                , const FDamageList::FSpanVec& spans ) noexcept -> int
+{
+  // Returns the column of the first changed character
+  // in the damaged spans or -1 if nothing has changed
+
+  for (const auto& span : spans)
+  {
+    const auto length = std::size_t(span.xmax - span.xmin + 1);
+    const auto pos = findFirstChange(line + span.xmin, line_old + span.xmin, length);
+
+    if ( pos < length )
+      return span.xmin + int(pos);
+  }
+
+  return -1;
+}
+
+//----------------------------------------------------------------------
+inline auto findLastSpanChange ( const FChar* line, const FChar* line_old
+                               , const FDamageList::FSpanVec& spans ) noexcept -> int
+{
+  // Returns the column after the last changed character
+  // in the damaged spans or 0 if nothing has changed
+
+  for (auto iter = spans.crbegin(); iter != spans.crend(); ++iter)
+  {
+    const auto length = std::size_t(iter->xmax - iter->xmin + 1);
+    const auto end = findLastChange(line + iter->xmin, line_old + iter->xmin, length);
+
+    if ( end > 0 )
+      return iter->xmin + int(end);
+  }
+
+  return 0;
+}
+
+//----------------------------------------------------------------------
+inline void markUnchangedCharacters ( FChar* first, const FChar* first_old
+                                    , std::size_t length ) noexcept
+{
+  // Sets the no_changes bit for all unchanged characters in the range
+
+  std::size_t x{0};
+
+  while ( x < length )
+  {
+    const auto unchanged = findFirstChange(first + x, first_old + x, length - x);
+    std::for_each ( first + x, first + x + unchanged
+                  , [] (FChar& fchar)
+                    {
+                      fchar.setBit(FAttribute::set::no_changes);
+                    } );
+    x += unchanged + 1;  // Skip the changed character
+  }
+}
+
 bool             var::fvterm_initialized{false};
+std::unique_ptr<FWorkerPool> var::compositor_pool{};
 constexpr uInt32 var::transparent_mask;
 constexpr uInt32 var::print_transparent_mask;
 constexpr uInt32 var::print_reset_mask;
@@ -106,7 +172,9 @@ bool                 FVTerm::draw_completed{false};
 bool                 FVTerm::skip_one_vterm_update{false};
 bool                 FVTerm::no_terminal_updates{false};
 bool                 FVTerm::force_terminal_update{false};
+uInt64               FVTerm::compose_time_us{0};
 FVTerm::FTermRegion* FVTerm::active_region{nullptr};
+uInt64               FVTerm::FTermRegion::coverage_generation{1};
 int                  FVTerm::tabstop{8};
 
 using TransparentInvisibleLookupMap = std::unordered_set<wchar_t>;
@@ -172,6 +240,13 @@ auto FVTerm::getFOutput() -> std::shared_ptr<FOutput>
   return init_object->foutput;
 }
 
+//----------------------------------------------------------------------
+auto FVTerm::getCompositorThreads() noexcept -> std::size_t
+{
+  const auto& pool = internal::var::compositor_pool;
+  return pool ? pool->getThreadCount() : 1;
+}
+
 //----------------------------------------------------------------------
 auto FVTerm::getPrintCursor() -> FPoint
 {
@@ -218,6 +293,25 @@ void FVTerm::setNonBlockingRead (bool enable)
   init_object->foutput->setNonBlockingRead (enable);
 }
 
+//----------------------------------------------------------------------
+void FVTerm::setCompositorThreads (std::size_t count)
+{
+  // Sets the number of threads that copy the changed region rows
+  // into the virtual terminal (0 = one per CPU core, 1 = serial)
+
+  if ( count == 0 )
+    count = std::max(std::size_t(std::thread::hardware_concurrency()), std::size_t(1));
+
+  if ( count == getCompositorThreads() )
+    return;
+
+  auto& pool = internal::var::compositor_pool;
+  pool.reset();
+
+  if ( count > 1 )
+    pool = std::make_unique<FWorkerPool>(count);
+}
+
 //----------------------------------------------------------------------
 auto FVTerm::hasPreprocessingHandler (const FVTerm* instance) noexcept -> bool
 {
@@ -274,6 +368,9 @@ void FVTerm::resizeVTerm (const FSize& size) const noexcept
   const FRect box{0, 0, size.getWidth(), size.getHeight()};
   resizeRegion (box, vterm.get());
   resizeRegion (box, vterm_old.get());
+
+  if ( window_index )
+    window_index->setSize(size);
 }
 
 //----------------------------------------------------------------------
@@ -281,17 +378,10 @@ void FVTerm::putVTerm() const
 {
   // Update the entire terminal screen
 
-  auto xmax = uInt(vterm->size.width - 1);
-  auto ymax = uInt(vterm->size.height - 1);
-  auto vterm_changes = vterm->changes_in_line.begin();
-  std::for_each ( vterm_changes
-                , vterm_changes + vterm->size.height
-                , [&xmax] (auto& vterm_changes_line) noexcept
-                  {
-                    vterm_changes_line.xmin = 0;
-                    vterm_changes_line.xmax = xmax;
-                  } );
-  vterm->changes_in_row = {0, ymax};
+  const auto xmax = vterm->size.width - 1;
+  const auto ymax = vterm->size.height - 1;
+  vterm->addBlockChanges (FRect{FPoint{0, 0}, FPoint{xmax, ymax}});
+  vterm->changes_in_row = {0, uInt(ymax)};
   updateTerminal();
 }
 
@@ -314,42 +404,95 @@ auto FVTerm::updateTerminal() const -> bool
 void FVTerm::reduceTerminalLineUpdates (uInt y)
 {
   static const auto& init_object = getGlobalFVTermInstance();
-  static const auto& vterm = init_object->vterm;
-  static const auto& vterm_old = init_object->vterm_old;
+  const auto& vterm = init_object->vterm;  // Instance can be replaced
+  const auto& vterm_old = init_object->vterm_old;
+  static FDamageList::FSpanVec spans{};
   auto& vterm_changes = vterm->changes_in_line[unsigned(y)];
   uInt& xmin = vterm_changes.xmin;
   uInt& xmax = vterm_changes.xmax;
 
-  if ( xmin > xmax )  // No changes
+  // Only the damaged spans of the line can contain changed characters
+  if ( ! vterm->getDamagedSpans(int(y), spans) )  // No changes
     return;
 
-  auto first = vterm->getFCharIterator(int(xmin), int(y));
-  auto first_old = vterm_old->getFCharIterator(int(xmin), int(y));
-  auto last = vterm->getFCharIterator(int(xmax), int(y));
-  auto last_old = vterm_old->getFCharIterator(int(xmax), int(y));
+  auto* line = &*vterm->getFCharIterator(0, int(y));
+  const auto* line_old = &*vterm_old->getFCharIterator(0, int(y));
+  const auto first_change = internal::findFirstSpanChange(line, line_old, spans);
 
-  while ( xmin < xmax && *first == *first_old )
+  if ( first_change < 0 )  // All damaged characters are unchanged
   {
-    xmin++;
-    ++first;
-    ++first_old;
+    xmin = std::max(xmax, 1U);  // Empty range
+    xmax = xmin - 1;
+    return;
   }
 
-  while ( last >= first && *last == *last_old )
+  const auto end = internal::findLastSpanChange(line, line_old, spans);
+  xmin = uInt(first_change);
+  xmax = uInt(end - 1);
+
+  // Mark the unchanged characters between xmin and xmax
+  auto x = first_change + 1;
+
+  for (const auto& span : spans)
   {
-    xmax--;
-    --last;
-    --last_old;
+    if ( x >= end )
+      break;
+
+    // Characters outside the damaged spans are unchanged
+    const auto span_start = std::min(std::max(span.xmin, x), end);
+    std::for_each ( line + x, line + span_start
+                  , [] (FChar& fchar)
+                    {
+                      fchar.setBit(FAttribute::set::no_changes);
+                    } );
+    const auto span_end = std::min(span.xmax + 1, end);
+
+    if ( span_start < span_end )
+    {
+      internal::markUnchangedCharacters ( line + span_start
+                                        , line_old + span_start
+                                        , std::size_t(span_end - span_start) );
+    }
+
+    x = std::max(span_start, span_end);
   }
+}
 
-  while ( last > first )
-  {
-    if ( *last == *last_old )
-      last->setBit(FAttribute::set::no_changes);
+//----------------------------------------------------------------------
+void FVTerm::shiftLastTerminalLines (int top, int bottom, int lines)
+{
+  // The terminal has moved its lines from top to bottom by the given
+  // number of lines up (lines > 0) or down (lines < 0). The last
+  // virtual terminal is shifted in the same way, and all lines of
+  // the block are compared again with the virtual terminal.
 
-    --last;
-    --last_old;
+  static const auto& init_object = getGlobalFVTermInstance();
+  const auto& vterm = init_object->vterm;  // Instance can be replaced
+  const auto& vterm_old = init_object->vterm_old;
+  const auto count = std::min(std::abs(lines), bottom - top + 1);
+  vterm_old->rotateRows (top, bottom, lines);
+
+  // The inserted terminal lines are empty and can never be equal
+  // to a character of the virtual terminal
+  FChar invalid_char{};
+  invalid_char.color.data = FCellColor{FColor::Undefined, FColor::Undefined}.data;
+  invalid_char.ch[0] = L'\0';
+  const auto first_new = ( lines > 0 ) ? bottom - count + 1 : top;
+
+  for (auto y{first_new}; y < first_new + count; y++)
+  {
+    const auto new_line = vterm_old->getFCharIterator(0, y);
+    std::fill (new_line, new_line + vterm->size.width, invalid_char);
   }
+
+  const auto xmax = uInt(vterm->size.width - 1);
+
+  for (auto y{top}; y <= bottom; y++)
+    vterm->addLineChanges (uInt(y), 0, xmax);
+
+  auto& changes_in_row = vterm->changes_in_row;
+  changes_in_row.ymin = std::min(changes_in_row.ymin, uInt(top));
+  changes_in_row.ymax = std::max(changes_in_row.ymax, uInt(bottom));
 }
 
 //----------------------------------------------------------------------
@@ -585,6 +728,7 @@ void FVTerm::resizeRegion ( const FShadowBox& shadowbox
   {
     region->position.x = shadowbox.box.getX();
     region->position.y = shadowbox.box.getY();
+    updateWindowIndex (region);
     return;  // Move only
   }
 
@@ -599,6 +743,7 @@ void FVTerm::resizeRegion ( const FShadowBox& shadowbox
   updateRegionProperties (region, shadowbox);
   // Set default FChar in region
   resetTextRegionToDefault (region, { FSize{full_width, full_height} });
+  updateWindowIndex (region);
 }
 
 //----------------------------------------------------------------------
@@ -610,6 +755,17 @@ void FVTerm::resizeRegion (const FRect& box, FTermRegion* region) const
   resizeRegion ({box, no_shadow}, region);
 }
 
+//----------------------------------------------------------------------
+void FVTerm::updateWindowIndex (const FTermRegion* region) const
+{
+  // Updates the spatial index after the region has been moved or resized
+
+  if ( window_index )
+    window_index->update(region);
+
+  FTermRegion::invalidateCoverage();
+}
+
 //----------------------------------------------------------------------
 void FVTerm::restoreVTerm (const FRect& box) const noexcept
 {
@@ -703,22 +859,20 @@ void FVTerm::getRegion (const FPoint& pos, FTermRegion* region) const noexcept
 
   const int y_end  = std::min(vterm->size.height - ay, region->size.height);
   const int length = std::min(vterm->size.width - ax, region->size.width);
-  const auto region_width = getFullRegionWidth(region);
-  const auto vterm_width = getFullRegionWidth(vterm.get());
   auto line_changes = region->changes_in_line.begin();
-  auto ac = region->data.begin();  // Region character
-  auto tc = vterm->data.cbegin() + (ay * vterm_width);  // Terminal character
 
   for (auto y{0}; y < y_end; y++)  // line loop
   {
-    putRegionLine (*(tc + unsigned(ax)), *ac, length);
+    const auto tc = vterm->getFCharIterator(ax, ay + y);  // Terminal character
+    const auto ac = region->getFCharIterator(0, y);  // Region character
+    putRegionLine (*tc, *ac, length);
     line_changes->xmin = 0;
     line_changes->xmax = uInt(length - 1);
     ++line_changes;
-    ac += region_width;
-    tc += vterm_width;
   }
 
+  region->damage.clear();
+  region->damage.add (FRect{FPoint{0, 0}, FPoint{length - 1, y_end - 1}});
   auto& changes_in_row = region->changes_in_row;
   changes_in_row.ymin = 0;
   changes_in_row.ymax = std::max(changes_in_row.ymax, uInt(y_end - 1));
@@ -746,26 +900,19 @@ void FVTerm::getRegion (const FRect& box, FTermRegion* region) const noexcept
   if ( dy < 0 ) { h += dy; y -= dy; dy = 0; }
   const int y_end = std::min(vterm->size.height - y, h);
   const int length = std::min(vterm->size.width - x, w);
-  const auto region_width = getFullRegionWidth(region);
-  const auto vterm_width = getFullRegionWidth(vterm.get());
-  auto ac = region->data.begin() + (dy * region_width);  // Region character
-  auto tc = vterm->data.cbegin() + (y * vterm_width);  // Terminal character
 
   if ( length < 1 )
     return;
 
-  auto line_changes = region->changes_in_line.begin() + dy;
-
   for (auto line{0}; line < y_end; line++)  // line loop
   {
-    putRegionLine (*(tc + x), *(ac + dx), length);
-    line_changes->xmin = std::min(line_changes->xmin, uInt(dx));
-    line_changes->xmax = std::max(line_changes->xmax, uInt(dx + length - 1));
-    ++line_changes;
-    ac += region_width;
-    tc += vterm_width;
+    const auto tc = vterm->getFCharIterator(x, y + line);  // Terminal character
+    const auto ac = region->getFCharIterator(dx, dy + line);  // Region character
+    putRegionLine (*tc, *ac, length);
   }
 
+  region->addBlockChanges (FRect{FPoint{dx, dy}, FPoint{dx + length - 1, dy + y_end - 1}});
+
   auto& changes_in_row = region->changes_in_row;
   changes_in_row.ymin = 0;
   changes_in_row.ymax = std::max(changes_in_row.ymax, uInt(y_end - 1));
@@ -801,6 +948,10 @@ void FVTerm::addLayer (FTermRegion* region) const noexcept
 
   // Update the range of changed rows and the cursor on vterm
   updateVTermChangesFromBatch(geometry);
+
+  if ( region->input_cursor_visible )
+    getCoveragePlane(region);  // Validates the plane for isCovered()
+
   updateVTermCursor(region);
 }
 
@@ -827,7 +978,6 @@ void FVTerm::copyRegion (FTermRegion* dst, const FPoint& pos, FTermRegion* src)
     skip_one_vterm_update = true;
 
   const int src_width = getFullRegionWidth(src);
-  const int dst_width = getFullRegionWidth(dst);
   const int src_height = src->minimized ? src->min_size.height : getFullRegionHeight(src);
   const int ax = std::max(0, pos.getX() - 1);
   const int ay = std::max(0, pos.getY() - 1);
@@ -840,19 +990,27 @@ void FVTerm::copyRegion (FTermRegion* dst, const FPoint& pos, FTermRegion* src)
     return;
 
   auto src_changes = src->changes_in_line.cbegin();
-  auto dst_changes = dst->changes_in_line.begin() + ay;
-  auto sc = src->data.cbegin() + (src_width * ot) + ol;  // src character ptr
-  auto dc = dst->data.begin() + (dst_width * ay) + ax;  // dst character ptr
+  const CoveredState* coverage{nullptr};  // Coverage of the src line
 
   if ( skip_one_vterm_update )  // dst is the virtual terminal
+  {
     determineCoveredRegions(src);
+    const auto& plane = getCoveragePlane(src);
+
+    if ( ! plane.empty() )
+      coverage = plane.data() + (src_width * ot) + ol;
+  }
 
   for (int y{0}; y < y_end; y++)  // line loop
   {
+    const auto sc = src->getFCharIterator(ol, ot + y);  // src character ptr
+    const auto dc = dst->getFCharIterator(ax, ay + y);  // dst character ptr
+
     if ( skip_one_vterm_update && src_changes->trans_count > 0 )
     {
       // Line with hidden and transparent characters
-      putRegionLineWithTransparency (sc, dc, length, {ax, ay + y}, src_changes->covered);
+      putRegionLineWithTransparency ( sc, dc, length, {ax, ay + y}
+                                    , src_changes->covered, coverage );
     }
     else
     {
@@ -860,17 +1018,20 @@ void FVTerm::copyRegion (FTermRegion* dst, const FPoint& pos, FTermRegion* src)
       putRegionLine (*sc, *dc, length);
     }
 
-    dst_changes->xmin = std::min(dst_changes->xmin, uInt(ax));
-    dst_changes->xmax = std::max(dst_changes->xmax, uInt(ax + length - 1));
     ++src_changes;
-    ++dst_changes;
-    sc += src_width;
-    dc += dst_width;
+
+    if ( coverage )
+      coverage += src_width;
   }
 
+  dst->addBlockChanges (FRect{FPoint{ax, ay}, FPoint{ax + length - 1, ay + y_end - 1}});
+
   dst->changes_in_row.ymin = std::min(dst->changes_in_row.ymin, uInt(ay));
   dst->changes_in_row.ymax = std::max(dst->changes_in_row.ymax, uInt(ay + y_end - 1));
   dst->has_changes = true;
+
+  if ( dst != vterm.get() )
+    dst->markFlagsChanged();
 }
 
 //----------------------------------------------------------------------
@@ -878,6 +1039,7 @@ void FVTerm::determineWindowLayers() noexcept
 {
   // Determination of the window layer for all virtual windows
 
+  FTermRegion::invalidateCoverage();  // The window order has changed
   const auto* vterm_win_list = getWindowList();
 
   if ( ! vterm_win_list || vterm_win_list->empty() )
@@ -902,22 +1064,10 @@ void FVTerm::scrollRegionForward (FTermRegion* region)
   if ( ! region || region->size.height <= 1 )
     return;
 
+  const bool hardware_scrolling = canScrollTerminalLines(region);
   const int y_max = region->size.height - 1;
   const int x_max = region->size.width - 1;
-  auto line_changes = region->changes_in_line.begin();
-  const auto region_width = getFullRegionWidth(region);
-  auto sc = region->data.cbegin() + region_width;  // source character
-  auto dc = region->data.begin();  // destination character
-
-  for (auto y{0}; y < y_max; y++)
-  {
-    putRegionLine (*sc, *dc, region->size.width);
-    line_changes->xmin = 0;
-    line_changes->xmax = uInt(x_max);
-    ++line_changes;
-    sc += region_width;
-    dc += region_width;
-  }
+  region->rotateRows (0, y_max, 1);  // The first line becomes the last
 
   // insert a new line below
   const auto& lc = region->getFChar(x_max, region->size.height - 2);  // last character
@@ -925,13 +1075,22 @@ void FVTerm::scrollRegionForward (FTermRegion* region)
   nc.attr = lc.attr;
   nc.ch[0] = L' ';
   nc.ch[1] = L'\0';
-  dc = region->data.begin() + (region_width * y_max);  // destination character
+  const auto dc = region->getFCharIterator(0, y_max);  // destination character
   std::fill (dc, dc + region->size.width, nc);
-  auto new_line_changes = region->changes_in_line.begin() + y_max;
-  new_line_changes->xmin = 0;
-  new_line_changes->xmax = uInt(x_max);
-  region->changes_in_row = {0, uInt(y_max)};
+
+  if ( hardware_scrolling && scrollTerminalLines(region, 1) )
+  {
+    // The terminal has scrolled, only the new line must be drawn
+    shiftRegionLineChanges (region, 1);
+  }
+  else
+  {
+    region->addBlockChanges (FRect{FPoint{0, 0}, FPoint{x_max, y_max}});
+    region->changes_in_row = {0, uInt(y_max)};
+  }
+
   region->has_changes = true;
+  region->markFlagsChanged();  // The lines have been moved
 
   if ( region == vdesktop.get() )
     scrollTerminalForward();  // Scrolls the terminal up one line
@@ -945,22 +1104,10 @@ void FVTerm::scrollRegionReverse (FTermRegion* region)
   if ( ! region || region->size.height <= 1 )
     return;
 
+  const bool hardware_scrolling = canScrollTerminalLines(region);
   const int y_max = region->size.height - 1;
   const int x_max = region->size.width - 1;
-  auto line_changes = region->changes_in_line.begin() + y_max;
-  const auto region_width = getFullRegionWidth(region);
-  auto sc = region->data.cbegin() + (region_width * (y_max - 1));  // source character
-  auto dc = region->data.begin() + (region_width * y_max);  // destination character
-
-  for (auto y = y_max; y > 0; y--)
-  {
-    putRegionLine (*sc, *dc, region->size.width);
-    line_changes->xmin = 0;
-    line_changes->xmax = uInt(x_max);
-    --line_changes;
-    sc -= region_width;
-    dc -= region_width;
-  }
+  region->rotateRows (0, y_max, -1);  // The last line becomes the first
 
   // insert a new line above
   const auto& lc = region->getFChar(0, 1);  // last character
@@ -968,13 +1115,22 @@ void FVTerm::scrollRegionReverse (FTermRegion* region)
   nc.attr = lc.attr;
   nc.ch[0] = L' ';
   nc.ch[1] = L'\0';
-  dc = region->data.begin();  // destination character
+  const auto dc = region->getFCharIterator(0, 0);  // destination character
   std::fill (dc, dc + region->size.width, nc);
-  auto new_line_changes = region->changes_in_line.begin() + y_max;
-  new_line_changes->xmin = 0;
-  new_line_changes->xmax = uInt(x_max);
-  region->changes_in_row = {0, uInt(y_max)};
+
+  if ( hardware_scrolling && scrollTerminalLines(region, -1) )
+  {
+    // The terminal has scrolled, only the new line must be drawn
+    shiftRegionLineChanges (region, -1);
+  }
+  else
+  {
+    region->addBlockChanges (FRect{FPoint{0, 0}, FPoint{x_max, y_max}});
+    region->changes_in_row = {0, uInt(y_max)};
+  }
+
   region->has_changes = true;
+  region->markFlagsChanged();  // The lines have been moved
 
   if ( region == vdesktop.get() )
     scrollTerminalReverse();  // Scrolls the terminal down one line
@@ -1009,6 +1165,9 @@ void FVTerm::clearRegion (FTermRegion* region, wchar_t fillchar) noexcept
     clearRegionWithShadow(region, nc);
 
   auto line_changes = region->changes_in_line.begin();
+  region->damage.clear();
+  region->damage.add (FRect{ FPoint{0, 0}
+                           , FPoint{int(width) - 1, getFullRegionHeight(region) - 1} });
 
   for (auto i{0}; i < region->size.height; i++)
   {
@@ -1039,6 +1198,7 @@ void FVTerm::clearRegion (FTermRegion* region, wchar_t fillchar) noexcept
 
   region->changes_in_row = {0, uInt(getFullRegionHeight(region) - 1)};
   region->has_changes = true;
+  region->markFlagsChanged();
 }
 
 //----------------------------------------------------------------------
@@ -1060,9 +1220,20 @@ auto FVTerm::processTerminalUpdate() const -> bool
 
   // Update data on VTerm
   if ( skip_one_vterm_update )
+  {
     skip_one_vterm_update = false;
+    compose_time_us = 0;
+  }
   else
+  {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    using std::chrono::steady_clock;
+    const auto start = steady_clock::now();
     updateVTerm();
+    const auto duration = steady_clock::now() - start;
+    compose_time_us = uInt64(duration_cast<microseconds>(duration).count());
+  }
 
   // Update the visible terminal
   return updateTerminal();
@@ -1111,6 +1282,17 @@ auto FVTerm::isInitialized() noexcept -> bool
   return internal::var::fvterm_initialized;
 }
 
+//----------------------------------------------------------------------
+auto FVTerm::hasCompleteWindowIndex() noexcept -> bool
+{
+  // The spatial index can replace the iteration over the window list
+  // only if it contains all windows of the list
+
+  const auto* vterm_win_list = getWindowList();
+  const auto* index = getWindowIndex();
+  return vterm_win_list && index && index->getCount() == vterm_win_list->size();
+}
+
 //----------------------------------------------------------------------
 void FVTerm::resetRegionEncoding() const
 {
@@ -1147,11 +1329,16 @@ inline void FVTerm::resetTextRegionToDefault ( FTermRegion* region
     { 0x00080000U }  // char_width = 1
   };
   std::fill (region->data.begin(), region->data.end(), default_char);
+  region->row_table.clear();
+  std::fill ( region->flag_plane.begin(), region->flag_plane.end()
+            , FTermRegion::getTransparencyFlags(default_char) );
+  region->markFlagsChanged();
 
   const FTermRegion::FLineChanges unchanged { uInt(size.getWidth())
                                           , 0, 0, false };
   std::fill (region->changes_in_line.begin(), region->changes_in_line.end(), unchanged);
   region->changes_in_row = { uInt(size.getHeight()), 0};
+  region->damage.clear();
 }
 
 //----------------------------------------------------------------------
@@ -1173,6 +1360,7 @@ inline auto FVTerm::resizeTextRegion (FTermRegion* region, std::size_t size) con
   // Resize text region to "size" FChar elements
 
   region->data.resize(size);
+  region->flag_plane.resize(size);
   return true;
 }
 
@@ -1187,8 +1375,19 @@ auto FVTerm::isCovered (const FPoint& pos, const FTermRegion* region) const noex
     || vterm_win_list->back()->getVWin() == region )  // Top window can't be covered
     return CoveredState::None;
 
-  const auto pos_x = pos.getX();
-  const auto pos_y = pos.getY();
+  const auto x = pos.getX() - region->position.x;
+  const auto y = pos.getY() - region->position.y;
+  const auto width = getFullRegionWidth(region);
+
+  // Only a plane validated by getCoveragePlane() is used here,
+  // because rebuilding it would allocate memory
+  if ( region->coverage_plane_generation == FTermRegion::coverage_generation
+    && ! region->coverage_plane.empty() && x >= 0 && y >= 0
+    && x < width && y < getFullRegionHeight(region) )
+    return region->coverage_plane[std::size_t(y * width + x)];  // Cached state
+
+  if ( hasCompleteWindowIndex() )
+    return isCoveredByIndex (pos, region);
 
   auto is_covered{CoveredState::None};  // Initial state: no coverage
   bool found{ region == vdesktop.get() };
@@ -1206,37 +1405,237 @@ auto FVTerm::isCovered (const FPoint& pos, const FTermRegion* region) const noex
       continue;
     }
 
-    const int win_x_min = win->position.x;
-    const int win_y_min = win->position.y;
+    const auto state = getCoveredState(pos, win);
 
-    if ( pos_x < win_x_min || pos_y < win_y_min )
-      continue;
+    if ( state == CoveredState::Full )
+      return CoveredState::Full;  // Fully covered
 
-    const int current_height = win->minimized ? win->min_size.height
-                                              : getFullRegionHeight(win);
-    const int win_x_max = win_x_min + getFullRegionWidth(win);
-    const int win_y_max = win_y_min + current_height;
+    if ( state == CoveredState::Half )
+      is_covered = CoveredState::Half;  // Mark as partially covered
+  }
 
-    if ( pos_x >= win_x_max || pos_y >= win_y_max )
+  return is_covered;
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::isCoveredByIndex ( const FPoint& pos
+                              , const FTermRegion* region ) const noexcept -> CoveredState
+{
+  // Determines the covered state with the windows of the spatial index
+  // that share the tile of the given position
+
+  int layer{0};  // All windows are above the virtual desktop
+
+  if ( region != vdesktop.get() )
+  {
+    if ( ! region->visible || ! window_index->contains(region) )
+      return CoveredState::None;
+
+    layer = region->layer;
+  }
+
+  auto is_covered{CoveredState::None};  // Initial state: no coverage
+
+  for (const auto* win : window_index->getRegionsAt(pos.getX(), pos.getY()))
+  {
+    if ( ! win->visible || win->layer <= layer )
       continue;
 
-    // Position is covered by this window - check for transparency
-    const auto delta_x = pos_x - win->position.x;
-    const auto delta_y = pos_y - win->position.y;
-    const auto width = getFullRegionWidth(win);
-    const auto index = unsigned(delta_y) * unsigned(width) + unsigned(delta_x);
-    const auto& character = win->data[index];
+    const auto state = getCoveredState(pos, win);
+
+    if ( state == CoveredState::Full )
+      return CoveredState::Full;
+
+    if ( state == CoveredState::Half )
+      is_covered = CoveredState::Half;
+  }
+
+  return is_covered;
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::getCoveredState ( const FPoint& pos
+                                    , const FTermRegion* win ) const noexcept -> CoveredState
+{
+  // Returns the covered state of the position by the window
+
+  const auto pos_x = pos.getX();
+  const auto pos_y = pos.getY();
+  const int win_x_min = win->position.x;
+  const int win_y_min = win->position.y;
+
+  if ( pos_x < win_x_min || pos_y < win_y_min )
+    return CoveredState::None;
+
+  const int current_height = win->minimized ? win->min_size.height
+                                            : getFullRegionHeight(win);
+  const int win_x_max = win_x_min + getFullRegionWidth(win);
+  const int win_y_max = win_y_min + current_height;
+
+  if ( pos_x >= win_x_max || pos_y >= win_y_max )
+    return CoveredState::None;
+
+  // Position is covered by this window - check for transparency
+  const auto delta_x = pos_x - win->position.x;
+  const auto delta_y = pos_y - win->position.y;
+  const auto flags = win->getTransparencyFlags(delta_x, delta_y);
+
+  if ( flags & FTermRegion::TRANSPARENT_FLAG )
+    return CoveredState::None;
+
+  if ( flags & FTermRegion::COLOR_OVERLAY_FLAG )  // Color overlay = half covered
+    return CoveredState::Half;
+
+  return CoveredState::Full;
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::getCoveragePlane (const FTermRegion* region) const -> const FCoveragePlane&
+{
+  // Returns the coverage of all region characters by the windows above.
+  // The cached plane is used as long as no region has changed since it
+  // was validated (see FTermRegion::invalidateCoverage). Otherwise, it
+  // is only rebuilt if the region or a window above has been moved,
+  // resized, shown, hidden, raised or lowered, or if the transparency
+  // flags of a window above have changed. An empty plane is returned
+  // for regions outside the window stack.
+
+  if ( region->coverage_plane_generation == FTermRegion::coverage_generation )
+    return region->coverage_plane;
+
+  region->coverage_plane_generation = FTermRegion::coverage_generation;
+
+  if ( ! determineCoverageKeys(region) )
+  {
+    region->coverage_keys.clear();
+    region->coverage_plane.clear();
+    return region->coverage_plane;
+  }
+
+  if ( region->coverage_keys != coverage_key_buffer )
+    buildCoveragePlane(region);
+
+  return region->coverage_plane;
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::getCoverageKey (const FTermRegion* region) const noexcept -> CoverageKey
+{
+  const int current_height = region->minimized ? region->min_size.height
+                                               : getFullRegionHeight(region);
+  return { region, region->position.x, region->position.y
+         , getFullRegionWidth(region), current_height
+         , region->flag_revision, region->visible };
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::determineCoverageKeys (const FTermRegion* region) const -> bool
+{
+  // Stores the keys of the region and of all windows above it
+  // in coverage_key_buffer
+
+  const auto* vterm_win_list = getWindowList();
+  coverage_key_buffer.clear();
 
-    if ( character.isBitSet(FAttribute::set::transparent) )
+  if ( ! region || ! vterm_win_list )
+    return false;
+
+  coverage_key_buffer.push_back(getCoverageKey(region));
+  bool found{ region == vdesktop.get() };
+
+  for (const auto& vterm_obj : *vterm_win_list)
+  {
+    const auto* win = vterm_obj->getVWin();
+
+    if ( ! win )
       continue;
 
-    if ( character.isBitSet(FAttribute::set::color_overlay) )  // Color overlay = half covered
-      is_covered = CoveredState::Half;  // Mark as partially covered
+    if ( ! found )  // Windows below the region
+    {
+      found = ( region == win );
+      continue;
+    }
+
+    coverage_key_buffer.push_back(getCoverageKey(win));
+  }
+
+  return found;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::buildCoveragePlane (const FTermRegion* region) const
+{
+  const auto width = getFullRegionWidth(region);
+  const auto height = getFullRegionHeight(region);
+  const auto size = std::size_t(std::max(0, width) * std::max(0, height));
+  region->coverage_plane.assign(size, CoveredState::None);
+  region->coverage_keys = coverage_key_buffer;
+  auto iter = coverage_key_buffer.cbegin() + 1;  // Skip the region key
+
+  while ( iter != coverage_key_buffer.cend() )
+  {
+    if ( iter->visible )
+      addCoverageOfWindow (region, *iter);
+
+    ++iter;
+  }
+}
+
+//----------------------------------------------------------------------
+void FVTerm::addCoverageOfWindow ( const FTermRegion* region
+                                 , const CoverageKey& win_key ) const noexcept
+{
+  // Merges the coverage of the window above into the region plane.
+  // The flag plane of lines with pending changes is not yet up to date,
+  // so the flags of these lines are taken from the character data.
+
+  const auto* win = win_key.region;
+  const auto width = getFullRegionWidth(region);
+  const auto x_min = std::max(win_key.x, region->position.x);
+  const auto y_min = std::max(win_key.y, region->position.y);
+  const auto x_max = std::min(win_key.x + win_key.width, region->position.x + width);
+  const auto y_max = std::min ( win_key.y + win_key.height
+                              , region->position.y + getFullRegionHeight(region) );
+
+  if ( x_min >= x_max || y_min >= y_max )
+    return;  // No intersection
+
+  for (auto y{y_min}; y < y_max; y++)
+  {
+    const auto win_y = y - win_key.y;
+    const auto win_offset = int(win->getRowOffset(win_y)) + x_min - win_key.x;
+    const auto offset = (y - region->position.y) * width + x_min - region->position.x;
+    auto state = region->coverage_plane.begin() + offset;
+
+    if ( win->hasLineChanges(win_y) )
+    {
+      auto fchar = win->data.cbegin() + win_offset;
+      const auto fchar_end = fchar + (x_max - x_min);
+
+      for (; fchar < fchar_end; ++fchar, ++state)
+        addCoverage (*state, FTermRegion::getTransparencyFlags(*fchar));
+    }
     else
-      return CoveredState::Full;  // Fully covered
+    {
+      auto flags = win->flag_plane.cbegin() + win_offset;
+      const auto flags_end = flags + (x_max - x_min);
+
+      for (; flags < flags_end; ++flags, ++state)
+        addCoverage (*state, *flags);
+    }
   }
+}
 
-  return is_covered;
+//----------------------------------------------------------------------
+inline void FVTerm::addCoverage (CoveredState& state, uInt8 flags) noexcept
+{
+  if ( flags & FTermRegion::TRANSPARENT_FLAG )
+    return;
+
+  if ( ! (flags & FTermRegion::COLOR_OVERLAY_FLAG) )
+    state = CoveredState::Full;
+  else if ( state == CoveredState::None )
+    state = CoveredState::Half;  // Color overlay = half covered
 }
 
 //----------------------------------------------------------------------
@@ -1319,7 +1718,10 @@ void FVTerm::passChangesToOverlap (const FTermRegion* region) const
   if ( ! region || ! vterm_win_list || vterm_win_list->empty() )
     return;
 
-  processOverlappingWindows (region, *vterm_win_list);
+  if ( hasCompleteWindowIndex() )
+    processOverlappingWindowsByIndex (region);
+  else
+    processOverlappingWindows (region, *vterm_win_list);
 }
 
 //----------------------------------------------------------------------
@@ -1346,6 +1748,23 @@ inline void FVTerm::processOverlappingWindows ( const FTermRegion* region
   }
 }
 
+//----------------------------------------------------------------------
+inline void FVTerm::processOverlappingWindowsByIndex (const FTermRegion* region) const
+{
+  // Only windows from the tiles of the region can overlap it
+
+  if ( ! window_index->contains(region) )
+    return;
+
+  findOverlappingRegions (region);
+
+  for (auto* win : index_search_buffer)
+  {
+    if ( win->visible && win->layer > region->layer && win->isOverlapped(region) )
+      passChangesToOverlappingWindow (win, region);
+  }
+}
+
 //----------------------------------------------------------------------
 inline void FVTerm::passChangesToOverlappingWindow (FTermRegion* win, const FTermRegion* region) const noexcept
 {
@@ -1389,9 +1808,7 @@ inline void FVTerm::passChangesToOverlappingWindowLine ( FTermRegion* win
   const int x_end = calculateEndCoordinate (vterm_x_max, region_x_max, win_x_min, win_x_max);
 
   // Sets the new change boundaries
-  auto& line_changes = win->changes_in_line[unsigned(y)];
-  line_changes.xmin = uInt(std::min(int(line_changes.xmin), x_start));
-  line_changes.xmax = uInt(std::max(int(line_changes.xmax), x_end));
+  win->addLineChanges (uInt(y), uInt(x_start), uInt(x_end));
 }
 
 //----------------------------------------------------------------------
@@ -1554,48 +1971,167 @@ inline void FVTerm::buildLineChangeBatch ( const FTermRegion* region
 inline void FVTerm::applyLineBatch ( FTermRegion* region
                                    , const LayerGeometry& geo ) const noexcept
 {
+  if ( isParallelLineBatch() )
+  {
+    applyLineBatchInBands (region, geo);
+  }
+  else
+  {
+    for (const auto& line : line_changes_batch)
+    {
+      // Process all lines in batch with same operation
+      for (int i = 0; i < line.count; ++i)
+      {
+        const auto y = line.ypos + i;
+        const auto ty = geo.region_y + y;  // Global terminal y-position
+
+        if ( applyLineBatchRow(region, geo, line, y, damage_spans) )
+          region->markFlagsChanged();  // Invalidates the coverage of the windows below
+
+        for (const auto& span : damage_spans)
+          vterm->addLineChanges (uInt(ty), uInt(span.xmin), uInt(span.xmax));
+      }
+    }
+  }
+
+  region->resetDamage();  // Keep only the damage of unprocessed lines
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::isParallelLineBatch() const noexcept -> bool
+{
+  // Only large batches compensate the synchronization costs
+
+  if ( ! internal::var::compositor_pool )
+    return false;
+
+  std::size_t rows{0};
+  std::size_t cells{0};
+
   for (const auto& line : line_changes_batch)
   {
-    const auto line_xmin = line.xmin;
-    const auto line_xmax = line.xmax;
-    const auto has_no_trans = line.has_no_transparency == NoTrans::Set;
-    const auto tx = geo.region_x + line_xmin;  // Global terminal x-position
-    const int length = line_xmax - line_xmin + 1;
+    rows += std::size_t(line.count);
+    cells += std::size_t(line.count) * std::size_t(line.xmax - line.xmin + 1);
+  }
 
-    // Process all lines in batch with same operation
+  return rows > 1 && cells >= MIN_PARALLEL_CELLS;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::applyLineBatchInBands ( FTermRegion* region
+                                   , const LayerGeometry& geo ) const noexcept
+{
+  // Distributes bands of consecutive rows to the worker pool. Different
+  // rows never share region or vterm data, so only the vterm damage and
+  // the flag revision are updated afterwards in ascending row order.
+  // This gives the same result as the serial path.
+
+  batch_rows.clear();
+
+  for (const auto& line : line_changes_batch)
     for (int i = 0; i < line.count; ++i)
+      batch_rows.push_back({1, line.ypos + i, line.xmin, line.xmax, line.has_no_transparency});
+
+  auto& pool = *internal::var::compositor_pool;
+  const auto row_count = batch_rows.size();
+  const auto band_count = std::min(2 * pool.getThreadCount(), row_count);
+
+  if ( row_bands.size() < band_count )
+    row_bands.resize(band_count);
+
+  pool.run ( band_count
+           , [this, region, &geo, row_count, band_count] (std::size_t index)
+             {
+               auto& band = row_bands[index];
+               const auto first = row_count * index / band_count;
+               const auto last = row_count * (index + 1) / band_count;
+               band.composited_spans.clear();
+               band.flag_changes = 0;
+
+               for (auto i{first}; i < last; i++)
+               {
+                 const auto& row = batch_rows[i];
+                 const auto ty = geo.region_y + row.ypos;
+
+                 if ( applyLineBatchRow(region, geo, row, row.ypos, band.damage_spans) )
+                   band.flag_changes++;
+
+                 for (const auto& span : band.damage_spans)
+                   band.composited_spans.push_back({ty, span.xmin, span.xmax});
+               }
+             } );
+
+  for (std::size_t index{0}; index < band_count; index++)
+  {
+    const auto& band = row_bands[index];
+
+    for (const auto& span : band.composited_spans)
+      vterm->addLineChanges (uInt(span.y), uInt(span.xmin), uInt(span.xmax));
+
+    if ( band.flag_changes > 0 )
     {
-      const auto y = line.ypos + i;
-      auto line_changes = region->changes_in_line.begin() + y;
-      const auto ty = geo.region_y + y;  // Global terminal y-position
-      const auto region_line_offset = y * geo.width + line_xmin;
-      const auto vterm_line_offset = ty * geo.vterm_width + tx;
-      auto ac = region->data.begin() + region_line_offset;    // Region character
-      auto tc = vterm->data.begin() + vterm_line_offset;  // Terminal character
-
-      if ( has_no_trans )
-      {
-        // Line has only covered characters
-        putRegionLine (*ac, *tc, length);
-      }
-      else
-      {
-        // Line with hidden and transparent characters
-        addRegionLineWithTransparency (ac, tc, length);
-      }
+      region->flag_revision += band.flag_changes;
+      FTermRegion::invalidateCoverage();
+    }
+  }
+}
 
-      auto vterm_changes = vterm->changes_in_line.begin() + ty;
-      const auto tx_start = uInt(tx);
-      const auto tx_end   = uInt(std::min( geo.ax + line_xmax
-                                         , geo.vterm_width - 1 ));
-      vterm_changes->xmin = std::min(vterm_changes->xmin, tx_start);
-      vterm_changes->xmax = std::max(vterm_changes->xmax, tx_end);
+//----------------------------------------------------------------------
+inline auto FVTerm::applyLineBatchRow ( FTermRegion* region
+                                      , const LayerGeometry& geo
+                                      , const LineChanges& line
+                                      , int y
+                                      , FDamageList::FSpanVec& spans ) const noexcept -> bool
+{
+  // Copies the damaged spans of region line y into vterm and
+  // replaces the spans with the written vterm columns.
+  // Returns true if the transparency flags of the line have changed.
 
-      line_changes->xmin = uInt(geo.width);
-      line_changes->xmax = 0;
-      ++line_changes;
+  const auto line_xmin = line.xmin;
+  const auto line_xmax = line.xmax;
+  const auto has_no_trans = line.has_no_transparency == NoTrans::Set;
+  auto& line_changes = region->changes_in_line[unsigned(y)];
+  const auto ty = geo.region_y + y;  // Global terminal y-position
+  region->getDamagedSpans (y, spans);
+  auto written = spans.begin();
+
+  // Copy only the damaged spans of the line
+  for (const auto& span : spans)
+  {
+    const auto span_xmin = std::max(span.xmin, line_xmin);
+    const auto span_xmax = std::min(span.xmax, line_xmax);
+
+    if ( span_xmin > span_xmax )
+      continue;
+
+    const auto tx = geo.region_x + span_xmin;  // Global terminal x-position
+    const int length = span_xmax - span_xmin + 1;
+    auto ac = region->getFCharIterator(span_xmin, y);  // Region character
+    auto tc = vterm->getFCharIterator(tx, ty);  // Terminal character
+
+    if ( has_no_trans )
+    {
+      // Line has only covered characters
+      putRegionLine (*ac, *tc, length);
     }
+    else
+    {
+      // Line with hidden and transparent characters
+      addRegionLineWithTransparency (ac, tc, length);
+    }
+
+    const auto tx_end = std::min(geo.region_x + span_xmax, geo.vterm_width - 1);
+    *written = {tx, tx_end};
+    ++written;
   }
+
+  spans.erase (written, spans.end());
+  const bool flags_changed = region->copyTransparencyFlags ( uInt(y)
+                                                           , line_changes.xmin
+                                                           , line_changes.xmax );
+  line_changes.xmin = uInt(geo.width);
+  line_changes.xmax = 0;
+  return flags_changed;
 }
 
 //----------------------------------------------------------------------
@@ -1634,6 +2170,7 @@ inline void FVTerm::scrollTerminalForward() const
     ++vdesktop_changes;
   }
 
+  vdesktop->resetDamage();
   vdesktop->changes_in_row = {0, uInt(vdesktop->size.height - 2)};
   putRegion (FPoint{1, 1}, vdesktop.get());
   saveCurrentVTerm();  // Ensure that the current terminal is comparable
@@ -1662,12 +2199,126 @@ inline void FVTerm::scrollTerminalReverse() const
     ++vdesktop_changes;
   }
 
+  vdesktop->resetDamage();
   vdesktop->changes_in_row = {1, uInt(vdesktop->size.height - 1)};
   putRegion (FPoint{1, 1}, vdesktop.get());
   saveCurrentVTerm();  // Ensure that the current terminal is comparable
   forceTerminalUpdate();
 }
 
+//----------------------------------------------------------------------
+auto FVTerm::canScrollTerminalLines (const FTermRegion* region) const -> bool
+{
+  // A window can be scrolled by the terminal if its lines fill the
+  // full terminal width without transparent characters and if no
+  // other window covers it. Narrower windows would require left and
+  // right margins (DECSLRM), which many terminals do not support,
+  // so they are always scrolled in the virtual terminal. While the
+  // terminal updates are paused, nothing may be written to the
+  // terminal.
+
+  if ( areTerminalUpdatesPaused()
+    || region == vdesktop.get()
+    || ! region->visible
+    || region->minimized
+    || region->shadow.width != 0
+    || region->position.x != 0
+    || region->size.width != vterm->size.width
+    || region->position.y < 0
+    || region->position.y + region->size.height > vterm->size.height )
+    return false;
+
+  const auto line_changes_end = region->changes_in_line.cbegin()
+                              + region->size.height;
+  const auto has_transparency = [] (const FTermRegion::FLineChanges& line_changes)
+  {
+    return line_changes.trans_count != 0;
+  };
+
+  if ( std::any_of( region->changes_in_line.cbegin(), line_changes_end
+                  , has_transparency ) )
+    return false;
+
+  const auto& coverage_plane = getCoveragePlane(region);
+
+  if ( coverage_plane.empty() )  // Not in the window list
+    return false;
+
+  if ( region->coverage_keys.size() == 1 )  // No window above
+    return true;
+
+  const auto covered_end = coverage_plane.cbegin()
+                         + region->size.width * region->size.height;
+  return std::all_of ( coverage_plane.cbegin(), covered_end
+                     , [] (CoveredState state)
+                       {
+                         return state == CoveredState::None;
+                       } );
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::scrollTerminalLines (const FTermRegion* region, int lines) const -> bool
+{
+  // Scrolls the terminal lines of the region by one line up (lines > 0)
+  // or down (lines < 0) and shifts the virtual terminal in the same way
+
+  const int top = region->position.y;
+  const int bottom = top + region->size.height - 1;
+
+  if ( ! foutput->scrollTerminalLines(top, bottom, lines) )
+    return false;
+
+  // The old terminal content was scrolled by the terminal itself
+  vterm->rotateRows (top, bottom, lines);
+  vterm_old->rotateRows (top, bottom, lines);
+
+  auto changes_begin = vterm->changes_in_line.begin() + top;
+  auto changes_end = vterm->changes_in_line.begin() + bottom + 1;
+  std::rotate ( changes_begin
+              , ( lines > 0 ) ? changes_begin + 1 : changes_end - 1
+              , changes_end );
+  vterm->resetDamage();
+
+  if ( vterm->changes_in_row.ymin <= vterm->changes_in_row.ymax )
+  {
+    vterm->changes_in_row.ymin = std::min(vterm->changes_in_row.ymin, uInt(top));
+    vterm->changes_in_row.ymax = std::max(vterm->changes_in_row.ymax, uInt(bottom));
+  }
+
+  // The new terminal line is empty and can never be equal
+  // to a character of the virtual terminal
+  FChar invalid_char{};
+  invalid_char.color.data = FCellColor{FColor::Undefined, FColor::Undefined}.data;
+  invalid_char.ch[0] = L'\0';
+  const auto new_line = vterm_old->getFCharIterator(0, ( lines > 0 ) ? bottom : top);
+  std::fill (new_line, new_line + vterm->size.width, invalid_char);
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::shiftRegionLineChanges (FTermRegion* region, int lines) const noexcept
+{
+  // Moves the pending line changes with the scrolled lines
+  // and marks the new line as changed
+
+  const int y_max = region->size.height - 1;
+  const auto new_y = uInt(( lines > 0 ) ? y_max : 0);
+  const auto changes_begin = region->changes_in_line.begin();
+  const auto changes_end = changes_begin + region->size.height;
+  std::rotate ( changes_begin
+              , ( lines > 0 ) ? changes_begin + 1 : changes_end - 1
+              , changes_end );
+  region->changes_in_line[new_y].trans_count = 0;
+  region->resetDamage();
+  region->addLineChanges (new_y, 0, uInt(region->size.width - 1));
+  auto& changes_in_row = region->changes_in_row;
+
+  if ( changes_in_row.ymin <= changes_in_row.ymax )
+    changes_in_row = {0, std::max(changes_in_row.ymax, uInt(y_max))};
+  else
+    changes_in_row = {new_y, new_y};
+}
+
 //--------------------------------------------------------------------setTermAttributes--
 void FVTerm::callPreprocessingHandler (const FTermRegion* region) const
 {
@@ -1768,8 +2419,13 @@ void FVTerm::initSettings()
   createVDesktop (term_size);
   active_region = vdesktop.get();
 
+  // Create the spatial index of the window regions
+  window_index = std::make_shared<FWindowIndex>();
+  window_index->setSize(term_size);
+
   // Reserving a typical number of changes
   line_changes_batch.reserve(32);
+  damage_spans.reserve(FDamageList::MAX_RECTS);
 
   // Reservation of capacity for at least 16 regions
   covered_regions_buffer.reserve(16);
@@ -1795,6 +2451,7 @@ inline void FVTerm::saveCurrentVTerm() const noexcept
 {
   // Save the content of the virtual terminal
   std::memcpy(vterm_old->data.data(), vterm->data.data(), vterm->data.size() * sizeof(FChar));
+  vterm_old->row_table = vterm->row_table;
 }
 
 //----------------------------------------------------------------------
@@ -1862,8 +2519,7 @@ inline void FVTerm::putMultiLayerRegionLine ( FChar_iterator dst_char
     // Precalculate array indexing values for getFChar
     const auto x = term_x - x_min;
     const auto y = term_y - y_min;
-    const auto width = getFullRegionWidth(win);
-    const auto index = y * width + x;
+    const auto index = int(win->getRowOffset(y)) + x;
 
     // Calculate the intersection of the line with the window
     const auto start_idx = std::max(0, x_min - term_x);
@@ -1872,7 +2528,8 @@ inline void FVTerm::putMultiLayerRegionLine ( FChar_iterator dst_char
     // Store pre-calculated region line data
     overlay_line_buffer.push_back
     (
-      { win->data.begin(), index, start_idx, end_idx }
+      { win->data.begin(), win->flag_plane.cbegin(), index
+      , start_idx, end_idx, ! win->hasLineChanges(y) }
     );
   }
 
@@ -1880,18 +2537,22 @@ inline void FVTerm::putMultiLayerRegionLine ( FChar_iterator dst_char
   {
     auto offset = line.start_idx + line.offset;
     auto win_char = line.iter + offset;
+    auto win_flags = line.flags + offset;
     auto dst = dst_char + line.start_idx;
 
     // Process only the intersecting part of the line
-    for (std::ptrdiff_t idx{line.start_idx}; idx < line.end_idx; ++idx, ++win_char, ++dst)
+    for ( std::ptrdiff_t idx{line.start_idx}; idx < line.end_idx
+        ; ++idx, ++win_char, ++win_flags, ++dst )
     {
       auto& char_search = *(search_buffer + idx);
 
       if ( char_search == SearchState::ready )
         continue;
 
-      const auto transparency = win_char->attr.data
-                              & internal::var::transparent_mask;
+      // Read the dense flag plane to avoid loading transparent characters
+      const auto transparency = line.use_flags
+                              ? uInt32(*win_flags) << FTermRegion::FLAG_SHIFT
+                              : win_char->attr.data & internal::var::transparent_mask;
 
       if ( transparency == FAttribute::set::transparent )  // Transparent
       {
@@ -1957,100 +2618,69 @@ inline void FVTerm::putRegionLineWithTransparency ( FChar_const_iterator src_cha
                                                   , FChar_iterator dst_char
                                                   , const int length
                                                   , FPoint pos
-                                                  , bool line_covered) const
+                                                  , bool line_covered
+                                                  , const CoveredState* coverage ) const
 {
-  if ( length < 1 )
-    return;
+  auto remaining = std::size_t(std::max(0, length));
 
-  bool is_region_transparent = isFCharTransparent(*src_char);
-  int region_count{1};
-  const auto end_char = src_char + length;
-  auto region_start = src_char;
-  auto current_char = src_char + 1;
-  const auto unroll_end = end_char - 3;
-
-  while ( current_char < unroll_end )  // Main unrolled loop
-  {
-    const std::array<bool, 4> trans_data
-    {{
-      isFCharTransparent(*current_char),
-      isFCharTransparent(*(current_char + 1)),
-      isFCharTransparent(*(current_char + 2)),
-      isFCharTransparent(*(current_char + 3))
-    }};
-
-    if ( trans_data[0] == is_region_transparent
-      && trans_data[1] == is_region_transparent
-      && trans_data[2] == is_region_transparent
-      && trans_data[3] == is_region_transparent )
-    {
-      region_count += 4;
-      current_char += 4;
-      continue;
-    }
+  while ( remaining > 0 )
+  {
+    // Determine the region of characters with the same transparency
+    const bool is_region_transparent = isFCharTransparent(*src_char);
+    const auto region_count = getAttributeRunLength ( &*src_char, remaining
+                                                    , internal::var::transparent_mask
+                                                    , is_region_transparent );
+    const auto count = int(region_count);
 
-    for (uInt i = 0; i < 4; ++i)
-    {
-      const bool is_current_char_transparent = trans_data[i];
+    if ( is_region_transparent || (line_covered && ! coverage) )
+      putMultiLayerRegionLine (dst_char, count, pos);
+    else if ( line_covered )
+      putPartlyCoveredRegionLine (src_char, dst_char, count, pos, coverage);
+    else
+      putRegionLine (*src_char, *dst_char, count);
 
-      if ( is_current_char_transparent == is_region_transparent )
-      {
-        ++region_count;
-      }
-      else
-      {
-        // Process completed region
-        if ( is_region_transparent || line_covered )
-          putMultiLayerRegionLine (dst_char, region_count, pos);
-        else
-          putRegionLine (*region_start, *dst_char, region_count);
-
-        pos.x_ref() += region_count;
-        dst_char += region_count;
-
-        // Reset for the next region
-        is_region_transparent = is_current_char_transparent;
-        region_start = current_char;
-        region_count = 1;
-      }
+    pos.x_ref() += count;
+    src_char += count;
+    dst_char += count;
+    remaining -= region_count;
 
-      ++current_char;
-    }
+    if ( coverage )
+      coverage += count;
   }
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::putPartlyCoveredRegionLine ( FChar_const_iterator src_char
+                                               , FChar_iterator dst_char
+                                               , const int length
+                                               , FPoint pos
+                                               , const CoveredState* coverage ) const
+{
+  // Copies the uncovered runs of non-transparent characters directly
+  // and composes only the covered runs from the overlapping layers
+
+  int remaining{length};
 
-  while ( current_char < end_char )  // Process remaining characters (tail)
+  while ( remaining > 0 )
   {
-    const bool is_current_transparent = isFCharTransparent(*current_char);
+    const bool is_covered = *coverage != CoveredState::None;
+    int count{1};
 
-    if ( is_current_transparent == is_region_transparent )
-    {
-      ++region_count;
-    }
+    while ( count < remaining
+         && (coverage[count] != CoveredState::None) == is_covered )
+      count++;
+
+    if ( is_covered )
+      putMultiLayerRegionLine (dst_char, count, pos);
     else
-    {
-      // Process completed region
-      if ( is_region_transparent || line_covered )
-        putMultiLayerRegionLine (dst_char, region_count, pos);
-      else
-        putRegionLine (*region_start, *dst_char, region_count);
-
-      pos.x_ref() += region_count;
-      dst_char += region_count;
-
-      // Start new region
-      is_region_transparent = is_current_transparent;
-      region_start = current_char;
-      region_count = 1;
-    }
+      putRegionLine (*src_char, *dst_char, count);
 
-    ++current_char;
+    pos.x_ref() += count;
+    src_char += count;
+    dst_char += count;
+    coverage += count;
+    remaining -= count;
   }
-
-  // Handle the final region
-  if ( is_region_transparent || line_covered )
-    putMultiLayerRegionLine (dst_char, region_count, pos);
-  else
-    putRegionLine (*region_start, *dst_char, region_count);
 }
 
 //----------------------------------------------------------------------
@@ -2058,43 +2688,25 @@ inline void FVTerm::addRegionLineWithTransparency ( FChar_const_iterator src_cha
                                                   , FChar_iterator dst_char
                                                   , const int length ) const
 {
-  if ( length == 0 )
-    return;
-
-  const auto handle_region = \
-      [this, &dst_char] ( bool transparent
-                        , int count
-                        , FChar_const_iterator start )
-  {
-    if ( transparent )
-      addTransparent (start, dst_char, count);
-    else
-      putNonTransparent (start, dst_char, count);
-  };
+  auto remaining = std::size_t(std::max(0, length));
 
-  const auto end_char = src_char + length;
-  auto region_start = src_char;
-  int region_count{1};
-  bool is_region_transparent{isFCharTransparent(*src_char)};
-
-  for (auto current_char = src_char + 1; current_char < end_char; ++current_char)
+  while ( remaining > 0 )
   {
-    const bool is_current_char_transparent = isFCharTransparent(*current_char);
+    // Determine the region of characters with the same transparency
+    const bool is_region_transparent = isFCharTransparent(*src_char);
+    const auto region_count = getAttributeRunLength ( &*src_char, remaining
+                                                    , internal::var::transparent_mask
+                                                    , is_region_transparent );
+    auto count = int(region_count);
+    auto region_start = src_char;
+    src_char += count;
+    remaining -= region_count;
 
-    if ( is_current_char_transparent == is_region_transparent )
-      ++region_count;
+    if ( is_region_transparent )
+      addTransparent (region_start, dst_char, count);
     else
-    {
-      handle_region (is_region_transparent, region_count, region_start);
-      // Reset for the next region
-      is_region_transparent = is_current_char_transparent;
-      region_start = current_char;
-      region_count = 1;
-    }
+      putNonTransparent (region_start, dst_char, count);
   }
-
-  // Handle the final region
-  handle_region (is_region_transparent, region_count, region_start);
 }
 
 //----------------------------------------------------------------------
@@ -2176,6 +2788,9 @@ auto FVTerm::clearFullRegion (FTermRegion* region, FChar& fillchar) const -> boo
       ++vdesktop_changes;
     }
 
+    vdesktop->damage.clear();
+    vdesktop->damage.add (FRect{ FPoint{0, 0}
+                               , FPoint{vdesktop->size.width - 1, vdesktop->size.height - 1} });
     vdesktop->changes_in_row = {0, uInt(vdesktop->size.height - 1)};
     vdesktop->has_changes = true;
   }
@@ -2306,11 +2921,16 @@ inline auto FVTerm::printCharacter ( FTermRegion* region
   {
     region->cursor.x = 1;
     region->cursor.y++;
+
+    // The next line does not have to follow in memory (see row_table)
+    ac = ( region->cursor.y > getFullRegionHeight(region) )
+         ? region->data.end()
+         : region->getFCharIterator(0, region->cursor.y - 1);
   }
   else if ( char_width == 2 )
   {
     printPaddingCharacter (region, term_char);
-    ++ac;
+    ac = region->getFCharIterator(region->cursor.x - 1, region->cursor.y - 1);
   }
 
   // Prevent up scrolling
@@ -2338,6 +2958,9 @@ inline auto FVTerm::printCharacterOnCoordinate ( FTermRegion* region
   if ( trans_changed != 0 )
     region->changes_in_line[ay].trans_count += uInt(trans_changed);
 
+  if ( FTermRegion::getTransparencyFlags(*ac) != FTermRegion::getTransparencyFlags(ch) )
+    region->markFlagsChanged();
+
   // copy character to region
   *ac = ch;
 
@@ -2433,6 +3056,12 @@ inline void FVTerm::determineCoveredRegions (FTermRegion* src) const
     return;
   }
 
+  if ( hasCompleteWindowIndex() )
+  {
+    determineCoveredRegionsByIndex(src);
+    return;
+  }
+
   const auto end = vterm_win_list->crend();
   const auto src_layer = src->layer;
 
@@ -2461,6 +3090,49 @@ inline void FVTerm::determineCoveredRegions (FTermRegion* src) const
   addVDesktopToListIfExists(covered_regions_buffer);
 }
 
+//----------------------------------------------------------------------
+inline void FVTerm::determineCoveredRegionsByIndex (FTermRegion* src) const
+{
+  findOverlappingRegions (src);
+  auto& candidates = index_search_buffer;
+  const auto src_layer = src->layer;
+
+  // Regions from top to bottom
+  std::sort ( candidates.begin(), candidates.end()
+            , [] (const FTermRegion* lhs, const FTermRegion* rhs)
+              {
+                return lhs->layer > rhs->layer;
+              } );
+
+  for (const auto* win : candidates)
+  {
+    if ( ! win->visible || win->layer < 1 || ! win->isOverlapped(src) )
+      continue;
+
+    covered_regions_buffer.push_back(win);
+
+    if ( win->layer <= src_layer )
+      continue;
+
+    determineLineCoveredState(win, src);
+  }
+
+  addVDesktopToListIfExists(covered_regions_buffer);
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::findOverlappingRegions (const FTermRegion* region) const
+{
+  // Stores the candidates of the spatial index in index_search_buffer
+
+  const auto height = region->minimized ? region->min_size.height
+                                        : getFullRegionHeight(region);
+  const FRect box { FPoint{region->position.x, region->position.y}
+                  , FSize{ std::size_t(std::max(getFullRegionWidth(region), 0))
+                         , std::size_t(std::max(height, 0)) } };
+  window_index->getRegionsIn (box, index_search_buffer);
+}
+
 //----------------------------------------------------------------------
 inline void FVTerm::resetLineCoveredState (FTermRegion* src) const
 {
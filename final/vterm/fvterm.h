@@ -51,6 +51,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <tuple>
 #include <utility>
@@ -63,6 +64,7 @@
 #include "final/util/frect.h"
 #include "final/util/fsize.h"
 #include "final/util/fstringstream.h"
+#include "final/vterm/fdamagelist.h"
 #include "final/vterm/fvtermattribute.h"
 #include "final/vterm/fvtermbuffer.h"
 
@@ -82,6 +84,7 @@ class FString;
 class FStyle;
 class FVTermBuffer;
 class FWidget;
+class FWindowIndex;
 
 template <typename FOutputType>
 struct outputClass
@@ -167,6 +170,10 @@ class FVTerm : public FVTermAttribute
     auto  getVWin() const noexcept -> const FTermRegion*;
     auto  getPrintCursor() -> FPoint;
     static auto  getWindowList() noexcept -> FVTermList*;
+    static auto  getWindowIndex() noexcept -> FWindowIndex*;
+    static auto  getCompositorThreads() noexcept -> std::size_t;
+    static auto  getComposeTime() noexcept -> uInt64;
+    static auto  getLastVirtualTerminal() noexcept -> const FTermRegion*;
 
     // Mutators
     void  setTerminalUpdates (TerminalUpdate) const;
@@ -174,12 +181,14 @@ class FVTerm : public FVTermAttribute
     void  setVWin (std::unique_ptr<FTermRegion>&&) noexcept;
     static void  setNonBlockingRead (bool = true);
     static void  unsetNonBlockingRead();
+    static void  setCompositorThreads (std::size_t);
 
     // Predicates
     static auto  isDrawingFinished() noexcept -> bool;
     static auto  isTerminalUpdateForced() noexcept -> bool;
     static auto  areTerminalUpdatesPaused() noexcept -> bool;
     static auto  hasPendingTerminalUpdates() noexcept -> bool;
+    static auto  hasCompleteWindowIndex() noexcept -> bool;
     auto hasPreprocessingHandler (const FVTerm*) noexcept -> bool;
 
     // Methods
@@ -190,6 +199,7 @@ class FVTerm : public FVTermAttribute
     void  putVTerm() const;
     auto  updateTerminal() const -> bool;
     static void reduceTerminalLineUpdates (uInt);
+    static void shiftLastTerminalLines (int, int, int);
     virtual void addPreprocessingHandler ( const FVTerm*
                                          , FPreprocessingFunction&& );
     virtual void delPreprocessingHandler (const FVTerm*);
@@ -246,6 +256,7 @@ class FVTerm : public FVTermAttribute
     auto  createRegion (const FRect&) -> std::unique_ptr<FTermRegion>;
     void  resizeRegion (const FShadowBox&, FTermRegion*) const;
     void  resizeRegion (const FRect&, FTermRegion*) const;
+    void  updateWindowIndex (const FTermRegion*) const;
     void  restoreVTerm (const FRect&) const noexcept;
     auto  updateVTermCursor (const FTermRegion*) const noexcept -> bool;
     void  hideVTermCursor() const noexcept;
@@ -284,10 +295,12 @@ class FVTerm : public FVTermAttribute
 
     struct RegionLine
     {
-      FChar_const_iterator iter;       // Source drawing region line
-      std::ptrdiff_t       offset;     // Source data offset
-      std::ptrdiff_t       start_idx;  // Start index
-      std::ptrdiff_t       end_idx;    // End index
+      FChar_const_iterator               iter;       // Source drawing region line
+      std::vector<uInt8>::const_iterator flags;      // Source flag plane
+      std::ptrdiff_t                     offset;     // Source data offset
+      std::ptrdiff_t                     start_idx;  // Start index
+      std::ptrdiff_t                     end_idx;    // End index
+      bool                               use_flags;  // Flag plane is up to date
     };
 
     enum class NoTrans : sInt8
@@ -306,8 +319,44 @@ class FVTerm : public FVTermAttribute
       NoTrans  has_no_transparency;
     };
 
+    struct CoverageKey  // Region state that determines the coverage
+    {
+      const FTermRegion* region;
+      int   x;
+      int   y;
+      int   width;          // Full region width
+      int   height;         // Effective region height (minimized or full)
+      uInt  flag_revision;  // Change counter of the flag plane
+      bool  visible;
+
+      friend constexpr auto operator == ( const CoverageKey& lhs
+                                        , const CoverageKey& rhs ) noexcept -> bool
+      {
+        return lhs.region == rhs.region
+            && lhs.x == rhs.x && lhs.y == rhs.y
+            && lhs.width == rhs.width && lhs.height == rhs.height
+            && lhs.flag_revision == rhs.flag_revision
+            && lhs.visible == rhs.visible;
+      }
+    };
+
+    struct CompositedSpan  // Written vterm columns of a line
+    {
+      int  y;
+      int  xmin;
+      int  xmax;
+    };
+
+    struct RowBand  // Working data of a parallel composited row band
+    {
+      FDamageList::FSpanVec       damage_spans{};
+      std::vector<CompositedSpan> composited_spans{};
+      uInt                        flag_changes{0};
+    };
+
     // Constants
     static constexpr int DEFAULT_MINIMIZED_HEIGHT = 1;
+    static constexpr std::size_t MIN_PARALLEL_CELLS = 16384;  // Smallest batch for the worker pool
 
     // Enumeration
     enum class CoveredState : uInt8
@@ -330,6 +379,9 @@ class FVTerm : public FVTermAttribute
     using FOverlaySearchBuffer = std::vector<SearchState>;
     using FOverlayLineBuffer = std::vector<RegionLine>;
     using FLineChangesBatch = std::vector<LineChanges>;
+    using FCoverageKeys = std::vector<CoverageKey>;
+    using FCoveragePlane = std::vector<CoveredState>;
+    using FRowBandVector = std::vector<RowBand>;
 
     // Methods
     static void setGlobalFVTermInstance (FVTerm*) noexcept;
@@ -340,6 +392,14 @@ class FVTerm : public FVTermAttribute
     auto  resizeTextRegion (FTermRegion*, std::size_t, std::size_t ) const -> bool;
     auto  resizeTextRegion (FTermRegion*, std::size_t) const -> bool;
     auto  isCovered (const FPoint&, const FTermRegion*) const noexcept -> CoveredState;
+    auto  isCoveredByIndex (const FPoint&, const FTermRegion*) const noexcept -> CoveredState;
+    auto  getCoveredState (const FPoint&, const FTermRegion*) const noexcept -> CoveredState;
+    auto  getCoveragePlane (const FTermRegion*) const -> const FCoveragePlane&;
+    auto  getCoverageKey (const FTermRegion*) const noexcept -> CoverageKey;
+    auto  determineCoverageKeys (const FTermRegion*) const -> bool;
+    void  buildCoveragePlane (const FTermRegion*) const;
+    void  addCoverageOfWindow (const FTermRegion*, const CoverageKey&) const noexcept;
+    static void addCoverage (CoveredState&, uInt8) noexcept;
     auto  isRegionValid (const FShadowBox&) const noexcept -> bool;
     auto  isSizeEqual (const FTermRegion*, const FShadowBox&) const noexcept -> bool;
     constexpr auto  needsHeightResize (const FTermRegion*, const std::size_t) const noexcept -> bool;
@@ -350,6 +410,7 @@ class FVTerm : public FVTermAttribute
     constexpr auto  getFullRegionHeight (const FTermRegion*) const noexcept -> int;
     void  passChangesToOverlap (const FTermRegion*) const;
     void  processOverlappingWindows (const FTermRegion*, const FVTermList&) const;
+    void  processOverlappingWindowsByIndex (const FTermRegion*) const;
     void  passChangesToOverlappingWindow (FTermRegion*, const FTermRegion*) const noexcept;
     void  passChangesToOverlappingWindowLine (FTermRegion*, int, const FTermRegion*) const noexcept;
     auto  calculateStartCoordinate (int, int) const noexcept -> int;
@@ -361,9 +422,16 @@ class FVTerm : public FVTermAttribute
     auto  isLayerOutsideVTerm (const LayerGeometry&) const noexcept -> bool;
     void  buildLineChangeBatch (const FTermRegion*, const LayerGeometry&) const noexcept;
     void  applyLineBatch (FTermRegion*, const LayerGeometry&) const noexcept;
+    auto  isParallelLineBatch() const noexcept -> bool;
+    void  applyLineBatchInBands (FTermRegion*, const LayerGeometry&) const noexcept;
+    auto  applyLineBatchRow ( FTermRegion*, const LayerGeometry&
+                            , const LineChanges&, int, FDamageList::FSpanVec& ) const noexcept -> bool;
     void  updateVTermChangesFromBatch (const LayerGeometry&) const noexcept;
     void  scrollTerminalForward() const;
     void  scrollTerminalReverse() const;
+    auto  canScrollTerminalLines (const FTermRegion*) const -> bool;
+    auto  scrollTerminalLines (const FTermRegion*, int) const -> bool;
+    void  shiftRegionLineChanges (FTermRegion*, int) const noexcept;
     void  callPreprocessingHandler (const FTermRegion*) const;
     auto  hasChildRegionChanges (const FTermRegion*) const -> bool;
     void  clearChildRegionChanges (const FTermRegion*) const;
@@ -381,7 +449,9 @@ class FVTerm : public FVTermAttribute
     void  applyColorOverlay (const FChar&, FChar&) const;
     void  inheritBackground (const FChar&, FChar&) const;
     void  putMultiLayerRegionLine (FChar_iterator, const int, const FPoint&) const noexcept;
-    void  putRegionLineWithTransparency (FChar_const_iterator, FChar_iterator, const int, FPoint, bool) const;
+    void  putRegionLineWithTransparency ( FChar_const_iterator, FChar_iterator, const int
+                                        , FPoint, bool, const CoveredState* ) const;
+    void  putPartlyCoveredRegionLine (FChar_const_iterator, FChar_iterator, const int, FPoint, const CoveredState*) const;
     void  addRegionLineWithTransparency (FChar_const_iterator, FChar_iterator, const int) const;
     void  addTransparentRegionLine (const FChar_const_iterator&, const FChar_iterator&, const int) const;
     void  addTransparentRegionChar (const FChar&, FChar&) const;
@@ -398,6 +468,8 @@ class FVTerm : public FVTermAttribute
     void  addTransparent (FChar_const_iterator, FChar_iterator&, int&) const;
     void  addVDesktopToListIfExists (FTermRegionList&) const;
     void  determineCoveredRegions (FTermRegion*) const;
+    void  determineCoveredRegionsByIndex (FTermRegion*) const;
+    void  findOverlappingRegions (const FTermRegion*) const;
     void  resetLineCoveredState (FTermRegion*) const;
     void  determineLineCoveredState (const FTermRegion* const, FTermRegion*) const noexcept;
     auto  canUpdateTerminalNow() const -> bool;
@@ -408,13 +480,19 @@ class FVTerm : public FVTermAttribute
     FTermRegion*                  child_print_region{nullptr};  // Print region for children
     FVTermBuffer                  vterm_buffer{};               // Print buffer
     mutable FLineChangesBatch     line_changes_batch{};         // All line changes to an region
+    mutable FDamageList::FSpanVec damage_spans{};               // Damaged spans of a region line
+    mutable FLineChangesBatch     batch_rows{};                 // Single rows of the line changes batch
+    mutable FRowBandVector        row_bands{};                  // Parallel compositing bands
     mutable FOverlayLineBuffer    overlay_line_buffer{};        // Overlay region line buffer
     mutable FOverlaySearchBuffer  overlay_search_buffer{};      // Overlay search state buffer
     mutable FTermRegionList       covered_regions_buffer{};     // Covered overlay regions buffer
+    mutable std::vector<FTermRegion*> index_search_buffer{};    // Window index query buffer
+    mutable FCoverageKeys         coverage_key_buffer{};        // Coverage keys of a region
     FChar                         nc{};                         // Next character
     std::unique_ptr<FTermRegion>  vwin{};                       // Virtual window
     std::shared_ptr<FOutput>      foutput{};                    // Terminal output class
     std::shared_ptr<FVTermList>   vterm_window_list{};          // List of all window owner in z-order
+    std::shared_ptr<FWindowIndex> window_index{};               // Spatial index of the window regions
     std::shared_ptr<FTermRegion>  vterm{};                      // Virtual terminal
     std::shared_ptr<FTermRegion>  vterm_old{};                  // Last virtual terminal
     std::shared_ptr<FTermRegion>  vdesktop{};                   // Virtual desktop
@@ -424,6 +502,7 @@ class FVTerm : public FVTermAttribute
     static bool                   skip_one_vterm_update;
     static bool                   no_terminal_updates;
     static bool                   force_terminal_update;
+    static uInt64                 compose_time_us;              // Last composition time (us)
 
     // Friend function
     friend void setPrintRegion (FWidget&, FTermRegion*);
@@ -459,6 +538,17 @@ struct FVTerm::FTermRegion  // Define virtual terminal character properties
   using FChar_const_reference = FCharVec::const_reference;
   using FChar_iterator        = FCharVec::iterator;
   using FChar_const_iterator  = FCharVec::const_iterator;
+  using FFlagVec              = std::vector<uInt8>;
+  using FRowTable             = std::vector<uInt>;
+
+  // Constants
+  static constexpr uInt32 FLAG_SHIFT = 13U;  // Bit position of the transparent attribute
+  static constexpr uInt32 FLAG_MASK = FAttribute::set::transparent
+                                    | FAttribute::set::color_overlay
+                                    | FAttribute::set::inherit_background;
+  static constexpr uInt8 TRANSPARENT_FLAG = uInt8(FAttribute::set::transparent >> FLAG_SHIFT);
+  static constexpr uInt8 COLOR_OVERLAY_FLAG = uInt8(FAttribute::set::color_overlay >> FLAG_SHIFT);
+  static constexpr uInt8 INHERIT_BACKGROUND_FLAG = uInt8(FAttribute::set::inherit_background >> FLAG_SHIFT);
 
   // Constructor
   FTermRegion() = default;
@@ -501,14 +591,21 @@ struct FVTerm::FTermRegion  // Define virtual terminal character properties
   constexpr auto isPrintPositionInsideRegion() const noexcept -> bool;
   auto reprint (const FRect&, const FSize&) noexcept -> bool;
 
+  inline auto getRowOffset (int y) const noexcept -> unsigned
+  {
+    // Returns the index of the first character of line y in data
+    const auto row = row_table.empty() ? unsigned(y) : row_table[unsigned(y)];
+    return row * unsigned(size.width + shadow.width);
+  }
+
   inline auto getFChar (int x, int y) const noexcept -> FChar_const_reference
   {
-    return data[unsigned(y) * unsigned(size.width + shadow.width) + unsigned(x)];
+    return data[getRowOffset(y) + unsigned(x)];
   }
 
   inline auto getFChar (int x, int y) noexcept -> FChar_reference
   {
-    return data[unsigned(y) * unsigned(size.width + shadow.width) + unsigned(x)];
+    return data[getRowOffset(y) + unsigned(x)];
   }
 
   inline auto getFChar (const FPoint& pos) const noexcept -> FChar_const_reference
@@ -523,12 +620,30 @@ struct FVTerm::FTermRegion  // Define virtual terminal character properties
 
   inline auto getFCharIterator (int x, int y) const noexcept -> FChar_const_iterator
   {
-    return data.cbegin() + (unsigned(y) * unsigned(size.width + shadow.width) + unsigned(x));
+    return data.cbegin() + (getRowOffset(y) + unsigned(x));
   }
 
   inline auto getFCharIterator (int x, int y) noexcept -> FChar_iterator
   {
-    return data.begin() + (unsigned(y) * unsigned(size.width + shadow.width) + unsigned(x));
+    return data.begin() + (getRowOffset(y) + unsigned(x));
+  }
+
+  static constexpr auto getTransparencyFlags (const FChar& fchar) noexcept -> uInt8
+  {
+    return uInt8((fchar.attr.data & FLAG_MASK) >> FLAG_SHIFT);
+  }
+
+  inline auto getTransparencyFlags (int x, int y) const noexcept -> uInt8
+  {
+    // The flag plane is only up to date in lines without pending changes
+    const auto index = getRowOffset(y) + unsigned(x);
+    return hasLineChanges(y) ? getTransparencyFlags(data[index]) : flag_plane[index];
+  }
+
+  inline auto hasLineChanges (int y) const noexcept -> bool
+  {
+    const auto& line_changes = changes_in_line[unsigned(y)];
+    return line_changes.xmin <= line_changes.xmax;
   }
 
   constexpr void setCursorPos (int x, int y) noexcept
@@ -553,6 +668,14 @@ struct FVTerm::FTermRegion  // Define virtual terminal character properties
   }
 
   void updateRegionChanges (uInt, uInt, uInt8) noexcept;
+  auto copyTransparencyFlags (uInt, uInt, uInt) noexcept -> bool;
+  void markFlagsChanged() noexcept;
+  static void invalidateCoverage() noexcept;
+  void rotateRows (int, int, int);
+  void addLineChanges (uInt, uInt, uInt) noexcept;
+  void addBlockChanges (const FRect&) noexcept;
+  void resetDamage() noexcept;
+  auto getDamagedSpans (int, FDamageList::FSpanVec&) const -> bool;
 
   // Data members
   struct Coordinate
@@ -582,8 +705,18 @@ struct FVTerm::FTermRegion  // Define virtual terminal character properties
   FDataAccessPtr  owner{nullptr};        // Object that owns this FTermRegion
   FPreprocVector  preproc_list{};
   FRowChanges     changes_in_row{};
-  FLineChangesVec changes_in_line{};
+  FLineChangesVec changes_in_line{};     // Change with addLineChanges()
   FCharVec        data{};                // FChar data of the drawing region
+  FRowTable       row_table{};           // Line to data row (empty = identity)
+  FFlagVec        flag_plane{};          // Dense transparency flags of data
+  uInt            flag_revision{0};      // Change counter of the transparency flags
+  FDamageList     damage{};              // Merged dirty rectangles
+
+  // Coverage by the windows above (see FVTerm::getCoveragePlane)
+  static uInt64          coverage_generation;           // Change counter of all regions
+  mutable uInt64         coverage_plane_generation{0};  // Validated generation
+  mutable FCoverageKeys  coverage_keys{};               // Cache key
+  mutable FCoveragePlane coverage_plane{};              // Per-character coverage state
 };
 
 //----------------------------------------------------------------------
@@ -691,16 +824,7 @@ inline auto FVTerm::FTermRegion::reprint ( const FRect& box
 
   auto first_row = unsigned(y_start);
   auto last_row  = unsigned(std::max(0, y_end));
-  auto line_changes = changes_in_line.begin() + first_row;
-  const auto line_changes_end = changes_in_line.cbegin() + last_row;
-
-  while  ( line_changes <= line_changes_end )  // Line loop
-  {
-    line_changes->xmin = std::min(line_changes->xmin, uInt(x_start));
-    line_changes->xmax = std::max(line_changes->xmax, uInt(x_end));
-    ++line_changes;
-  }
-
+  addBlockChanges (FRect{FPoint{x_start, y_start}, FPoint{x_end, int(last_row)}});
   changes_in_row.ymin = std::min(changes_in_row.ymin, first_row);
   changes_in_row.ymax = std::max(changes_in_row.ymax, last_row);
   return true;
@@ -715,11 +839,203 @@ inline void FVTerm::FTermRegion::updateRegionChanges ( uInt x, uInt y
 
   line_changes.xmin = std::min(line_changes.xmin, x);
   line_changes.xmax = std::max(line_changes.xmax, x_end);
+  damage.add (FRect{FPoint{int(x), int(y)}, FPoint{int(x_end), int(y)}});
 
   changes_in_row.ymin = std::min(changes_in_row.ymin, y);
   changes_in_row.ymax = std::max(changes_in_row.ymax, y);
 }
 
+//----------------------------------------------------------------------
+inline auto FVTerm::FTermRegion::copyTransparencyFlags ( uInt y, uInt xmin
+                                                       , uInt xmax ) noexcept -> bool
+{
+  // Copies the transparency flags of the characters in the line
+  // range [xmin .. xmax] into the flag plane. Returns true if at least
+  // one flag has changed (the caller increments flag_revision).
+
+  const auto width = uInt(size.width + shadow.width);
+  xmax = std::min(xmax, width - 1);
+
+  if ( xmin > xmax )
+    return false;
+
+  const auto offset = getRowOffset(int(y));
+  auto fchar = data.cbegin() + offset + xmin;
+  const auto last = data.cbegin() + offset + xmax + 1;
+  auto flags = flag_plane.begin() + offset + xmin;
+  bool changed{false};
+
+  while ( fchar < last )
+  {
+    const auto new_flags = getTransparencyFlags(*fchar);
+    changed |= ( *flags != new_flags );
+    *flags = new_flags;
+    ++fchar;
+    ++flags;
+  }
+
+  return changed;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FTermRegion::markFlagsChanged() noexcept
+{
+  // The transparency flags of the data have changed. This also
+  // applies to lines with pending changes, whose flag plane entries
+  // are only updated when the region is composited.
+
+  flag_revision++;
+  invalidateCoverage();
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FTermRegion::invalidateCoverage() noexcept
+{
+  // Cached coverage planes are revalidated after a window has been
+  // moved, resized, shown, hidden, raised or lowered, or after
+  // the transparency flags of a region have changed
+
+  coverage_generation++;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FTermRegion::addLineChanges ( uInt y, uInt xmin
+                                                , uInt xmax ) noexcept
+{
+  // Extends the changes of line y by the range [xmin .. xmax]
+
+  auto& line_changes = changes_in_line[y];
+  line_changes.xmin = std::min(line_changes.xmin, xmin);
+  line_changes.xmax = std::max(line_changes.xmax, xmax);
+  damage.add (FRect{FPoint{int(xmin), int(y)}, FPoint{int(xmax), int(y)}});
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FTermRegion::addBlockChanges (const FRect& box) noexcept
+{
+  // Extends the line changes by the region coordinates of box
+
+  if ( box.getX2() < box.getX1() || box.getY2() < box.getY1() )
+    return;
+
+  auto line_changes = changes_in_line.begin() + box.getY1();
+  const auto line_changes_end = changes_in_line.begin() + box.getY2() + 1;
+  const auto xmin = uInt(box.getX1());
+  const auto xmax = uInt(box.getX2());
+
+  while ( line_changes < line_changes_end )  // Line loop
+  {
+    line_changes->xmin = std::min(line_changes->xmin, xmin);
+    line_changes->xmax = std::max(line_changes->xmax, xmax);
+    ++line_changes;
+  }
+
+  damage.add (box);
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FTermRegion::resetDamage() noexcept
+{
+  // Keeps only the damage of lines with pending changes
+
+  damage.clear();
+  int y{0};
+
+  for (const auto& line_changes : changes_in_line)
+  {
+    if ( line_changes.xmin <= line_changes.xmax )
+    {
+      damage.add (FRect{ FPoint{int(line_changes.xmin), y}
+                       , FPoint{int(line_changes.xmax), y} });
+    }
+
+    y++;
+  }
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::FTermRegion::getDamagedSpans ( int y
+                                                 , FDamageList::FSpanVec& spans ) const -> bool
+{
+  // Returns the damaged column spans of line y. The line changes
+  // are used as a single span if the damage rectangles do not
+  // describe them exactly. Line changes must therefore be added with
+  // addLineChanges() or addBlockChanges(), because a direct change of
+  // xmin/xmax within the outer span bounds would not be detected.
+
+  const auto& line_changes = changes_in_line[unsigned(y)];
+  const auto xmin = int(line_changes.xmin);
+  const auto xmax = int(line_changes.xmax);
+
+  if ( xmin > xmax )
+  {
+    spans.clear();
+    return false;
+  }
+
+  if ( ! damage.getLineSpans(y, spans)
+    || spans.front().xmin != xmin || spans.back().xmax != xmax )
+  {
+    spans.clear();
+    spans.push_back({xmin, xmax});
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FTermRegion::rotateRows (int first, int last, int n)
+{
+  // Rotates the lines first to last by n lines up (n > 0) or down
+  // (n < 0). Only the row table is changed, the characters of the
+  // right shadow are moved back to their lines.
+
+  const int count = last - first + 1;
+
+  if ( count < 2 || n % count == 0 )
+    return;
+
+  if ( row_table.empty() )  // Create the identity mapping
+  {
+    row_table.resize(std::size_t(size.height + shadow.height));
+    std::iota (row_table.begin(), row_table.end(), 0U);
+  }
+
+  const auto first_row = row_table.begin() + first;
+  const auto middle_row = first_row + ((n % count) + count) % count;
+  const auto shadow_width = std::size_t(shadow.width);
+
+  if ( shadow_width == 0 )
+  {
+    std::rotate (first_row, middle_row, first_row + count);
+    return;
+  }
+
+  static FCharVec shadow_chars{};
+  static FFlagVec shadow_flags{};
+  shadow_chars.clear();
+  shadow_flags.clear();
+
+  for (auto y{first}; y <= last; y++)  // Save the right shadow
+  {
+    const auto offset = getRowOffset(y) + unsigned(size.width);
+    shadow_chars.insert (shadow_chars.end(), data.cbegin() + offset
+                        , data.cbegin() + offset + shadow_width);
+    shadow_flags.insert (shadow_flags.end(), flag_plane.cbegin() + offset
+                        , flag_plane.cbegin() + offset + shadow_width);
+  }
+
+  std::rotate (first_row, middle_row, first_row + count);
+
+  for (auto y{first}; y <= last; y++)  // Restore the right shadow
+  {
+    const auto offset = getRowOffset(y) + unsigned(size.width);
+    const auto index = std::size_t(y - first) * shadow_width;
+    std::copy_n (shadow_chars.cbegin() + index, shadow_width, data.begin() + offset);
+    std::copy_n (shadow_flags.cbegin() + index, shadow_width, flag_plane.begin() + offset);
+  }
+}
+
 
 //----------------------------------------------------------------------
 // struct FVTerm::FVTermPreprocessing
@@ -882,6 +1198,15 @@ inline auto FVTerm::getWindowList() noexcept -> FVTermList*
         : nullptr;
 }
 
+//----------------------------------------------------------------------
+inline auto FVTerm::getWindowIndex() noexcept -> FWindowIndex*
+{
+  static const auto& init_object = getGlobalFVTermInstance();
+  return ( isInitialized() && init_object->window_index )
+        ? init_object->window_index.get()
+        : nullptr;
+}
+
 //----------------------------------------------------------------------
 inline void FVTerm::setVWin (std::unique_ptr<FTermRegion>&& region) noexcept
 { vwin = std::move(region); }
@@ -890,6 +1215,14 @@ inline void FVTerm::setVWin (std::unique_ptr<FTermRegion>&& region) noexcept
 inline void FVTerm::unsetNonBlockingRead()
 { setNonBlockingRead(false); }
 
+//----------------------------------------------------------------------
+inline auto FVTerm::getComposeTime() noexcept -> uInt64
+{ return compose_time_us; }
+
+//----------------------------------------------------------------------
+inline auto FVTerm::getLastVirtualTerminal() noexcept -> const FTermRegion*
+{ return getGlobalFVTermInstance()->vterm_old.get(); }
+
 //----------------------------------------------------------------------
 inline auto FVTerm::isDrawingFinished() noexcept -> bool
 { return draw_completed; }
@@ -1007,6 +1340,7 @@ inline void FVTerm::initFromGlobalInstance()
 
   foutput           = std::shared_ptr<FOutput>(init_object->foutput);
   vterm_window_list = std::shared_ptr<FVTermList>(init_object->vterm_window_list);
+  window_index      = std::shared_ptr<FWindowIndex>(init_object->window_index);
   vterm             = std::shared_ptr<FTermRegion>(init_object->vterm);
   vterm_old         = std::shared_ptr<FTermRegion>(init_object->vterm_old);
   vdesktop          = std::shared_ptr<FTermRegion>(init_object->vdesktop);
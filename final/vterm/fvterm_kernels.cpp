@@ -0,0 +1,485 @@
+/***********************************************************************
+* fvterm_kernels.cpp - Vectorized character cell scanning functions    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__) \
+    && defined(__GNUC__)
+  #define F_HAVE_X86_KERNELS
+  #include <immintrin.h>
+#endif
+
+#include "final/vterm/fvterm_kernels.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+static_assert ( std::is_standard_layout<FChar>::value
+              , "The kernels require a standard layout FChar" );
+
+// Constants
+constexpr std::size_t attr_offset = offsetof(FChar, attr);
+constexpr std::size_t compare_size = attr_offset + sizeof(uInt32);
+
+struct kernel_table
+{
+  using FindChangeFunc = auto (*) (const FChar*, const FChar*, std::size_t) noexcept -> std::size_t;
+  using RunLengthFunc = auto (*) (const FChar*, std::size_t, uInt32, bool) noexcept -> std::size_t;
+
+  FKernelType    type;
+  FindChangeFunc find_first_change;
+  FindChangeFunc find_last_change;
+  RunLengthFunc  get_attribute_run_length;
+};
+
+#if defined(__clang__)
+  #pragma clang diagnostic push
+  #if __has_warning("-Wunsafe-buffer-usage")
+    #pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
+  #endif
+#endif
+
+// Scalar kernels
+//----------------------------------------------------------------------
+auto findFirstChangeScalar ( const FChar* lhs, const FChar* rhs
+                           , std::size_t length ) noexcept -> std::size_t
+{
+  std::size_t i{0};
+
+  while ( i < length && lhs[i] == rhs[i] )
+    ++i;
+
+  return i;
+}
+
+//----------------------------------------------------------------------
+auto findLastChangeScalar ( const FChar* lhs, const FChar* rhs
+                          , std::size_t length ) noexcept -> std::size_t
+{
+  std::size_t i{length};
+
+  while ( i > 0 && lhs[i - 1] == rhs[i - 1] )
+    --i;
+
+  return i;
+}
+
+//----------------------------------------------------------------------
+auto getAttributeRunLengthScalar ( const FChar* fchar, std::size_t length
+                                 , uInt32 mask, bool set ) noexcept -> std::size_t
+{
+  std::size_t i{0};
+
+  while ( i < length && fchar[i].isBitSet(mask) == set )
+    ++i;
+
+  return i;
+}
+
+#if defined(F_HAVE_X86_KERNELS)
+
+// The vector kernels compare the bytes of the character and the color
+// directly and the attribute bytes through the compare mask of
+// operator == (const FChar&, const FChar&). The cell must therefore
+// fit in one 16-byte or two 16-byte vectors.
+constexpr bool is_single_vector_cell = sizeof(FChar) == 16 && compare_size == 16;
+constexpr bool is_double_vector_cell = sizeof(FChar) >= 32 && compare_size <= 32;
+constexpr bool has_vector_compare = is_single_vector_cell || is_double_vector_cell;
+
+// Cells compared per SSE2 loop step (four or two 16-byte vectors)
+constexpr std::size_t SSE2_CELLS = is_single_vector_cell ? 4 : 2;
+
+//----------------------------------------------------------------------
+auto getCellCompareMask() noexcept -> const uInt8*
+{
+  // Byte mask for the first 32 bytes of a cell. A compact
+  // cell is repeated in the upper half for the AVX2 kernels.
+
+  alignas(32) static const auto mask = [] ()
+  {
+    std::array<uInt8, 32> bytes{};
+    const auto attr_mask = getCompareBitMask();
+
+    for (std::size_t i{0}; i < bytes.size(); i++)
+    {
+      const auto pos = i % sizeof(FChar);
+
+      if ( pos < attr_offset )
+        bytes[i] = 0xff;
+      else if ( pos < compare_size )  // x86 is little-endian
+        bytes[i] = uInt8(attr_mask >> (8 * (pos - attr_offset)));
+    }
+
+    return bytes;
+  }();
+
+  return mask.data();
+}
+
+//----------------------------------------------------------------------
+inline auto loadCell (const FChar* fchar, std::size_t byte_offset) noexcept -> __m128i
+{
+  return _mm_loadu_si128 \
+  (
+    reinterpret_cast<const __m128i*>(reinterpret_cast<const uInt8*>(fchar) + byte_offset)
+  );
+}
+
+//----------------------------------------------------------------------
+inline auto getCellDiffSSE2 ( const FChar* lhs, const FChar* rhs
+                            , __m128i mask_lo, __m128i mask_hi ) noexcept -> __m128i
+{
+  // Returns the masked byte differences of one cell
+
+  auto diff = _mm_and_si128(_mm_xor_si128(loadCell(lhs, 0), loadCell(rhs, 0)), mask_lo);
+
+  if ( is_double_vector_cell )
+  {
+    const auto diff_hi = _mm_xor_si128(loadCell(lhs, 16), loadCell(rhs, 16));
+    diff = _mm_or_si128(diff, _mm_and_si128(diff_hi, mask_hi));
+  }
+
+  return diff;
+}
+
+//----------------------------------------------------------------------
+inline auto isZeroSSE2 (__m128i diff) noexcept -> bool
+{
+  const auto zero = _mm_setzero_si128();
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(diff, zero)) == 0xffff;
+}
+
+//----------------------------------------------------------------------
+inline auto isCellEqualSSE2 ( const FChar* lhs, const FChar* rhs
+                            , __m128i mask_lo, __m128i mask_hi ) noexcept -> bool
+{
+  return isZeroSSE2(getCellDiffSSE2(lhs, rhs, mask_lo, mask_hi));
+}
+
+//----------------------------------------------------------------------
+inline auto areCellsEqualSSE2 ( const FChar* lhs, const FChar* rhs
+                              , __m128i mask_lo, __m128i mask_hi ) noexcept -> bool
+{
+  // Compares SSE2_CELLS cells with a single test of the combined
+  // differences
+
+  auto diff = getCellDiffSSE2(lhs, rhs, mask_lo, mask_hi);
+
+  for (std::size_t n{1}; n < SSE2_CELLS; n++)
+    diff = _mm_or_si128(diff, getCellDiffSSE2(lhs + n, rhs + n, mask_lo, mask_hi));
+
+  return isZeroSSE2(diff);
+}
+
+//----------------------------------------------------------------------
+auto findFirstChangeSSE2 ( const FChar* lhs, const FChar* rhs
+                         , std::size_t length ) noexcept -> std::size_t
+{
+  const auto* mask = getCellCompareMask();
+  const auto mask_lo = _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+  const auto mask_hi = _mm_load_si128(reinterpret_cast<const __m128i*>(mask + 16));
+  std::size_t i{0};
+
+  // Skips the equal cell groups, then finds the changed cell
+  while ( i + SSE2_CELLS <= length
+       && areCellsEqualSSE2(lhs + i, rhs + i, mask_lo, mask_hi) )
+    i += SSE2_CELLS;
+
+  while ( i < length && isCellEqualSSE2(lhs + i, rhs + i, mask_lo, mask_hi) )
+    ++i;
+
+  return i;
+}
+
+//----------------------------------------------------------------------
+auto findLastChangeSSE2 ( const FChar* lhs, const FChar* rhs
+                        , std::size_t length ) noexcept -> std::size_t
+{
+  const auto* mask = getCellCompareMask();
+  const auto mask_lo = _mm_load_si128(reinterpret_cast<const __m128i*>(mask));
+  const auto mask_hi = _mm_load_si128(reinterpret_cast<const __m128i*>(mask + 16));
+  std::size_t i{length};
+
+  while ( i >= SSE2_CELLS
+       && areCellsEqualSSE2(lhs + i - SSE2_CELLS, rhs + i - SSE2_CELLS, mask_lo, mask_hi) )
+    i -= SSE2_CELLS;
+
+  while ( i > 0 && isCellEqualSSE2(lhs + i - 1, rhs + i - 1, mask_lo, mask_hi) )
+    --i;
+
+  return i;
+}
+
+//----------------------------------------------------------------------
+auto getAttributeRunLengthSSE2 ( const FChar* fchar, std::size_t length
+                               , uInt32 mask, bool set ) noexcept -> std::size_t
+{
+  // Loads the 16 bytes that end with the attribute of four cells
+  // and transposes the attribute words into one vector
+
+  constexpr std::size_t offset = attr_offset + sizeof(uInt32) - 16;
+  const auto mask_vec = _mm_set1_epi32(int(mask));
+  const auto zero = _mm_setzero_si128();
+  std::size_t i{0};
+
+  while ( i + 4 <= length )
+  {
+    const auto* cell = fchar + i;
+    const auto c01 = _mm_unpackhi_epi32(loadCell(cell, offset), loadCell(cell + 1, offset));
+    const auto c23 = _mm_unpackhi_epi32(loadCell(cell + 2, offset), loadCell(cell + 3, offset));
+    const auto attr = _mm_unpackhi_epi64(c01, c23);
+    const auto unset = _mm_cmpeq_epi32(_mm_and_si128(attr, mask_vec), zero);
+    const auto unset_bits = uInt(_mm_movemask_ps(_mm_castsi128_ps(unset)));
+    const auto stop_bits = set ? unset_bits : ~unset_bits & 0xfU;
+
+    if ( stop_bits != 0 )
+      return i + std::size_t(__builtin_ctz(stop_bits));
+
+    i += 4;
+  }
+
+  return i + getAttributeRunLengthScalar(fchar + i, length - i, mask, set);
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("avx2")))
+inline auto getCellDiffMaskAVX2 ( const FChar* lhs, const FChar* rhs
+                                , __m256i mask ) noexcept -> uInt
+{
+  // Returns a bit mask with one bit per equal byte
+
+  const auto l = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs));
+  const auto r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs));
+  const auto diff = _mm256_and_si256(_mm256_xor_si256(l, r), mask);
+  return uInt(_mm256_movemask_epi8(_mm256_cmpeq_epi8(diff, _mm256_setzero_si256())));
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("avx2")))
+auto findFirstChangeAVX2 ( const FChar* lhs, const FChar* rhs
+                         , std::size_t length ) noexcept -> std::size_t
+{
+  const auto mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(getCellCompareMask()));
+  std::size_t i{0};
+
+  if ( is_single_vector_cell )  // Two cells per vector
+  {
+    while ( i + 2 <= length )
+    {
+      const auto equal = getCellDiffMaskAVX2(lhs + i, rhs + i, mask);
+
+      if ( equal != 0xffffffffU )
+        return ( (equal & 0xffffU) == 0xffffU ) ? i + 1 : i;
+
+      i += 2;
+    }
+
+    return i + findFirstChangeScalar(lhs + i, rhs + i, length - i);
+  }
+
+  while ( i < length && getCellDiffMaskAVX2(lhs + i, rhs + i, mask) == 0xffffffffU )
+    ++i;
+
+  return i;
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("avx2")))
+auto findLastChangeAVX2 ( const FChar* lhs, const FChar* rhs
+                        , std::size_t length ) noexcept -> std::size_t
+{
+  const auto mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(getCellCompareMask()));
+  std::size_t i{length};
+
+  if ( is_single_vector_cell )  // Two cells per vector
+  {
+    while ( i >= 2 )
+    {
+      const auto equal = getCellDiffMaskAVX2(lhs + i - 2, rhs + i - 2, mask);
+
+      if ( equal != 0xffffffffU )
+        return ( (equal >> 16U) == 0xffffU ) ? i - 1 : i;
+
+      i -= 2;
+    }
+
+    return findLastChangeScalar(lhs, rhs, i);
+  }
+
+  while ( i > 0 && getCellDiffMaskAVX2(lhs + i - 1, rhs + i - 1, mask) == 0xffffffffU )
+    --i;
+
+  return i;
+}
+
+#endif  // defined(F_HAVE_X86_KERNELS)
+
+#if defined(__clang__)
+  #pragma clang diagnostic pop
+#endif
+
+//----------------------------------------------------------------------
+auto detectKernelType() noexcept -> FKernelType
+{
+#if defined(F_HAVE_X86_KERNELS)
+  if ( ! has_vector_compare )
+    return FKernelType::Scalar;
+
+  __builtin_cpu_init();
+
+  if ( __builtin_cpu_supports("avx2") )
+    return FKernelType::AVX2;
+
+  return FKernelType::SSE2;
+#else
+  return FKernelType::Scalar;
+#endif
+}
+
+//----------------------------------------------------------------------
+auto getKernelTable (FKernelType type) noexcept -> const kernel_table*
+{
+#if defined(F_HAVE_X86_KERNELS)
+  if ( type == FKernelType::AVX2 )
+  {
+    // The attribute gather of SSE2 is as fast as an AVX2 gather
+    static const kernel_table avx2_kernels
+    {
+      type
+    , &findFirstChangeAVX2
+    , &findLastChangeAVX2
+    , &getAttributeRunLengthSSE2
+    };
+    return &avx2_kernels;
+  }
+
+  if ( type == FKernelType::SSE2 )
+  {
+    static const kernel_table sse2_kernels
+    {
+      type
+    , &findFirstChangeSSE2
+    , &findLastChangeSSE2
+    , &getAttributeRunLengthSSE2
+    };
+    return &sse2_kernels;
+  }
+#endif
+
+  static const kernel_table scalar_kernels
+  {
+    FKernelType::Scalar
+  , &findFirstChangeScalar
+  , &findLastChangeScalar
+  , &getAttributeRunLengthScalar
+  };
+  return &scalar_kernels;
+}
+
+//----------------------------------------------------------------------
+auto getActiveKernels() noexcept -> std::atomic<const kernel_table*>&
+{
+  // The compositor threads read the table while
+  // setKernelType() can replace it
+  static std::atomic<const kernel_table*> kernels
+  {
+    getKernelTable(getSupportedKernelType())
+  };
+  return kernels;
+}
+
+//----------------------------------------------------------------------
+inline auto getKernels() noexcept -> const kernel_table*
+{
+  return getActiveKernels().load(std::memory_order_acquire);
+}
+
+}  // namespace internal
+
+
+// non-member functions
+//----------------------------------------------------------------------
+auto getSupportedKernelType() noexcept -> FKernelType
+{
+  static const auto type = internal::detectKernelType();
+  return type;
+}
+
+//----------------------------------------------------------------------
+auto getKernelType() noexcept -> FKernelType
+{
+  return internal::getKernels()->type;
+}
+
+//----------------------------------------------------------------------
+void setKernelType (FKernelType type) noexcept
+{
+  // Selects the kernel implementation. Instruction sets
+  // not supported by the processor are replaced by the
+  // best supported one.
+
+  const auto supported = getSupportedKernelType();
+
+  if ( uInt8(type) > uInt8(supported) )
+    type = supported;
+
+  internal::getActiveKernels().store ( internal::getKernelTable(type)
+                                     , std::memory_order_release );
+}
+
+//----------------------------------------------------------------------
+auto findFirstChange ( const FChar* lhs, const FChar* rhs
+                     , std::size_t length ) noexcept -> std::size_t
+{
+  // Returns the index of the first cell that differs between
+  // lhs and rhs, or length if all cells are equal
+
+  return internal::getKernels()->find_first_change(lhs, rhs, length);
+}
+
+//----------------------------------------------------------------------
+auto findLastChange ( const FChar* lhs, const FChar* rhs
+                    , std::size_t length ) noexcept -> std::size_t
+{
+  // Returns the index after the last cell that differs between
+  // lhs and rhs, or 0 if all cells are equal
+
+  return internal::getKernels()->find_last_change(lhs, rhs, length);
+}
+
+//----------------------------------------------------------------------
+auto getAttributeRunLength ( const FChar* fchar, std::size_t length
+                           , uInt32 mask, bool set ) noexcept -> std::size_t
+{
+  // Returns the number of leading cells whose attribute bits
+  // in mask are set (set = true) or all unset (set = false)
+
+  return internal::getKernels()->get_attribute_run_length(fchar, length, mask, set);
+}
+
+}  // namespace finalcut
@@ -1,9 +1,9 @@
 /***********************************************************************
-* sgr_optimizer.h - Combines SGR (Select Graphic Rendition) attributes *
+* fvterm_kernels.h - Vectorized character cell scanning functions      *
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2019-2025 Markus Gans                                      *
+* Copyright 2026 Markus Gans                                           *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -20,66 +20,38 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
-/*  Standalone class
- *  ════════════════
- *
- * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
- * ▕ SGRoptimizer ▏
- * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
- */
-
-#ifndef SGR_OPTIMIZER_H
-#define SGR_OPTIMIZER_H
+#ifndef FVTERM_KERNELS_H
+#define FVTERM_KERNELS_H
 
 #if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
   #error "Only <final/final.h> can be included directly."
 #endif
 
-#include <array>
-#include <string>
-#include <vector>
+#include <cstddef>
+
+#include "final/ftypes.h"
 
 namespace finalcut
 {
 
-//----------------------------------------------------------------------
-// class SGRoptimizer
-//----------------------------------------------------------------------
-
-class SGRoptimizer final
+// The kernels scan character cells with the widest instruction set
+// the processor supports. The implementation is selected at runtime
+// on the first call. The scalar implementation is always available.
+enum class FKernelType : uInt8
 {
-  public:
-    // Constants
-    static constexpr std::string::size_type ATTR_BUF_SIZE{8192u};
-
-    // Constructors
-    explicit SGRoptimizer (std::string&);
-
-    // Method
-    void optimize();
-
-  private:
-    struct parameter
-    {
-      std::size_t start;
-      std::size_t end;
-    };
-
-    // Constants
-    static constexpr auto NOT_SET = static_cast<std::size_t>(-1);
-
-    // Methods
-    void findParameter();
-    auto isSGRStart (std::size_t) const noexcept -> bool;
-    void combineParameter();
-    void handleSGRterminating ( std::vector<parameter>::const_iterator, std::size_t&
-                              , std::size_t, std::size_t ) noexcept;
-
-    // Data member
-    std::string& seq;
-    std::vector<parameter> csi_parameter{};
+  Scalar,  // Portable C++ implementation
+  SSE2,    // 128-bit x86 vector instructions
+  AVX2     // 256-bit x86 vector instructions
 };
 
+// non-member function forward declarations
+auto getSupportedKernelType() noexcept -> FKernelType;
+auto getKernelType() noexcept -> FKernelType;
+void setKernelType (FKernelType) noexcept;
+auto findFirstChange (const FChar*, const FChar*, std::size_t) noexcept -> std::size_t;
+auto findLastChange (const FChar*, const FChar*, std::size_t) noexcept -> std::size_t;
+auto getAttributeRunLength (const FChar*, std::size_t, uInt32, bool) noexcept -> std::size_t;
+
 }  // namespace finalcut
 
-#endif  // SGR_OPTIMIZER_H
+#endif  // FVTERM_KERNELS_H
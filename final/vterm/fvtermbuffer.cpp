@@ -145,17 +145,8 @@ auto FVTermBuffer::print (wchar_t ch) -> int
 {
   data.emplace_back();
   auto& nc = data.back();  // next character
-  nc.ch.unicode_data[0] = ch;
-#if defined(__clang__)
-  #pragma clang diagnostic push
-  #if __has_warning("-Wunsafe-buffer-usage")
-    #pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
-  #endif
-#endif
-  nc.ch.unicode_data[1] = L'\0';
-#if defined(__clang__)
-  #pragma clang diagnostic pop
-#endif
+  nc.ch[0] = ch;
+  nc.ch[1] = L'\0';
   setAttribute(nc);
   const auto column_width = getColumnWidth(nc.ch.unicode_data[0]);
   addColumnWidth(nc, column_width);  // add column width
@@ -200,28 +191,14 @@ void FVTermBuffer::add (UnicodeBoundary& ucb)
   if ( ucb.char_width == 2
     && fterm_data.getTerminalEncoding() != Encoding::UTF8 )
   {
-    nc.ch.unicode_data[0] = L'.';
-#if defined(__clang__)
-  #pragma clang diagnostic push
-  #if __has_warning("-Wunsafe-buffer-usage")
-    #pragma clang diagnostic ignored "-Wunsafe-buffer-usage"
-  #endif
-#endif
-    nc.ch.unicode_data[1] = L'\0';
-#if defined(__clang__)
-  #pragma clang diagnostic pop
-#endif
+    nc.ch[0] = L'.';
+    nc.ch[1] = L'\0';
     nc.setCharWidth(1);
   }
   else
   {
-    const auto end = std::min(ucb.iter, ucb.cbegin + UNICODE_MAX);
-    std::copy(ucb.cbegin, end, nc.ch.begin());
+    nc.ch.assign(ucb.cbegin, ucb.iter);
     nc.setCharWidth(uInt32(ucb.char_width));
-    const auto idx = std::size_t(end - ucb.cbegin);
-
-    if ( idx < UNICODE_MAX )
-      nc.ch[idx] = L'\0';
   }
 
   ucb.cbegin = ucb.iter;
@@ -0,0 +1,214 @@
+/***********************************************************************
+* fwindowindex.cpp - Tile grid index of the window regions             *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+
+#include "final/vterm/fwindowindex.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FWindowIndex
+//----------------------------------------------------------------------
+
+// public methods of FWindowIndex
+//----------------------------------------------------------------------
+auto FWindowIndex::getOwner (const FTermRegion* region) const -> FVTerm*
+{
+  const auto iter = entries.find(region);
+  return ( iter != entries.end() ) ? iter->second.owner : nullptr;
+}
+
+//----------------------------------------------------------------------
+void FWindowIndex::getRegionsIn (const FRect& box, FTermRegionList& list) const
+{
+  // Collects every indexed region whose tiles intersect the box.
+  // The result can contain regions that do not overlap the box.
+
+  list.clear();
+
+  if ( box.getX2() < box.getX1() || box.getY2() < box.getY1() )
+    return;
+
+  const auto first_column = getColumn(box.getX1());
+  const auto last_column = getColumn(box.getX2());
+  const auto first_row = getRow(box.getY1());
+  const auto last_row = getRow(box.getY2());
+
+  for (auto row{first_row}; row <= last_row; row++)
+  {
+    for (auto column{first_column}; column <= last_column; column++)
+    {
+      const auto& tile = tiles[std::size_t(row * tile_columns + column)];
+      list.insert (list.end(), tile.cbegin(), tile.cend());
+    }
+  }
+
+  if ( first_column == last_column && first_row == last_row )
+    return;  // A single tile has no duplicates
+
+  std::sort (list.begin(), list.end());
+  list.erase (std::unique(list.begin(), list.end()), list.end());
+}
+
+//----------------------------------------------------------------------
+void FWindowIndex::setSize (const FSize& size)
+{
+  // Adapts the grid to the terminal size and re-indexes all regions
+
+  const auto width = std::max(int(size.getWidth()), 1);
+  const auto height = std::max(int(size.getHeight()), 1);
+  tile_columns = (width + TILE_WIDTH - 1) / TILE_WIDTH;
+  tile_rows = (height + TILE_HEIGHT - 1) / TILE_HEIGHT;
+  tiles.clear();
+  tiles.resize(std::size_t(tile_columns * tile_rows));
+
+  for (const auto& entry : entries)
+    addToTiles (entry.second);
+}
+
+//----------------------------------------------------------------------
+void FWindowIndex::insert (FTermRegion* region, FVTerm* owner)
+{
+  if ( ! region )
+    return;
+
+  remove (region);
+  const FEntry entry{region, owner, getRegionBox(region)};
+  addToTiles (entry);
+  entries.emplace(region, entry);
+}
+
+//----------------------------------------------------------------------
+void FWindowIndex::update (const FTermRegion* region)
+{
+  // Re-indexes the region after a move or a resize
+
+  const auto iter = entries.find(region);
+
+  if ( iter == entries.end() )
+    return;
+
+  auto& entry = iter->second;
+  const auto box = getRegionBox(region);
+
+  if ( box == entry.box )
+    return;
+
+  removeFromTiles (entry);
+  entry.box = box;
+  addToTiles (entry);
+}
+
+//----------------------------------------------------------------------
+void FWindowIndex::remove (const FTermRegion* region)
+{
+  const auto iter = entries.find(region);
+
+  if ( iter == entries.end() )
+    return;
+
+  removeFromTiles (iter->second);
+  entries.erase(iter);
+}
+
+//----------------------------------------------------------------------
+void FWindowIndex::remove (const FVTerm* owner)
+{
+  // Removes all regions of the owner object
+
+  auto iter = entries.begin();
+
+  while ( iter != entries.end() )
+  {
+    if ( owner && iter->second.owner == owner )
+    {
+      removeFromTiles (iter->second);
+      iter = entries.erase(iter);
+    }
+    else
+      ++iter;
+  }
+}
+
+//----------------------------------------------------------------------
+void FWindowIndex::clear()
+{
+  entries.clear();
+
+  for (auto& tile : tiles)
+    tile.clear();
+}
+
+
+// private methods of FWindowIndex
+//----------------------------------------------------------------------
+auto FWindowIndex::getRegionBox (const FTermRegion* region) noexcept -> FRect
+{
+  // The full height is also used for minimized regions,
+  // so that minimizing does not require an update
+
+  const auto width = region->size.width + region->shadow.width;
+  const auto height = region->size.height + region->shadow.height;
+  return { FPoint{region->position.x, region->position.y}
+         , FSize{std::size_t(std::max(width, 0)), std::size_t(std::max(height, 0))} };
+}
+
+//----------------------------------------------------------------------
+void FWindowIndex::addToTiles (const FEntry& entry)
+{
+  const auto& box = entry.box;
+
+  if ( box.getX2() < box.getX1() || box.getY2() < box.getY1() )
+    return;  // Empty region
+
+  const auto last_column = getColumn(box.getX2());
+  const auto last_row = getRow(box.getY2());
+
+  for (auto row{getRow(box.getY1())}; row <= last_row; row++)
+    for (auto column{getColumn(box.getX1())}; column <= last_column; column++)
+      tiles[std::size_t(row * tile_columns + column)].push_back(entry.region);
+}
+
+//----------------------------------------------------------------------
+void FWindowIndex::removeFromTiles (const FEntry& entry)
+{
+  const auto& box = entry.box;
+
+  if ( box.getX2() < box.getX1() || box.getY2() < box.getY1() )
+    return;  // Empty region
+
+  const auto last_column = getColumn(box.getX2());
+  const auto last_row = getRow(box.getY2());
+
+  for (auto row{getRow(box.getY1())}; row <= last_row; row++)
+  {
+    for (auto column{getColumn(box.getX1())}; column <= last_column; column++)
+    {
+      auto& tile = tiles[std::size_t(row * tile_columns + column)];
+      tile.erase (std::remove(tile.begin(), tile.end(), entry.region), tile.end());
+    }
+  }
+}
+
+}  // namespace finalcut
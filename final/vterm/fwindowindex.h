@@ -0,0 +1,146 @@
+/***********************************************************************
+* fwindowindex.h - Tile grid index of the window regions               *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏1     *▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FWindowIndex ▏- - - -▕ FTermRegion ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏       ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+#ifndef FWINDOWINDEX_H
+#define FWINDOWINDEX_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <unordered_map>
+#include <vector>
+
+#include "final/util/frect.h"
+#include "final/util/fsize.h"
+#include "final/util/fstring.h"
+#include "final/vterm/fvterm.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FWindowIndex
+//----------------------------------------------------------------------
+
+class FWindowIndex
+{
+  public:
+    // Using-declarations
+    using FTermRegion = FVTerm::FTermRegion;
+    using FTermRegionList = std::vector<FTermRegion*>;
+
+    // Constants
+    static constexpr int TILE_WIDTH{16};
+    static constexpr int TILE_HEIGHT{8};
+
+    // Constructor
+    FWindowIndex() = default;
+
+    // Accessors
+    auto getClassName() const -> FString;
+    auto getCount() const noexcept -> std::size_t;
+    auto getOwner (const FTermRegion*) const -> FVTerm*;
+    auto getRegionsAt (int, int) const noexcept -> const FTermRegionList&;
+    void getRegionsIn (const FRect&, FTermRegionList&) const;
+
+    // Mutator
+    void setSize (const FSize&);
+
+    // Inquiry
+    auto contains (const FTermRegion*) const -> bool;
+
+    // Methods
+    void insert (FTermRegion*, FVTerm* = nullptr);
+    void update (const FTermRegion*);
+    void remove (const FTermRegion*);
+    void remove (const FVTerm*);
+    void clear();
+
+  private:
+    struct FEntry
+    {
+      FTermRegion* region{nullptr};
+      FVTerm*      owner{nullptr};
+      FRect        box{};  // Region rectangle including the shadow
+    };
+
+    // Using-declaration
+    using FEntryMap = std::unordered_map<const FTermRegion*, FEntry>;
+
+    // Accessors
+    static auto getRegionBox (const FTermRegion*) noexcept -> FRect;
+    auto getColumn (int) const noexcept -> int;
+    auto getRow (int) const noexcept -> int;
+
+    // Methods
+    void addToTiles (const FEntry&);
+    void removeFromTiles (const FEntry&);
+
+    // Data members
+    FEntryMap                    entries{};
+    std::vector<FTermRegionList> tiles{1};
+    int                          tile_columns{1};
+    int                          tile_rows{1};
+};
+
+// FWindowIndex inline functions
+//----------------------------------------------------------------------
+inline auto FWindowIndex::getClassName() const -> FString
+{ return "FWindowIndex"; }
+
+//----------------------------------------------------------------------
+inline auto FWindowIndex::getCount() const noexcept -> std::size_t
+{ return entries.size(); }
+
+//----------------------------------------------------------------------
+inline auto FWindowIndex::getRegionsAt (int x, int y) const noexcept -> const FTermRegionList&
+{ return tiles[std::size_t(getRow(y) * tile_columns + getColumn(x))]; }
+
+//----------------------------------------------------------------------
+inline auto FWindowIndex::contains (const FTermRegion* region) const -> bool
+{ return entries.find(region) != entries.end(); }
+
+//----------------------------------------------------------------------
+inline auto FWindowIndex::getColumn (int x) const noexcept -> int
+{
+  // Positions outside the grid are assigned to the border tiles
+  return std::max(0, std::min(x / TILE_WIDTH, tile_columns - 1));
+}
+
+//----------------------------------------------------------------------
+inline auto FWindowIndex::getRow (int y) const noexcept -> int
+{
+  return std::max(0, std::min(y / TILE_HEIGHT, tile_rows - 1));
+}
+
+}  // namespace finalcut
+
+#endif  // FWINDOWINDEX_H
@@ -375,6 +375,32 @@ void FLineEdit::onKeyPress (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FLineEdit::onPaste (FPasteEvent* ev)
+{
+  if ( isReadOnly() )
+    return;
+
+  ev->accept();
+  auto input = pasteFilter(ev->getText());
+  const auto len = text.getLength();
+  const auto used = insert_mode ? len : std::min(cursor_pos, len);
+  const auto available = ( max_length > used ) ? max_length - used : 0;
+
+  if ( input.getLength() > available )
+  {
+    input = input.left(available);
+    FVTerm::getFOutput()->beep();
+  }
+
+  if ( input.isEmpty() )
+    return;
+
+  inputText (input);  // Inserts the whole text at once
+  drawInputField();
+  forceTerminalUpdate();
+}
+
 //----------------------------------------------------------------------
 void FLineEdit::onMouseDown (FMouseEvent* ev)
 {
@@ -1183,12 +1209,34 @@ inline auto FLineEdit::characterFilter (const wchar_t c) const -> wchar_t
   if ( input_filter.empty() )
     return c;
 
-  if ( std::regex_match(std::wstring(1, c), std::wregex(input_filter)) )
+  if ( std::regex_match(std::wstring(1, c), input_regex) )
     return c;
 
   return L'\0';
 }
 
+//----------------------------------------------------------------------
+auto FLineEdit::pasteFilter (const FString& input) const -> FString
+{
+  // Removes line breaks, control characters and all
+  // characters rejected by the input filter
+
+  std::wstring filtered{};
+  filtered.reserve(input.getLength());
+  const auto has_filter = ! input_filter.empty();
+
+  for (const auto& ch : input)
+  {
+    if ( ch < L' ' || ch == L'\x7f' )
+      continue;
+
+    if ( ! has_filter || std::regex_match(std::wstring(1, ch), input_regex) )
+      filtered.push_back(ch);
+  }
+
+  return FString{filtered};
+}
+
 //----------------------------------------------------------------------
 void FLineEdit::processActivate()
 {
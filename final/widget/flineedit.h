@@ -48,6 +48,7 @@
 #endif
 
 #include <limits>
+#include <regex>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -167,6 +168,7 @@ class FLineEdit : public FWidget
 
     // Event handlers
     void onKeyPress (FKeyEvent*) override;
+    void onPaste (FPasteEvent*) override;
     void onMouseDown (FMouseEvent*) override;
     void onMouseUp (FMouseEvent*) override;
     void onMouseMove (FMouseEvent*) override;
@@ -230,6 +232,7 @@ class FLineEdit : public FWidget
     void acceptInput();
     auto keyInput (FKey) -> bool;
     auto characterFilter (const wchar_t) const -> wchar_t;
+    auto pasteFilter (const FString&) const -> FString;
     void processActivate();
     void processChanged() const;
 
@@ -240,6 +243,7 @@ class FLineEdit : public FWidget
     FLabel*          label{};
     FWidget*         label_associated_widget{this};
     std::wstring     input_filter{};
+    std::wregex      input_regex{};
     KeyMap           key_map{};
     DragScrollMode   drag_scroll{DragScrollMode::None};
     LabelOrientation label_orientation{LabelOrientation::Left};
@@ -298,11 +302,17 @@ inline auto FLineEdit::getLabelOrientation() const -> LabelOrientation
 
 //----------------------------------------------------------------------
 inline void FLineEdit::setInputFilter (const FString& regex_string)
-{ input_filter = regex_string.toWString(); }
+{
+  input_filter = regex_string.toWString();
+  input_regex.assign(input_filter);  // Compiled once for all input
+}
 
 //----------------------------------------------------------------------
 inline void FLineEdit::clearInputFilter()
-{ input_filter.clear(); }
+{
+  input_filter.clear();
+  input_regex = std::wregex{};
+}
 
 //----------------------------------------------------------------------
 inline void FLineEdit::setInputType (const InputType type)
@@ -734,15 +734,16 @@ void FScrollView::copyToRegion()
     std::memcpy (&ac[0], &vc[0], sizeof(FChar) * unsigned(x_end));
 
     // Update line changes
-    auto& line_changes = print_region->changes_in_line[unsigned(ay + y)];
-    line_changes.xmin = std::min({line_changes.xmin, line_start, max_limit});
-    line_changes.xmax = std::min(std::max(line_changes.xmax, line_end), max_limit);
+    print_region->addLineChanges ( uInt(ay + y)
+                                 , std::min(line_start, max_limit)
+                                 , std::min(line_end, max_limit) );
   }
 
   print_region->changes_in_row = {0, uInt(y_end - 1)};
   setViewportCursor();
   viewport->has_changes = false;
   print_region->has_changes = true;
+  print_region->markFlagsChanged();
 }
 
 
@@ -351,6 +351,20 @@ void FTextView::onKeyPress (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FTextView::onPaste (FPasteEvent* ev)
+{
+  // Appends all pasted lines with a single insert operation
+  append (ev->getText());
+  ev->accept();
+
+  if ( ! isShown() )
+    return;
+
+  scrollToEnd();
+  redraw();
+}
+
 //----------------------------------------------------------------------
 void FTextView::onMouseDown (FMouseEvent* ev)
 {
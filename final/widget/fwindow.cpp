@@ -27,6 +27,7 @@
 #include "final/input/fmouse.h"
 #include "final/menu/fmenubar.h"
 #include "final/menu/fmenu.h"
+#include "final/vterm/fwindowindex.h"
 #include "final/widget/fcombobox.h"
 #include "final/widget/fstatusbar.h"
 #include "final/widget/fwindow.h"
@@ -302,7 +303,10 @@ void FWindow::drawBorder()
 void FWindow::show()
 {
   if ( isVirtualWindow() )
+  {
     getVWin()->visible = true;
+    FTermRegion::invalidateCoverage();
+  }
 
   FWidget::show();
 }
@@ -320,7 +324,10 @@ void FWindow::hide()
   }
 
   if ( isVirtualWindow() )
+  {
     virtual_win->visible = false;
+    FTermRegion::invalidateCoverage();
+  }
 
   FWidget::hide();
   const auto& t_geometry = getTermGeometryWithShadow();
@@ -333,7 +340,10 @@ void FWindow::setX (int x, bool adjust)
   FWidget::setX (x, adjust);
 
   if ( isVirtualWindow() )
+  {
     getVWin()->position.x = getTermX() - 1;
+    updateWindowIndex (getVWin());
+  }
 }
 
 //----------------------------------------------------------------------
@@ -343,7 +353,10 @@ void FWindow::setY (int y, bool adjust)
   FWidget::setY (y, adjust);
 
   if ( isVirtualWindow() )
+  {
     getVWin()->position.y = getTermY() - 1;
+    updateWindowIndex (getVWin());
+  }
 }
 
 //----------------------------------------------------------------------
@@ -358,6 +371,7 @@ void FWindow::setPos (const FPoint& p, bool adjust)
     auto virtual_win = getVWin();
     virtual_win->position.x = getTermX() - 1;
     virtual_win->position.y = getTermY() - 1;
+    updateWindowIndex (virtual_win);
   }
 }
 
@@ -431,6 +445,8 @@ void FWindow::setGeometry ( const FPoint& p, const FSize& size, bool adjust)
 
     if ( getY() != old_y )
       getVWin()->position.y = getTermY() - 1;
+
+    updateWindowIndex (getVWin());
   }
 }
 
@@ -444,6 +460,7 @@ void FWindow::move (const FPoint& pos)
     auto virtual_win = getVWin();
     virtual_win->position.x = getTermX() - 1;
     virtual_win->position.y = getTermY() - 1;
+    updateWindowIndex (virtual_win);
   }
 }
 
@@ -456,6 +473,9 @@ auto FWindow::getWindowWidgetAt (int x, int y) -> FWindow*
   if ( ! vterm_win_list || vterm_win_list->empty() )
     return nullptr;
 
+  if ( hasCompleteWindowIndex() )
+    return getWindowWidgetByIndex (x, y);
+
   auto iter = vterm_win_list->cend();
   const auto begin = vterm_win_list->cbegin();
 
@@ -484,6 +504,7 @@ void FWindow::addWindow (FWidget* obj)
   if ( vterm_win_list )
     vterm_win_list->push_back(obj);
 
+  addToWindowIndex (obj);
   processAlwaysOnTop();
 }
 
@@ -503,6 +524,10 @@ void FWindow::delWindow (const FWidget* obj)
     if ( (*iter) == obj )
     {
       vterm_win_list->erase(iter);
+
+      if ( getWindowIndex() )
+        getWindowIndex()->remove(static_cast<const FVTerm*>(obj));
+
       determineWindowLayers();
       return;
     }
@@ -678,6 +703,7 @@ auto FWindow::minimizeWindow() -> bool
 
   const auto& virtual_win = getVWin();
   virtual_win->minimized = bool( ! isMinimized() );
+  FTermRegion::invalidateCoverage();
   const auto& t_geometry = getTermGeometryWithShadow();
   restoreVTerm (t_geometry);
 
@@ -761,6 +787,8 @@ void FWindow::adjustSize()
 
     if ( getTermY() != old_y )
       getVWin()->position.y = getTermY() - 1;
+
+    updateWindowIndex (getVWin());
   }
 }
 
@@ -890,7 +918,10 @@ void FWindow::processAlwaysOnTop()
     delWindow (*iter);
 
     if ( getWindowList() )
+    {
       getWindowList()->push_back(*iter);
+      addToWindowIndex (*iter);
+    }
 
     ++iter;
   }
@@ -898,6 +929,42 @@ void FWindow::processAlwaysOnTop()
   determineWindowLayers();
 }
 
+//----------------------------------------------------------------------
+void FWindow::addToWindowIndex (FWidget* obj)
+{
+  // Registers the virtual window of obj in the spatial window index
+
+  auto* window_index = getWindowIndex();
+
+  if ( window_index && obj->getVWin() )
+    window_index->insert (obj->getVWin(), obj);
+}
+
+//----------------------------------------------------------------------
+auto FWindow::getWindowWidgetByIndex (int x, int y) -> FWindow*
+{
+  // Returns the topmost window at the terminal position (x, y)
+  // from the windows of the corresponding index tile
+
+  const auto* window_index = getWindowIndex();
+  FWindow* found{nullptr};
+  int found_layer{0};
+
+  for (const auto* region : window_index->getRegionsAt(x - 1, y - 1))
+  {
+    auto w = static_cast<FWindow*>(window_index->getOwner(region));
+
+    if ( w && region->layer > found_layer && ! w->isWindowHidden()
+      && getVisibleTermGeometry(w).contains(x, y) )
+    {
+      found = w;
+      found_layer = region->layer;
+    }
+  }
+
+  return found;
+}
+
 //----------------------------------------------------------------------
 auto FWindow::getWindowWidgetImpl (FWidget* obj) -> FWindow*
 {
@@ -176,6 +176,8 @@ class FWindow : public FWidget
     static auto  getVisibleTermGeometry (FWindow*) -> FRect;
     static void  deleteFromAlwaysOnTopList (const FWidget*);
     static void  processAlwaysOnTop();
+    static void  addToWindowIndex (FWidget*);
+    static auto  getWindowWidgetByIndex (int, int) -> FWindow*;
     static auto  getWindowWidgetImpl (FWidget*) -> FWindow*;
     static auto  getWindowWidgetImpl (FWidget*, const FWidgetFlags&) -> FWindow*;
     static auto  getWindowLayerImpl (FWidget*) -> int;
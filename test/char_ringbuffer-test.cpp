@@ -3,7 +3,7 @@
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2022-2025 Markus Gans                                      *
+* Copyright 2022-2026 Markus Gans                                      *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -47,6 +47,7 @@ class CharRingBufferTest : public CPPUNIT_NS::TestFixture
     void IteratorTest();
     void emplaceTest();
     void KeyStringTest();
+    void fillTest();
 
   private:
     // Adds code needed to register the test suite
@@ -60,6 +61,7 @@ class CharRingBufferTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (IteratorTest);
     CPPUNIT_TEST (emplaceTest);
     CPPUNIT_TEST (KeyStringTest);
+    CPPUNIT_TEST (fillTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -1066,6 +1068,68 @@ void CharRingBufferTest::KeyStringTest()
   CPPUNIT_ASSERT ( char_rbuf.strncmp_front("\033[11~", 5) );
 }
 
+//----------------------------------------------------------------------
+void CharRingBufferTest::fillTest()
+{
+  finalcut::CharRingBuffer<8> char_rbuf;
+  std::string input{"abcdefghijk"};
+  std::size_t pos{0};
+  std::size_t calls{0};
+
+  auto read_input = [&input, &pos, &calls] (char* data, std::size_t length)
+  {
+    calls++;
+    const auto count = std::min(length, input.length() - pos);
+
+    if ( count == 0 )
+      return ssize_t(-1);  // EAGAIN
+
+    std::memcpy (data, input.data() + pos, count);
+    pos += count;
+    return ssize_t(count);
+  };
+
+  // Short read
+  input = "abc";
+  CPPUNIT_ASSERT ( char_rbuf.fill(read_input) == 3 );
+  CPPUNIT_ASSERT ( calls == 1 );
+  CPPUNIT_ASSERT ( char_rbuf.getSize() == 3 );
+  CPPUNIT_ASSERT ( char_rbuf.back() == 'c' );
+  CPPUNIT_ASSERT ( char_rbuf.strncmp_front("abc", 3) );
+
+  // No data available
+  calls = 0;
+  CPPUNIT_ASSERT ( char_rbuf.fill(read_input) == -1 );
+  CPPUNIT_ASSERT ( calls == 1 );
+  CPPUNIT_ASSERT ( char_rbuf.getSize() == 3 );
+
+  // Up to the free capacity with a wrap-around
+  char_rbuf.pop(2);
+  input = "defghijk";
+  pos = 0;
+  calls = 0;
+  CPPUNIT_ASSERT ( char_rbuf.fill(read_input) == 7 );
+  CPPUNIT_ASSERT ( calls == 2 );  // Two contiguous areas
+  CPPUNIT_ASSERT ( char_rbuf.isFull() );
+  CPPUNIT_ASSERT ( char_rbuf.front() == 'c' );
+  CPPUNIT_ASSERT ( char_rbuf.back() == 'j' );
+  CPPUNIT_ASSERT ( std::string(char_rbuf.begin(), char_rbuf.end()) == "cdefghij" );
+  CPPUNIT_ASSERT ( char_rbuf.strncmp_front("cdefghij", 8) );
+
+  // A full buffer does not read
+  calls = 0;
+  CPPUNIT_ASSERT ( char_rbuf.fill(read_input) == 0 );
+  CPPUNIT_ASSERT ( calls == 0 );
+
+  // The remaining input after the next pop
+  char_rbuf.pop(4);
+  CPPUNIT_ASSERT ( char_rbuf.fill(read_input) == 1 );
+  CPPUNIT_ASSERT ( std::string(char_rbuf.begin(), char_rbuf.end()) == "ghijk" );
+  char_rbuf.push('l');
+  CPPUNIT_ASSERT ( char_rbuf.back() == 'l' );
+  CPPUNIT_ASSERT ( std::string(char_rbuf.begin(), char_rbuf.end()) == "ghijkl" );
+}
+
 
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (CharRingBufferTest);
@@ -172,6 +172,8 @@ class ConEmu
     auto  getDA (console) const noexcept -> const char*;
     auto  getDA1 (console) const noexcept -> const char*;
     auto  getSEC_DA (console) const noexcept -> const char*;
+    auto  getXTVERSION (console) const noexcept -> const char*;
+    auto  getDECRPM_SYNC (console) const noexcept -> const char*;
 
     // Methods
     auto  openMasterPTY() -> bool;
@@ -185,6 +187,7 @@ class ConEmu
     auto  isValidFileDescriptor (int) const noexcept -> bool;
     void  writeToMaster (const char*, std::size_t) noexcept;
     void  writeToStdout (const char*, std::size_t) noexcept;
+    void  writeColorName (int) noexcept;
     void  parseTerminalBuffer (std::size_t, console) noexcept;
 
     // Data members
@@ -497,6 +500,8 @@ inline void ConEmu::printConEmuDebug() noexcept
   static_cast<void>(setenv ("DA",         "\\033[c", 1));
   static_cast<void>(setenv ("DA1",        "\\033[1c", 1));
   static_cast<void>(setenv ("SEC_DA",     "\\033[>c", 1));
+  static_cast<void>(setenv ("XTVERSION",  "\\033[>0q", 1));
+  static_cast<void>(setenv ("DECRQM",     "\\033[?2026$p", 1));
   static_cast<void>(setenv ("ANSWERBACK", "\\005", 1));
   static_cast<void>(setenv ("TITLE",      "\\033[21t", 1));
   static_cast<void>(setenv ("COLOR16",    "\\033]4;15;?\\a", 1));
@@ -513,8 +518,8 @@ inline void ConEmu::printConEmuDebug() noexcept
 
   // Command line
   static constexpr char debug_command[] = "/bin/bash -c ' \
-      for i in DSR CURSOR_POS DECID DA DA1 SEC_DA ANSWERBACK \
-               TITLE COLOR16 COLOR88 COLOR256; \
+      for i in DSR CURSOR_POS DECID DA DA1 SEC_DA XTVERSION DECRQM \
+               ANSWERBACK TITLE COLOR16 COLOR88 COLOR256; \
       do \
         eval \"echo -en \\\"$i${GO_MIDDLE}\\\"; \
               echo -n \\\"\\${$i}\\\"; \
@@ -841,6 +846,72 @@ inline auto ConEmu::getSEC_DA (console con) const noexcept -> const char*
   return sec_da[static_cast<std::size_t>(con)];
 }
 
+//----------------------------------------------------------------------
+inline auto ConEmu::getXTVERSION (console con) const noexcept -> const char*
+{
+  static ConsoleStringTableType xtversion
+  {{
+    nullptr,                             // Ansi,
+    C_STR("\033P>|XTerm(312)\033\\"),    // XTerm
+    nullptr,                             // Rxvt
+    nullptr,                             // Urxvt
+    nullptr,                             // KDE Konsole
+    nullptr,                             // GNOME Terminal
+    nullptr,                             // VTE Terminal >= 0.53.0
+    nullptr,                             // PuTTY
+    nullptr,                             // Windows Terminal
+    nullptr,                             // Tera Term
+    nullptr,                             // Cygwin
+    C_STR("\033P>|mintty 3.6.1\033\\"),  // Mintty
+    nullptr,                             // st - simple terminal
+    nullptr,                             // Linux console
+    nullptr,                             // FreeBSD console
+    nullptr,                             // NetBSD console
+    nullptr,                             // OpenBSD console
+    nullptr,                             // Sun console
+    nullptr,                             // screen
+    C_STR("\033P>|tmux 3.3a\033\\"),     // tmux
+    nullptr,                             // kterm
+    nullptr,                             // mlterm - Multi Lingual TERMinal
+    C_STR("\033P>|kitty(0.26.5)\033\\")  // kitty
+  }};
+
+  return xtversion[static_cast<std::size_t>(con)];
+}
+
+//----------------------------------------------------------------------
+inline auto ConEmu::getDECRPM_SYNC (console con) const noexcept -> const char*
+{
+  static ConsoleStringTableType decrpm_sync
+  {{
+    nullptr,                   // Ansi,
+    C_STR("\033[?2026;0$y"),  // XTerm
+    nullptr,                   // Rxvt
+    nullptr,                   // Urxvt
+    nullptr,                   // KDE Konsole
+    nullptr,                   // GNOME Terminal
+    nullptr,                   // VTE Terminal >= 0.53.0
+    nullptr,                   // PuTTY
+    nullptr,                   // Windows Terminal
+    nullptr,                   // Tera Term
+    nullptr,                   // Cygwin
+    C_STR("\033[?2026;2$y"),  // Mintty
+    nullptr,                   // st - simple terminal
+    nullptr,                   // Linux console
+    nullptr,                   // FreeBSD console
+    nullptr,                   // NetBSD console
+    nullptr,                   // OpenBSD console
+    nullptr,                   // Sun console
+    nullptr,                   // screen
+    C_STR("\033[?2026;2$y"),  // tmux
+    nullptr,                   // kterm
+    nullptr,                   // mlterm - Multi Lingual TERMinal
+    C_STR("\033[?2026;2$y")   // kitty
+  }};
+
+  return decrpm_sync[static_cast<std::size_t>(con)];
+}
+
 //----------------------------------------------------------------------
 inline auto ConEmu::openMasterPTY() -> bool
 {
@@ -1050,6 +1121,20 @@ inline void ConEmu::writeToStdout (const char* data, std::size_t length) noexcep
   }
 }
 
+//----------------------------------------------------------------------
+inline void ConEmu::writeColorName (int color_index) noexcept
+{
+  // Sends the OSC 4 response in one piece like a real terminal,
+  // so that the reader never receives a partial color name
+  std::array<char, 32> reply{};
+  const int length = std::snprintf ( reply.data(), reply.size()
+                                   , "\033]4;%d;rgb:%s\a"
+                                   , color_index, colorname[std::size_t(color_index)] );
+
+  if ( length > 0 )
+    writeToMaster(reply.data(), std::size_t(length));
+}
+
 //----------------------------------------------------------------------
 inline void ConEmu::parseTerminalBuffer (std::size_t length, console con) noexcept
 {
@@ -1134,6 +1219,38 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con) noexce
 
       i += 3;  // Skip the sequence
     }
+    else if ( i + 4 < length  // Terminal name and version (XTVERSION) - ESC [ > 0 q
+           && buffer[i] == '\033'
+           && buffer[i + 1] == '['
+           && buffer[i + 2] == '>'
+           && buffer[i + 3] == '0'
+           && buffer[i + 4] == 'q' )
+    {
+      const char* xtversion = getXTVERSION(con);
+
+      if ( xtversion )
+        writeToMaster(xtversion, std::strlen(xtversion));
+
+      i += 4;  // Skip the sequence
+    }
+    else if ( i + 8 < length  // Request synchronized output mode (DECRQM) - ESC [ ? 2 0 2 6 $ p
+           && buffer[i] == '\033'
+           && buffer[i + 1] == '['
+           && buffer[i + 2] == '?'
+           && buffer[i + 3] == '2'
+           && buffer[i + 4] == '0'
+           && buffer[i + 5] == '2'
+           && buffer[i + 6] == '6'
+           && buffer[i + 7] == '$'
+           && buffer[i + 8] == 'p' )
+    {
+      const char* decrpm = getDECRPM_SYNC(con);
+
+      if ( decrpm )
+        writeToMaster(decrpm, std::strlen(decrpm));
+
+      i += 8;  // Skip the sequence
+    }
     else if ( i + 4 < length  // Report xterm window's title - ESC [ 2 1 t
            && buffer[i] == '\033'
            && buffer[i + 1] == '['
@@ -1167,6 +1284,20 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con) noexce
 
       i += 4;  // Skip the sequence
     }
+    else if ( i + 6 < length  // Report xterm font name - ESC ] 5 0 ; ? BEL
+           && buffer[i] == '\033'
+           && buffer[i + 1] == ']'
+           && buffer[i + 2] == '5'
+           && buffer[i + 3] == '0'
+           && buffer[i + 4] == ';'
+           && buffer[i + 5] == '?'
+           && buffer[i + 6] == '\a' )
+    {
+      if ( con == console::xterm )
+        writeToMaster("\033]50;fixed\a", 10);
+
+      i += 6;  // Skip the sequence
+    }
     else if ( i + 7 < length  // Get xterm color name (0-9) - ESC ] 4 ; 0..9 ; ? BEL
            && buffer[i] == '\033'
            && buffer[i + 1] == ']'
@@ -1195,11 +1326,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con) noexce
         && con != console::kterm )
       {
         const int color_index = buffer[i + 4] - '0';
-        writeToMaster("\033]4;", 4);
-        writeToMaster(&buffer[i + 4], 1);
-        writeToMaster(";rgb:", 5);
-        writeToMaster(colorname[color_index], 14);
-        writeToMaster("\a", 1);
+        writeColorName(color_index);
       }
 
       i += 7;  // Skip the sequence
@@ -1234,12 +1361,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con) noexce
       {
         const int color_index = (buffer[i + 4] - '0') * 10
                               + (buffer[i + 5] - '0');
-        writeToMaster("\033]4;", 4);
-        writeToMaster(&buffer[i + 4], 1);
-        writeToMaster(&buffer[i + 5], 1);
-        writeToMaster(";rgb:", 5);
-        writeToMaster(colorname[color_index], 14);
-        writeToMaster("\a", 1);
+        writeColorName(color_index);
       }
 
       i += 8;  // Skip the sequence
@@ -1279,13 +1401,7 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con) noexce
 
         if ( color_index < 256 )
         {
-          writeToMaster("\033]4;", 4);
-          writeToMaster(&buffer[i + 4], 1);
-          writeToMaster(&buffer[i + 5], 1);
-          writeToMaster(&buffer[i + 6], 1);
-          writeToMaster(";rgb:", 5);
-          writeToMaster(colorname[color_index], 14);
-          writeToMaster("\a", 1);
+          writeColorName(color_index);
         }
       }
 
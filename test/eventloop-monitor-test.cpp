@@ -255,6 +255,7 @@ class FSystemTest : public finalcut::FSystem
     auto fclose (FILE*) noexcept -> int override;
     auto putchar (int) noexcept -> int override;
     auto putstring (const char*, std::size_t) noexcept -> int override;
+    auto writev (int, const struct iovec*, int) noexcept -> ssize_t override;
     auto sigaction ( int, const struct sigaction*
                    , struct sigaction*) noexcept -> int override;
     auto timer_create ( clockid_t, struct sigevent*
@@ -400,6 +401,23 @@ inline auto FSystemTest::putstring (const char* str, std::size_t len) noexcept -
   return 1;
 }
 
+//----------------------------------------------------------------------
+inline auto FSystemTest::writev (int, const struct iovec* iov, int iovcnt) noexcept -> ssize_t
+{
+  ssize_t length{0};
+
+  for (int i{0}; i < iovcnt; ++i)
+  {
+    if ( FSystemTest::putstring(static_cast<const char*>(iov[i].iov_base)
+                               , iov[i].iov_len) == EOF )
+      return -1;
+
+    length += ssize_t(iov[i].iov_len);
+  }
+
+  return length;
+}
+
 //----------------------------------------------------------------------
 inline auto FSystemTest::sigaction ( int signum
                                    , const struct sigaction* act
@@ -0,0 +1,282 @@
+/***********************************************************************
+* fbandwidthmonitor-test.cpp - FBandwidthMonitor unit tests            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FBandwidthMonitorTest
+//----------------------------------------------------------------------
+
+class FBandwidthMonitorTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FBandwidthMonitorTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void throughputTest();
+    void overloadTest();
+    void queueDepthTest();
+    void thresholdTest();
+    void resetTest();
+
+  private:
+    // Using-declaration
+    using Quality = finalcut::FBandwidthMonitor::Quality;
+
+    // Constant
+    static constexpr uInt64 interval = finalcut::FBandwidthMonitor::MEASURE_INTERVAL;
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FBandwidthMonitorTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (throughputTest);
+    CPPUNIT_TEST (overloadTest);
+    CPPUNIT_TEST (queueDepthTest);
+    CPPUNIT_TEST (thresholdTest);
+    CPPUNIT_TEST (resetTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+// static class attribute
+constexpr uInt64 FBandwidthMonitorTest::interval;
+
+//----------------------------------------------------------------------
+void FBandwidthMonitorTest::classNameTest()
+{
+  const finalcut::FBandwidthMonitor monitor{};
+  const finalcut::FString& classname = monitor.getClassName();
+  CPPUNIT_ASSERT ( classname == "FBandwidthMonitor" );
+}
+
+//----------------------------------------------------------------------
+void FBandwidthMonitorTest::noArgumentTest()
+{
+  finalcut::FBandwidthMonitor monitor{};
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Full );
+  CPPUNIT_ASSERT ( monitor.getThreshold() == finalcut::FBandwidthMonitor::DEFAULT_THRESHOLD );
+  CPPUNIT_ASSERT ( monitor.getLoad() == 0 );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 0 );
+  CPPUNIT_ASSERT ( monitor.getQueueDepth() == 0 );
+  CPPUNIT_ASSERT ( monitor.getTransferTime(1000) == 0 );  // Unknown throughput
+
+  // The first update starts the measurement
+  CPPUNIT_ASSERT ( ! monitor.update(1'000'000) );
+  CPPUNIT_ASSERT ( ! monitor.update(1'000'000 + interval) );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Full );
+  CPPUNIT_ASSERT ( monitor.getLoad() == 0 );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FBandwidthMonitorTest::throughputTest()
+{
+  finalcut::FBandwidthMonitor monitor{};
+  uInt64 now{1'000'000};
+  monitor.update(now);
+
+  // 1000 bytes in 100 ms = 10000 bytes per second
+  monitor.addWrite (600, 60'000);
+  monitor.addWrite (400, 40'000);
+  CPPUNIT_ASSERT ( ! monitor.update(now + interval / 2) );  // Interval not over
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 0 );
+  now += interval;
+  CPPUNIT_ASSERT ( ! monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 10'000 );
+  CPPUNIT_ASSERT ( monitor.getLoad() == 40 );  // 100 ms of 250 ms
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Full );
+  CPPUNIT_ASSERT ( monitor.getTransferTime(5000) == 500'000 );
+
+  // The next value is smoothed: (3 * 10000 + 2000) / 4
+  monitor.addWrite (200, 100'000);
+  now += interval;
+  CPPUNIT_ASSERT ( ! monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 8'000 );
+
+  // A fast connection has almost no load
+  monitor.addWrite (1'000'000, 100);
+  now += interval;
+  CPPUNIT_ASSERT ( ! monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getThroughput() > 1'000'000 );
+  CPPUNIT_ASSERT ( monitor.getLoad() == 0 );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Full );
+}
+
+//----------------------------------------------------------------------
+void FBandwidthMonitorTest::overloadTest()
+{
+  finalcut::FBandwidthMonitor monitor{};
+  uInt64 now{1'000'000};
+  monitor.update(now);
+
+  // 80 % load lowers the quality one step per interval
+  monitor.addWrite (2000, 200'000);
+  now += interval;
+  CPPUNIT_ASSERT ( monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getLoad() == 80 );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Reduced );
+
+  monitor.addWrite (2000, 200'000);
+  now += interval;
+  CPPUNIT_ASSERT ( monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Minimal );
+
+  monitor.addWrite (2000, 200'000);
+  now += interval;
+  CPPUNIT_ASSERT ( ! monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Minimal );
+  const auto last_change = now - interval;
+
+  // A load between half the threshold and the threshold
+  // keeps the current quality
+  monitor.addWrite (1250, 125'000);
+  now += interval;
+  CPPUNIT_ASSERT ( ! monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getLoad() == 50 );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Minimal );
+
+  // Low load: The quality only rises after the recovery time
+  while ( now + interval - last_change < finalcut::FBandwidthMonitor::RECOVERY_TIME )
+  {
+    now += interval;
+    CPPUNIT_ASSERT ( ! monitor.update(now) );
+    CPPUNIT_ASSERT ( monitor.getLoad() == 0 );
+    CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Minimal );
+  }
+
+  now += interval;
+  CPPUNIT_ASSERT ( monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Reduced );
+
+  now += interval;
+  CPPUNIT_ASSERT ( ! monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Reduced );
+
+  now += finalcut::FBandwidthMonitor::RECOVERY_TIME;
+  CPPUNIT_ASSERT ( monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Full );
+
+  // Overload again
+  monitor.addWrite (3000, 300'000);
+  now += interval;
+  CPPUNIT_ASSERT ( monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getLoad() == 120 );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Reduced );
+}
+
+//----------------------------------------------------------------------
+void FBandwidthMonitorTest::queueDepthTest()
+{
+  finalcut::FBandwidthMonitor monitor{};
+  uInt64 now{1'000'000};
+  monitor.update(now);
+  monitor.addWrite (100, 10'000);  // 10000 bytes per second
+  now += interval;
+  CPPUNIT_ASSERT ( ! monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getLoad() == 4 );
+
+  // Queued bytes count as busy time of the connection
+  monitor.setQueueDepth (1900);
+  CPPUNIT_ASSERT ( monitor.getQueueDepth() == 1900 );
+  monitor.addWrite (100, 10'000);
+  now += interval;
+  CPPUNIT_ASSERT ( monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getLoad() == 80 );  // (10 ms + 190 ms) / 250 ms
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Reduced );
+
+  // The load is limited
+  monitor.setQueueDepth (1'000'000);
+  now += interval;
+  CPPUNIT_ASSERT ( monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getLoad() == finalcut::FBandwidthMonitor::MAX_LOAD );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Minimal );
+}
+
+//----------------------------------------------------------------------
+void FBandwidthMonitorTest::thresholdTest()
+{
+  finalcut::FBandwidthMonitor monitor{};
+  monitor.setThreshold (0);
+  CPPUNIT_ASSERT ( monitor.getThreshold() == 1 );
+  monitor.setThreshold (5000);
+  CPPUNIT_ASSERT ( monitor.getThreshold() == finalcut::FBandwidthMonitor::MAX_LOAD );
+  monitor.setThreshold (90);
+  CPPUNIT_ASSERT ( monitor.getThreshold() == 90 );
+
+  // 80 % load is below the threshold
+  uInt64 now{1'000'000};
+  monitor.update(now);
+  monitor.addWrite (2000, 200'000);
+  now += interval;
+  CPPUNIT_ASSERT ( ! monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getLoad() == 80 );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Full );
+
+  monitor.setThreshold (80);
+  monitor.addWrite (2000, 200'000);
+  now += interval;
+  CPPUNIT_ASSERT ( monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Reduced );
+}
+
+//----------------------------------------------------------------------
+void FBandwidthMonitorTest::resetTest()
+{
+  finalcut::FBandwidthMonitor monitor{};
+  monitor.setThreshold (50);
+  uInt64 now{1'000'000};
+  monitor.update(now);
+  monitor.setQueueDepth (500);
+  monitor.addWrite (2000, 200'000);
+  now += interval;
+  CPPUNIT_ASSERT ( monitor.update(now) );
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Reduced );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 10'000 );
+
+  // The reset keeps the threshold
+  monitor.reset();
+  CPPUNIT_ASSERT ( monitor.getQuality() == Quality::Full );
+  CPPUNIT_ASSERT ( monitor.getThreshold() == 50 );
+  CPPUNIT_ASSERT ( monitor.getLoad() == 0 );
+  CPPUNIT_ASSERT ( monitor.getThroughput() == 0 );
+  CPPUNIT_ASSERT ( monitor.getQueueDepth() == 0 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FBandwidthMonitorTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,220 @@
+/***********************************************************************
+* fdamagelist-test.cpp - FDamageList unit tests                        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace
+{
+
+//----------------------------------------------------------------------
+auto isCovered (const finalcut::FDamageList& list, int x, int y) -> bool
+{
+  for (const auto& rect : list)
+    if ( rect.contains(finalcut::FPoint{x, y}) )
+      return true;
+
+  return false;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------
+// class FDamageListTest
+//----------------------------------------------------------------------
+
+class FDamageListTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FDamageListTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void addTest();
+    void mergeTest();
+    void overflowTest();
+    void lineSpansTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FDamageListTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (addTest);
+    CPPUNIT_TEST (mergeTest);
+    CPPUNIT_TEST (overflowTest);
+    CPPUNIT_TEST (lineSpansTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FDamageListTest::classNameTest()
+{
+  const finalcut::FDamageList d;
+  const finalcut::FString& classname = d.getClassName();
+  CPPUNIT_ASSERT ( classname == "FDamageList" );
+}
+
+//----------------------------------------------------------------------
+void FDamageListTest::noArgumentTest()
+{
+  finalcut::FDamageList d{};
+  CPPUNIT_ASSERT ( d.isEmpty() );
+  CPPUNIT_ASSERT ( d.getCount() == 0 );
+  CPPUNIT_ASSERT ( d.begin() == d.end() );
+
+  finalcut::FDamageList::FSpanVec spans{};
+  CPPUNIT_ASSERT ( ! d.getLineSpans(0, spans) );
+  CPPUNIT_ASSERT ( spans.empty() );
+}
+
+//----------------------------------------------------------------------
+void FDamageListTest::addTest()
+{
+  finalcut::FDamageList d{};
+
+  // Empty rectangles are ignored
+  d.add (finalcut::FRect{finalcut::FPoint{5, 5}, finalcut::FPoint{4, 5}});
+  CPPUNIT_ASSERT ( d.isEmpty() );
+
+  // Two distant rectangles are kept apart
+  d.add (finalcut::FRect{finalcut::FPoint{0, 0}, finalcut::FPoint{1, 0}});
+  d.add (finalcut::FRect{finalcut::FPoint{70, 0}, finalcut::FPoint{79, 0}});
+  CPPUNIT_ASSERT ( d.getCount() == 2 );
+  CPPUNIT_ASSERT ( isCovered(d, 0, 0) );
+  CPPUNIT_ASSERT ( isCovered(d, 79, 0) );
+  CPPUNIT_ASSERT ( ! isCovered(d, 40, 0) );
+
+  // A contained rectangle is absorbed
+  d.add (finalcut::FRect{finalcut::FPoint{72, 0}, finalcut::FPoint{75, 0}});
+  CPPUNIT_ASSERT ( d.getCount() == 2 );
+
+  d.clear();
+  CPPUNIT_ASSERT ( d.isEmpty() );
+  CPPUNIT_ASSERT ( ! isCovered(d, 0, 0) );
+}
+
+//----------------------------------------------------------------------
+void FDamageListTest::mergeTest()
+{
+  finalcut::FDamageList d{};
+
+  // Vertically adjacent line changes become one rectangle
+  for (int y{2}; y < 12; y++)
+    d.add (finalcut::FRect{finalcut::FPoint{10, y}, finalcut::FPoint{20, y}});
+
+  CPPUNIT_ASSERT ( d.getCount() == 1 );
+  const auto& rect = *d.begin();
+  CPPUNIT_ASSERT ( rect.getX1() == 10 );
+  CPPUNIT_ASSERT ( rect.getY1() == 2 );
+  CPPUNIT_ASSERT ( rect.getX2() == 20 );
+  CPPUNIT_ASSERT ( rect.getY2() == 11 );
+
+  // Overlapping rectangles are combined if their bounding
+  // box covers no additional cells
+  d.add (finalcut::FRect{finalcut::FPoint{15, 2}, finalcut::FPoint{25, 11}});
+  CPPUNIT_ASSERT ( d.getCount() == 1 );
+  CPPUNIT_ASSERT ( d.begin()->getX1() == 10 );
+  CPPUNIT_ASSERT ( d.begin()->getX2() == 25 );
+
+  // The overlap of two rectangles is counted only once
+  finalcut::FDamageList d1{};
+  d1.add (finalcut::FRect{finalcut::FPoint{0, 0}, finalcut::FPoint{9, 9}});
+  d1.add (finalcut::FRect{finalcut::FPoint{1, 1}, finalcut::FPoint{10, 10}});
+  CPPUNIT_ASSERT ( d1.getCount() == 2 );
+  CPPUNIT_ASSERT ( ! isCovered(d1, 10, 0) );
+  CPPUNIT_ASSERT ( ! isCovered(d1, 0, 10) );
+
+  // A rectangle that connects two others merges all three
+  finalcut::FDamageList d2{};
+  d2.add (finalcut::FRect{finalcut::FPoint{0, 0}, finalcut::FPoint{9, 0}});
+  d2.add (finalcut::FRect{finalcut::FPoint{0, 2}, finalcut::FPoint{9, 2}});
+  CPPUNIT_ASSERT ( d2.getCount() == 2 );
+  d2.add (finalcut::FRect{finalcut::FPoint{0, 1}, finalcut::FPoint{9, 1}});
+  CPPUNIT_ASSERT ( d2.getCount() == 1 );
+  CPPUNIT_ASSERT ( d2.begin()->getY1() == 0 );
+  CPPUNIT_ASSERT ( d2.begin()->getY2() == 2 );
+}
+
+//----------------------------------------------------------------------
+void FDamageListTest::overflowTest()
+{
+  finalcut::FDamageList d{};
+  constexpr int count = int(finalcut::FDamageList::MAX_RECTS) + 8;
+
+  // Single cells on a diagonal cannot be merged without growth
+  for (int i{0}; i < count; i++)
+    d.add (finalcut::FRect{finalcut::FPoint{i * 4, i * 2}, finalcut::FPoint{i * 4, i * 2}});
+
+  CPPUNIT_ASSERT ( d.getCount() == finalcut::FDamageList::MAX_RECTS );
+
+  // Every added cell is still covered
+  for (int i{0}; i < count; i++)
+    CPPUNIT_ASSERT ( isCovered(d, i * 4, i * 2) );
+}
+
+//----------------------------------------------------------------------
+void FDamageListTest::lineSpansTest()
+{
+  finalcut::FDamageList d{};
+  finalcut::FDamageList::FSpanVec spans{};
+  d.add (finalcut::FRect{finalcut::FPoint{60, 3}, finalcut::FPoint{65, 3}});
+  d.add (finalcut::FRect{finalcut::FPoint{2, 0}, finalcut::FPoint{4, 5}});
+  d.add (finalcut::FRect{finalcut::FPoint{30, 3}, finalcut::FPoint{34, 3}});
+  d.add (finalcut::FRect{finalcut::FPoint{35, 3}, finalcut::FPoint{36, 3}});
+
+  CPPUNIT_ASSERT ( ! d.getLineSpans(6, spans) );
+  CPPUNIT_ASSERT ( spans.empty() );
+
+  CPPUNIT_ASSERT ( d.getLineSpans(1, spans) );
+  CPPUNIT_ASSERT ( spans.size() == 1 );
+  CPPUNIT_ASSERT ( spans[0].xmin == 2 );
+  CPPUNIT_ASSERT ( spans[0].xmax == 4 );
+
+  // Sorted spans with joined neighbors
+  CPPUNIT_ASSERT ( d.getLineSpans(3, spans) );
+  CPPUNIT_ASSERT ( spans.size() == 3 );
+  CPPUNIT_ASSERT ( spans[0].xmin == 2 );
+  CPPUNIT_ASSERT ( spans[0].xmax == 4 );
+  CPPUNIT_ASSERT ( spans[1].xmin == 30 );
+  CPPUNIT_ASSERT ( spans[1].xmax == 36 );
+  CPPUNIT_ASSERT ( spans[2].xmin == 60 );
+  CPPUNIT_ASSERT ( spans[2].xmax == 65 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FDamageListTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -63,6 +63,7 @@ class FEventTest : public CPPUNIT_NS::TestFixture
   protected:
     void feventTest();
     void fkeyeventTest();
+    void fpasteeventTest();
     void fmouseeventTest();
     void fwheeleventTest();
     void ffocuseventTest();
@@ -81,6 +82,7 @@ class FEventTest : public CPPUNIT_NS::TestFixture
     // Add a methods to the test suite
     CPPUNIT_TEST (feventTest);
     CPPUNIT_TEST (fkeyeventTest);
+    CPPUNIT_TEST (fpasteeventTest);
     CPPUNIT_TEST (fmouseeventTest);
     CPPUNIT_TEST (fwheeleventTest);
     CPPUNIT_TEST (ffocuseventTest);
@@ -210,6 +212,27 @@ void FEventTest::fkeyeventTest()
   CPPUNIT_ASSERT ( ! event3.isAccepted() );
 }
 
+//----------------------------------------------------------------------
+void FEventTest::fpasteeventTest()
+{
+  finalcut::FPasteEvent event (finalcut::Event::Paste, "Pasted text");
+  CPPUNIT_ASSERT ( event.getType() == finalcut::Event::Paste );
+  CPPUNIT_ASSERT ( event.getText() == "Pasted text" );
+  CPPUNIT_ASSERT ( ! event.isAccepted() );  // reject by default
+  event.accept();
+  CPPUNIT_ASSERT ( event.isAccepted() );
+  event.ignore();
+  CPPUNIT_ASSERT ( ! event.isAccepted() );
+
+  finalcut::FPasteEvent event1 (finalcut::Event::Paste, "");
+  CPPUNIT_ASSERT ( event1.getText().isEmpty() );
+
+  finalcut::FString text{L"Line 1\nLine 2\n\u00e4\u00f6\u00fc"};
+  finalcut::FPasteEvent event2 (finalcut::Event::Paste, std::move(text));
+  CPPUNIT_ASSERT ( event2.getText() == L"Line 1\nLine 2\n\u00e4\u00f6\u00fc" );
+  CPPUNIT_ASSERT ( event2.getText().getLength() == 17 );
+}
+
 //----------------------------------------------------------------------
 void FEventTest::fmouseeventTest()
 {
@@ -0,0 +1,442 @@
+/***********************************************************************
+* fkey_decoder-test.cpp - FKeyDecoder unit tests                       *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+#define USE_FINAL_H
+#include <final/input/fkey_hashmap.h>
+#undef USE_FINAL_H
+
+namespace test
+{
+
+using KeyCapMapType = std::array<finalcut::FKeyMap::KeyCapMap, 5>;
+
+KeyCapMapType termcap_keys =
+{{
+  { finalcut::FKey::Backspace , "\177"     , 1, {"kb"} },  // backspace key
+  { finalcut::FKey::Clear_tab , CSI "2~"   , 4, {"kt"} },  // clear-tab key
+  { finalcut::FKey::F1        , ESC "OP"   , 3, {"k1"} },  // F1 function key
+  { finalcut::FKey::Clear     , nullptr    , 0, {"kC"} },  // clear-screen or erase key
+  { finalcut::FKey::F2        , ESC "OQ"   , 3, {"k2"} }   // F2 function key
+}};
+
+//----------------------------------------------------------------------
+auto decode (finalcut::FKeyDecoder& decoder, const std::string& seq) -> finalcut::FKey
+{
+  decoder.reset();
+  auto key{finalcut::FKey::None};
+
+  for (const auto& ch : seq)
+    key = decoder.feed(ch);
+
+  return key;
+}
+
+}  // namespace test
+
+
+//----------------------------------------------------------------------
+// class FKeyDecoderTest
+//----------------------------------------------------------------------
+
+class FKeyDecoderTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FKeyDecoderTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void knownKeyTest();
+    void termcapKeyTest();
+    void incompleteTest();
+    void mouseTest();
+    void fuzzThroughputTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FKeyDecoderTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (knownKeyTest);
+    CPPUNIT_TEST (termcapKeyTest);
+    CPPUNIT_TEST (incompleteTest);
+    CPPUNIT_TEST (mouseTest);
+    CPPUNIT_TEST (fuzzThroughputTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FKeyDecoderTest::classNameTest()
+{
+  const finalcut::FKeyDecoder d;
+  const finalcut::FString& classname = d.getClassName();
+  CPPUNIT_ASSERT ( classname == "FKeyDecoder" );
+}
+
+//----------------------------------------------------------------------
+void FKeyDecoderTest::noArgumentTest()
+{
+  finalcut::FKeyDecoder decoder;
+  CPPUNIT_ASSERT ( decoder.getLength() == 0 );
+  CPPUNIT_ASSERT ( decoder.getNumberOfStates() > 1 );
+  CPPUNIT_ASSERT ( decoder.getKey() == finalcut::FKey::Incomplete );
+
+  // Bracketed paste start marker
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[200~") == finalcut::FKey::Bracketed_paste );
+  CPPUNIT_ASSERT ( decoder.getLength() == 6 );
+  decoder.reset();
+  CPPUNIT_ASSERT ( decoder.getLength() == 0 );
+  CPPUNIT_ASSERT ( decoder.getKey() == finalcut::FKey::Incomplete );
+
+  // No key sequence starts with a printable character
+  CPPUNIT_ASSERT ( decoder.feed('a') == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( decoder.feed('\033') == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( decoder.getLength() == 2 );
+}
+
+//----------------------------------------------------------------------
+void FKeyDecoderTest::knownKeyTest()
+{
+  finalcut::FKeyDecoder decoder;
+  decoder.setMouseSequences(false);
+  using keybuffer = finalcut::CharRingBuffer<12>;
+  keybuffer char_rbuf;
+  std::size_t count{0};
+
+  for (const auto& entry : finalcut::FKeyMap::getKeyMap())
+  {
+    if ( entry.length == 0 )
+      continue;
+
+    const std::string seq(entry.string.data(), entry.length);
+    char_rbuf.clear();
+
+    for (const auto& ch : seq)
+      char_rbuf.push(ch);
+
+    // Same result as the hash table lookup
+    const auto expected = finalcut::fkeyhashmap::getKnownKey(char_rbuf);
+    CPPUNIT_ASSERT ( expected != finalcut::FKey::None );
+    CPPUNIT_ASSERT ( test::decode(decoder, seq) == expected );
+    CPPUNIT_ASSERT ( decoder.getLength() == seq.length() );
+    count++;
+  }
+
+  CPPUNIT_ASSERT ( count == finalcut::FKeyMap::getKeyMap().size() );
+
+  // Prefixes of other key sequences
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033O") == finalcut::FKey::Meta_O );
+  CPPUNIT_ASSERT ( decoder.feed('a') == finalcut::FKey::Ctrl_up );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[") == finalcut::FKey::Meta_left_square_bracket );
+  CPPUNIT_ASSERT ( decoder.feed('2') == finalcut::FKey::Incomplete );
+  CPPUNIT_ASSERT ( decoder.feed(';') == finalcut::FKey::Incomplete );
+  CPPUNIT_ASSERT ( decoder.feed('3') == finalcut::FKey::Incomplete );
+  CPPUNIT_ASSERT ( decoder.feed('~') == finalcut::FKey::Meta_insert );
+}
+
+//----------------------------------------------------------------------
+void FKeyDecoderTest::termcapKeyTest()
+{
+  finalcut::FKeyDecoder decoder;
+  const auto states = decoder.getNumberOfStates();
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[2~") == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\177") == finalcut::FKey::None );
+
+  // Termcap strings take precedence over the known keys
+  decoder.setKeyCapMap(test::termcap_keys.cbegin(), test::termcap_keys.cend());
+  CPPUNIT_ASSERT ( decoder.getNumberOfStates() > states );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[2~") == finalcut::FKey::Clear_tab );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\177") == finalcut::FKey::Backspace );
+  CPPUNIT_ASSERT ( test::decode(decoder, ESC "OP") == finalcut::FKey::F1 );
+  CPPUNIT_ASSERT ( test::decode(decoder, ESC "OQ") == finalcut::FKey::F2 );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[2;3~") == finalcut::FKey::Meta_insert );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[200~") == finalcut::FKey::Bracketed_paste );
+
+  // A new key map replaces the previous termcap strings
+  decoder.setKeyCapMap(test::termcap_keys.cbegin(), test::termcap_keys.cbegin());
+  CPPUNIT_ASSERT ( decoder.getNumberOfStates() == states );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[2~") == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\177") == finalcut::FKey::None );
+}
+
+//----------------------------------------------------------------------
+void FKeyDecoderTest::incompleteTest()
+{
+  finalcut::FKeyDecoder decoder;
+  decoder.setMouseSequences(false);
+
+  CPPUNIT_ASSERT ( decoder.feed('\033') == finalcut::FKey::Incomplete );
+  CPPUNIT_ASSERT ( decoder.feed('[') == finalcut::FKey::Meta_left_square_bracket );
+  CPPUNIT_ASSERT ( decoder.feed('1') == finalcut::FKey::Incomplete );
+  CPPUNIT_ASSERT ( decoder.feed(';') == finalcut::FKey::Incomplete );
+  CPPUNIT_ASSERT ( decoder.feed('5') == finalcut::FKey::Incomplete );
+  CPPUNIT_ASSERT ( decoder.feed('A') == finalcut::FKey::Ctrl_up );
+  CPPUNIT_ASSERT ( decoder.getLength() == 6 );
+
+  // Unknown sequence
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[_") == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( decoder.feed('.') == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( decoder.getLength() == 4 );
+
+  // The urxvt mouse sequence is not a key without mouse support
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[32;11;7M") == finalcut::FKey::None );
+}
+
+//----------------------------------------------------------------------
+void FKeyDecoderTest::mouseTest()
+{
+  finalcut::FKeyDecoder decoder;
+  const std::string x11_mouse{"\033[M Z2"};
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[M") == finalcut::FKey::Incomplete );
+  CPPUNIT_ASSERT ( decoder.feed(' ') == finalcut::FKey::Incomplete );
+  CPPUNIT_ASSERT ( decoder.feed('Z') == finalcut::FKey::Incomplete );
+  CPPUNIT_ASSERT ( decoder.feed('2') == finalcut::FKey::X11mouse );
+
+  // The mouse data bytes can match a key sequence
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[M\033[A") == finalcut::FKey::X11mouse );
+
+  // SGR extended mouse (button press and release)
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[<0;11;7M") == finalcut::FKey::Extended_mouse );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[<0;11;7m") == finalcut::FKey::Extended_mouse );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[<0;1M") == finalcut::FKey::Incomplete );
+  CPPUNIT_ASSERT ( decoder.feed(';') == finalcut::FKey::Incomplete );
+  CPPUNIT_ASSERT ( decoder.feed('1') == finalcut::FKey::Incomplete );
+  CPPUNIT_ASSERT ( decoder.feed('M') == finalcut::FKey::Extended_mouse );
+
+  // urxvt mouse
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[32;11;7M") == finalcut::FKey::Urxvt_mouse );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[35;100;40M") == finalcut::FKey::Urxvt_mouse );
+
+  // Key sequences with the same beginning as an urxvt mouse string
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[15;3~") == finalcut::FKey::Meta_f5 );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[1;5A") == finalcut::FKey::Ctrl_up );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[20;3~") == finalcut::FKey::Meta_f9 );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[32;11") == finalcut::FKey::Incomplete );
+
+  // Without mouse support
+  decoder.setMouseSequences(false);
+  CPPUNIT_ASSERT ( test::decode(decoder, x11_mouse) == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[<0;11;7M") == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( test::decode(decoder, "\033[15;3~") == finalcut::FKey::Meta_f5 );
+  decoder.setMouseSequences();
+  CPPUNIT_ASSERT ( test::decode(decoder, x11_mouse) == finalcut::FKey::X11mouse );
+}
+
+//----------------------------------------------------------------------
+void FKeyDecoderTest::fuzzThroughputTest()
+{
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  using std::chrono::steady_clock;
+  using keybuffer = finalcut::CharRingBuffer<512>;
+
+  // Key strings of the termcap and the known key tables
+  const auto& keycap_map = finalcut::FKeyMap::getKeyCapMap();
+  const auto keycap_end = std::find_if ( keycap_map.cbegin()
+                                       , keycap_map.cend()
+                                       , [] (const auto& entry)
+                                         { return entry.length == 0; } );
+  std::map<std::string, finalcut::FKey> key_strings{};
+
+  for (const auto& entry : finalcut::FKeyMap::getKeyMap())
+    key_strings[std::string(entry.string.data(), entry.length)] = entry.num;
+
+  for (auto iter{keycap_map.cbegin()}; iter != keycap_end; ++iter)
+    if ( iter->string && iter->length != 0 && iter->string[0] == '\033' )
+      key_strings[std::string(iter->string, iter->length)] = iter->num;
+
+  // Meta-O, Meta-[ and Meta-] are only decoded after a timeout
+  auto is_substring_key = [] (const std::string& seq)
+  {
+    return seq.length() == 2
+        && (seq[1] == 'O' || seq[1] == '[' || seq[1] == ']');
+  };
+  std::vector<std::pair<std::string, finalcut::FKey>> keys{};
+
+  for (const auto& entry : key_strings)
+    if ( ! is_substring_key(entry.first) )
+      keys.emplace_back(entry);
+
+  CPPUNIT_ASSERT ( keys.size() > 200 );
+
+  // Randomized stream of key strings, mouse strings and characters
+  std::mt19937 rng{20260101};
+  auto random = [&rng] (int min, int max)
+  {
+    return std::uniform_int_distribution<int>(min, max)(rng);
+  };
+  std::string stream{};
+  std::vector<finalcut::FKey> expected{};
+  constexpr std::size_t stream_size = 1024 * 1024;
+
+  while ( stream.length() < stream_size )
+  {
+    const int choice = random(0, 9);
+
+    if ( choice < 4 )  // Key string
+    {
+      const auto& k = keys[std::size_t(random(0, int(keys.size()) - 1))];
+      stream += k.first;
+      expected.push_back(k.second);
+    }
+    else if ( choice == 4 )  // X11 mouse
+    {
+      stream += "\033[M";
+
+      for (int i{0}; i < 3; i++)
+        stream.push_back(char(random(32, 126)));
+
+      expected.push_back(finalcut::FKey::X11mouse);
+    }
+    else if ( choice == 5 )  // SGR extended mouse
+    {
+      stream += "\033[<" + std::to_string(random(0, 95))
+              + ";" + std::to_string(random(1, 300))
+              + ";" + std::to_string(random(1, 300))
+              + ( random(0, 1) ? "M" : "m" );
+      expected.push_back(finalcut::FKey::Extended_mouse);
+    }
+    else if ( choice == 6 )  // urxvt mouse
+    {
+      stream += "\033[" + std::to_string(random(32, 95))
+              + ";" + std::to_string(random(1, 300))
+              + ";" + std::to_string(random(1, 300)) + "M";
+      expected.push_back(finalcut::FKey::Urxvt_mouse);
+    }
+    else  // Printable character
+    {
+      const auto ch = char(random(' ', '~'));
+      stream.push_back(ch);
+      expected.push_back(finalcut::FKey(uChar(ch)));
+    }
+  }
+
+  // Byte-wise decoding with the automaton
+  finalcut::FKeyDecoder decoder;
+  decoder.setKeyCapMap(keycap_map.cbegin(), keycap_end);
+  std::vector<finalcut::FKey> decoded{};
+  decoded.reserve(expected.size());
+  auto start = steady_clock::now();
+
+  for (const auto& ch : stream)
+  {
+    const auto key = decoder.feed(ch);
+
+    if ( key == finalcut::FKey::Incomplete
+      || (decoder.getLength() == 2 && is_substring_key(std::string{'\033', ch})) )
+      continue;
+
+    if ( key == finalcut::FKey::None && decoder.getLength() == 1 )
+      decoded.push_back(finalcut::FKey(uChar(ch)));
+    else
+      decoded.push_back(key);
+
+    decoder.reset();
+  }
+
+  const auto decoder_us = duration_cast<microseconds>(steady_clock::now() - start).count();
+  CPPUNIT_ASSERT ( decoder.getLength() == 0 );
+  CPPUNIT_ASSERT ( decoded == expected );
+
+  // Reference: hash table lookup of the whole buffer after each byte
+  finalcut::fkeyhashmap::setKeyCapMap<keybuffer>(keycap_map.cbegin(), keycap_end);
+  keybuffer char_rbuf;
+  std::vector<finalcut::FKey> hashed{};
+  hashed.reserve(expected.size());
+  start = steady_clock::now();
+
+  for (const auto& ch : stream)
+  {
+    char_rbuf.push(ch);
+    const auto len = char_rbuf.getSize();
+    auto key{finalcut::FKey::None};
+
+    if ( char_rbuf[0] != '\033' )
+      key = finalcut::FKey(uChar(ch));
+    else if ( len >= 3 && char_rbuf[1] == '[' )
+    {
+      if ( char_rbuf[2] == 'M' )
+        key = ( len < 6 ) ? finalcut::FKey::Incomplete : finalcut::FKey::X11mouse;
+      else if ( char_rbuf[2] == '<' )
+        key = ( len < 9 || (ch != 'M' && ch != 'm') )
+            ? finalcut::FKey::Incomplete : finalcut::FKey::Extended_mouse;
+      else if ( len >= 9 && ch == 'M'
+             && char_rbuf[2] >= '1' && char_rbuf[2] <= '9'
+             && std::isdigit(char_rbuf[3]) )
+        key = finalcut::FKey::Urxvt_mouse;
+    }
+
+    if ( key == finalcut::FKey::None )
+      key = finalcut::fkeyhashmap::getTermcapKey(char_rbuf);
+
+    if ( key == finalcut::FKey::None )
+      key = finalcut::fkeyhashmap::getKnownKey(char_rbuf);
+
+    if ( key == finalcut::FKey::None || key == finalcut::FKey::Incomplete
+      || (len == 2 && is_substring_key(std::string{'\033', ch})) )
+      continue;
+
+    hashed.push_back(key);
+    char_rbuf.clear();
+  }
+
+  const auto hashmap_us = duration_cast<microseconds>(steady_clock::now() - start).count();
+  CPPUNIT_ASSERT ( hashed == expected );
+
+  const auto mib = double(stream.length()) / double(1024 * 1024);
+  std::cout << "\n  " << expected.size() << " keys in "
+            << stream.length() / 1024 << " KiB\n"
+            << "  Automaton:  " << decoder_us << " µs ("
+            << mib / (double(std::max(decoder_us, int64_t(1))) / 1e6)
+            << " MiB/s)\n"
+            << "  Hash table: " << hashmap_us << " µs ("
+            << mib / (double(std::max(hashmap_us, int64_t(1))) / 1e6)
+            << " MiB/s)\n";
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FKeyDecoderTest);
+
+// The general unit test main part
+#include <main-test.inc>
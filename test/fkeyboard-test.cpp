@@ -3,7 +3,7 @@
 *                                                                      *
 * This file is part of the FINAL CUT widget toolkit                    *
 *                                                                      *
-* Copyright 2018-2024 Markus Gans                                      *
+* Copyright 2018-2026 Markus Gans                                      *
 *                                                                      *
 * FINAL CUT is free software; you can redistribute it and/or modify    *
 * it under the terms of the GNU Lesser General Public License as       *
@@ -20,9 +20,12 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <fcntl.h>
+
 #include <chrono>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <cppunit/BriefTestProgressListener.h>
 #include <cppunit/CompilerOutputter.h>
@@ -32,7 +35,13 @@
 #include <cppunit/TestResultCollector.h>
 #include <cppunit/TestRunner.h>
 
+#include <sys/wait.h>
+
+#include <conemu.h>
 #include <final/final.h>
+#define USE_FINAL_H
+#include <final/input/fkey_hashmap.h>
+#undef USE_FINAL_H
 
 #define CPPUNIT_ASSERT_CSTRING(expected, actual) \
             check_c_string (expected, actual, CPPUNIT_SOURCELINE())
@@ -288,6 +297,7 @@ test_type fkey =
 //----------------------------------------------------------------------
 
 class FKeyboardTest : public CPPUNIT_NS::TestFixture
+                    , test::ConEmu
 {
   public:
     FKeyboardTest();
@@ -307,6 +317,8 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     void mouseTest();
     void utf8Test();
     void unknownKeyTest();
+    void bracketedPasteTest();
+    void pasteThroughputTest();
 
   private:
     // Adds code needed to register the test suite
@@ -326,6 +338,8 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (mouseTest);
     CPPUNIT_TEST (utf8Test);
     CPPUNIT_TEST (unknownKeyTest);
+    CPPUNIT_TEST (bracketedPasteTest);
+    CPPUNIT_TEST (pasteThroughputTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -333,6 +347,8 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     void enableFakingInput();
     template<typename CharT>
     void input (CharT&&);
+    void injectInput (const std::string&) const;
+    void readInput();
     void processInput();
     void clear();
     void keyPressed();
@@ -3146,6 +3162,278 @@ void FKeyboardTest::unknownKeyTest()
   CPPUNIT_ASSERT ( keyboard->getKeyName(key_pressed) == "" );
 }
 
+//----------------------------------------------------------------------
+void FKeyboardTest::bracketedPasteTest()
+{
+  using finalcut::FKey;
+  std::vector<FKey> keys{};
+  std::vector<std::string> pastes{};
+  auto collect = [this, &keys, &pastes] ()
+  {
+    keys.push_back(keyboard->getKey());
+
+    if ( keyboard->getKey() == FKey::Bracketed_paste )
+      pastes.push_back(keyboard->getPasteText());
+  };
+  keyboard->setPressCommand (finalcut::FKeyboardCommand(collect));
+  auto readAll = [this, &keys] (std::size_t num)
+  {
+    for (int i{0}; i < 100 && keys.size() < num; i++)
+      readInput();
+  };
+
+  // Key strings inside the paste are not interpreted
+  input("a\033[200~x\033[Ay\033[20z\033\033[201~b");
+  readAll(3);
+  CPPUNIT_ASSERT ( keys.size() == 3 );
+  CPPUNIT_ASSERT ( keys[0] == FKey('a') );
+  CPPUNIT_ASSERT ( keys[1] == FKey::Bracketed_paste );
+  CPPUNIT_ASSERT ( keys[2] == FKey('b') );
+  CPPUNIT_ASSERT ( pastes.size() == 1 );
+  CPPUNIT_ASSERT ( pastes[0] == "x\033[Ay\033[20z\033" );
+  CPPUNIT_ASSERT ( keyboard->getPasteText().empty() );
+  CPPUNIT_ASSERT ( keyboard->getKeyName(FKey::Bracketed_paste) == "bracketed paste" );
+
+  // Each paste is delivered separately
+  keys.clear();
+  pastes.clear();
+  input("\033[200~one\033[201~\033[200~two\033[201~");
+  readAll(2);
+  CPPUNIT_ASSERT ( keys.size() == 2 );
+  CPPUNIT_ASSERT ( pastes.size() == 2 );
+  CPPUNIT_ASSERT ( pastes[0] == "one" );
+  CPPUNIT_ASSERT ( pastes[1] == "two" );
+
+  // A paste that spans several reads
+  keys.clear();
+  pastes.clear();
+  input("\033[200~first ");
+  readAll(1);
+  CPPUNIT_ASSERT ( keys.empty() );
+  input("second\033[2");
+  readAll(1);
+  CPPUNIT_ASSERT ( keys.empty() );
+  input("01~");
+  readAll(1);
+  CPPUNIT_ASSERT ( keys.size() == 1 );
+  CPPUNIT_ASSERT ( keys[0] == FKey::Bracketed_paste );
+  CPPUNIT_ASSERT ( pastes.size() == 1 );
+  CPPUNIT_ASSERT ( pastes[0] == "first second" );
+  CPPUNIT_ASSERT ( ! keyboard->hasPendingInput() );
+
+  // A paste above the size limit is delivered in parts
+  const auto paste_size_limit = finalcut::FKeyboard::getPasteSizeLimit();
+  CPPUNIT_ASSERT ( paste_size_limit == 4 * 1024 * 1024 );
+  finalcut::FKeyboard::setPasteSizeLimit(4);
+  CPPUNIT_ASSERT ( finalcut::FKeyboard::getPasteSizeLimit() == 4 );
+  keys.clear();
+  pastes.clear();
+  input("\033[200~abcdefghij\033[201~k");
+  readAll(4);
+  CPPUNIT_ASSERT ( keys.size() == 4 );
+  CPPUNIT_ASSERT ( pastes.size() == 3 );
+  CPPUNIT_ASSERT ( pastes[0] == "abcd" );
+  CPPUNIT_ASSERT ( pastes[1] == "efgh" );
+  CPPUNIT_ASSERT ( pastes[2] == "ij" );
+  CPPUNIT_ASSERT ( keys[3] == FKey('k') );
+
+  // The end marker is not split by the size limit
+  keys.clear();
+  pastes.clear();
+  input("\033[200~abc\033[201~");
+  readAll(1);
+  CPPUNIT_ASSERT ( keys.size() == 1 );
+  CPPUNIT_ASSERT ( pastes.size() == 1 );
+  CPPUNIT_ASSERT ( pastes[0] == "abc" );
+
+  // A UTF-8 character is not split by the size limit
+  keyboard->enableUTF8();
+  keys.clear();
+  pastes.clear();
+  input("\033[200~abc\xe2\x82\xac" "de\033[201~");  // "abc€de"
+  readAll(3);
+  CPPUNIT_ASSERT ( keys.size() == 3 );
+  CPPUNIT_ASSERT ( pastes.size() == 3 );
+  CPPUNIT_ASSERT ( pastes[0] == "abc" );
+  CPPUNIT_ASSERT ( pastes[1] == "\xe2\x82\xac" "d" );
+  CPPUNIT_ASSERT ( pastes[2] == "e" );
+
+  finalcut::FKeyboard::setPasteSizeLimit(2);
+  keys.clear();
+  pastes.clear();
+  input("\033[200~\xe2\x82\xac" "a\033[201~");  // "€a"
+  readAll(2);
+  CPPUNIT_ASSERT ( keys.size() == 2 );
+  CPPUNIT_ASSERT ( pastes.size() == 2 );
+  CPPUNIT_ASSERT ( pastes[0] == "\xe2\x82\xac" );
+  CPPUNIT_ASSERT ( pastes[1] == "a" );
+  keyboard->disableUTF8();
+  finalcut::FKeyboard::setPasteSizeLimit(paste_size_limit);
+
+  // A paste without end marker is delivered after the keypress timeout
+  keys.clear();
+  pastes.clear();
+  input("\033[200~lost");
+  readInput();
+  CPPUNIT_ASSERT ( keys.empty() );
+  keyboard->clearKeyBufferOnTimeout();
+  readInput();
+  CPPUNIT_ASSERT ( keys.empty() );  // Before the timeout
+  const auto timeout = finalcut::FKeyboard::getKeypressTimeout();
+  std::this_thread::sleep_for(std::chrono::microseconds(timeout + 20'000));
+  keyboard->clearKeyBufferOnTimeout();
+  readInput();
+  CPPUNIT_ASSERT ( keys.size() == 1 );
+  CPPUNIT_ASSERT ( keys[0] == FKey::Bracketed_paste );
+  CPPUNIT_ASSERT ( pastes.size() == 1 );
+  CPPUNIT_ASSERT ( pastes[0] == "lost" );
+
+  // The following input is parsed as keys again
+  input("\033[Ax");
+  readAll(3);
+  CPPUNIT_ASSERT ( keys.size() == 3 );
+  CPPUNIT_ASSERT ( keys[1] == FKey::Up );
+  CPPUNIT_ASSERT ( keys[2] == FKey('x') );
+}
+
+//----------------------------------------------------------------------
+void FKeyboardTest::pasteThroughputTest()
+{
+  pid_t pid = forkConEmu();
+
+  if ( isConEmuChildProcess(pid) )
+  {
+    // (gdb) set follow-fork-mode child
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    using std::chrono::steady_clock;
+    std::string received{};
+    auto collect = [this, &received] ()
+    {
+      received.push_back(char(keyboard->getKey()));
+    };
+    keyboard->setPressCommand (finalcut::FKeyboardCommand(collect));
+
+    // Paste throughput (64 KiB of printable text)
+    constexpr std::size_t paste_size = 64 * 1024;
+    constexpr std::size_t chunk_size = 2048;  // Fits into the tty input queue
+    std::string paste{};
+    paste.reserve(paste_size);
+
+    for (std::size_t i{0}; i < paste_size; i++)
+      paste.push_back(char(' ' + i % 95));
+
+    auto paste_time = steady_clock::duration::zero();
+
+    for (std::size_t pos{0}; pos < paste_size; pos += chunk_size)
+    {
+      const auto chunk = paste.substr(pos, chunk_size);
+      const auto expected = received.length() + chunk.length();
+      injectInput (chunk);
+      const auto start = steady_clock::now();
+
+      while ( received.length() < expected
+           && steady_clock::now() - start < std::chrono::seconds(2) )
+        readInput();
+
+      paste_time += steady_clock::now() - start;
+    }
+
+    const auto paste_us = duration_cast<microseconds>(paste_time).count();
+    const auto mib_per_s = double(paste_size) / double(1024 * 1024)
+                         / (double(std::max(paste_us, int64_t(1))) / 1e6);
+    std::cout << "\n  Paste of " << paste_size / 1024 << " KiB: "
+              << paste_us << " µs (" << mib_per_s << " MiB/s)\n";
+    CPPUNIT_ASSERT ( received == paste );
+
+    // stdin shares the file status flags with stdout and stays blocking
+    const int stdin_flags = fcntl(finalcut::FTermios::getStdIn(), F_GETFL);
+    CPPUNIT_ASSERT ( stdin_flags != -1 );
+    CPPUNIT_ASSERT ( (stdin_flags & O_NONBLOCK) == 0 );
+
+    // Bracketed paste of a 1 MiB log
+    constexpr std::size_t log_size = 1024 * 1024;
+    std::string log_text{};
+    std::string pasted{};
+    int paste_events{0};
+    auto collect_paste = [this, &pasted, &paste_events] ()
+    {
+      if ( keyboard->getKey() != finalcut::FKey::Bracketed_paste )
+        return;
+
+      pasted = keyboard->getPasteText();
+      paste_events++;
+    };
+    keyboard->setPressCommand (finalcut::FKeyboardCommand(collect_paste));
+    log_text.reserve(log_size);
+
+    while ( log_text.length() < log_size )
+      log_text += "2026-01-01 12:00:00 [info] line "
+                + std::to_string(log_text.length()) + "\r";
+
+    const auto framed = "\033[200~" + log_text + "\033[201~";
+    paste_time = steady_clock::duration::zero();
+
+    for (std::size_t pos{0}; pos < framed.length(); pos += chunk_size)
+    {
+      injectInput (framed.substr(pos, chunk_size));
+      const auto start = steady_clock::now();
+
+      do
+        readInput();
+      while ( keyboard->hasPendingInput() );
+
+      paste_time += steady_clock::now() - start;
+    }
+
+    const auto log_us = duration_cast<microseconds>(paste_time).count();
+    std::cout << "  Bracketed paste of " << log_text.length() / 1024
+              << " KiB: " << log_us << " µs\n";
+    CPPUNIT_ASSERT ( paste_events == 1 );
+    CPPUNIT_ASSERT ( pasted == log_text );
+    keyboard->setPressCommand (finalcut::FKeyboardCommand(collect));
+
+    // Per-keystroke latency
+    constexpr int keystrokes = 200;
+    auto latency = steady_clock::duration::zero();
+    received.clear();
+
+    for (int i{0}; i < keystrokes; i++)
+    {
+      injectInput (std::string(1, char('a' + i % 26)));
+      const auto start = steady_clock::now();
+
+      while ( received.length() < std::size_t(i + 1)
+           && steady_clock::now() - start < std::chrono::seconds(1) )
+        readInput();
+
+      latency += steady_clock::now() - start;
+    }
+
+    const auto latency_us = duration_cast<microseconds>(latency).count() / keystrokes;
+    std::cout << "  Keystroke latency: " << latency_us << " µs\n";
+    CPPUNIT_ASSERT ( received.length() == std::size_t(keystrokes) );
+    CPPUNIT_ASSERT ( received.back() == char('a' + (keystrokes - 1) % 26) );
+    CPPUNIT_ASSERT ( latency_us < 10'000 );
+
+    printConEmuDebug();
+    closeConEmuStdStreams();
+    exit(EXIT_SUCCESS);
+  }
+  else  // Parent
+  {
+    // Start the terminal emulation
+    startConEmuTerminal (ConEmu::console::xterm);
+    int wstatus;
+
+    if ( waitpid(pid, &wstatus, WUNTRACED) != pid )
+      std::cerr << "waitpid error" << std::endl;
+
+    if ( WIFEXITED(wstatus) )
+      CPPUNIT_ASSERT ( WEXITSTATUS(wstatus) == 0 );
+  }
+}
+
 //----------------------------------------------------------------------
 void FKeyboardTest::init()
 {
@@ -3244,6 +3532,27 @@ void FKeyboardTest::input (CharT&& string)
   fflush(stdin);
 }
 
+//----------------------------------------------------------------------
+void FKeyboardTest::injectInput (const std::string& string) const
+{
+  // Simulates keystrokes without a trailing end of transmission
+
+  auto stdin_no = finalcut::FTermios::getStdIn();
+
+  for (auto c : string)
+    if ( ::ioctl (stdin_no, TIOCSTI, &c) < 0 )
+      break;
+}
+
+//----------------------------------------------------------------------
+void FKeyboardTest::readInput()
+{
+  if ( keyboard->isKeyPressed(0) || keyboard->hasPendingInput() )
+    keyboard->fetchKeyCode();
+
+  keyboard->processQueuedInput();
+}
+
 //----------------------------------------------------------------------
 void FKeyboardTest::processInput()
 {
@@ -20,8 +20,11 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <array>
 #include <iomanip>
+#include <random>
 #include <string>
+#include <vector>
 
 #include <cppunit/BriefTestProgressListener.h>
 #include <cppunit/CompilerOutputter.h>
@@ -51,6 +54,180 @@ void check_string ( const std::string& s1
 }
 
 
+namespace test
+{
+
+//----------------------------------------------------------------------
+// class TerminalState
+//----------------------------------------------------------------------
+
+class TerminalState
+{
+  // Simple model of the graphic rendition of an ECMA-48 terminal
+
+  public:
+    void write (const std::string&);
+
+    auto operator == (const TerminalState& other) const -> bool
+    {
+      return attributes == other.attributes
+          && font == other.font
+          && foreground == other.foreground
+          && background == other.background
+          && other_output == other.other_output;
+    }
+
+  private:
+    // Methods
+    void setGraphicRendition (const std::vector<int>&);
+    static auto readColor (const std::vector<int>&, std::size_t&) -> std::string;
+
+    // Data members
+    std::array<bool, 22> attributes{};
+    int                  font{10};
+    std::string          foreground{"39"};
+    std::string          background{"49"};
+    std::string          other_output{};  // All non-SGR characters
+};
+
+//----------------------------------------------------------------------
+void TerminalState::write (const std::string& output)
+{
+  std::size_t pos{0};
+
+  while ( pos < output.length() )
+  {
+    if ( output.compare(pos, 2, CSI) == 0 )
+    {
+      auto end = pos + 2;
+
+      while ( end < output.length()
+           && (std::isdigit(uChar(output[end])) || output[end] == ';') )
+        end++;
+
+      if ( end < output.length() && output[end] == 'm' )
+      {
+        std::vector<int> parameters{0};
+
+        for (auto i = pos + 2; i < end; i++)
+        {
+          if ( output[i] == ';' )
+            parameters.push_back(0);
+          else
+            parameters.back() = parameters.back() * 10 + output[i] - '0';
+        }
+
+        setGraphicRendition (parameters);
+        pos = end + 1;
+        continue;
+      }
+    }
+
+    other_output.push_back(output[pos]);
+    pos++;
+  }
+}
+
+//----------------------------------------------------------------------
+void TerminalState::setGraphicRendition (const std::vector<int>& parameters)
+{
+  for (std::size_t i{0}; i < parameters.size(); i++)
+  {
+    const int p = parameters[i];
+
+    if ( p == 0 )
+    {
+      attributes.fill(false);
+      font = 10;
+      foreground = "39";
+      background = "49";
+    }
+    else if ( (p >= 1 && p <= 9) || p == 21 )
+      attributes[std::size_t(p)] = true;
+    else if ( p >= 10 && p <= 19 )
+      font = p;
+    else if ( p == 22 )
+      attributes[1] = attributes[2] = false;
+    else if ( p == 24 )
+      attributes[4] = attributes[21] = false;
+    else if ( p >= 23 && p <= 29 )
+      attributes[std::size_t(p - 20)] = false;
+    else if ( (p >= 30 && p <= 37) || p == 39 || (p >= 90 && p <= 97) )
+      foreground = std::to_string(p);
+    else if ( (p >= 40 && p <= 47) || p == 49 || (p >= 100 && p <= 107) )
+      background = std::to_string(p);
+    else if ( p == 38 )
+      foreground = readColor(parameters, i);
+    else if ( p == 48 )
+      background = readColor(parameters, i);
+    else  // Unknown parameter
+      other_output += "[" + std::to_string(p) + "]";
+  }
+}
+
+//----------------------------------------------------------------------
+auto TerminalState::readColor ( const std::vector<int>& parameters
+                              , std::size_t& i ) -> std::string
+{
+  // Extended color: 5;index or 2;red;green;blue
+
+  std::string color{"x"};
+  const std::size_t count = ( i + 1 < parameters.size()
+                           && parameters[i + 1] == 2 ) ? 4 : 2;
+
+  for (std::size_t n{0}; n < count && i + 1 < parameters.size(); n++)
+  {
+    i++;
+    color += ";" + std::to_string(parameters[i]);
+  }
+
+  return color;
+}
+
+//----------------------------------------------------------------------
+void setTermEnvironment (finalcut::FOptiAttr& oa)
+{
+  // Same initialization as in FTerm::init_optiAttr()
+
+  using finalcut::FTermcap;
+  using finalcut::Termcap;
+
+  const finalcut::FOptiAttr::TermEnv optiattr_env =
+  {
+    { TCAP(t_enter_bold_mode)          , TCAP(t_exit_bold_mode) },
+    { TCAP(t_enter_dim_mode)           , TCAP(t_exit_dim_mode) },
+    { TCAP(t_enter_italics_mode)       , TCAP(t_exit_italics_mode) },
+    { TCAP(t_enter_underline_mode)     , TCAP(t_exit_underline_mode) },
+    { TCAP(t_enter_blink_mode)         , TCAP(t_exit_blink_mode) },
+    { TCAP(t_enter_reverse_mode)       , TCAP(t_exit_reverse_mode) },
+    { TCAP(t_enter_standout_mode)      , TCAP(t_exit_standout_mode) },
+    { TCAP(t_enter_secure_mode)        , TCAP(t_exit_secure_mode) },
+    { TCAP(t_enter_protected_mode)     , TCAP(t_exit_protected_mode) },
+    { TCAP(t_enter_crossed_out_mode)   , TCAP(t_exit_crossed_out_mode) },
+    { TCAP(t_enter_dbl_underline_mode) , TCAP(t_exit_dbl_underline_mode) },
+    { TCAP(t_set_attributes)           , TCAP(t_exit_attribute_mode) },
+    { TCAP(t_enter_alt_charset_mode)   , TCAP(t_exit_alt_charset_mode) },
+    { TCAP(t_enter_pc_charset_mode)    , TCAP(t_exit_pc_charset_mode) },
+    {
+      TCAP(t_set_a_foreground),
+      TCAP(t_set_a_background),
+      TCAP(t_set_foreground),
+      TCAP(t_set_background),
+      TCAP(t_set_color_pair),
+      TCAP(t_orig_pair),
+      TCAP(t_orig_colors),
+      FTermcap::max_color,
+      FTermcap::attr_without_color,
+      FTermcap::ansi_default_color
+    }
+  };
+
+  oa.setTermEnvironment(optiattr_env);
+}
+
+}  // namespace test
+
+
 //----------------------------------------------------------------------
 // class FOptiAttrTest
 //----------------------------------------------------------------------
@@ -77,6 +254,8 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     void teratermTest();
     void ibmColorTest();
     void wyse50Test();
+    void transitionCacheTest();
+    void sgrFuzzTest();
 
   private:
     auto printSequence (const std::string&) -> std::string;
@@ -101,6 +280,8 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (teratermTest);
     CPPUNIT_TEST (ibmColorTest);
     CPPUNIT_TEST (wyse50Test);
+    CPPUNIT_TEST (transitionCacheTest);
+    CPPUNIT_TEST (sgrFuzzTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -239,121 +420,6 @@ void FOptiAttrTest::sgrOptimizerTest()
   CPPUNIT_ASSERT ( from == to );
   CPPUNIT_ASSERT ( ! oa.changeAttribute(from, to).data );
 
-
-  // Test only the optimizer
-  // -----------------------
-  std::string buffer = { CSI "0;10m" CSI "11m"  CSI "36m" CSI "44m" };
-  finalcut::SGRoptimizer sgr_optimizer(buffer);
-  CPPUNIT_ASSERT ( buffer.length() == 22 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 16 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "0;10;11;36;44m" );
-
-  buffer = CSI "0;1m" CSI "34m";
-  CPPUNIT_ASSERT ( buffer.length() == 11 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 9 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "0;1;34m" );
-
-  buffer = CSI "m" CSI "34m";
-  CPPUNIT_ASSERT ( buffer.length() == 8 );
-  sgr_optimizer.optimize();
-//std::cerr << "--->"
-//          << printSequence(buffer)
-//          << "<---\n";
-  CPPUNIT_ASSERT ( buffer.length() == 7 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "0;34m" );
-
-  buffer = CSI "1m" CSI "m" CSI "45m";
-  CPPUNIT_ASSERT ( buffer.length() == 12 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 9 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "1;0;45m" );
-
-  buffer = CSI "47m";
-  CPPUNIT_ASSERT ( buffer.length() == 5 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 5 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "47m" );
-
-  buffer = CSI "47m" CSI "m" CSI "1m";
-  CPPUNIT_ASSERT ( buffer.length() == 12 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 9 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "47;0;1m" );
-
-  buffer = CSI "49m" CSI "m" CSI "0m";
-  CPPUNIT_ASSERT ( buffer.length() == 12 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 9 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "49;0;0m" );
-
-  buffer = CSI "m" CSI "m" CSI "m";
-  CPPUNIT_ASSERT ( buffer.length() == 9 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 8 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "0;0;0m" );
-
-  buffer = CSI "m";
-  CPPUNIT_ASSERT ( buffer.length() == 3 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 3 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "m" );
-
-  buffer = CSI "0;10;1;7m" CSI "3m" CSI "39m" CSI "49m";
-  CPPUNIT_ASSERT ( buffer.length() == 25 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 19 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "0;10;1;7;3;39;49m" );
-
-  buffer = CSI "m" CSI "38;5;20m" CSI "48;5;229m";
-  CPPUNIT_ASSERT ( buffer.length() == 24 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 21 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "0;38;5;20;48;5;229m" );
-
-  buffer = CSI "m" CSI "38;5;20m" CSI "11;16H";
-  CPPUNIT_ASSERT ( buffer.length() == 21 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 20 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "0;38;5;20m" CSI "11;16H" );
-
-  buffer = CSI "1;1H" CSI "m" CSI "38;5;35m";
-  CPPUNIT_ASSERT ( buffer.length() == 19 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 18 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "1;1H" CSI "0;38;5;35m" );
-
-  buffer = CSI "m" CSI "38;5;20m" CSI "11;16H" CSI "48;5;229m";
-  CPPUNIT_ASSERT ( buffer.length() == 32 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 31 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "0;38;5;20m" CSI "11;16H" CSI "48;5;229m" );
-
-  buffer = CSI "m" CSI "38;5;20m" "ABC" CSI "48;5;229m";
-  CPPUNIT_ASSERT ( buffer.length() == 27 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 26 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "0;38;5;20mABC" CSI "48;5;229m" );
-
-  buffer = CSI "m" CSI "1m" CSI "2m" CSI "3m" CSI "4m"
-                      CSI "5m" CSI "7m" CSI "8m" CSI "9m";
-  CPPUNIT_ASSERT ( buffer.length() == 35 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 20 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "0;1;2;3;4;5;7;8;9m" );
-
-  buffer = CSI "0m" CSI "46;36;1m";
-  CPPUNIT_ASSERT ( buffer.length() == 14 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 12 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "0;46;36;1m" );
-
-  buffer = CSI "m" CSI "38;2;0;139;139m" CSI "48;2;240;255;240m";
-  CPPUNIT_ASSERT ( buffer.length() == 39 );
-  sgr_optimizer.optimize();
-  CPPUNIT_ASSERT ( buffer.length() == 36 );
-  CPPUNIT_ASSERT_STRING ( buffer, CSI "0;38;2;0;139;139;48;2;240;255;240m" );
 }
 
 //----------------------------------------------------------------------
@@ -1147,7 +1213,11 @@ void FOptiAttrTest::vt100Test()
   CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to).data
                         , CSI "0m\017$<2>" );
   CPPUNIT_ASSERT ( from == to );
+#if defined(F_COMPACT_FCHAR)
+  CPPUNIT_ASSERT ( oa.isInvisibleSimulated(to) );
+#else
   CPPUNIT_ASSERT ( to.encoded_char[0] == ' ' );
+#endif
   CPPUNIT_ASSERT ( ! oa.changeAttribute(from, to).data );
 
   // Invisible off (with default colors)
@@ -2091,7 +2161,11 @@ void FOptiAttrTest::rxvtTest()
   CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to).data
                         , CSI "0m\017" );
   CPPUNIT_ASSERT ( from == to );
+#if defined(F_COMPACT_FCHAR)
+  CPPUNIT_ASSERT ( oa.isInvisibleSimulated(to) );
+#else
   CPPUNIT_ASSERT ( to.encoded_char[0] == ' ' );
+#endif
   CPPUNIT_ASSERT ( ! oa.changeAttribute(from, to).data );
 
   // Invisible off (with default colors)
@@ -2562,7 +2636,11 @@ void FOptiAttrTest::linuxTest()
   CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to).data
                         , CSI "0m\017" );
   CPPUNIT_ASSERT ( from == to );
+#if defined(F_COMPACT_FCHAR)
+  CPPUNIT_ASSERT ( oa.isInvisibleSimulated(to) );
+#else
   CPPUNIT_ASSERT ( to.encoded_char[0] == ' ' );
+#endif
   CPPUNIT_ASSERT ( ! oa.changeAttribute(from, to).data );
 
   // Invisible off (with default colors)
@@ -3038,7 +3116,11 @@ void FOptiAttrTest::puttyTest()
   CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to).data
                         , CSI "0m\017" );
   CPPUNIT_ASSERT ( from == to );
+#if defined(F_COMPACT_FCHAR)
+  CPPUNIT_ASSERT ( oa.isInvisibleSimulated(to) );
+#else
   CPPUNIT_ASSERT ( to.encoded_char[0] == ' ' );
+#endif
   CPPUNIT_ASSERT ( ! oa.changeAttribute(from, to).data );
 
   // Invisible off (with default colors)
@@ -3509,7 +3591,11 @@ void FOptiAttrTest::teratermTest()
   CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to).data
                         , CSI "0m\017$<2>" );
   CPPUNIT_ASSERT ( from == to );
+#if defined(F_COMPACT_FCHAR)
+  CPPUNIT_ASSERT ( oa.isInvisibleSimulated(to) );
+#else
   CPPUNIT_ASSERT ( to.encoded_char[0] == ' ' );
+#endif
   CPPUNIT_ASSERT ( ! oa.changeAttribute(from, to).data );
 
   // Invisible off (with default colors)
@@ -3964,7 +4050,11 @@ void FOptiAttrTest::ibmColorTest()
   CPPUNIT_ASSERT ( from != to );
   CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to).data, "" );
   CPPUNIT_ASSERT ( from == to );
+#if defined(F_COMPACT_FCHAR)
+  CPPUNIT_ASSERT ( oa.isInvisibleSimulated(to) );
+#else
   CPPUNIT_ASSERT ( to.encoded_char[0] == ' ' );
+#endif
   CPPUNIT_ASSERT ( ! oa.changeAttribute(from, to).data );
 
   // Invisible off (with default colors)
@@ -4691,6 +4781,258 @@ void FOptiAttrTest::wyse50Test()
   CPPUNIT_ASSERT ( ! oa.changeAttribute(from, to).data );
 }
 
+//----------------------------------------------------------------------
+void FOptiAttrTest::transitionCacheTest()
+{
+  finalcut::FStartOptions::getInstance().sgr_optimizer = true;
+  finalcut::FOptiAttr oa;
+  oa.setDefaultColorSupport();  // ANSI default color
+  oa.setMaxColor (256);
+  oa.setNoColorVideo (0);
+  oa.set_enter_bold_mode ({CSI "1m", 4});
+  oa.set_exit_bold_mode ({CSI "22m", 5});
+  oa.set_enter_dim_mode ({CSI "2m", 4});
+  oa.set_exit_dim_mode ({CSI "22m", 5});
+  oa.set_enter_italics_mode ({CSI "3m", 4});
+  oa.set_exit_italics_mode ({CSI "23m", 5});
+  oa.set_enter_underline_mode ({CSI "4m", 4});
+  oa.set_exit_underline_mode ({CSI "24m", 5});
+  oa.set_enter_blink_mode ({CSI "5m", 4});
+  oa.set_exit_blink_mode ({CSI "25m", 5});
+  oa.set_enter_reverse_mode ({CSI "7m", 4});
+  oa.set_exit_reverse_mode ({CSI "27m", 5});
+  oa.set_enter_standout_mode ({CSI "7m", 4});
+  oa.set_exit_standout_mode ({CSI "27m", 5});
+  oa.set_enter_secure_mode ({CSI "8m", 4});
+  oa.set_exit_secure_mode ({CSI "28m", 5});
+  oa.set_enter_protected_mode ({nullptr, 0});
+  oa.set_exit_protected_mode ({CSI "0m", 4});
+  oa.set_enter_crossed_out_mode ({CSI "9m", 4});
+  oa.set_exit_crossed_out_mode ({CSI "29m", 5});
+  oa.set_enter_dbl_underline_mode ({CSI "21m", 5});
+  oa.set_exit_dbl_underline_mode ({CSI "24m", 5});
+  oa.set_set_attributes ({CSI "0"
+                         "%?%p1%p6%|%t;1%;"
+                         "%?%p5%t;2%;"
+                         "%?%p2%t;4%;"
+                         "%?%p1%p3%|%t;7%;"
+                         "%?%p4%t;5%;"
+                         "%?%p7%t;8%;m"
+                         "%?%p9%t\033(0%e\033(B%;", 97});
+  oa.set_exit_attribute_mode ({CSI "0m", 4});
+  oa.set_enter_alt_charset_mode ({ESC "(0", 3});
+  oa.set_exit_alt_charset_mode ({ESC "(B", 3});
+  oa.set_enter_pc_charset_mode ({nullptr, 0});
+  oa.set_exit_pc_charset_mode ({nullptr, 0});
+  oa.set_a_foreground_color ({CSI "%?%p1%{8}%<%t3%p1%d%e%p1%{16}%<%t9%p1"
+                              "%{8}%-%d%e38;5;%p1%d%;m", 62});
+  oa.set_a_background_color ({CSI "%?%p1%{8}%<%t4%p1%d%e%p1%{16}%<%t10"
+                              "%p1%{8}%-%d%e48;5;%p1%d%;m", 63});
+  oa.set_foreground_color ({nullptr, 0});
+  oa.set_background_color ({nullptr, 0});
+  oa.set_term_color_pair ({nullptr, 0});
+  oa.set_orig_pair ({CSI "39;49m", 8});
+  oa.set_orig_colors ({nullptr, 0});
+  oa.initialize();
+  CPPUNIT_ASSERT ( oa.getTransitionCacheSize() == 0 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 0 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 0 );
+
+  // Blue text on light gray background + bold
+  const finalcut::FChar start{};
+  finalcut::FChar from{start};
+  finalcut::FChar to{};
+  to.color.setFgColor(finalcut::FColor::Blue);
+  to.color.setBgColor(finalcut::FColor::LightGray);
+  to.attr.bit()->bold = true;
+  CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to).data
+                        , CSI "0;1m" ESC "(B" CSI "34;47m" );
+  CPPUNIT_ASSERT ( from == to );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheSize() == 1 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 0 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 1 );
+
+  // No change
+  CPPUNIT_ASSERT ( ! oa.changeAttribute(from, to).data );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheSize() == 2 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 2 );
+  CPPUNIT_ASSERT ( ! oa.changeAttribute(from, to).data );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 1 );
+
+  // The same transition again comes from the cache
+  from = start;
+  const auto cached = oa.changeAttribute(from, to);
+  CPPUNIT_ASSERT ( cached.length == 17 );
+  CPPUNIT_ASSERT ( std::string(cached.data, cached.length)
+                   == CSI "0;1m" ESC "(B" CSI "34;47m" );
+  CPPUNIT_ASSERT ( from == to );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheSize() == 2 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == 2 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == 2 );
+
+  // Cached and computed transitions must produce the same results
+  std::vector<finalcut::FChar> states{};
+  std::srand(42);
+
+  for (int n{0}; n < 40; n++)
+  {
+    finalcut::FChar ch{};
+    ch.color.setFgColor(finalcut::FColor(std::rand() % 258 - 1));
+    ch.color.setBgColor(finalcut::FColor(std::rand() % 258 - 1));
+    ch.attr.data = uInt32(std::rand()) & 0x1fffU;
+    states.push_back(ch);
+  }
+
+  std::vector<std::string> first_pass{};
+  std::vector<finalcut::FChar> first_term{};
+  from = start;
+
+  for (int n{0}; n < 400; n++)
+  {
+    to = states[std::size_t(n * 7 + n / 40) % states.size()];
+    const auto seq = oa.changeAttribute(from, to);
+    first_pass.emplace_back(seq.data ? std::string(seq.data, seq.length) : "-");
+    first_term.push_back(from);
+  }
+
+  const auto hits = oa.getTransitionCacheHits();
+  const auto misses = oa.getTransitionCacheMisses();
+  from = start;
+
+  for (int n{0}; n < 400; n++)
+  {
+    to = states[std::size_t(n * 7 + n / 40) % states.size()];
+    const auto seq = oa.changeAttribute(from, to);
+    CPPUNIT_ASSERT ( first_pass[std::size_t(n)]
+                     == (seq.data ? std::string(seq.data, seq.length) : "-") );
+    CPPUNIT_ASSERT ( first_term[std::size_t(n)] == from );
+  }
+
+  CPPUNIT_ASSERT ( oa.getTransitionCacheHits() == hits + 400 );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheMisses() == misses );
+
+  // Changed terminal capabilities invalidate the cache
+  CPPUNIT_ASSERT ( oa.getTransitionCacheSize() > 0 );
+  oa.set_enter_bold_mode ({CSI "1m", 4});
+  CPPUNIT_ASSERT ( oa.getTransitionCacheSize() == 0 );
+  from = start;
+  to = states[0];
+  oa.changeAttribute(from, to);
+  CPPUNIT_ASSERT ( oa.getTransitionCacheSize() == 1 );
+  oa.setMaxColor (8);
+  CPPUNIT_ASSERT ( oa.getTransitionCacheSize() == 0 );
+  oa.setMaxColor (256);
+  from = start;
+  oa.changeAttribute(from, to);
+  CPPUNIT_ASSERT ( oa.getTransitionCacheSize() == 1 );
+  oa.initialize();
+  CPPUNIT_ASSERT ( oa.getTransitionCacheSize() == 0 );
+
+  // A changed SGR optimizer setting invalidates the cache
+  from = start;
+  to = start;
+  to.color.setFgColor(finalcut::FColor::Red);
+  to.color.setBgColor(finalcut::FColor::Blue);
+  CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to).data
+                        , CSI "31;44m" );
+  finalcut::FStartOptions::getInstance().sgr_optimizer = false;
+  from = start;
+  CPPUNIT_ASSERT_STRING ( oa.changeAttribute(from, to).data
+                        , CSI "31m" CSI "44m" );
+  CPPUNIT_ASSERT ( oa.getTransitionCacheSize() == 1 );
+  finalcut::FStartOptions::getInstance().sgr_optimizer = true;
+
+  // The cache size is limited
+  from = start;
+
+  for (int n{0}; n < 3000; n++)
+  {
+    to = start;
+    to.color.setFgColor(finalcut::FColor(n % 256));
+    to.color.setBgColor(finalcut::FColor(n / 256));
+    oa.changeAttribute(from, to);
+    CPPUNIT_ASSERT ( oa.getTransitionCacheSize() <= 1024 );
+  }
+
+  CPPUNIT_ASSERT ( oa.getTransitionCacheSize() > 0 );
+  oa.clearTransitionCache();
+  CPPUNIT_ASSERT ( oa.getTransitionCacheSize() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FOptiAttrTest::sgrFuzzTest()
+{
+  // Compares the directly combined SGR strings with the
+  // uncombined output for random attribute changes
+
+  const std::vector<std::string> terminals =
+  {
+    "ansi", "vt100", "vt220", "linux", "xterm", "xterm-256color",
+    "rxvt", "rxvt-unicode-256color", "screen-256color", "tmux-256color",
+    "Eterm-color", "cygwin", "cons25", "putty", "konsole", "pcansi"
+  };
+
+  std::mt19937 random_engine{2026};
+  std::uniform_int_distribution<uInt32> attribute_distribution{0, 0x1fff};
+  std::bernoulli_distribution change_distribution{0.3};
+  auto& start_options = finalcut::FStartOptions::getInstance();
+  auto& fterm_data = finalcut::FTermData::getInstance();
+  std::size_t combined_length{0};
+  std::size_t uncombined_length{0};
+
+  for (const auto& terminal : terminals)
+  {
+    fterm_data.setTermType(terminal);
+    finalcut::FTermcap::max_color = 1;  // Reset the previous color count
+    finalcut::FTermcap::init();
+    finalcut::FOptiAttr oa;
+    test::setTermEnvironment(oa);
+    const int max_color = std::max(finalcut::FTermcap::max_color, 8);
+    std::uniform_int_distribution<int> color_distribution{-1, max_color - 1};
+    finalcut::FChar term_uncombined{};
+    finalcut::FChar term_combined{};
+    test::TerminalState state_uncombined{};
+    test::TerminalState state_combined{};
+    finalcut::FChar next{};
+
+    for (int n{0}; n < 2000; n++)
+    {
+      if ( change_distribution(random_engine) )
+        next.attr.data = attribute_distribution(random_engine);
+
+      if ( change_distribution(random_engine) )
+        next.color.setFgColor(finalcut::FColor(color_distribution(random_engine)));
+
+      if ( change_distribution(random_engine) )
+        next.color.setBgColor(finalcut::FColor(color_distribution(random_engine)));
+
+      // Uncombined SGR output
+      start_options.sgr_optimizer = false;
+      auto next_uncombined = next;
+      const auto seq1 = oa.changeAttribute (term_uncombined, next_uncombined);
+      const std::string uncombined = seq1.data ? std::string(seq1.data, seq1.length) : "";
+
+      // Directly combined SGR output
+      start_options.sgr_optimizer = true;
+      auto next_combined = next;
+      const auto seq2 = oa.changeAttribute (term_combined, next_combined);
+      const std::string combined = seq2.data ? std::string(seq2.data, seq2.length) : "";
+
+      CPPUNIT_ASSERT ( bool(seq1.data) == bool(seq2.data) );
+      CPPUNIT_ASSERT ( term_uncombined == term_combined );
+      CPPUNIT_ASSERT ( next_uncombined == next_combined );
+      state_uncombined.write (uncombined);
+      state_combined.write (combined);
+      CPPUNIT_ASSERT ( state_uncombined == state_combined );
+      combined_length += combined.length();
+      uncombined_length += uncombined.length();
+    }
+  }
+
+  CPPUNIT_ASSERT ( combined_length > 0 );
+  CPPUNIT_ASSERT ( combined_length < uncombined_length );
+}
+
 //----------------------------------------------------------------------
 auto FOptiAttrTest::printSequence (const std::string& s) -> std::string
 {
@@ -139,6 +139,7 @@ class FOptiMoveTest : public CPPUNIT_NS::TestFixture
     void puttyTest();
     void teratermTest();
     void wyse50Test();
+    void costCalibrationTest();
 
   private:
     auto printSequence (const std::string&) -> std::string;
@@ -160,6 +161,7 @@ class FOptiMoveTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (puttyTest);
     CPPUNIT_TEST (teratermTest);
     CPPUNIT_TEST (wyse50Test);
+    CPPUNIT_TEST (costCalibrationTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -871,6 +873,78 @@ void FOptiMoveTest::wyse50Test()
   finalcut::printDurations(om);
 }
 
+//----------------------------------------------------------------------
+void FOptiMoveTest::costCalibrationTest()
+{
+  finalcut::FTermcap::clearMotionCache();
+  finalcut::FOptiMove om;
+  om.setTermSize (200, 120);
+  om.setBaudRate (38400);
+  om.setTabStop (8);
+  om.set_eat_newline_glitch (true);
+  om.set_tabular ({"\t", 1});
+  om.set_back_tab ({CSI "Z", 3});
+  om.set_cursor_home ({CSI "H", 3});
+  om.set_cursor_to_ll ({nullptr, 0});
+  om.set_carriage_return ({"\r", 1});
+  om.set_cursor_up ({CSI "A", 3});
+  om.set_cursor_down ({"\n", 1});
+  om.set_cursor_right ({CSI "C", 3});
+  om.set_cursor_left ({"\b", 1});
+  om.set_cursor_address ({CSI "%i%p1%d;%p2%dH", 16});
+  om.set_column_address ({CSI "%i%p1%dG", 10});
+  om.set_row_address ({CSI "%i%p1%dd", 10});
+  om.set_parm_up_cursor ({CSI "%p1%dA", 8});
+  om.set_parm_down_cursor ({CSI "%p1%dB", 8});
+  om.set_parm_right_cursor ({CSI "%p1%dC", 8});
+  om.set_parm_left_cursor ({CSI "%p1%dD", 8});
+  CPPUNIT_ASSERT ( ! om.isCostCalibrated() );
+
+  // The durations of the parameterized capabilities are estimated
+  // from a sample expansion with two-digit parameters
+  CPPUNIT_ASSERT_STRING (om.moveCursor (175, 90, 179, 90).data, CSI "180G");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (137, 33, 139, 32).data, CSI "33;140H");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (108, 111, 108, 109).data, CSI "110d");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (53, 101, 50, 98).data, CSI "99;51H");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (13, 60, 9, 61).data, "\n\b\b\b\b");
+
+  std::size_t estimated_length{0};
+
+  for (int y{0}; y < 120; y += 7)
+    for (int x{0}; x < 200; x += 11)
+      estimated_length += om.moveCursor(x, y, 199 - x, y + 3).length
+                        + om.moveCursor(x, y, x + 3, y / 2).length;
+
+  // The calibrated costs are the lengths of the actual expansions
+  om.setCostCalibration();
+  CPPUNIT_ASSERT ( om.isCostCalibrated() );
+  CPPUNIT_ASSERT_STRING (om.moveCursor (175, 90, 179, 90).data, CSI "4C");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (137, 33, 139, 32).data, CSI "A" CSI "2C");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (108, 111, 108, 109).data, CSI "2A");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (53, 101, 50, 98).data, CSI "3A\b\b\b");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (13, 60, 9, 61).data, "\n" CSI "4D");
+
+  // Short distances still use the shortest sequences
+  CPPUNIT_ASSERT_STRING (om.moveCursor (9, 4, 10, 4).data, CSI "C");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (10, 4, 9, 4).data, "\b");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (5, 5, 0, 0).data, CSI "H");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (0, 0, 5, 5).data, CSI "6;6H");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (1, 0, 8, 0).data, "\t");
+
+  std::size_t calibrated_length{0};
+
+  for (int y{0}; y < 120; y += 7)
+    for (int x{0}; x < 200; x += 11)
+      calibrated_length += om.moveCursor(x, y, 199 - x, y + 3).length
+                         + om.moveCursor(x, y, x + 3, y / 2).length;
+
+  CPPUNIT_ASSERT ( calibrated_length < estimated_length );
+
+  om.setCostCalibration(false);
+  CPPUNIT_ASSERT ( ! om.isCostCalibrated() );
+  CPPUNIT_ASSERT_STRING (om.moveCursor (175, 90, 179, 90).data, CSI "180G");
+}
+
 //----------------------------------------------------------------------
 auto FOptiMoveTest::printSequence (const std::string& s) -> std::string
 {
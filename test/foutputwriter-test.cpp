@@ -0,0 +1,216 @@
+/***********************************************************************
+* foutputwriter-test.cpp - FOutputWriter unit tests                    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FOutputWriterTest
+//----------------------------------------------------------------------
+
+class FOutputWriterTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FOutputWriterTest() = default;
+
+  protected:
+    void classNameTest();
+    void orderTest();
+    void backpressureTest();
+    void destructorTest();
+    void writeErrorTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FOutputWriterTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (orderTest);
+    CPPUNIT_TEST (backpressureTest);
+    CPPUNIT_TEST (destructorTest);
+    CPPUNIT_TEST (writeErrorTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::classNameTest()
+{
+  const finalcut::FOutputWriter writer{[] (const std::string&) { return true; }};
+  const finalcut::FString& classname = writer.getClassName();
+  CPPUNIT_ASSERT ( classname == "FOutputWriter" );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::orderTest()
+{
+  // The frames are written in the order of the queue
+  std::vector<std::string> output{};
+  finalcut::FOutputWriter writer { [&output] (const std::string& frame)
+                                   {
+                                     output.push_back(frame);
+                                     return true;
+                                   } };
+  CPPUNIT_ASSERT ( ! writer.isBusy() );
+  CPPUNIT_ASSERT ( writer.getPendingFrames() == 0 );
+
+  for (auto n{0}; n < 100; n++)
+  {
+    std::string frame = "frame " + std::to_string(n);
+    writer.push (frame);
+    CPPUNIT_ASSERT ( frame.empty() );  // The caller gets an empty string
+  }
+
+  writer.waitUntilIdle();
+  CPPUNIT_ASSERT ( ! writer.isBusy() );
+  CPPUNIT_ASSERT ( writer.getWrittenFrames() == 100 );
+  CPPUNIT_ASSERT ( output.size() == 100 );
+
+  for (std::size_t n{0}; n < output.size(); n++)
+    CPPUNIT_ASSERT ( output[n] == "frame " + std::to_string(n) );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::backpressureTest()
+{
+  // A slow terminal is simulated by a blocked write function
+  std::atomic<bool> blocked{true};
+  std::atomic<std::size_t> bytes{0};
+  finalcut::FOutputWriter writer { [&blocked, &bytes] (const std::string& frame)
+                                   {
+                                     while ( blocked )
+                                       std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+                                     bytes += frame.size();
+                                     return true;
+                                   } };
+  constexpr auto queue_size = finalcut::FOutputWriter::QUEUE_SIZE;
+  std::string frame{"abc"};
+  writer.push (frame);
+  CPPUNIT_ASSERT ( writer.isBusy() );
+  CPPUNIT_ASSERT ( ! writer.isFull() );
+
+  for (std::size_t n{1}; n < queue_size; n++)
+  {
+    frame = "abc";
+    writer.push (frame);
+  }
+
+  CPPUNIT_ASSERT ( writer.isFull() );
+  CPPUNIT_ASSERT ( writer.getPendingFrames() == queue_size );
+  CPPUNIT_ASSERT ( writer.getPendingBytes() == 3 * queue_size );
+  CPPUNIT_ASSERT ( writer.getWrittenFrames() == 0 );
+
+  // A full queue blocks the producer until a frame is written
+  std::atomic<bool> pushed{false};
+  std::thread producer { [&writer, &pushed] ()
+                         {
+                           std::string last_frame{"xyz"};
+                           writer.push (last_frame);
+                           pushed = true;
+                         } };
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  CPPUNIT_ASSERT ( ! pushed );
+
+  blocked = false;
+  producer.join();
+  CPPUNIT_ASSERT ( pushed );
+  writer.waitUntilIdle();
+  CPPUNIT_ASSERT ( ! writer.isBusy() );
+  CPPUNIT_ASSERT ( writer.getWrittenFrames() == queue_size + 1 );
+  CPPUNIT_ASSERT ( bytes == 3 * (queue_size + 1) );
+  CPPUNIT_ASSERT ( writer.getWrittenBytes() == 3 * (queue_size + 1) );
+  CPPUNIT_ASSERT ( writer.getPendingBytes() == 0 );
+  CPPUNIT_ASSERT ( writer.getWriteTime() >= 50'000 );  // Blocked for 50 ms
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::destructorTest()
+{
+  // The destructor writes all queued frames
+  std::string output{};
+
+  {
+    finalcut::FOutputWriter writer { [&output] (const std::string& frame)
+                                     {
+                                       std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                                       output += frame;
+                                       return true;
+                                     } };
+
+    for (const auto* str : {"a", "b", "c", "d", "e"})
+    {
+      std::string frame{str};
+      writer.push (frame);
+    }
+  }
+
+  CPPUNIT_ASSERT ( output == "abcde" );
+}
+
+//----------------------------------------------------------------------
+void FOutputWriterTest::writeErrorTest()
+{
+  // Failed writes are counted
+  std::string output{};
+  finalcut::FOutputWriter writer { [&output] (const std::string& frame)
+                                   {
+                                     if ( frame == "error" )
+                                       return false;
+
+                                     output += frame;
+                                     return true;
+                                   } };
+  CPPUNIT_ASSERT ( writer.getWriteErrors() == 0 );
+
+  for (const auto* str : {"a", "error", "b", "error", "c"})
+  {
+    std::string frame{str};
+    writer.push (frame);
+  }
+
+  writer.waitUntilIdle();
+  CPPUNIT_ASSERT ( output == "abc" );
+  CPPUNIT_ASSERT ( writer.getWrittenFrames() == 5 );
+  CPPUNIT_ASSERT ( writer.getWriteErrors() == 2 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FOutputWriterTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,213 @@
+/***********************************************************************
+* fsystem-test.cpp - FSystem unit tests                                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+auto readAll (int fd) -> std::string
+{
+  // Reads from fd until the write end is closed
+
+  std::string data{};
+  char buffer[4096]{};
+  ssize_t bytes{};
+
+  while ( (bytes = ::read(fd, buffer, sizeof(buffer))) != 0 )
+  {
+    if ( bytes > 0 )
+      data.append(buffer, std::size_t(bytes));
+  }
+
+  return data;
+}
+
+}  // namespace test
+
+//----------------------------------------------------------------------
+// class FSystemTest
+//----------------------------------------------------------------------
+
+class FSystemTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FSystemTest() = default;
+
+  protected:
+    void outputModeTest();
+    void writeAllTest();
+    void partialWriteTest();
+    void writeErrorTest();
+    void stalledWriteTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FSystemTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (outputModeTest);
+    CPPUNIT_TEST (writeAllTest);
+    CPPUNIT_TEST (partialWriteTest);
+    CPPUNIT_TEST (writeErrorTest);
+    CPPUNIT_TEST (stalledWriteTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FSystemTest::outputModeTest()
+{
+  const auto& fsystem = finalcut::FSystem::getInstance();
+  CPPUNIT_ASSERT ( fsystem->getOutputMode() == finalcut::FSystem::OutputMode::Stdio );
+  fsystem->setOutputMode (finalcut::FSystem::OutputMode::Direct);
+  CPPUNIT_ASSERT ( fsystem->getOutputMode() == finalcut::FSystem::OutputMode::Direct );
+  fsystem->setOutputMode (finalcut::FSystem::OutputMode::Stdio);
+  CPPUNIT_ASSERT ( fsystem->getOutputMode() == finalcut::FSystem::OutputMode::Stdio );
+}
+
+//----------------------------------------------------------------------
+void FSystemTest::writeAllTest()
+{
+  const auto& fsystem = finalcut::FSystem::getInstance();
+  int fd[2]{};
+  CPPUNIT_ASSERT ( ::pipe(fd) == 0 );
+
+  char str1[] = "\033[1;1H";
+  char str2[] = "";
+  char str3[] = "Hello, World!";
+  finalcut::FSystem::IOVector iov
+  {
+    { str1, sizeof(str1) - 1 },
+    { str2, 0 },
+    { str3, sizeof(str3) - 1 }
+  };
+
+  CPPUNIT_ASSERT ( fsystem->writeAll(fd[1], iov) );
+  ::close(fd[1]);
+  CPPUNIT_ASSERT ( test::readAll(fd[0]) == "\033[1;1HHello, World!" );
+  ::close(fd[0]);
+
+  // Nothing to write
+  iov.clear();
+  CPPUNIT_ASSERT ( fsystem->writeAll(fd[1], iov) );
+}
+
+//----------------------------------------------------------------------
+void FSystemTest::partialWriteTest()
+{
+  // Writes more data into a non-blocking pipe than fits into
+  // its buffer, which leads to partial writes and EAGAIN
+
+  const auto& fsystem = finalcut::FSystem::getInstance();
+  int fd[2]{};
+  CPPUNIT_ASSERT ( ::pipe(fd) == 0 );
+  const int flags = ::fcntl(fd[1], F_GETFL);
+  CPPUNIT_ASSERT ( ::fcntl(fd[1], F_SETFL, flags | O_NONBLOCK) == 0 );
+
+  constexpr std::size_t count{3000};
+  std::vector<std::string> lines{};
+  std::string expected{};
+  finalcut::FSystem::IOVector iov{};
+
+  for (std::size_t i{0}; i < count; i++)
+    lines.emplace_back(std::string(97 + i % 7, char('a' + i % 26)) + "\n");
+
+  for (auto& line : lines)
+  {
+    expected += line;
+    iov.push_back({&line[0], line.size()});
+  }
+
+  std::string received{};
+  std::thread reader ( [&received, &fd] ()
+                       {
+                         received = test::readAll(fd[0]);
+                       } );
+
+  CPPUNIT_ASSERT ( fsystem->writeAll(fd[1], iov) );
+  ::close(fd[1]);
+  reader.join();
+  ::close(fd[0]);
+  CPPUNIT_ASSERT ( expected.size() > 65536 );
+  CPPUNIT_ASSERT ( received.size() == expected.size() );
+  CPPUNIT_ASSERT ( received == expected );
+}
+
+//----------------------------------------------------------------------
+void FSystemTest::writeErrorTest()
+{
+  const auto& fsystem = finalcut::FSystem::getInstance();
+  char str[] = "text";
+  finalcut::FSystem::IOVector iov{ { str, sizeof(str) - 1 } };
+  CPPUNIT_ASSERT ( ! fsystem->writeAll(-1, iov) );
+}
+
+//----------------------------------------------------------------------
+void FSystemTest::stalledWriteTest()
+{
+  // A non-blocking pipe without a reader never gets free
+  // buffer space, so writeAll() gives up after a time limit
+
+  const auto& fsystem = finalcut::FSystem::getInstance();
+  int fd[2]{};
+  CPPUNIT_ASSERT ( ::pipe(fd) == 0 );
+  const int flags = ::fcntl(fd[1], F_GETFL);
+  CPPUNIT_ASSERT ( ::fcntl(fd[1], F_SETFL, flags | O_NONBLOCK) == 0 );
+
+  std::string data(1024 * 1024, 'x');
+  finalcut::FSystem::IOVector iov{ { &data[0], data.size() } };
+  const auto start = std::chrono::steady_clock::now();
+  CPPUNIT_ASSERT ( ! fsystem->writeAll(fd[1], iov) );
+  CPPUNIT_ASSERT ( errno == EAGAIN );
+  const auto duration = std::chrono::steady_clock::now() - start;
+  CPPUNIT_ASSERT ( duration >= std::chrono::seconds(4) );
+  CPPUNIT_ASSERT ( duration < std::chrono::seconds(30) );
+  CPPUNIT_ASSERT ( iov[0].iov_len < data.size() );  // Partially written
+  ::close(fd[1]);
+  ::close(fd[0]);
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FSystemTest);
+
+// The general unit test main part
+#include <main-test.inc>
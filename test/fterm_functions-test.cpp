@@ -59,6 +59,7 @@ class FTermFunctionsTest : public CPPUNIT_NS::TestFixture
     void env2uintTest();
     void exitMessageTest();
     void rgb2ColorIndexTest();
+    void reduceToBasicColorTest();
     void isReverseNewFontcharTest();
     void cp437Test();
     void utf8Test();
@@ -121,6 +122,7 @@ class FTermFunctionsTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (env2uintTest);
     CPPUNIT_TEST (exitMessageTest);
     CPPUNIT_TEST (rgb2ColorIndexTest);
+    CPPUNIT_TEST (reduceToBasicColorTest);
     CPPUNIT_TEST (isReverseNewFontcharTest);
     CPPUNIT_TEST (cp437Test);
     CPPUNIT_TEST (utf8Test);
@@ -234,6 +236,45 @@ void FTermFunctionsTest::rgb2ColorIndexTest()
   CPPUNIT_ASSERT ( finalcut::rgb2ColorIndex (0x09, 0x41, 0x32) == 23 );
 }
 
+//----------------------------------------------------------------------
+void FTermFunctionsTest::reduceToBasicColorTest()
+{
+  using finalcut::FColor;
+  using finalcut::reduceToBasicColor;
+
+  // The basic colors and the default color are unchanged
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor::Default) == FColor::Default );
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor::Black) == FColor::Black );
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor::Brown) == FColor::Brown );
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor::White) == FColor::White );
+
+  // Color cube
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor::Grey0) == FColor::Black );
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor::NavyBlue) == FColor::Blue );
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor::Blue1) == FColor::LightBlue );
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor::DarkGreen) == FColor::Green );
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(196)) == FColor::LightRed );     // #ff0000
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(124)) == FColor::Red );          // #af0000
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(226)) == FColor::Yellow );       // #ffff00
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(136)) == FColor::Brown );        // #af8700
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(51)) == FColor::LightCyan );     // #00ffff
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(201)) == FColor::LightMagenta ); // #ff00ff
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(208)) == FColor::LightRed );     // #ff8700
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(59)) == FColor::DarkGray );      // #5f5f5f
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(145)) == FColor::LightGray );    // #afafaf
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(231)) == FColor::White );        // #ffffff
+
+  // Grayscale ramp
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(232)) == FColor::Black );        // #080808
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(240)) == FColor::DarkGray );     // #585858
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(248)) == FColor::LightGray );    // #a8a8a8
+  CPPUNIT_ASSERT ( reduceToBasicColor(FColor(255)) == FColor::White );        // #eeeeee
+
+  // All 256 colors are reduced to the 16 basic colors
+  for (auto c{0}; c < 256; c++)
+    CPPUNIT_ASSERT ( reduceToBasicColor(FColor(c)) < 16 );
+}
+
 //----------------------------------------------------------------------
 void FTermFunctionsTest::isReverseNewFontcharTest()
 {
@@ -1580,126 +1621,126 @@ void FTermFunctionsTest::FullWidthHalfWidthTest()
   // Column width (FChar)
   finalcut::FChar fchar{};
   std::wstring s = L"1";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   auto column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 1 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"\t";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"\r";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"\n";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"\v";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L" ";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 1 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"0";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 1 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"1";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 1 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"2";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 1 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"3";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 1 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"０";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 2 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"１";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 2 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"２";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 2 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"３";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 2 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"\U00000300";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"\U00000348";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"\U0000094d";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   fchar.attr.bit()->char_width = 0x00 & 0x03;
   s = L"\U00000e37";
-  std::copy(std::begin(s), std::end(s), std::begin(fchar.ch));
+  fchar.ch.assign(std::begin(s), std::end(s));
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(fchar) == 0 );
   column_width = finalcut::getColumnWidth(fchar.ch[0]);
   finalcut::addColumnWidth(fchar, column_width);
@@ -251,6 +251,12 @@ void FTermcapTest::encodeMotionParameterTest()
   CPPUNIT_ASSERT ( tcap.encodeMotionParameter(cursor_address, 25, 1) == CSI "2;26H" );
   CPPUNIT_ASSERT ( tcap.encodeMotionParameter(cursor_address, 0, 0) == CSI "1;1H" );
   CPPUNIT_ASSERT ( tcap.encodeMotionParameter(cursor_address, 79, 23) == CSI "24;80H" );
+
+  // A result is not overwritten by the next call
+  const auto first = tcap.encodeMotionParameter(cursor_address, 1, 2);
+  const auto second = tcap.encodeMotionParameter(cursor_address, 3, 4);
+  CPPUNIT_ASSERT ( first == CSI "3;2H" );
+  CPPUNIT_ASSERT ( second == CSI "5;4H" );
 }
 
 //----------------------------------------------------------------------
@@ -276,6 +282,12 @@ void FTermcapTest::encodeParameterTest()
   CPPUNIT_ASSERT ( tcap.encodeParameter(parm_up_cursor, 5) == CSI "5A" );
   const auto& parm_delete_line = TCS(tcap.getString("DL"));
   CPPUNIT_ASSERT ( tcap.encodeParameter(parm_delete_line, 9) == CSI "9M" );
+
+  // A result is not overwritten by the next call
+  const auto left = tcap.encodeParameter(parm_left_cursor, 3);
+  const auto right = tcap.encodeParameter(parm_right_cursor, 4);
+  CPPUNIT_ASSERT ( left == CSI "3D" );
+  CPPUNIT_ASSERT ( right == CSI "4C" );
 }
 
 //----------------------------------------------------------------------
@@ -307,6 +319,14 @@ void FTermcapTest::paddingPrintTest()
   CPPUNIT_ASSERT ( ! output.empty() );
   CPPUNIT_ASSERT ( output == "12$34567" );
 
+  // Padding detection
+  CPPUNIT_ASSERT ( ! tcap.hasPadding(nullptr, 0) );
+  CPPUNIT_ASSERT ( ! tcap.hasPadding("$", 1) );
+  CPPUNIT_ASSERT ( ! tcap.hasPadding("12$34567", 8) );
+  CPPUNIT_ASSERT ( ! tcap.hasPadding("12$<", 3) );
+  CPPUNIT_ASSERT ( tcap.hasPadding("12$<", 4) );
+  CPPUNIT_ASSERT ( tcap.hasPadding("\033[H\033[2J$<50>", 12) );
+
   // No closing '>'
   output.clear();
   status = tcap.paddingPrint ("12$3$<4567", 10, 1);
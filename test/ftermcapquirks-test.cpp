@@ -112,6 +112,11 @@ static tcap_map tcap[] =
   { {nullptr, 0}, {"Ss"} },  // set cursor style
   { {nullptr, 0}, {"sf"} },  // scroll_forward
   { {nullptr, 0}, {"sr"} },  // scroll_reverse
+  { {nullptr, 0}, {"cs"} },  // change_scroll_region
+  { {nullptr, 0}, {"al"} },  // insert_line
+  { {nullptr, 0}, {"dl"} },  // delete_line
+  { {nullptr, 0}, {"AL"} },  // parm_insert_line
+  { {nullptr, 0}, {"DL"} },  // parm_delete_line
   { {nullptr, 0}, {"ti"} },  // enter_ca_mode
   { {nullptr, 0}, {"te"} },  // exit_ca_mode
   { {nullptr, 0}, {"eA"} },  // enable_acs
@@ -0,0 +1,340 @@
+/***********************************************************************
+* ftermcaptemplate-test.cpp - FTermcapTemplate unit tests              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <random>
+#include <string>
+
+#include <final/final.h>
+
+#include <term.h>  // tparm and tgoto for the comparison
+
+#ifdef OK
+  #undef OK
+#endif
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+auto expand ( const char* string
+            , const finalcut::FTermcapTemplate::Parameters& params ) -> std::string
+{
+  const finalcut::FTermcapTemplate compiled_template{string};
+  std::string output{};
+  compiled_template.expand (params, output);
+  return output;
+}
+
+//----------------------------------------------------------------------
+auto tparm ( const char* string
+           , const finalcut::FTermcapTemplate::Parameters& p ) -> std::string
+{
+  const auto* result = ::tparm ( string
+                               , long(p[0]), long(p[1]), long(p[2])
+                               , long(p[3]), long(p[4]), long(p[5])
+                               , long(p[6]), long(p[7]), long(p[8]) );
+  return result ? result : "";
+}
+
+}  // namespace test
+
+//----------------------------------------------------------------------
+// class FTermcapTemplateTest
+//----------------------------------------------------------------------
+
+class FTermcapTemplateTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FTermcapTemplateTest() = default;
+
+  protected:
+    void classNameTest();
+    void compileTest();
+    void expandTest();
+    void conditionTest();
+    void formatTest();
+    void tparmComparisonTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FTermcapTemplateTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (compileTest);
+    CPPUNIT_TEST (expandTest);
+    CPPUNIT_TEST (conditionTest);
+    CPPUNIT_TEST (formatTest);
+    CPPUNIT_TEST (tparmComparisonTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FTermcapTemplateTest::classNameTest()
+{
+  const finalcut::FTermcapTemplate compiled_template;
+  const finalcut::FString& classname = compiled_template.getClassName();
+  CPPUNIT_ASSERT ( classname == "FTermcapTemplate" );
+}
+
+//----------------------------------------------------------------------
+void FTermcapTemplateTest::compileTest()
+{
+  finalcut::FTermcapTemplate compiled_template;
+  CPPUNIT_ASSERT ( ! compiled_template.isCompiled() );
+  CPPUNIT_ASSERT ( compiled_template.getSource().empty() );
+  CPPUNIT_ASSERT ( compiled_template.getInstructionCount() == 0 );
+  CPPUNIT_ASSERT ( ! compiled_template.compile(nullptr) );
+
+  // cup: text, %i, %p1%d, text, %p2%d, text
+  CPPUNIT_ASSERT ( compiled_template.compile(CSI "%i%p1%d;%p2%dH") );
+  CPPUNIT_ASSERT ( compiled_template.isCompiled() );
+  CPPUNIT_ASSERT ( compiled_template.getSource() == CSI "%i%p1%d;%p2%dH" );
+  CPPUNIT_ASSERT ( compiled_template.getInstructionCount() == 6 );
+
+  // Text without parameters
+  CPPUNIT_ASSERT ( compiled_template.compile(CSI "0m") );
+  CPPUNIT_ASSERT ( compiled_template.getInstructionCount() == 1 );
+  CPPUNIT_ASSERT ( compiled_template.compile("100%%") );
+  CPPUNIT_ASSERT ( compiled_template.getInstructionCount() == 1 );
+
+  // String parameters are not supported
+  CPPUNIT_ASSERT ( ! compiled_template.compile(OSC "0;%p1%s" BEL) );
+  CPPUNIT_ASSERT ( ! compiled_template.isCompiled() );
+  CPPUNIT_ASSERT ( compiled_template.getSource() == OSC "0;%p1%s" BEL );
+  CPPUNIT_ASSERT ( compiled_template.getInstructionCount() == 0 );
+  CPPUNIT_ASSERT ( ! compiled_template.compile("%p1%l%d") );
+
+  // Termcap style without %p
+  CPPUNIT_ASSERT ( ! compiled_template.compile(CSI "%i%d;%dH") );
+
+  // Syntax errors
+  CPPUNIT_ASSERT ( ! compiled_template.compile("%p0%d") );
+  CPPUNIT_ASSERT ( ! compiled_template.compile("%p1%{12") );
+  CPPUNIT_ASSERT ( ! compiled_template.compile("%p1%'a") );
+  CPPUNIT_ASSERT ( ! compiled_template.compile("%p1%P1") );
+  CPPUNIT_ASSERT ( ! compiled_template.compile("%?%p1%tA") );
+  CPPUNIT_ASSERT ( ! compiled_template.compile("%p1%;") );
+  CPPUNIT_ASSERT ( ! compiled_template.compile("%p1%") );
+
+  // An expansion of a not compiled template fails
+  std::string output{"text"};
+  CPPUNIT_ASSERT ( ! compiled_template.expand({{1}}, output) );
+  CPPUNIT_ASSERT ( output.empty() );
+
+  compiled_template.compile(CSI "%p1%dm");
+  compiled_template.clear();
+  CPPUNIT_ASSERT ( ! compiled_template.isCompiled() );
+  CPPUNIT_ASSERT ( compiled_template.getSource().empty() );
+  CPPUNIT_ASSERT ( compiled_template.getInstructionCount() == 0 );
+}
+
+//----------------------------------------------------------------------
+void FTermcapTemplateTest::expandTest()
+{
+  // Cursor address
+  CPPUNIT_ASSERT ( test::expand(CSI "%i%p1%d;%p2%dH", {{0, 0}}) == CSI "1;1H" );
+  CPPUNIT_ASSERT ( test::expand(CSI "%i%p1%d;%p2%dH", {{23, 79}}) == CSI "24;80H" );
+  CPPUNIT_ASSERT ( test::expand(CSI "%p1%dd", {{-12}}) == CSI "-12d" );
+
+  // Parameter order and text
+  CPPUNIT_ASSERT ( test::expand("%p9%d%p8%d%p7%d%p6%d%p5%d%p4%d%p3%d%p2%d%p1%d"
+                               , {{1, 2, 3, 4, 5, 6, 7, 8, 9}}) == "987654321" );
+  CPPUNIT_ASSERT ( test::expand("100%%", {{}}) == "100%" );
+
+  // Constants and arithmetic
+  CPPUNIT_ASSERT ( test::expand("%p1%{10}%+%d", {{5}}) == "15" );
+  CPPUNIT_ASSERT ( test::expand("%p1%{10}%-%d", {{5}}) == "-5" );
+  CPPUNIT_ASSERT ( test::expand("%p1%p2%*%d", {{6, 7}}) == "42" );
+  CPPUNIT_ASSERT ( test::expand("%p1%p2%/%d", {{17, 5}}) == "3" );
+  CPPUNIT_ASSERT ( test::expand("%p1%p2%m%d", {{17, 5}}) == "2" );
+  CPPUNIT_ASSERT ( test::expand("%p1%p2%/%d", {{17, 0}}) == "0" );
+  CPPUNIT_ASSERT ( test::expand("%p1%p2%m%d", {{17, 0}}) == "0" );
+  CPPUNIT_ASSERT ( test::expand("%p1%{12}%&%d", {{10}}) == "8" );
+  CPPUNIT_ASSERT ( test::expand("%p1%{12}%|%d", {{10}}) == "14" );
+  CPPUNIT_ASSERT ( test::expand("%p1%{12}%^%d", {{10}}) == "6" );
+  CPPUNIT_ASSERT ( test::expand("%p1%~%d", {{0}}) == "-1" );
+  CPPUNIT_ASSERT ( test::expand("%p1%!%d", {{0}}) == "1" );
+  CPPUNIT_ASSERT ( test::expand("%p1%!%d", {{3}}) == "0" );
+  CPPUNIT_ASSERT ( test::expand("%p1%p2%A%d", {{2, 0}}) == "0" );
+  CPPUNIT_ASSERT ( test::expand("%p1%p2%O%d", {{2, 0}}) == "1" );
+  CPPUNIT_ASSERT ( test::expand("%p1%p2%=%d", {{4, 4}}) == "1" );
+  CPPUNIT_ASSERT ( test::expand("%p1%p2%>%d", {{4, 3}}) == "1" );
+  CPPUNIT_ASSERT ( test::expand("%p1%p2%<%d", {{4, 3}}) == "0" );
+
+  // Characters
+  CPPUNIT_ASSERT ( test::expand("%'A'%p1%+%c", {{2}}) == "C" );
+  CPPUNIT_ASSERT ( test::expand(ESC "Y%p1%' '%+%c%p2%' '%+%c", {{1, 2}})
+                   == ESC "Y!\"" );
+  CPPUNIT_ASSERT ( test::expand("%p1%c", {{0}}) == "\200" );
+  CPPUNIT_ASSERT ( test::expand("A%p1%cB", {{256}}) == "A" );  // C string end
+
+  // Variables
+  CPPUNIT_ASSERT ( test::expand("%p1%Pa%p2%Pb%gb%d%ga%d", {{1, 2}}) == "21" );
+  CPPUNIT_ASSERT ( test::expand("%p1%Pz%gz%gz%+%d", {{21}}) == "42" );
+  CPPUNIT_ASSERT ( test::expand("%p1%PA", {{7}}) == "" );
+  CPPUNIT_ASSERT ( test::expand("%p1%gA%d", {{0}}) == "7" );  // Static
+
+  // Empty stack
+  CPPUNIT_ASSERT ( test::expand("%p1%d%d", {{5}}) == "50" );
+}
+
+//----------------------------------------------------------------------
+void FTermcapTemplateTest::conditionTest()
+{
+  // xterm-256color setaf
+  const char* setaf = CSI "%?%p1%{8}%<%t3%p1%d%e%p1%{16}%<%t9%p1%{8}%-%d"
+                      "%e38;5;%p1%d%;m";
+  CPPUNIT_ASSERT ( test::expand(setaf, {{1}}) == CSI "31m" );
+  CPPUNIT_ASSERT ( test::expand(setaf, {{12}}) == CSI "94m" );
+  CPPUNIT_ASSERT ( test::expand(setaf, {{196}}) == CSI "38;5;196m" );
+
+  // if-then without else
+  CPPUNIT_ASSERT ( test::expand("A%?%p1%tB%;C", {{1}}) == "ABC" );
+  CPPUNIT_ASSERT ( test::expand("A%?%p1%tB%;C", {{0}}) == "AC" );
+
+  // if-then-else
+  CPPUNIT_ASSERT ( test::expand("%?%p1%tyes%eno%;", {{1}}) == "yes" );
+  CPPUNIT_ASSERT ( test::expand("%?%p1%tyes%eno%;", {{0}}) == "no" );
+
+  // Nested conditions
+  const char* nested = "%?%p1%t%?%p2%tA%eB%;%eC%;";
+  CPPUNIT_ASSERT ( test::expand(nested, {{1, 1}}) == "A" );
+  CPPUNIT_ASSERT ( test::expand(nested, {{1, 0}}) == "B" );
+  CPPUNIT_ASSERT ( test::expand(nested, {{0, 1}}) == "C" );
+
+  // xterm sgr
+  const char* sgr = "%?%p9%t" ESC "(0%e" ESC "(B%;" CSI "0%?%p6%t;1%;%?%p5%t;2%;"
+                    "%?%p2%t;4%;%?%p1%p3%|%t;7%;%?%p4%t;5%;%?%p7%t;8%;m";
+  CPPUNIT_ASSERT ( test::expand(sgr, {{}}) == ESC "(B" CSI "0m" );
+  CPPUNIT_ASSERT ( test::expand(sgr, {{0, 1, 0, 0, 0, 1}}) == ESC "(B" CSI "0;1;4m" );
+  CPPUNIT_ASSERT ( test::expand(sgr, {{1, 0, 0, 1, 0, 0, 1, 0, 1}})
+                   == ESC "(0" CSI "0;7;5;8m" );
+}
+
+//----------------------------------------------------------------------
+void FTermcapTemplateTest::formatTest()
+{
+  CPPUNIT_ASSERT ( test::expand("%p1%3d|", {{7}}) == "  7|" );
+  CPPUNIT_ASSERT ( test::expand("%p1%03d|", {{7}}) == "007|" );
+  CPPUNIT_ASSERT ( test::expand("%p1%:-3d|", {{7}}) == "7  |" );
+  CPPUNIT_ASSERT ( test::expand("%p1%x", {{255}}) == "ff" );
+  CPPUNIT_ASSERT ( test::expand("%p1%02X", {{10}}) == "0A" );
+  CPPUNIT_ASSERT ( test::expand("%p1%#o", {{8}}) == "010" );
+  CPPUNIT_ASSERT ( test::expand("%p1%2.2X", {{5}}) == "05" );
+
+  // linux initc
+  const char* initc = OSC "P%p1%x%p2%{255}%*%{1000}%/%02x%p3%{255}%*"
+                      "%{1000}%/%02x%p4%{255}%*%{1000}%/%02x";
+  CPPUNIT_ASSERT ( test::expand(initc, {{1, 1000, 0, 500}}) == OSC "P1ff007f" );
+}
+
+//----------------------------------------------------------------------
+void FTermcapTemplateTest::tparmComparisonTest()
+{
+  // Compares the expansion of all parameterized capability strings
+  // of several terminals with the result of tparm()
+
+  const std::vector<std::string> terminals =
+  {
+    "ansi", "vt100", "vt220", "linux", "xterm", "xterm-256color",
+    "rxvt", "rxvt-unicode-256color", "screen-256color", "tmux-256color",
+    "Eterm-color", "cygwin", "cons25", "sun", "wsvt25", "mach-color", "pcansi"
+  };
+
+  std::mt19937 random_engine{42};
+  std::uniform_int_distribution<int> value_distribution{0, 300};
+  std::bernoulli_distribution bool_distribution{0.5};
+  auto& fterm_data = finalcut::FTermData::getInstance();
+  std::size_t compared{0};
+
+  for (const auto& terminal : terminals)
+  {
+    fterm_data.setTermType(terminal);
+    finalcut::FTermcap::init();
+    CPPUNIT_ASSERT ( finalcut::FTermcap::isInitialized() );
+
+    for (const auto& entry : finalcut::FTermcap::strings)
+    {
+      const auto& cap = entry.string;
+
+      if ( ! cap.data || ! std::strchr(cap.data, '%') )
+        continue;
+
+      const finalcut::FTermcapTemplate compiled_template{cap.data};
+
+      if ( ! compiled_template.isCompiled() )
+        continue;
+
+      for (int n{0}; n < 50; n++)
+      {
+        finalcut::FTermcapTemplate::Parameters params{};
+
+        for (auto& param : params)
+          param = ( n % 2 == 0 ) ? value_distribution(random_engine)
+                                 : int(bool_distribution(random_engine));
+
+        const auto expected = test::tparm(cap.data, params);
+        const auto result = finalcut::FTermcap::encodeParameter \
+            ( cap, params[0], params[1], params[2], params[3], params[4]
+            , params[5], params[6], params[7], params[8] );
+        CPPUNIT_ASSERT_EQUAL ( expected, result );
+        compared++;
+      }
+    }
+
+    // Cursor motion
+    const auto& cup = finalcut::FTermcap::strings \
+        [int(finalcut::Termcap::t_cursor_address)].string;
+
+    if ( ! cup.data )
+      continue;
+
+    for (int n{0}; n < 50; n++)
+    {
+      const int col = value_distribution(random_engine) % 200;
+      const int row = value_distribution(random_engine) % 60;
+      const std::string expected = ::tgoto(cup.data, col, row);
+      const auto result = finalcut::FTermcap::encodeMotionParameter \
+          (cup, col, row);
+      CPPUNIT_ASSERT_EQUAL ( expected, std::string(result.data, result.length) );
+    }
+  }
+
+  CPPUNIT_ASSERT ( compared > 1000 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FTermcapTemplateTest);
+
+// The general unit test main part
+#include <main-test.inc>
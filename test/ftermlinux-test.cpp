@@ -134,6 +134,7 @@ class FSystemTest : public finalcut::FSystem
     auto fputs (const char*, FILE*) noexcept -> int override;
     auto putchar (int) noexcept -> int override;
     auto putstring (const char*, std::size_t) noexcept -> int override;
+    auto writev (int, const struct iovec*, int) noexcept -> ssize_t override;
     auto sigaction ( int, const struct sigaction*
                    , struct sigaction*) noexcept -> int override;
     auto timer_create ( clockid_t, struct sigevent*
@@ -1945,6 +1946,12 @@ auto FSystemTest::putstring (const char* str, std::size_t len) noexcept -> int
   return std::fwrite(str, 1, len, stdout);
 }
 
+//----------------------------------------------------------------------
+auto FSystemTest::writev (int fd, const struct iovec* iov, int iovcnt) noexcept -> ssize_t
+{
+  return ::writev(fd, iov, iovcnt);
+}
+
 //----------------------------------------------------------------------
 auto FSystemTest::sigaction ( int, const struct sigaction*
                             , struct sigaction* ) noexcept -> int
@@ -0,0 +1,1331 @@
+/***********************************************************************
+* ftermoutput-test.cpp - FTermOutput unit tests                        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FSystemCapture
+//----------------------------------------------------------------------
+
+class FSystemCapture : public finalcut::FSystem
+{
+  public:
+    // Constructor
+    FSystemCapture();
+
+    // Accessor
+    auto getOutput() const -> const std::string&;
+
+    // Mutator
+    void setWriteError (bool);
+
+    // Methods
+    void clear();
+    auto inPortByte (uShort) noexcept -> uChar override;
+    void outPortByte (uChar, uShort) noexcept override;
+    auto isTTY (int) const noexcept -> int override;
+    auto ioctl (int, uLong, ...) noexcept -> int override;
+    auto pipe (finalcut::PipeData&) noexcept -> int override;
+    auto open (const char*, int, ...) noexcept -> int override;
+    auto close (int) noexcept -> int override;
+    auto fopen (const char*, const char*) noexcept -> FILE* override;
+    auto fclose (FILE*) noexcept -> int override;
+    auto fputs (const char*, FILE*) noexcept -> int override;
+    auto putchar (int) noexcept -> int override;
+    auto putstring (const char*, std::size_t) noexcept -> int override;
+    auto writev (int, const struct iovec*, int) noexcept -> ssize_t override;
+    auto sigaction ( int, const struct sigaction*
+                   , struct sigaction*) noexcept -> int override;
+    auto timer_create ( clockid_t, struct sigevent*
+                      , timer_t* ) noexcept -> int override;
+    auto timer_settime ( timer_t, int
+                       , const struct itimerspec*
+                       , struct itimerspec* ) noexcept -> int override;
+    auto timer_delete (timer_t) noexcept -> int override;
+    auto kqueue() noexcept -> int override;
+    auto kevent ( int, const struct kevent*
+                , int, struct kevent*
+                , int, const struct timespec* ) noexcept -> int override;
+    auto getuid() noexcept -> uid_t override;
+    auto geteuid() noexcept -> uid_t override;
+    auto getpwuid_r ( uid_t, struct passwd*, char*
+                    , size_t, struct passwd** ) noexcept -> int override;
+    auto realpath (const char*, char*) noexcept -> char* override;
+
+  private:
+    // Data members
+    std::string output{};
+    bool        write_error{false};
+};
+
+//----------------------------------------------------------------------
+FSystemCapture::FSystemCapture()
+{
+  // The terminal output is collected by writev()
+  setOutputMode (finalcut::FSystem::OutputMode::Direct);
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::getOutput() const -> const std::string&
+{
+  return output;
+}
+
+//----------------------------------------------------------------------
+void FSystemCapture::setWriteError (bool enable)
+{
+  write_error = enable;
+}
+
+//----------------------------------------------------------------------
+void FSystemCapture::clear()
+{
+  output.clear();
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::inPortByte (uShort) noexcept -> uChar
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+void FSystemCapture::outPortByte (uChar, uShort) noexcept
+{ }
+
+//----------------------------------------------------------------------
+auto FSystemCapture::isTTY (int) const noexcept -> int
+{
+  return 1;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::ioctl (int, uLong, ...) noexcept -> int
+{
+  return -1;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::pipe (finalcut::PipeData&) noexcept -> int
+{
+  return -1;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::open (const char*, int, ...) noexcept -> int
+{
+  return -1;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::close (int) noexcept -> int
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::fopen (const char*, const char*) noexcept -> FILE*
+{
+  return nullptr;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::fclose (FILE*) noexcept -> int
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::fputs (const char* str, FILE*) noexcept -> int
+{
+  output.append(str);
+  return 1;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::putchar (int c) noexcept -> int
+{
+  output.push_back(char(c));
+  return c;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::putstring (const char* str, std::size_t len) noexcept -> int
+{
+  output.append(str, len);
+  return int(len);
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::writev (int, const struct iovec* iov, int iovcnt) noexcept -> ssize_t
+{
+  ssize_t written{0};
+
+  if ( write_error )
+  {
+    errno = EIO;
+    return -1;
+  }
+
+  for (int i{0}; i < iovcnt; i++)
+  {
+    output.append (static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+    written += ssize_t(iov[i].iov_len);
+  }
+
+  return written;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::sigaction ( int, const struct sigaction*
+                               , struct sigaction* ) noexcept -> int
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::timer_create ( clockid_t, struct sigevent*
+                                  , timer_t* ) noexcept -> int
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::timer_settime ( timer_t, int
+                                   , const struct itimerspec*
+                                   , struct itimerspec* ) noexcept -> int
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::timer_delete (timer_t) noexcept -> int
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::kqueue() noexcept -> int
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::kevent ( int, const struct kevent*
+                            , int, struct kevent*
+                            , int, const struct timespec* ) noexcept -> int
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::getuid() noexcept -> uid_t
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::geteuid() noexcept -> uid_t
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::getpwuid_r ( uid_t, struct passwd*, char*
+                                , size_t, struct passwd** ) noexcept -> int
+{
+  return 0;
+}
+
+//----------------------------------------------------------------------
+auto FSystemCapture::realpath (const char*, char*) noexcept -> char*
+{
+  return const_cast<char*>("");
+}
+
+
+//----------------------------------------------------------------------
+// class TerminalModel
+//----------------------------------------------------------------------
+
+class TerminalModel final
+{
+  public:
+    struct Cell
+    {
+      wchar_t ch{L' '};
+      bool    bold{false};
+      bool    underline{false};
+      bool    reverse{false};
+    };
+
+    // Constructor
+    TerminalModel (int w, int h)
+      : width{w}
+      , height{h}
+      , bottom_margin{h - 1}
+      , cells(std::size_t(w * h))
+    { }
+
+    // Accessors
+    auto getCell (int x, int y) const -> const Cell&
+    {
+      return cells[std::size_t(y * width + x)];
+    }
+
+    auto getCursor() const -> finalcut::FPoint
+    {
+      return { cursor_x, cursor_y };
+    }
+
+    // Method
+    void write (const std::string&);
+
+  private:
+    // Enumeration
+    enum class State { Ground, Escape, Charset, Csi, Osc };
+
+    // Methods
+    auto cell (int x, int y) -> Cell&
+    {
+      return cells[std::size_t(y * width + x)];
+    }
+
+    void printChar (wchar_t);
+    void escape (char);
+    void csi (char);
+    void sgr();
+    void lineFeed();
+    void reverseIndex();
+    void scrollUp (int, int, int);
+    void scrollDown (int, int, int);
+    void eraseCells (int, int, int);
+    auto getParam (std::size_t, int) const -> int;
+    void moveCursor (int x, int y)
+    {
+      cursor_x = std::max(0, std::min(x, width - 1));
+      cursor_y = std::max(0, std::min(y, height - 1));
+      wrap_pending = false;
+    }
+
+    // Data members
+    int               width;
+    int               height;
+    int               cursor_x{0};
+    int               cursor_y{0};
+    int               top_margin{0};
+    int               bottom_margin;
+    bool              wrap_pending{false};
+    bool              autowrap{true};
+    bool              insert_mode{false};
+    Cell              attribute{};
+    wchar_t           last_char{L' '};
+    State             state{State::Ground};
+    std::string       params{};
+    wchar_t           utf8_char{0};
+    int               utf8_bytes{0};
+    std::vector<Cell> cells;
+};
+
+//----------------------------------------------------------------------
+void TerminalModel::write (const std::string& data)
+{
+  // Interprets the xterm control sequences used by FTermOutput
+
+  for (const auto& byte : data)
+  {
+    const auto ch = static_cast<unsigned char>(byte);
+
+    if ( state == State::Escape )
+    {
+      escape(char(ch));
+      continue;
+    }
+
+    if ( state == State::Charset )
+    {
+      state = State::Ground;  // Character set designations are ignored
+      continue;
+    }
+
+    if ( state == State::Csi )
+    {
+      if ( ch >= 0x40 && ch <= 0x7e )
+      {
+        state = State::Ground;
+        csi(char(ch));
+      }
+      else
+        params.push_back(char(ch));
+
+      continue;
+    }
+
+    if ( state == State::Osc )
+    {
+      if ( ch == 0x07 || ch == 0x1b )
+        state = ( ch == 0x1b ) ? State::Charset : State::Ground;
+
+      continue;
+    }
+
+    if ( utf8_bytes > 0 && (ch & 0xc0) == 0x80 )
+    {
+      utf8_char = (utf8_char << 6) | wchar_t(ch & 0x3f);
+
+      if ( --utf8_bytes == 0 )
+        printChar(utf8_char);
+
+      continue;
+    }
+
+    if ( ch >= 0xf0 )
+    {
+      utf8_char = wchar_t(ch & 0x07);
+      utf8_bytes = 3;
+    }
+    else if ( ch >= 0xe0 )
+    {
+      utf8_char = wchar_t(ch & 0x0f);
+      utf8_bytes = 2;
+    }
+    else if ( ch >= 0xc0 )
+    {
+      utf8_char = wchar_t(ch & 0x1f);
+      utf8_bytes = 1;
+    }
+    else if ( ch == 0x1b )
+      state = State::Escape;
+    else if ( ch == '\r' )
+      moveCursor (0, cursor_y);
+    else if ( ch == '\n' )
+      lineFeed();
+    else if ( ch == '\b' )
+      moveCursor (cursor_x - 1, cursor_y);
+    else if ( ch == '\t' )
+      moveCursor ((cursor_x / 8 + 1) * 8, cursor_y);
+    else if ( ch >= 0x20 && ch < 0x7f )
+      printChar(wchar_t(ch));
+  }
+}
+
+//----------------------------------------------------------------------
+void TerminalModel::printChar (wchar_t ch)
+{
+  if ( wrap_pending )
+  {
+    moveCursor (0, cursor_y);
+    lineFeed();
+  }
+
+  if ( insert_mode )
+  {
+    auto line = cells.begin() + cursor_y * width;
+    std::copy_backward ( line + cursor_x, line + width - 1, line + width);
+  }
+
+  auto& c = cell(cursor_x, cursor_y);
+  c = attribute;
+  c.ch = ch;
+  last_char = ch;
+
+  if ( cursor_x < width - 1 )
+    cursor_x++;
+  else if ( autowrap )
+    wrap_pending = true;
+}
+
+//----------------------------------------------------------------------
+void TerminalModel::escape (char ch)
+{
+  state = State::Ground;
+
+  if ( ch == '[' )
+  {
+    params.clear();
+    state = State::Csi;
+  }
+  else if ( ch == ']' )
+    state = State::Osc;
+  else if ( ch == '(' || ch == ')' || ch == '*' || ch == '+' )
+    state = State::Charset;
+  else if ( ch == 'D' )
+    lineFeed();
+  else if ( ch == 'E' )
+  {
+    moveCursor (0, cursor_y);
+    lineFeed();
+  }
+  else if ( ch == 'M' )
+    reverseIndex();
+}
+
+//----------------------------------------------------------------------
+void TerminalModel::csi (char final_byte)
+{
+  if ( ! params.empty() && params[0] == '?' )  // DEC private modes
+  {
+    params.erase(0, 1);
+
+    if ( getParam(0, 0) == 7 && (final_byte == 'h' || final_byte == 'l') )
+    {
+      autowrap = ( final_byte == 'h' );
+      wrap_pending = false;
+    }
+
+    return;
+  }
+
+  if ( ! params.empty() && (params[0] < '0' || params[0] > ';') )
+    return;  // Other private sequences
+
+  const int n = std::max(1, getParam(0, 1));
+
+  switch ( final_byte )
+  {
+    case 'H':
+    case 'f':
+      moveCursor (getParam(1, 1) - 1, getParam(0, 1) - 1);
+      break;
+
+    case 'A':
+      moveCursor (cursor_x, cursor_y - n);
+      break;
+
+    case 'B':
+      moveCursor (cursor_x, cursor_y + n);
+      break;
+
+    case 'C':
+      moveCursor (cursor_x + n, cursor_y);
+      break;
+
+    case 'D':
+      moveCursor (cursor_x - n, cursor_y);
+      break;
+
+    case 'G':
+    case '`':
+      moveCursor (n - 1, cursor_y);
+      break;
+
+    case 'd':
+      moveCursor (cursor_x, n - 1);
+      break;
+
+    case 'J':
+      if ( getParam(0, 0) == 0 )
+      {
+        eraseCells (cursor_x, width - 1, cursor_y);
+
+        for (int y{cursor_y + 1}; y < height; y++)
+          eraseCells (0, width - 1, y);
+      }
+      else if ( getParam(0, 0) == 2 )
+      {
+        for (int y{0}; y < height; y++)
+          eraseCells (0, width - 1, y);
+      }
+      break;
+
+    case 'K':
+      if ( getParam(0, 0) == 0 )
+        eraseCells (cursor_x, width - 1, cursor_y);
+      else if ( getParam(0, 0) == 1 )
+        eraseCells (0, cursor_x, cursor_y);
+      else
+        eraseCells (0, width - 1, cursor_y);
+      break;
+
+    case 'X':
+      eraseCells (cursor_x, std::min(cursor_x + n, width) - 1, cursor_y);
+      break;
+
+    case 'b':  // Repeat the preceding character
+      for (int i{0}; i < n; i++)
+        printChar(last_char);
+      break;
+
+    case '@':
+    {
+      auto line = cells.begin() + cursor_y * width;
+      const auto count = std::min(n, width - cursor_x);
+      std::copy_backward (line + cursor_x, line + width - count, line + width);
+      eraseCells (cursor_x, cursor_x + count - 1, cursor_y);
+      break;
+    }
+
+    case 'P':
+    {
+      auto line = cells.begin() + cursor_y * width;
+      const auto count = std::min(n, width - cursor_x);
+      std::copy (line + cursor_x + count, line + width, line + cursor_x);
+      eraseCells (width - count, width - 1, cursor_y);
+      break;
+    }
+
+    case 'L':
+      if ( cursor_y >= top_margin && cursor_y <= bottom_margin )
+        scrollDown (cursor_y, bottom_margin, n);
+
+      moveCursor (0, cursor_y);
+      break;
+
+    case 'M':
+      if ( cursor_y >= top_margin && cursor_y <= bottom_margin )
+        scrollUp (cursor_y, bottom_margin, n);
+
+      moveCursor (0, cursor_y);
+      break;
+
+    case 'S':
+      scrollUp (top_margin, bottom_margin, n);
+      break;
+
+    case 'T':
+      scrollDown (top_margin, bottom_margin, n);
+      break;
+
+    case 'r':
+      top_margin = getParam(0, 1) - 1;
+      bottom_margin = getParam(1, height) - 1;
+      moveCursor (0, 0);
+      break;
+
+    case 'm':
+      sgr();
+      break;
+
+    case 'h':
+    case 'l':
+      if ( getParam(0, 0) == 4 )
+        insert_mode = ( final_byte == 'h' );
+      break;
+
+    default:
+      break;
+  }
+}
+
+//----------------------------------------------------------------------
+void TerminalModel::sgr()
+{
+  std::size_t index{0};
+
+  do
+  {
+    const auto value = getParam(index, 0);
+
+    if ( value == 0 )
+      attribute = Cell{};
+    else if ( value == 1 )
+      attribute.bold = true;
+    else if ( value == 4 )
+      attribute.underline = true;
+    else if ( value == 7 )
+      attribute.reverse = true;
+    else if ( value == 22 )
+      attribute.bold = false;
+    else if ( value == 24 )
+      attribute.underline = false;
+    else if ( value == 27 )
+      attribute.reverse = false;
+    else if ( value == 38 || value == 48 )
+      index += 2;  // Skip the 256 color parameters
+
+    index++;
+  }
+  while ( index < std::size_t(std::count(params.begin(), params.end(), ';') + 1) );
+}
+
+//----------------------------------------------------------------------
+void TerminalModel::lineFeed()
+{
+  wrap_pending = false;
+
+  if ( cursor_y == bottom_margin )
+    scrollUp (top_margin, bottom_margin, 1);
+  else if ( cursor_y < height - 1 )
+    cursor_y++;
+}
+
+//----------------------------------------------------------------------
+void TerminalModel::reverseIndex()
+{
+  wrap_pending = false;
+
+  if ( cursor_y == top_margin )
+    scrollDown (top_margin, bottom_margin, 1);
+  else if ( cursor_y > 0 )
+    cursor_y--;
+}
+
+//----------------------------------------------------------------------
+void TerminalModel::scrollUp (int top, int bottom, int n)
+{
+  const auto count = std::min(n, bottom - top + 1);
+  auto first = cells.begin() + top * width;
+  auto last = cells.begin() + (bottom + 1) * width;
+  std::copy (first + count * width, last, first);
+
+  for (int y{bottom - count + 1}; y <= bottom; y++)
+    eraseCells (0, width - 1, y);
+}
+
+//----------------------------------------------------------------------
+void TerminalModel::scrollDown (int top, int bottom, int n)
+{
+  const auto count = std::min(n, bottom - top + 1);
+  auto first = cells.begin() + top * width;
+  auto last = cells.begin() + (bottom + 1) * width;
+  std::copy_backward (first, last - count * width, last);
+
+  for (int y{top}; y < top + count; y++)
+    eraseCells (0, width - 1, y);
+}
+
+//----------------------------------------------------------------------
+void TerminalModel::eraseCells (int from, int to, int y)
+{
+  for (int x{from}; x <= to; x++)
+    cell(x, y) = Cell{};
+}
+
+//----------------------------------------------------------------------
+auto TerminalModel::getParam (std::size_t index, int default_value) const -> int
+{
+  std::size_t pos{0};
+
+  for (std::size_t i{0}; i < index; i++)
+  {
+    pos = params.find(';', pos);
+
+    if ( pos == std::string::npos )
+      return default_value;
+
+    pos++;
+  }
+
+  if ( pos >= params.size() || params[pos] == ';' )
+    return default_value;
+
+  return std::atoi(params.c_str() + pos);
+}
+
+
+//----------------------------------------------------------------------
+// class FVTerm_protected
+//----------------------------------------------------------------------
+
+class FVTerm_protected : public finalcut::FVTerm
+{
+  public:
+    // Using-declarations
+    using finalcut::FVTerm::getVirtualTerminal;
+    using finalcut::FVTerm::finishDrawing;
+    using finalcut::FVTerm::initTerminal;
+};
+
+
+//----------------------------------------------------------------------
+// class FTermOutputTest
+//----------------------------------------------------------------------
+
+class FTermOutputTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FTermOutputTest() = default;
+    void setUp() override;
+    void tearDown() override;
+
+  protected:
+    void classNameTest();
+    void lineRunsTest();
+    void lineRewriteTest();
+    void lineEraseTest();
+    void writeErrorTest();
+    void directOutputOrderTest();
+    void presentationPolicyTest();
+    void synchronizedOutputTest();
+    void lineShiftTest();
+    void textRunTest();
+
+  private:
+    // Using-declaration
+    using FTermRegion = finalcut::FVTerm::FTermRegion;
+
+    // Methods
+    void setText (int, int, const std::wstring&, const std::string& = "");
+    auto update() -> std::string;
+    auto isScreenEqual() const -> bool;
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FTermOutputTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (lineRunsTest);
+    CPPUNIT_TEST (lineRewriteTest);
+    CPPUNIT_TEST (lineEraseTest);
+    CPPUNIT_TEST (writeErrorTest);
+    CPPUNIT_TEST (directOutputOrderTest);
+    CPPUNIT_TEST (presentationPolicyTest);
+    CPPUNIT_TEST (synchronizedOutputTest);
+    CPPUNIT_TEST (lineShiftTest);
+    CPPUNIT_TEST (textRunTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+
+    // Data members
+    std::unique_ptr<finalcut::FApplication>  app{};
+    std::unique_ptr<FVTerm_protected>        fvterm{};
+    std::unique_ptr<finalcut::FSystem>       fsystem{};
+    std::unique_ptr<TerminalModel>           screen{};
+    std::shared_ptr<finalcut::FTermOutput>   output{};
+    FSystemCapture*                          capture{nullptr};
+    FTermRegion*                             vterm{nullptr};
+};
+
+//----------------------------------------------------------------------
+void FTermOutputTest::setUp()
+{
+  // Initializes the terminal output of an xterm and redirects
+  // the written bytes into the terminal model
+
+  static char arg0[] = "./a.out";
+  static char arg1[] = "--no-terminal-detection";
+  static char arg2[] = "--no-mouse";
+  static char arg3[] = "--no-color-change";
+  static char arg4[] = "--encoding=utf8";
+  static char* argv[] = { arg0, arg1, arg2, arg3, arg4, nullptr };
+  setenv ("TERM", "xterm-256color", 1);
+  app = std::make_unique<finalcut::FApplication>(5, argv);
+  fvterm = std::make_unique<FVTerm_protected>();
+  fvterm->initTerminal();
+  vterm = fvterm->getVirtualTerminal();
+  output = std::static_pointer_cast<finalcut::FTermOutput>(finalcut::FVTerm::getFOutput());
+  output->setPresentationPolicy (finalcut::FTermOutput::PresentationPolicy::LatencyFirst);
+  capture = new FSystemCapture();
+  fsystem.reset(capture);
+  finalcut::FTerm::setFSystem(fsystem);
+  screen = std::make_unique<TerminalModel>(vterm->size.width, vterm->size.height);
+
+  // Start with an empty screen
+  output->clearTerminal();
+  FVTerm_protected::finishDrawing();
+
+  for (int y{0}; y < vterm->size.height; y++)
+    setText (0, y, std::wstring(std::size_t(vterm->size.width), L' '));
+
+  update();
+}
+
+//----------------------------------------------------------------------
+void FTermOutputTest::tearDown()
+{
+  finalcut::FTerm::setFSystem(fsystem);  // Restore the system calls
+  fsystem.reset();
+  output.reset();
+  fvterm.reset();
+  app.reset();
+}
+
+//----------------------------------------------------------------------
+void FTermOutputTest::setText ( int x, int y, const std::wstring& text
+                              , const std::string& bold )
+{
+  // Writes text into the virtual terminal. A '1' in bold
+  // marks the corresponding character as bold.
+
+  for (std::size_t n{0}; n < text.length(); n++)
+  {
+    auto& fchar = vterm->getFChar(x + int(n), y);
+    fchar.ch = { text[n] };
+    fchar.color = finalcut::FCellColor{ finalcut::FColor::Default
+                                      , finalcut::FColor::Default };
+    fchar.attr.data = 0;
+    fchar.attr.bit()->bold = n < bold.length() && bold[n] == '1';
+    fchar.setCharWidth(1);
+  }
+
+  vterm->addLineChanges (uInt(y), uInt(x), uInt(x) + uInt(text.length()) - 1);
+  vterm->changes_in_row.ymin = std::min(vterm->changes_in_row.ymin, uInt(y));
+  vterm->changes_in_row.ymax = std::max(vterm->changes_in_row.ymax, uInt(y));
+  vterm->has_changes = true;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutputTest::update() -> std::string
+{
+  // Writes the changes to the terminal and returns the written bytes
+
+  fvterm->updateTerminal();
+  fvterm->flush();
+  auto bytes = capture->getOutput();
+  capture->clear();
+  screen->write(bytes);
+  return bytes;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutputTest::isScreenEqual() const -> bool
+{
+  // Compares the emulated terminal screen with the virtual terminal.
+  // Spaces are compared without the bold attribute.
+
+  for (int y{0}; y < vterm->size.height; y++)
+  {
+    for (int x{0}; x < vterm->size.width; x++)
+    {
+      const auto& fchar = vterm->getFChar(x, y);
+      const auto& cell = screen->getCell(x, y);
+      const auto ch = wchar_t(fchar.ch[0]);
+      const bool bold = fchar.attr.bit()->bold && ch != L' ';
+
+      if ( cell.ch != ch || (cell.bold && cell.ch != L' ') != bold )
+        return false;
+    }
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FTermOutputTest::classNameTest()
+{
+  const finalcut::FString& classname = output->getClassName();
+  CPPUNIT_ASSERT ( classname == "FTermOutput" );
+}
+
+//----------------------------------------------------------------------
+void FTermOutputTest::lineRunsTest()
+{
+  setText (2, 3, L"abcdefghij", "0000011111");
+  update();
+  CPPUNIT_ASSERT ( isScreenEqual() );
+
+  // A single changed character is printed as a run
+  setText (7, 3, L"X", "1");
+  const auto bytes = update();
+  const auto& stat = output->getStatistics();
+  CPPUNIT_ASSERT ( stat.run_line_bytes > 0 );
+  CPPUNIT_ASSERT ( stat.rewrite_line_bytes == 0 );
+  CPPUNIT_ASSERT ( stat.erase_line_bytes == 0 );
+  CPPUNIT_ASSERT ( bytes.find('X') != std::string::npos );
+  CPPUNIT_ASSERT ( bytes.find('f') == std::string::npos );
+  CPPUNIT_ASSERT ( isScreenEqual() );
+
+  const auto& fchar = vterm->getFChar(7, 3);
+  CPPUNIT_ASSERT ( fchar.attr.bit()->bold );
+  CPPUNIT_ASSERT ( fchar.getCharWidth() == 1 );
+  CPPUNIT_ASSERT ( fchar.isBitSet(finalcut::FAttribute::set::printed) );
+}
+
+//----------------------------------------------------------------------
+void FTermOutputTest::lineRewriteTest()
+{
+  setText (2, 3, L"abc", "011");
+  update();
+  CPPUNIT_ASSERT ( isScreenEqual() );
+
+  // Without the frame planner, only the changed runs are printed
+  CPPUNIT_ASSERT ( ! output->hasFramePlanner() );
+  setText (2, 3, L"xby", "011");
+  update();
+  CPPUNIT_ASSERT ( output->getStatistics().rewrite_line_bytes == 0 );
+  CPPUNIT_ASSERT ( isScreenEqual() );
+  setText (2, 3, L"abc", "011");
+  update();
+  output->setFramePlanner();
+  CPPUNIT_ASSERT ( output->hasFramePlanner() );
+
+  // Reprinting the unchanged bold 'b' is cheaper than moving
+  // the cursor over it
+  setText (2, 3, L"xby", "011");
+  const auto bytes = update();
+  const auto& stat = output->getStatistics();
+  CPPUNIT_ASSERT ( stat.rewrite_line_bytes > 0 );
+  CPPUNIT_ASSERT ( stat.run_line_bytes == 0 );
+  CPPUNIT_ASSERT ( stat.erase_line_bytes == 0 );
+  CPPUNIT_ASSERT ( bytes.find("by") != std::string::npos );
+  CPPUNIT_ASSERT ( isScreenEqual() );
+
+  // The unchanged character keeps its attributes and width
+  for (int x{3}; x <= 4; x++)
+  {
+    const auto& fchar = vterm->getFChar(x, 3);
+    CPPUNIT_ASSERT ( fchar.attr.bit()->bold );
+    CPPUNIT_ASSERT ( fchar.getCharWidth() == 1 );
+    CPPUNIT_ASSERT ( ! fchar.isBitSet(finalcut::FAttribute::set::no_changes) );
+    CPPUNIT_ASSERT ( fchar.isBitSet(finalcut::FAttribute::set::printed) );
+  }
+}
+
+//----------------------------------------------------------------------
+void FTermOutputTest::lineEraseTest()
+{
+  output->setFramePlanner();
+  setText (2, 3, L"abcdefghijklmnopqrstuvwxyz", "11111111111111111111111111");
+  update();
+  CPPUNIT_ASSERT ( isScreenEqual() );
+
+  // Clearing the line end and printing the remaining
+  // characters is the shortest output
+  setText (2, 3, L"a  d      j       r       ", "10010000001000000010000000");
+  const auto bytes = update();
+  const auto& stat = output->getStatistics();
+  CPPUNIT_ASSERT ( stat.erase_line_bytes > 0 );
+  CPPUNIT_ASSERT ( stat.run_line_bytes == 0 );
+  CPPUNIT_ASSERT ( stat.rewrite_line_bytes == 0 );
+  CPPUNIT_ASSERT ( bytes.find(CSI "K") != std::string::npos );
+  CPPUNIT_ASSERT ( isScreenEqual() );
+
+  // The printed characters keep their attributes and width
+  for (const auto x : {5, 12, 20})
+  {
+    const auto& fchar = vterm->getFChar(x, 3);
+    CPPUNIT_ASSERT ( fchar.attr.bit()->bold );
+    CPPUNIT_ASSERT ( fchar.getCharWidth() == 1 );
+    CPPUNIT_ASSERT ( ! fchar.isBitSet(finalcut::FAttribute::set::no_changes) );
+  }
+
+  // Erased characters are marked as unchanged
+  const auto& erased = vterm->getFChar(3, 3);
+  CPPUNIT_ASSERT ( erased.getCharWidth() == 1 );
+  CPPUNIT_ASSERT ( erased.isBitSet(finalcut::FAttribute::set::no_changes) );
+}
+
+//----------------------------------------------------------------------
+void FTermOutputTest::writeErrorTest()
+{
+  setText (2, 3, L"abc");
+  update();
+  CPPUNIT_ASSERT ( output->getStatistics().write_errors == 0 );
+
+  // A failed write is counted and the lost text is not on the screen
+  capture->setWriteError (true);
+  setText (2, 5, L"lost text", "000011111");
+  CPPUNIT_ASSERT ( update().empty() );
+  CPPUNIT_ASSERT ( output->getStatistics().write_errors == 1 );
+  CPPUNIT_ASSERT ( ! isScreenEqual() );
+
+  // The next update repaints the whole screen
+  capture->setWriteError (false);
+  update();
+  CPPUNIT_ASSERT ( output->getStatistics().write_errors == 1 );
+  CPPUNIT_ASSERT ( isScreenEqual() );
+}
+
+//----------------------------------------------------------------------
+void FTermOutputTest::directOutputOrderTest()
+{
+  // Direct terminal output is written after the buffered frame
+  setText (2, 3, L"abc");
+  fvterm->updateTerminal();  // Without flush
+  CPPUNIT_ASSERT ( capture->getOutput().empty() );
+  output->beep();
+  const auto bytes = capture->getOutput();
+  const auto text_pos = bytes.find("abc");
+  const auto bell_pos = bytes.rfind('\a');
+  CPPUNIT_ASSERT ( text_pos != std::string::npos );
+  CPPUNIT_ASSERT ( bell_pos != std::string::npos );
+  CPPUNIT_ASSERT ( text_pos < bell_pos );
+
+  // The same applies to the output thread
+  capture->clear();
+  output->setOutputThread();
+  setText (2, 4, L"def");
+  fvterm->updateTerminal();
+  output->beep();
+  output->unsetOutputThread();
+  const auto thread_bytes = capture->getOutput();
+  const auto thread_text_pos = thread_bytes.find("def");
+  const auto thread_bell_pos = thread_bytes.rfind('\a');
+  CPPUNIT_ASSERT ( thread_text_pos != std::string::npos );
+  CPPUNIT_ASSERT ( thread_bell_pos != std::string::npos );
+  CPPUNIT_ASSERT ( thread_text_pos < thread_bell_pos );
+}
+
+//----------------------------------------------------------------------
+void FTermOutputTest::presentationPolicyTest()
+{
+  using PresentationPolicy = finalcut::FTermOutput::PresentationPolicy;
+
+  // LatencyFirst presents every update immediately
+  setText (2, 3, L"abc");
+  update();
+  CPPUNIT_ASSERT ( output->getPresentationPolicy() == PresentationPolicy::LatencyFirst );
+  CPPUNIT_ASSERT ( output->isFlushTimeout() );
+
+  // FixedRate waits for the frame interval
+  output->setPresentationPolicy (PresentationPolicy::FixedRate);
+  output->setFrameRate (10);  // 100 ms
+  CPPUNIT_ASSERT ( output->getFrameRate() == 10 );
+  CPPUNIT_ASSERT ( ! output->isFlushTimeout() );
+  std::this_thread::sleep_for(std::chrono::milliseconds(110));
+  CPPUNIT_ASSERT ( output->isFlushTimeout() );
+
+  // Adaptive waits for the adjusted flush interval
+  // of at most 200 ms
+  output->setPresentationPolicy (PresentationPolicy::LatencyFirst);
+  setText (2, 3, L"def");
+  update();
+  output->setPresentationPolicy (PresentationPolicy::Adaptive);
+  CPPUNIT_ASSERT ( ! output->isFlushTimeout() );
+  std::this_thread::sleep_for(std::chrono::milliseconds(210));
+  CPPUNIT_ASSERT ( output->isFlushTimeout() );
+}
+
+//----------------------------------------------------------------------
+void FTermOutputTest::synchronizedOutputTest()
+{
+  // Without synchronized output, no mode 2026 sequences are written
+  output->unsetSynchronizedOutput();
+  CPPUNIT_ASSERT ( ! output->hasSynchronizedOutput() );
+  setText (2, 3, L"abc");
+  auto bytes = update();
+  CPPUNIT_ASSERT ( bytes.find(CSI "?2026") == std::string::npos );
+
+  // The frame is enclosed in the begin and end sequence
+  output->setSynchronizedOutput();
+  CPPUNIT_ASSERT ( output->hasSynchronizedOutput() );
+  setText (2, 3, L"xyz");
+  bytes = update();
+  const std::string begin{CSI "?2026h"};
+  const std::string end{CSI "?2026l"};
+  CPPUNIT_ASSERT ( bytes.size() > begin.size() + end.size() );
+  CPPUNIT_ASSERT ( bytes.compare(0, begin.size(), begin) == 0 );
+  CPPUNIT_ASSERT ( bytes.compare(bytes.size() - end.size(), end.size(), end) == 0 );
+  CPPUNIT_ASSERT ( bytes.find("xyz") != std::string::npos );
+  CPPUNIT_ASSERT ( isScreenEqual() );
+
+  // An update without changes writes no empty frame
+  bytes = update();
+  CPPUNIT_ASSERT ( bytes.find(CSI "?2026") == std::string::npos );
+}
+
+//----------------------------------------------------------------------
+void FTermOutputTest::lineShiftTest()
+{
+  output->setFramePlanner();
+
+  // Every line shows the text of a line number. Numbers from 100
+  // are new lines with lower case letters.
+  const auto width = std::size_t(vterm->size.width);
+  std::vector<int> lines(std::size_t(vterm->size.height));
+  std::iota (lines.begin(), lines.end(), 0);
+  int next_line{100};
+
+  auto show = [this, width, &lines] ()
+  {
+    for (std::size_t y{0}; y < lines.size(); y++)
+    {
+      const auto first = ( lines[y] < 100 ) ? L'A' : L'a';
+      std::wstring text(width, L' ');
+
+      for (std::size_t x{0}; x < width; x++)
+        text[x] = wchar_t(first + (std::size_t(lines[y]) * 7 + x) % 26);
+
+      setText (0, int(y), text);
+    }
+
+    return update();
+  };
+
+  auto shift = [&lines, &next_line] (int top, int bottom, int distance)
+  {
+    // Moves the lines of the block by distance (> 0 = up, < 0 = down)
+    auto begin = lines.begin() + top;
+    auto end = lines.begin() + bottom + 1;
+
+    if ( distance > 0 )
+    {
+      std::rotate (begin, begin + distance, end);
+      std::generate (end - distance, end, [&next_line] () { return next_line++; });
+    }
+    else
+    {
+      std::rotate (begin, end + distance, end);
+      std::generate (begin, begin - distance, [&next_line] () { return next_line++; });
+    }
+  };
+
+  show();
+  CPPUNIT_ASSERT ( isScreenEqual() );
+  const auto& stat = output->getStatistics();
+
+  // One block up
+  shift (5, 14, 2);
+  show();
+  CPPUNIT_ASSERT ( stat.shifted_blocks == 1 );
+  CPPUNIT_ASSERT ( stat.shifted_lines == 8 );
+  CPPUNIT_ASSERT ( stat.shift_bytes > 0 );
+  CPPUNIT_ASSERT ( isScreenEqual() );
+
+  // One block down
+  shift (5, 14, -3);
+  show();
+  CPPUNIT_ASSERT ( stat.shifted_blocks == 1 );
+  CPPUNIT_ASSERT ( stat.shifted_lines == 7 );
+  CPPUNIT_ASSERT ( isScreenEqual() );
+
+  // Two blocks in opposite directions
+  shift (1, 8, 1);
+  shift (12, 21, -2);
+  show();
+  CPPUNIT_ASSERT ( stat.shifted_blocks == 2 );
+  CPPUNIT_ASSERT ( stat.shifted_lines == 7 + 8 );
+  CPPUNIT_ASSERT ( isScreenEqual() );
+
+  // Two blocks in the same direction
+  shift (0, 6, -1);
+  shift (10, 20, -2);
+  show();
+  CPPUNIT_ASSERT ( stat.shifted_blocks == 2 );
+  CPPUNIT_ASSERT ( stat.shifted_lines == 6 + 9 );
+  CPPUNIT_ASSERT ( isScreenEqual() );
+
+  shift (2, 9, 3);
+  shift (13, 22, 1);
+  show();
+  CPPUNIT_ASSERT ( stat.shifted_blocks == 2 );
+  CPPUNIT_ASSERT ( isScreenEqual() );
+
+  // The scrolling margins are reset to the full screen
+  CPPUNIT_ASSERT ( output->scrollTerminalLines(3, 7, 1) );
+  const auto bytes = update();
+  const auto margin_pos = bytes.find(CSI "4;8r");
+  const auto reset_pos = bytes.rfind(CSI "1;" + std::to_string(vterm->size.height) + "r");
+  CPPUNIT_ASSERT ( margin_pos != std::string::npos );
+  CPPUNIT_ASSERT ( reset_pos != std::string::npos );
+  CPPUNIT_ASSERT ( margin_pos < reset_pos );
+  CPPUNIT_ASSERT ( ! output->scrollTerminalLines(3, 7, 5) );  // Too many lines
+  CPPUNIT_ASSERT ( ! output->scrollTerminalLines(3, vterm->size.height, 1) );
+}
+
+//----------------------------------------------------------------------
+void FTermOutputTest::textRunTest()
+{
+  // Text runs must give the same screen as the per-character output
+
+  struct TextLine
+  {
+    int          x;
+    int          y;
+    std::wstring text;
+    std::string  bold;
+  };
+
+  const int width = vterm->size.width;
+  const int height = vterm->size.height;
+  const std::vector<TextLine> lines
+  {
+    { 2, 3, L"Hello, world!", "0000000111110" },  // ASCII
+    { 2, 4, L"\u00e4\u00f6\u00fc \u20ac \u2500\u2502 \U0001d400x", "00100001100" },  // UTF-8
+    { 2, 5, L"abc" + std::wstring(30, L' ') + L"d", "" },  // Erase after the run
+    { 2, 6, L"abc" + std::wstring(30, L'z') + L"d", "" },  // Repeat after the run
+    { width - 6, height - 1, L"uvwxyz", "110011" }  // Lower-right cell
+  };
+
+  auto print = [this, width] (const TextLine& line)
+  {
+    // Replaces a filled line with the text
+    setText (0, line.y, std::wstring(std::size_t(width), L'#'));
+    update();
+    setText (line.x, line.y, line.text, line.bold);
+    return update();
+  };
+
+  auto getLine = [this, width] (int y)
+  {
+    std::wstring text{};
+
+    for (int x{0}; x < width; x++)
+    {
+      const auto& cell = screen->getCell(x, y);
+      text += ( cell.bold && cell.ch != L' ' ) ? wchar_t(L'\x100000' + cell.ch)
+                                               : cell.ch;
+    }
+
+    return text;
+  };
+
+  auto skipCursorMove = [] (const std::string& bytes)
+  {
+    // The first cursor movement depends on the previous cursor position
+    if ( bytes.compare(0, 2, CSI) != 0 )
+      return bytes;
+
+    const auto end = bytes.find_first_of("HGCD");
+    return ( end == std::string::npos ) ? bytes : bytes.substr(end + 1);
+  };
+
+  CPPUNIT_ASSERT ( output->hasTextRuns() );
+
+  for (const auto& line : lines)
+  {
+    output->setTextRuns();
+    const auto run_bytes = print(line);
+    CPPUNIT_ASSERT ( isScreenEqual() );
+    const auto run_line = getLine(line.y);
+    const auto run_cursor = screen->getCursor();
+
+    output->unsetTextRuns();
+    const auto char_bytes = print(line);
+    CPPUNIT_ASSERT ( isScreenEqual() );
+    CPPUNIT_ASSERT ( getLine(line.y) == run_line );
+    CPPUNIT_ASSERT ( screen->getCursor() == run_cursor );
+    CPPUNIT_ASSERT ( skipCursorMove(run_bytes) == skipCursorMove(char_bytes) );
+  }
+
+  output->setTextRuns();
+  CPPUNIT_ASSERT ( output->hasTextRuns() );
+}
+
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FTermOutputTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,493 @@
+/***********************************************************************
+* ftermprobe-test.cpp - FTermProbe unit tests                          *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <sys/wait.h>
+#include <sys/mman.h>
+
+#include <conemu.h>
+#include <final/final.h>
+
+namespace
+{
+
+//----------------------------------------------------------------------
+auto parseString (finalcut::FTermProbe& probe, const char* str) -> bool
+{
+  return probe.parse (str, std::strlen(str));
+}
+
+//----------------------------------------------------------------------
+void addAllQueries (finalcut::FTermProbe& probe)
+{
+  using Query = finalcut::FTermProbe::Query;
+  probe.addQuery (Query::Answerback);
+  probe.addQuery (Query::SecondaryDA);
+  probe.addQuery (Query::XTVersion);
+  probe.addQuery (Query::SyncOutput);
+  probe.addQuery (Query::XTermFont);
+  probe.addQuery (Query::XTermTitle);
+}
+
+}  // anonymous namespace
+
+//----------------------------------------------------------------------
+// class FTermProbeTest
+//----------------------------------------------------------------------
+
+class FTermProbeTest : public CPPUNIT_NS::TestFixture
+                     , test::ConEmu
+{
+  public:
+    FTermProbeTest() = default;
+
+  protected:
+    void classNameTest();
+    void requestTest();
+    void multiplexerTest();
+    void responseTest();
+    void fragmentTest();
+    void missingResponseTest();
+    void answerbackTest();
+    void stringTerminatorTest();
+    void startupLatencyTest();
+    void syncOutputTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FTermProbeTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (requestTest);
+    CPPUNIT_TEST (multiplexerTest);
+    CPPUNIT_TEST (responseTest);
+    CPPUNIT_TEST (fragmentTest);
+    CPPUNIT_TEST (missingResponseTest);
+    CPPUNIT_TEST (answerbackTest);
+    CPPUNIT_TEST (stringTerminatorTest);
+    CPPUNIT_TEST (startupLatencyTest);
+    CPPUNIT_TEST (syncOutputTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FTermProbeTest::classNameTest()
+{
+  const finalcut::FTermProbe probe{};
+  const finalcut::FString& classname = probe.getClassName();
+  CPPUNIT_ASSERT ( classname == "FTermProbe" );
+}
+
+//----------------------------------------------------------------------
+void FTermProbeTest::requestTest()
+{
+  using Query = finalcut::FTermProbe::Query;
+  finalcut::FTermProbe probe{};
+  CPPUNIT_ASSERT ( probe.getTimeout() == finalcut::FTermProbe::DEFAULT_TIMEOUT );
+  CPPUNIT_ASSERT ( ! probe.hasQuery(Query::Answerback) );
+  CPPUNIT_ASSERT ( ! probe.isComplete() );
+
+  // Only the DA1 sentinel
+  CPPUNIT_ASSERT ( probe.getRequest() == "\033[c" );
+
+  // All queries in one request, the sentinel comes last
+  addAllQueries (probe);
+  CPPUNIT_ASSERT ( probe.hasQuery(Query::Answerback) );
+  CPPUNIT_ASSERT ( probe.hasQuery(Query::SecondaryDA) );
+  CPPUNIT_ASSERT ( probe.hasQuery(Query::XTVersion) );
+  CPPUNIT_ASSERT ( probe.hasQuery(Query::SyncOutput) );
+  CPPUNIT_ASSERT ( probe.hasQuery(Query::XTermFont) );
+  CPPUNIT_ASSERT ( probe.hasQuery(Query::XTermTitle) );
+  CPPUNIT_ASSERT ( probe.getRequest() == "\005"
+                                         "\033[>c"
+                                         "\033[>0q"
+                                         "\033[?2026$p"
+                                         "\033[21t"
+                                         "\033]50;?\a"
+                                         "\033[c" );
+
+  probe.setTimeout (150'000);
+  CPPUNIT_ASSERT ( probe.getTimeout() == 150'000 );
+
+  // clear() keeps the queries and the timeout
+  probe.clear();
+  CPPUNIT_ASSERT ( probe.hasQuery(Query::XTermFont) );
+  CPPUNIT_ASSERT ( probe.getTimeout() == 150'000 );
+}
+
+//----------------------------------------------------------------------
+void FTermProbeTest::multiplexerTest()
+{
+  // The font query and the sentinel pass through the multiplexer
+  using Query = finalcut::FTermProbe::Query;
+  auto& data = finalcut::FTermData::getInstance();
+  finalcut::FTermProbe probe{};
+  probe.addQuery (Query::XTermFont);
+  probe.addQuery (Query::XTermTitle);
+
+  data.setTermType (finalcut::FTermType::screen);
+  CPPUNIT_ASSERT ( probe.getRequest() == "\033[21t"
+                                         "\033P\033]50;?\a\033\\"
+                                         "\033P\033[c\033\\" );
+
+  data.unsetTermType (finalcut::FTermType::screen);
+  data.setTermType (finalcut::FTermType::tmux);
+  CPPUNIT_ASSERT ( probe.getRequest() == "\033[21t"
+                                         "\033Ptmux;\033\033]50;?\a\033\\"
+                                         "\033Ptmux;\033\033[c\033\\" );
+
+  data.unsetTermType (finalcut::FTermType::tmux);
+  CPPUNIT_ASSERT ( probe.getRequest() == "\033[21t\033]50;?\a\033[c" );
+
+  // Without the font query, the multiplexer answers the sentinel
+  finalcut::FTermProbe title_probe{};
+  title_probe.addQuery (Query::XTermTitle);
+  data.setTermType (finalcut::FTermType::tmux);
+  CPPUNIT_ASSERT ( title_probe.getRequest() == "\033[21t\033[c" );
+  data.unsetTermType (finalcut::FTermType::tmux);
+}
+
+//----------------------------------------------------------------------
+void FTermProbeTest::responseTest()
+{
+  using Query = finalcut::FTermProbe::Query;
+  finalcut::FTermProbe probe{};
+  addAllQueries (probe);
+
+  CPPUNIT_ASSERT ( ! parseString(probe, "\033[>19;312;0c"
+                                        "\033P>|XTerm(388)\033\\"
+                                        "\033[?2026;0$y"
+                                        "\033]lxterm\033\\"
+                                        "\033]50;fixed\a") );
+  CPPUNIT_ASSERT ( ! probe.isComplete() );
+  CPPUNIT_ASSERT ( parseString(probe, "\033[?64;1;2;6;9;15;18;21;22c") );
+  CPPUNIT_ASSERT ( probe.isComplete() );
+  CPPUNIT_ASSERT ( ! probe.hasReply(Query::Answerback) );
+  CPPUNIT_ASSERT ( probe.hasReply(Query::SecondaryDA) );
+  CPPUNIT_ASSERT ( probe.hasReply(Query::XTVersion) );
+  CPPUNIT_ASSERT ( probe.hasReply(Query::SyncOutput) );
+  CPPUNIT_ASSERT ( probe.hasReply(Query::XTermFont) );
+  CPPUNIT_ASSERT ( probe.hasReply(Query::XTermTitle) );
+  CPPUNIT_ASSERT ( probe.getAnswerback().isEmpty() );
+  CPPUNIT_ASSERT ( probe.getSecDA() == "\033[>19;312;0c" );
+  CPPUNIT_ASSERT ( probe.getXTVersion() == "XTerm(388)" );
+  CPPUNIT_ASSERT ( probe.getSyncOutputMode() == 0 );
+  CPPUNIT_ASSERT ( ! probe.hasSyncOutputSupport() );
+  CPPUNIT_ASSERT ( probe.getXTermTitle() == "xterm" );
+  CPPUNIT_ASSERT ( probe.getXTermFont() == "fixed" );
+
+  // Responses after the sentinel are ignored
+  CPPUNIT_ASSERT ( parseString(probe, "\033[>1;4000;13c") );
+  CPPUNIT_ASSERT ( probe.getSecDA() == "\033[>19;312;0c" );
+
+  // Synchronized output mode values
+  const std::array<std::pair<const char*, bool>, 5> mode_list
+  {{
+    { "\033[?2026;0$y\033[?62;c", false },  // Not recognized
+    { "\033[?2026;1$y\033[?62;c", true },   // Set
+    { "\033[?2026;2$y\033[?62;c", true },   // Reset
+    { "\033[?2026;3$y\033[?62;c", true },   // Permanently set
+    { "\033[?2026;4$y\033[?62;c", false }   // Permanently reset
+  }};
+
+  for (const auto& mode : mode_list)
+  {
+    probe.clear();
+    CPPUNIT_ASSERT ( ! probe.isComplete() );
+    CPPUNIT_ASSERT ( probe.getSyncOutputMode() == -1 );
+    CPPUNIT_ASSERT ( parseString(probe, mode.first) );
+    CPPUNIT_ASSERT ( probe.hasSyncOutputSupport() == mode.second );
+  }
+
+  // Mode reports of other modes
+  probe.clear();
+  CPPUNIT_ASSERT ( parseString(probe, "\033[?2004;2$y\033[?62;c") );
+  CPPUNIT_ASSERT ( ! probe.hasReply(Query::SyncOutput) );
+  CPPUNIT_ASSERT ( probe.getSyncOutputMode() == -1 );
+}
+
+//----------------------------------------------------------------------
+void FTermProbeTest::fragmentTest()
+{
+  // The responses arrive byte by byte
+  using Query = finalcut::FTermProbe::Query;
+  finalcut::FTermProbe probe{};
+  addAllQueries (probe);
+  const std::string response{ "PuTTY"
+                              "\033[>0;136;0c"
+                              "\033P>|kitty(0.26.5)\033\\"
+                              "\033[?2026;2$y"
+                              "\033]lTITLE\033\\"
+                              "\033]50;-misc-fixed-medium\a"
+                              "\033[?6c" };
+
+  for (std::size_t i{0}; i < response.length(); i++)
+  {
+    const bool last = ( i + 1 == response.length() );
+    CPPUNIT_ASSERT ( probe.parse(&response[i], 1) == last );
+  }
+
+  CPPUNIT_ASSERT ( probe.isComplete() );
+  CPPUNIT_ASSERT ( probe.hasReply(Query::Answerback) );
+  CPPUNIT_ASSERT ( probe.getAnswerback() == "PuTTY" );
+  CPPUNIT_ASSERT ( probe.getSecDA() == "\033[>0;136;0c" );
+  CPPUNIT_ASSERT ( probe.getXTVersion() == "kitty(0.26.5)" );
+  CPPUNIT_ASSERT ( probe.getSyncOutputMode() == 2 );
+  CPPUNIT_ASSERT ( probe.hasSyncOutputSupport() );
+  CPPUNIT_ASSERT ( probe.getXTermTitle() == "TITLE" );
+  CPPUNIT_ASSERT ( probe.getXTermFont() == "-misc-fixed-medium" );
+
+  // The same responses in two halves
+  probe.clear();
+  const auto half = response.length() / 2;
+  CPPUNIT_ASSERT ( ! probe.parse(response.data(), half) );
+  CPPUNIT_ASSERT ( probe.parse(&response[half], response.length() - half) );
+  CPPUNIT_ASSERT ( probe.getAnswerback() == "PuTTY" );
+  CPPUNIT_ASSERT ( probe.getXTVersion() == "kitty(0.26.5)" );
+  CPPUNIT_ASSERT ( probe.getXTermFont() == "-misc-fixed-medium" );
+}
+
+//----------------------------------------------------------------------
+void FTermProbeTest::missingResponseTest()
+{
+  // Unsupported queries remain unanswered,
+  // the sentinel completes the probe nevertheless
+  using Query = finalcut::FTermProbe::Query;
+  finalcut::FTermProbe probe{};
+  addAllQueries (probe);
+  CPPUNIT_ASSERT ( ! probe.parse(nullptr, 0) );
+  CPPUNIT_ASSERT ( parseString(probe, "\033[?1;2c") );
+  CPPUNIT_ASSERT ( probe.isComplete() );
+  CPPUNIT_ASSERT ( ! probe.hasReply(Query::Answerback) );
+  CPPUNIT_ASSERT ( ! probe.hasReply(Query::SecondaryDA) );
+  CPPUNIT_ASSERT ( ! probe.hasReply(Query::XTVersion) );
+  CPPUNIT_ASSERT ( ! probe.hasReply(Query::SyncOutput) );
+  CPPUNIT_ASSERT ( ! probe.hasReply(Query::XTermFont) );
+  CPPUNIT_ASSERT ( ! probe.hasReply(Query::XTermTitle) );
+  CPPUNIT_ASSERT ( probe.getSecDA().isEmpty() );
+  CPPUNIT_ASSERT ( probe.getXTVersion().isEmpty() );
+  CPPUNIT_ASSERT ( probe.getSyncOutputMode() == -1 );
+  CPPUNIT_ASSERT ( ! probe.hasSyncOutputSupport() );
+
+  // Unknown sequences are skipped
+  probe.clear();
+  CPPUNIT_ASSERT ( ! parseString(probe, "\033[25;80R\033[0n\033=\033]4;1;rgb:cdcd/0000/0000\a") );
+  CPPUNIT_ASSERT ( ! probe.hasReply(Query::XTermFont) );
+  CPPUNIT_ASSERT ( parseString(probe, "\033[?62;c") );
+}
+
+//----------------------------------------------------------------------
+void FTermProbeTest::answerbackTest()
+{
+  using Query = finalcut::FTermProbe::Query;
+  finalcut::FTermProbe probe{};
+
+  // Without the ENQ query, text is not an answerback message
+  probe.addQuery (Query::SecondaryDA);
+  CPPUNIT_ASSERT ( parseString(probe, "PuTTY\033[>0;136;0c\033[?6c") );
+  CPPUNIT_ASSERT ( ! probe.hasReply(Query::Answerback) );
+  CPPUNIT_ASSERT ( probe.getAnswerback().isEmpty() );
+
+  // The answerback message precedes all other responses
+  probe.addQuery (Query::Answerback);
+  probe.clear();
+  CPPUNIT_ASSERT ( ! parseString(probe, "Pu") );
+  CPPUNIT_ASSERT ( ! parseString(probe, "TTY\033[>0;136;0c") );
+  CPPUNIT_ASSERT ( ! parseString(probe, "abc") );
+  CPPUNIT_ASSERT ( parseString(probe, "\033[?6c") );
+  CPPUNIT_ASSERT ( probe.hasReply(Query::Answerback) );
+  CPPUNIT_ASSERT ( probe.getAnswerback() == "PuTTY" );
+  CPPUNIT_ASSERT ( probe.getSecDA() == "\033[>0;136;0c" );
+}
+
+//----------------------------------------------------------------------
+void FTermProbeTest::stringTerminatorTest()
+{
+  using Query = finalcut::FTermProbe::Query;
+  finalcut::FTermProbe probe{};
+  probe.addQuery (Query::XTermTitle);
+  probe.addQuery (Query::XTermFont);
+
+  // A title without string terminator (urxvt)
+  // and a font name terminated with ST
+  CPPUNIT_ASSERT ( parseString(probe, "\033]l\033]50;9x15\033\\\033[?1;2c") );
+  CPPUNIT_ASSERT ( probe.hasReply(Query::XTermTitle) );
+  CPPUNIT_ASSERT ( probe.getXTermTitle().isEmpty() );
+  CPPUNIT_ASSERT ( probe.hasReply(Query::XTermFont) );
+  CPPUNIT_ASSERT ( probe.getXTermFont() == "9x15" );
+
+  // An escape character at the end of the data
+  // could be the beginning of the string terminator
+  probe.clear();
+  CPPUNIT_ASSERT ( ! parseString(probe, "\033]lbash\033") );
+  CPPUNIT_ASSERT ( ! probe.hasReply(Query::XTermTitle) );
+  CPPUNIT_ASSERT ( ! parseString(probe, "\\") );
+  CPPUNIT_ASSERT ( probe.getXTermTitle() == "bash" );
+  CPPUNIT_ASSERT ( parseString(probe, "\033[?1;2c") );
+}
+
+//----------------------------------------------------------------------
+void FTermProbeTest::startupLatencyTest()
+{
+  // Startup benchmark for the terminal detection of an xterm.
+  // The former sequential queries waited 150 ms alone for
+  // the missing answerback message.
+  auto& data = finalcut::FTermData::getInstance();
+  auto& detect = finalcut::FTermDetection::getInstance();
+  data.setTermType("xterm");
+  detect.setTerminalDetection(true);
+
+  pid_t pid = forkConEmu();
+
+  if ( isConEmuChildProcess(pid) )
+  {
+    // (gdb) set follow-fork-mode child
+    setenv ("TERM", "xterm", 1);
+    setenv ("XTERM_VERSION", "XTerm(312)", 1);
+    unsetenv ("TERMCAP");
+    unsetenv ("COLORTERM");
+    unsetenv ("COLORFGBG");
+    unsetenv ("VTE_VERSION");
+    unsetenv ("ROXTERM_ID");
+    unsetenv ("KONSOLE_DBUS_SESSION");
+    unsetenv ("KONSOLE_DCOP");
+    unsetenv ("TMUX");
+    unsetenv ("KITTY_WINDOW_ID");
+
+    const auto start = std::chrono::steady_clock::now();
+    detect.detect();
+    const auto duration = std::chrono::steady_clock::now() - start;
+    const auto duration_us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+    std::cout << "\n  Terminal detection: " << duration_us << " µs\n";
+
+    CPPUNIT_ASSERT ( data.isTermType(finalcut::FTermType::xterm) );
+    CPPUNIT_ASSERT ( detect.getTermType() == "xterm-256color" );
+    CPPUNIT_ASSERT ( detect.getAnswerbackString() == "" );
+    CPPUNIT_ASSERT ( detect.getSecDAString() == "\033[>19;312;0c" );
+    CPPUNIT_ASSERT ( detect.getXTVersionString() == "XTerm(312)" );
+    CPPUNIT_ASSERT ( ! detect.hasSyncOutputSupport() );
+    CPPUNIT_ASSERT ( duration_us < 150'000 );
+
+    // All queries in a single round trip
+    finalcut::FTermios::setCaptureSendCharacters();
+    finalcut::FTermProbe probe{};
+    addAllQueries (probe);
+    CPPUNIT_ASSERT ( probe.run() );
+    std::cout << "  Probe round trip: " << probe.getRoundTripTime() << " µs\n";
+    CPPUNIT_ASSERT ( probe.getRoundTripTime() < finalcut::FTermProbe::DEFAULT_TIMEOUT );
+    CPPUNIT_ASSERT ( probe.getXTermTitle() == "TITLE" );
+    CPPUNIT_ASSERT ( probe.getXTermFont() == "fixed" );
+    finalcut::FTermios::unsetCaptureSendCharacters();
+
+    printConEmuDebug();
+    closeConEmuStdStreams();
+    unsetenv ("TERM");
+    unsetenv ("XTERM_VERSION");
+    exit(EXIT_SUCCESS);
+  }
+  else  // Parent
+  {
+    // Start the terminal emulation
+    startConEmuTerminal (ConEmu::console::xterm);
+    int wstatus;
+
+    if ( waitpid(pid, &wstatus, WUNTRACED) != pid )
+      std::cerr << "waitpid error" << std::endl;
+
+    if ( WIFEXITED(wstatus) )
+      CPPUNIT_ASSERT ( WEXITSTATUS(wstatus) == 0 );
+  }
+}
+
+//----------------------------------------------------------------------
+void FTermProbeTest::syncOutputTest()
+{
+  auto& data = finalcut::FTermData::getInstance();
+  auto& detect = finalcut::FTermDetection::getInstance();
+  data.setTermType("xterm-kitty");
+  detect.setTerminalDetection(true);
+
+  pid_t pid = forkConEmu();
+
+  if ( isConEmuChildProcess(pid) )
+  {
+    // (gdb) set follow-fork-mode child
+    setenv ("TERM", "xterm-kitty", 1);
+    setenv ("KITTY_WINDOW_ID", "1", 1);
+    setenv ("COLORTERM", "truecolor", 1);
+    unsetenv ("TERMCAP");
+    unsetenv ("COLORFGBG");
+    unsetenv ("VTE_VERSION");
+    unsetenv ("XTERM_VERSION");
+    unsetenv ("ROXTERM_ID");
+    unsetenv ("KONSOLE_DBUS_SESSION");
+    unsetenv ("KONSOLE_DCOP");
+    unsetenv ("TMUX");
+    detect.detect();
+
+    CPPUNIT_ASSERT ( data.isTermType(finalcut::FTermType::kitty) );
+    CPPUNIT_ASSERT ( detect.getXTVersionString() == "kitty(0.26.5)" );
+    CPPUNIT_ASSERT ( detect.hasSyncOutputSupport() );
+
+    printConEmuDebug();
+    closeConEmuStdStreams();
+    unsetenv ("TERM");
+    unsetenv ("KITTY_WINDOW_ID");
+    unsetenv ("COLORTERM");
+    exit(EXIT_SUCCESS);
+  }
+  else  // Parent
+  {
+    // Start the terminal emulation
+    startConEmuTerminal (ConEmu::console::kitty);
+    int wstatus;
+
+    if ( waitpid(pid, &wstatus, WUNTRACED) != pid )
+      std::cerr << "waitpid error" << std::endl;
+
+    if ( WIFEXITED(wstatus) )
+      CPPUNIT_ASSERT ( WEXITSTATUS(wstatus) == 0 );
+  }
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FTermProbeTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,334 @@
+/***********************************************************************
+* ftermprofilecache-test.cpp - FTermProfileCache unit tests            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <dirent.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <conemu.h>
+#include <final/final.h>
+
+namespace
+{
+
+struct Capabilities
+{
+  std::vector<std::string> strings{};
+  std::vector<std::string> keys{};
+  std::vector<int> values{};
+};
+
+//----------------------------------------------------------------------
+void setXTermEnvironment()
+{
+  setenv ("TERM", "xterm", 1);
+  setenv ("XTERM_VERSION", "XTerm(312)", 1);
+  unsetenv ("TERM_PROGRAM");
+  unsetenv ("TERMCAP");
+  unsetenv ("COLORTERM");
+  unsetenv ("COLORFGBG");
+  unsetenv ("VTE_VERSION");
+  unsetenv ("ROXTERM_ID");
+  unsetenv ("KONSOLE_DBUS_SESSION");
+  unsetenv ("KONSOLE_DCOP");
+  unsetenv ("TMUX");
+  unsetenv ("KITTY_WINDOW_ID");
+}
+
+//----------------------------------------------------------------------
+auto getCapabilities() -> Capabilities
+{
+  using finalcut::FTermcap;
+  Capabilities caps{};
+
+  for (const auto& entry : FTermcap::strings)
+    caps.strings.emplace_back(entry.string.data ? entry.string.data : "-");
+
+  for (const auto& entry : finalcut::FKeyMap::getKeyCapMap())
+    caps.keys.emplace_back ( std::to_string(uInt32(entry.num)) + ' '
+                           + entry.tname.data() + ' '
+                           + ( entry.string ? entry.string : "-" ) );
+
+  caps.values = { FTermcap::background_color_erase
+                , FTermcap::can_change_color_palette
+                , FTermcap::automatic_left_margin
+                , FTermcap::automatic_right_margin
+                , FTermcap::eat_nl_glitch
+                , FTermcap::has_ansi_escape_sequences
+                , FTermcap::ansi_default_color
+                , FTermcap::osc_support
+                , FTermcap::no_utf8_acs_chars
+                , FTermcap::no_padding_char
+                , FTermcap::xon_xoff_flow_control
+                , FTermcap::max_color
+                , FTermcap::tabstop
+                , FTermcap::padding_baudrate
+                , FTermcap::attr_without_color };
+  return caps;
+}
+
+//----------------------------------------------------------------------
+void clearCapabilities()
+{
+  for (auto&& entry : finalcut::FTermcap::strings)
+    entry.string = { nullptr, 0 };
+
+  for (auto&& entry : finalcut::FKeyMap::getKeyCapMap())
+  {
+    entry.string = nullptr;
+    entry.length = 0;
+  }
+
+  finalcut::FTermcap::max_color = 1;
+  finalcut::FTermcap::tabstop = -1;
+}
+
+//----------------------------------------------------------------------
+void removeDirectory (const std::string& path)
+{
+  auto dir = opendir(path.c_str());
+
+  if ( ! dir )
+    return;
+
+  while ( const auto* entry = readdir(dir) )
+  {
+    const std::string name{entry->d_name};
+
+    if ( name == "." || name == ".." )
+      continue;
+
+    const auto file_name = path + '/' + name;
+
+    if ( std::remove(file_name.c_str()) != 0 )
+      removeDirectory (file_name);
+  }
+
+  closedir(dir);
+  rmdir(path.c_str());
+}
+
+}  // anonymous namespace
+
+//----------------------------------------------------------------------
+// class FTermProfileCacheTest
+//----------------------------------------------------------------------
+
+class FTermProfileCacheTest : public CPPUNIT_NS::TestFixture
+                            , test::ConEmu
+{
+  public:
+    FTermProfileCacheTest() = default;
+
+  protected:
+    void classNameTest();
+    void disabledTest();
+    void cacheDirectoryTest();
+    void coldWarmStartTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FTermProfileCacheTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (disabledTest);
+    CPPUNIT_TEST (cacheDirectoryTest);
+    CPPUNIT_TEST (coldWarmStartTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FTermProfileCacheTest::classNameTest()
+{
+  const auto& profile_cache = finalcut::FTermProfileCache::getInstance();
+  const finalcut::FString& classname = profile_cache.getClassName();
+  CPPUNIT_ASSERT ( classname == "FTermProfileCache" );
+}
+
+//----------------------------------------------------------------------
+void FTermProfileCacheTest::disabledTest()
+{
+  // The cache is opt-in and never touches the terminal when disabled
+  auto& profile_cache = finalcut::FTermProfileCache::getInstance();
+  CPPUNIT_ASSERT ( ! profile_cache.isEnabled() );
+  CPPUNIT_ASSERT ( ! profile_cache.load() );
+  CPPUNIT_ASSERT ( ! profile_cache.isLoaded() );
+  CPPUNIT_ASSERT ( ! profile_cache.save() );
+  CPPUNIT_ASSERT ( profile_cache.getKey().empty() );
+  CPPUNIT_ASSERT ( profile_cache.getFileName().empty() );
+
+  finalcut::FStartOptions::getInstance().setDefault();
+  CPPUNIT_ASSERT ( ! finalcut::FStartOptions::getInstance().terminal_profile_cache );
+}
+
+//----------------------------------------------------------------------
+void FTermProfileCacheTest::cacheDirectoryTest()
+{
+  const auto& profile_cache = finalcut::FTermProfileCache::getInstance();
+  const auto* home = std::getenv("HOME");
+  const std::string saved_home{home ? home : ""};
+
+  setenv ("XDG_CACHE_HOME", "/var/tmp/cache", 1);
+  CPPUNIT_ASSERT ( profile_cache.getCacheDirectory() == "/var/tmp/cache/finalcut" );
+
+  // Relative paths are invalid according to the XDG specification
+  setenv ("XDG_CACHE_HOME", "cache", 1);
+  setenv ("HOME", "/home/user", 1);
+  CPPUNIT_ASSERT ( profile_cache.getCacheDirectory() == "/home/user/.cache/finalcut" );
+
+  unsetenv ("XDG_CACHE_HOME");
+  CPPUNIT_ASSERT ( profile_cache.getCacheDirectory() == "/home/user/.cache/finalcut" );
+
+  if ( home )
+    setenv ("HOME", saved_home.c_str(), 1);
+  else
+    unsetenv ("HOME");
+}
+
+//----------------------------------------------------------------------
+void FTermProfileCacheTest::coldWarmStartTest()
+{
+  // Startup benchmark of the terminal detection and termcap
+  // initialization with an empty cache (cold) and with
+  // a cached profile (warm)
+
+  std::string cache_home{"/tmp/finalcut-test-XXXXXX"};
+  CPPUNIT_ASSERT ( mkdtemp(&cache_home[0]) );
+  auto& data = finalcut::FTermData::getInstance();
+  auto& detect = finalcut::FTermDetection::getInstance();
+  auto& profile_cache = finalcut::FTermProfileCache::getInstance();
+  data.setTermType("xterm");
+  detect.setTerminalDetection(true);
+
+  pid_t pid = forkConEmu();
+
+  if ( isConEmuChildProcess(pid) )
+  {
+    // (gdb) set follow-fork-mode child
+    using namespace std::chrono;
+    setXTermEnvironment();
+    setenv ("XDG_CACHE_HOME", cache_home.c_str(), 1);
+    profile_cache.setEnabled();
+
+    // Cold start
+    auto start = steady_clock::now();
+    CPPUNIT_ASSERT ( ! profile_cache.load() );
+    detect.detect();
+    finalcut::FTermcap::init();
+    finalcut::FTermcapQuirks::terminalFixup();
+    CPPUNIT_ASSERT ( profile_cache.save() );
+    const auto cold_us = duration_cast<microseconds>(steady_clock::now() - start).count();
+    std::cout << "\n  Cold start: " << cold_us << " µs\n";
+
+    const auto file_name = profile_cache.getFileName();
+    CPPUNIT_ASSERT ( file_name.find(cache_home + "/finalcut/terminal-") == 0 );
+    CPPUNIT_ASSERT ( std::ifstream(file_name).good() );
+    CPPUNIT_ASSERT ( profile_cache.getKey().find("TERM=xterm\n") != std::string::npos );
+    CPPUNIT_ASSERT ( profile_cache.getKey().find("SEC_DA=\033[>19;312;0c") != std::string::npos );
+    const auto cold_caps = getCapabilities();
+    const auto cold_term_type = detect.getTermType();
+
+    // Warm start (as a new process with the original TERM)
+    setenv ("TERM", "xterm", 1);
+    clearCapabilities();
+    start = steady_clock::now();
+    CPPUNIT_ASSERT ( profile_cache.load() );
+    profile_cache.restoreCapabilities();
+    const auto warm_us = duration_cast<microseconds>(steady_clock::now() - start).count();
+    std::cout << "  Warm start: " << warm_us << " µs\n";
+
+    CPPUNIT_ASSERT ( profile_cache.isLoaded() );
+    CPPUNIT_ASSERT ( profile_cache.getFileName() == file_name );
+    CPPUNIT_ASSERT ( ! profile_cache.save() );  // Nothing new to save
+    CPPUNIT_ASSERT ( detect.getTermType() == cold_term_type );
+    CPPUNIT_ASSERT ( detect.getTermType() == "xterm-256color" );
+    CPPUNIT_ASSERT ( detect.getSecDAString() == "\033[>19;312;0c" );
+    CPPUNIT_ASSERT ( detect.getXTVersionString() == "XTerm(312)" );
+    CPPUNIT_ASSERT ( detect.canDisplay256Colors() );
+    CPPUNIT_ASSERT ( data.isTermType(finalcut::FTermType::xterm) );
+    CPPUNIT_ASSERT ( finalcut::FTermcap::isInitialized() );
+    CPPUNIT_ASSERT ( std::string(std::getenv("TERM")) == "xterm-256color" );
+    const auto warm_caps = getCapabilities();
+    CPPUNIT_ASSERT ( warm_caps.strings == cold_caps.strings );
+    CPPUNIT_ASSERT ( warm_caps.keys == cold_caps.keys );
+    CPPUNIT_ASSERT ( warm_caps.values == cold_caps.values );
+    CPPUNIT_ASSERT ( warm_us < 150'000 );
+
+    // A changed environment selects another profile
+    setenv ("TERM", "xterm", 1);
+    setenv ("COLORTERM", "truecolor", 1);
+    CPPUNIT_ASSERT ( ! profile_cache.load() );
+    CPPUNIT_ASSERT ( profile_cache.getFileName() != file_name );
+    unsetenv ("COLORTERM");
+
+    // A profile with another format version is ignored
+    std::ofstream (file_name, std::ofstream::trunc) << "version 0\n";
+    setenv ("TERM", "xterm", 1);
+    CPPUNIT_ASSERT ( ! profile_cache.load() );
+    CPPUNIT_ASSERT ( ! profile_cache.isLoaded() );
+
+    printConEmuDebug();
+    closeConEmuStdStreams();
+    unsetenv ("TERM");
+    unsetenv ("XTERM_VERSION");
+    unsetenv ("XDG_CACHE_HOME");
+    exit(EXIT_SUCCESS);
+  }
+  else  // Parent
+  {
+    // Start the terminal emulation
+    startConEmuTerminal (ConEmu::console::xterm);
+    int wstatus;
+
+    if ( waitpid(pid, &wstatus, WUNTRACED) != pid )
+      std::cerr << "waitpid error" << std::endl;
+
+    removeDirectory (cache_home);
+
+    if ( WIFEXITED(wstatus) )
+      CPPUNIT_ASSERT ( WEXITSTATUS(wstatus) == 0 );
+  }
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FTermProfileCacheTest);
+
+// The general unit test main part
+#include <main-test.inc>
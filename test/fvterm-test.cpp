@@ -87,6 +87,8 @@ class FTermOutputTest : public finalcut::FOutput
     auto setNewFont() -> bool override;
     void setNonBlockingRead (bool = true) override;
     static void setNoForce (bool = true);
+    static void setHardwareScrolling (bool = true);
+    static auto getScrolledLines() -> int;
 
     // Predicates
     auto isCursorHideable() const -> bool override;
@@ -110,11 +112,12 @@ class FTermOutputTest : public finalcut::FOutput
     void initScreenSettings() override;
     auto scrollTerminalForward() -> bool override;
     auto scrollTerminalReverse() -> bool override;
+    auto scrollTerminalLines (int, int, int) -> bool override;
     void clearTerminalAttributes() override;
     void clearTerminalState() override;
     auto clearTerminal (wchar_t = L' ') -> bool override;
     void flush() override;
-    void beep() const override;
+    void beep() override;
 
   private:
     // Using-declaration
@@ -132,6 +135,8 @@ class FTermOutputTest : public finalcut::FOutput
     // Data member
     bool                                   bell{false};
     static bool                            no_force;
+    static bool                            hardware_scrolling;
+    static int                             scrolled_lines;
     finalcut::FTerm                        fterm{};
     static finalcut::FVTerm::FTermRegion*  vterm;
     static finalcut::FTermData*            fterm_data;
@@ -143,6 +148,8 @@ class FTermOutputTest : public finalcut::FOutput
 
 // static class attributes
 bool                           FTermOutputTest::no_force{false};
+bool                           FTermOutputTest::hardware_scrolling{false};
+int                            FTermOutputTest::scrolled_lines{0};
 finalcut::FVTerm::FTermRegion* FTermOutputTest::vterm{nullptr};
 finalcut::FTermData*           FTermOutputTest::fterm_data{nullptr};
 
@@ -315,6 +322,19 @@ inline void FTermOutputTest::setNoForce (bool state)
   no_force = state;
 }
 
+//----------------------------------------------------------------------
+inline void FTermOutputTest::setHardwareScrolling (bool enable)
+{
+  hardware_scrolling = enable;
+  scrolled_lines = 0;
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutputTest::getScrolledLines() -> int
+{
+  return scrolled_lines;
+}
+
 //----------------------------------------------------------------------
 inline void FTermOutputTest::initTerminal (finalcut::FVTerm::FTermRegion* virtual_terminal)
 {
@@ -365,6 +385,16 @@ inline auto FTermOutputTest::scrollTerminalReverse() -> bool
   return true;
 }
 
+//----------------------------------------------------------------------
+inline auto FTermOutputTest::scrollTerminalLines (int, int, int lines) -> bool
+{
+  if ( ! hardware_scrolling )
+    return false;
+
+  scrolled_lines += lines;
+  return true;
+}
+
 //----------------------------------------------------------------------
 inline void FTermOutputTest::clearTerminalAttributes()
 {
@@ -391,7 +421,7 @@ inline void FTermOutputTest::flush()
 }
 
 //----------------------------------------------------------------------
-inline void FTermOutputTest::beep() const
+inline void FTermOutputTest::beep()
 {
   setBellState();
 }
@@ -780,9 +810,13 @@ class FVTermTest : public CPPUNIT_NS::TestFixture
     void FVTermPrintTest();
     void FVTermChildRegionPrintTest();
     void FVTermScrollTest();
+    void FVTermHardwareScrollTest();
+    void FVTermLastTerminalShiftTest();
+    void FVTermRowTableTest();
     void FVTermOverlappingWindowsTest();
     void FVTermTranparencyTest();
     void FVTermReduceUpdatesTest();
+    void FVTermParallelCompositingTest();
     void getFVTermRegionTest();
 
   private:
@@ -797,9 +831,13 @@ class FVTermTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (FVTermPrintTest);
     CPPUNIT_TEST (FVTermChildRegionPrintTest);
     CPPUNIT_TEST (FVTermScrollTest);
+    CPPUNIT_TEST (FVTermHardwareScrollTest);
+    CPPUNIT_TEST (FVTermLastTerminalShiftTest);
+    CPPUNIT_TEST (FVTermRowTableTest);
     CPPUNIT_TEST (FVTermOverlappingWindowsTest);
     CPPUNIT_TEST (FVTermTranparencyTest);
     CPPUNIT_TEST (FVTermReduceUpdatesTest);
+    CPPUNIT_TEST (FVTermParallelCompositingTest);
     CPPUNIT_TEST (getFVTermRegionTest);
 
     // End of test suite definition
@@ -853,7 +891,9 @@ void FVTermTest::OwnFunctionsTest()
 {
   finalcut::FChar shadow_char;
   shadow_char.ch = { L'\0', L'\0', L'\0', L'\0', L'\0' };
+#if !defined(F_COMPACT_FCHAR)
   shadow_char.encoded_char = { L'\0', L'\0', L'\0', L'\0', L'\0' };
+#endif
   shadow_char.color.setFgColor(finalcut::FColor::Default);
   shadow_char.color.setBgColor(finalcut::FColor::Default);
   shadow_char.attr.byte()->at(0) = 0;
@@ -1004,7 +1044,9 @@ void FVTermTest::FVTermBasesTest()
 
   finalcut::FChar default_char;
   default_char.ch           = { L' ', L'\0', L'\0', L'\0', L'\0' };
+#if !defined(F_COMPACT_FCHAR)
   default_char.encoded_char = { L'\0', L'\0', L'\0', L'\0', L'\0' };
+#endif
   default_char.color.setFgColor(finalcut::FColor::Default);
   default_char.color.setBgColor(finalcut::FColor::Default);
   default_char.attr.byte()->at(0) = 0;
@@ -2396,6 +2438,256 @@ void FVTermTest::FVTermScrollTest()
   test::printRegion (vdesktop);
 }
 
+//----------------------------------------------------------------------
+void FVTermTest::FVTermHardwareScrollTest()
+{
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+  auto&& vterm = p_fvterm.p_getVirtualTerminal();
+  CPPUNIT_ASSERT ( vterm->size.width == 80 );
+
+  // A full-width window from terminal line 3 to 12
+  finalcut::FRect geometry {finalcut::FPoint{0, 2}, finalcut::FSize{80, 10}};
+  auto vwin_ptr = p_fvterm.p_createRegion (geometry);
+  auto vwin = vwin_ptr.get();
+  p_fvterm.setVWin(std::move(vwin_ptr));
+  finalcut::FVTerm::getWindowList()->push_back(&p_fvterm);
+  vwin->visible = true;
+
+  for (auto y{0}; y < 10; y++)
+  {
+    p_fvterm.print() << finalcut::FPoint{1, y + 3}
+                     << finalcut::FString(std::size_t(80), wchar_t(L'A' + y));
+  }
+
+  p_fvterm.p_addLayer(vwin);
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 2).ch[0] == L'A' );
+  CPPUNIT_ASSERT ( vterm->getFChar(79, 11).ch[0] == L'J' );
+
+  auto hasOnlyLineChanges = [&vwin] (int line)
+  {
+    for (auto y{0}; y < vwin->size.height; y++)
+      if ( vwin->hasLineChanges(y) != ( y == line ) )
+        return false;
+
+    return true;
+  };
+
+  // Without terminal support, all lines are redrawn
+  FTermOutputTest::setHardwareScrolling(false);
+  p_fvterm.p_scrollRegionForward (vwin);
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 0).ch[0] == L'B' );
+  CPPUNIT_ASSERT ( vwin->hasLineChanges(0) );
+  CPPUNIT_ASSERT ( vwin->hasLineChanges(5) );
+  p_fvterm.p_addLayer(vwin);
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 2).ch[0] == L'B' );
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 11).ch[0] == L' ' );
+
+  // Scroll forward with the terminal
+  FTermOutputTest::setHardwareScrolling();
+  p_fvterm.p_scrollRegionForward (vwin);
+  CPPUNIT_ASSERT ( FTermOutputTest::getScrolledLines() == 1 );
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 0).ch[0] == L'C' );
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 7).ch[0] == L'J' );
+  CPPUNIT_ASSERT ( hasOnlyLineChanges(9) );
+  CPPUNIT_ASSERT ( vwin->changes_in_row.ymax >= 9 );
+  CPPUNIT_ASSERT ( vwin->damage.getCount() == 1 );
+  // The virtual terminal was shifted like the terminal
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 2).ch[0] == L'C' );
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 9).ch[0] == L'J' );
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 1).ch[0] == L' ' );
+  p_fvterm.p_addLayer(vwin);
+  CPPUNIT_ASSERT ( hasOnlyLineChanges(-1) );
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 10).ch[0] == L' ' );
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 11).ch[0] == L' ' );
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 12).ch[0] == L' ' );
+
+  // Scroll reverse with the terminal
+  p_fvterm.p_scrollRegionReverse (vwin);
+  CPPUNIT_ASSERT ( FTermOutputTest::getScrolledLines() == 0 );
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 0).ch[0] == L' ' );
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 1).ch[0] == L'C' );
+  CPPUNIT_ASSERT ( hasOnlyLineChanges(0) );
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 3).ch[0] == L'C' );
+  p_fvterm.p_addLayer(vwin);
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 2).ch[0] == L' ' );
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 10).ch[0] == L'J' );
+
+  // Pending changes move with their lines
+  p_fvterm.print() << finalcut::FPoint{5, 8} << "xyz";
+  CPPUNIT_ASSERT ( hasOnlyLineChanges(5) );
+  p_fvterm.p_scrollRegionForward (vwin);
+  CPPUNIT_ASSERT ( FTermOutputTest::getScrolledLines() == 1 );
+  CPPUNIT_ASSERT ( vwin->getFChar(4, 4).ch[0] == L'x' );
+  CPPUNIT_ASSERT ( vwin->changes_in_line[4].xmin == 4 );
+  CPPUNIT_ASSERT ( vwin->changes_in_line[4].xmax == 6 );
+  CPPUNIT_ASSERT ( ! vwin->hasLineChanges(5) );
+  CPPUNIT_ASSERT ( vwin->hasLineChanges(9) );
+  p_fvterm.p_addLayer(vwin);
+  CPPUNIT_ASSERT ( vterm->getFChar(4, 6).ch[0] == L'x' );
+
+  // No terminal scrolling while the terminal updates are paused
+  FTermOutputTest::setHardwareScrolling(true);
+  p_fvterm.setTerminalUpdates(finalcut::FVTerm::TerminalUpdate::Stop);
+  p_fvterm.p_scrollRegionForward (vwin);
+  CPPUNIT_ASSERT ( FTermOutputTest::getScrolledLines() == 0 );
+  CPPUNIT_ASSERT ( vwin->hasLineChanges(0) );
+  CPPUNIT_ASSERT ( vwin->hasLineChanges(9) );
+  p_fvterm.p_addLayer(vwin);
+  p_fvterm.setTerminalUpdates(finalcut::FVTerm::TerminalUpdate::Continue);
+  p_fvterm.p_scrollRegionForward (vwin);
+  CPPUNIT_ASSERT ( FTermOutputTest::getScrolledLines() == 1 );
+  p_fvterm.p_addLayer(vwin);
+
+  // Transparent characters require a complete redraw
+  p_fvterm.print() << finalcut::FPoint{1, 3}
+                   << finalcut::FStyle {finalcut::Style::Transparent}
+                   << "T" << finalcut::FStyle {finalcut::Style::None};
+  p_fvterm.p_addLayer(vwin);
+  p_fvterm.p_scrollRegionReverse (vwin);
+  CPPUNIT_ASSERT ( FTermOutputTest::getScrolledLines() == 1 );
+  CPPUNIT_ASSERT ( vwin->hasLineChanges(0) );
+  CPPUNIT_ASSERT ( vwin->hasLineChanges(9) );
+
+  FTermOutputTest::setHardwareScrolling(false);
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::FVTermLastTerminalShiftTest()
+{
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+  auto&& vterm = p_fvterm.p_getVirtualTerminal();
+  const auto* vterm_old = finalcut::FVTerm::getLastVirtualTerminal();
+  CPPUNIT_ASSERT ( vterm_old != nullptr );
+  CPPUNIT_ASSERT ( vterm_old->size.width == vterm->size.width );
+  CPPUNIT_ASSERT ( vterm_old->size.height == vterm->size.height );
+
+  auto isInserted = [&vterm_old] (int y)
+  {
+    const auto& fchar = vterm_old->getFChar(0, y);
+    return fchar.ch[0] == L'\0'
+        && fchar.color.getFgColor() == finalcut::FColor::Undefined
+        && fchar.color.getBgColor() == finalcut::FColor::Undefined;
+  };
+
+  auto hasFullLineChanges = [&vterm] (int from, int to)
+  {
+    for (auto y{from}; y <= to; y++)
+      if ( vterm->changes_in_line[y].xmin != 0
+        || vterm->changes_in_line[y].xmax != uInt(vterm->size.width - 1) )
+        return false;
+
+    return true;
+  };
+
+  const auto* line_3 = &vterm_old->getFChar(0, 3);
+  const auto* line_4 = &vterm_old->getFChar(0, 4);
+  vterm->changes_in_row = {uInt(vterm->size.height), 0};
+
+  // Delete a line at the top of the block (lines 2 to 5)
+  finalcut::FVTerm::shiftLastTerminalLines (2, 5, 1);
+  CPPUNIT_ASSERT ( &vterm_old->getFChar(0, 2) == line_3 );
+  CPPUNIT_ASSERT ( &vterm_old->getFChar(0, 3) == line_4 );
+  CPPUNIT_ASSERT ( ! isInserted(1) );
+  CPPUNIT_ASSERT ( ! isInserted(4) );
+  CPPUNIT_ASSERT ( isInserted(5) );
+  CPPUNIT_ASSERT ( ! isInserted(6) );
+  CPPUNIT_ASSERT ( hasFullLineChanges(2, 5) );
+  CPPUNIT_ASSERT ( vterm->changes_in_row.ymin == 2 );
+  CPPUNIT_ASSERT ( vterm->changes_in_row.ymax == 5 );
+
+  // Insert two lines at the top of the block (lines 10 to 14)
+  finalcut::FVTerm::shiftLastTerminalLines (10, 14, -2);
+  CPPUNIT_ASSERT ( isInserted(10) );
+  CPPUNIT_ASSERT ( isInserted(11) );
+  CPPUNIT_ASSERT ( ! isInserted(12) );
+  CPPUNIT_ASSERT ( ! isInserted(15) );
+  CPPUNIT_ASSERT ( hasFullLineChanges(10, 14) );
+  CPPUNIT_ASSERT ( vterm->changes_in_row.ymin == 2 );
+  CPPUNIT_ASSERT ( vterm->changes_in_row.ymax == 14 );
+
+  // An inserted line never matches a character of the virtual terminal
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 10) != vterm_old->getFChar(0, 10) );
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 12) == vterm_old->getFChar(0, 12) );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::FVTermRowTableTest()
+{
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+
+  // A 4x3 window with a shadow of one column and one line
+  const finalcut::FRect geometry {finalcut::FPoint{0, 0}, finalcut::FSize{4, 3}};
+  const finalcut::FSize shadow {1, 1};
+  auto vwin_ptr = p_fvterm.p_createRegion ({geometry, shadow});
+  auto vwin = vwin_ptr.get();
+  p_fvterm.setVWin(std::move(vwin_ptr));
+  CPPUNIT_ASSERT ( vwin->row_table.empty() );
+
+  p_fvterm.print() << finalcut::FPoint{1, 1} << "AAAA"
+                   << finalcut::FPoint{1, 2} << "BBBB"
+                   << finalcut::FPoint{1, 3} << "CCCC";
+
+  for (auto y{0}; y < 3; y++)
+    vwin->getFChar(4, y).ch[0] = wchar_t(L'a' + y);
+
+  vwin->getFChar(0, 3).ch[0] = L's';
+
+  auto getLine = [&vwin] (int y)
+  {
+    std::wstring line{};
+
+    for (auto x{0}; x < 5; x++)
+      line += vwin->getFChar(x, y).ch[0];
+
+    return line;
+  };
+
+  // Scrolling changes only the row table
+  const auto data_ptr = vwin->data.data();
+  p_fvterm.p_scrollRegionForward (vwin);
+  CPPUNIT_ASSERT ( vwin->data.data() == data_ptr );
+  CPPUNIT_ASSERT ( vwin->row_table.size() == 4 );
+  CPPUNIT_ASSERT ( vwin->row_table[0] == 1 );
+  CPPUNIT_ASSERT ( vwin->row_table[1] == 2 );
+  CPPUNIT_ASSERT ( vwin->row_table[2] == 0 );
+  CPPUNIT_ASSERT ( vwin->row_table[3] == 3 );
+  CPPUNIT_ASSERT ( getLine(0) == L"BBBBa" );
+  CPPUNIT_ASSERT ( getLine(1) == L"CCCCb" );
+  CPPUNIT_ASSERT ( getLine(2) == L"    c" );
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 3).ch[0] == L's' );
+
+  // Printing follows the logical lines
+  p_fvterm.print() << finalcut::FPoint{3, 3} << "xy";
+  CPPUNIT_ASSERT ( getLine(2) == L"  xyc" );
+  CPPUNIT_ASSERT ( vwin->data[2] == vwin->getFChar(2, 2) );
+
+  p_fvterm.p_scrollRegionReverse (vwin);
+  p_fvterm.p_scrollRegionReverse (vwin);
+  CPPUNIT_ASSERT ( getLine(0) == L"    a" );
+  CPPUNIT_ASSERT ( getLine(1) == L"    b" );
+  CPPUNIT_ASSERT ( getLine(2) == L"BBBBc" );
+  CPPUNIT_ASSERT ( vwin->getFChar(0, 3).ch[0] == L's' );
+
+  // Rotations wrap around
+  vwin->rotateRows (0, 2, 4);
+  CPPUNIT_ASSERT ( getLine(0) == L"    a" );
+  CPPUNIT_ASSERT ( getLine(1) == L"BBBBb" );
+  CPPUNIT_ASSERT ( getLine(2) == L"    c" );
+  vwin->rotateRows (0, 2, -1);
+  CPPUNIT_ASSERT ( getLine(0) == L"    a" );
+  CPPUNIT_ASSERT ( getLine(1) == L"    b" );
+  CPPUNIT_ASSERT ( getLine(2) == L"BBBBc" );
+
+  // Moving keeps the row table, a resize restores the identity mapping
+  const finalcut::FRect moved {finalcut::FPoint{2, 1}, finalcut::FSize{4, 3}};
+  p_fvterm.p_resizeRegion ({moved, shadow}, vwin);
+  CPPUNIT_ASSERT ( ! vwin->row_table.empty() );
+  CPPUNIT_ASSERT ( getLine(2) == L"BBBBc" );
+  const finalcut::FRect resized {finalcut::FPoint{2, 1}, finalcut::FSize{5, 3}};
+  p_fvterm.p_resizeRegion ({resized, shadow}, vwin);
+  CPPUNIT_ASSERT ( vwin->row_table.empty() );
+}
+
 //----------------------------------------------------------------------
 void FVTermTest::FVTermOverlappingWindowsTest()
 {
@@ -3047,6 +3339,106 @@ void FVTermTest::FVTermTranparencyTest()
                                       { 15, { {80, bg_char} } } } );
 
   CPPUNIT_ASSERT ( test::isRegionEqual(test_region, vterm) );
+
+  // The flag plane matches the transparency attributes
+  // of all lines without pending changes
+  for (const auto* win : { vwin_1, vwin_2, vwin_3, vwin_4, vwin_5 })
+  {
+    CPPUNIT_ASSERT ( win->flag_plane.size() == win->data.size() );
+
+    for (int y{0}; y < win->size.height; y++)
+    {
+      CPPUNIT_ASSERT ( ! win->hasLineChanges(y) );
+
+      for (int x{0}; x < win->size.width; x++)
+      {
+        const auto index = std::size_t(y * win->size.width + x);
+        CPPUNIT_ASSERT ( win->flag_plane[index]
+                         == finalcut::FVTerm::FTermRegion::getTransparencyFlags(win->data[index]) );
+      }
+    }
+  }
+
+  // Putting a covered window on the virtual terminal composes
+  // its lines with transparent characters from all layers
+  const auto composed_data = vterm->data;
+  p_fvterm_3.p_putRegion ({1, 1}, vwin_3);
+
+  for (const auto y : { 0, 1, 3, 4, 6, 7 })
+  {
+    CPPUNIT_ASSERT ( vwin_3->changes_in_line[unsigned(y)].trans_count > 0 );
+
+    for (int x{0}; x < 9; x++)
+    {
+      const auto index = std::size_t(y * vterm->size.width + x);
+      CPPUNIT_ASSERT ( vterm->data[index] == composed_data[index] );
+    }
+  }
+
+  // The input cursor is hidden by the opaque characters of the windows
+  // above, even after a change of the cached coverage of vwin_3
+  p_fvterm_3.p_setActiveRegion (vwin_3);
+  vwin_3->input_cursor_visible = true;
+  vwin_3->setInputCursorPos (2, 0);
+  CPPUNIT_ASSERT ( p_fvterm_3.p_updateVTermCursor(vwin_3) );
+  vwin_3->setInputCursorPos (0, 4);  // Below "─" of vwin_4
+  CPPUNIT_ASSERT ( ! p_fvterm_3.p_updateVTermCursor(vwin_3) );
+  vwin_3->setInputCursorPos (4, 4);  // Below "┼" of vwin_4 and "╳" of vwin_5
+  CPPUNIT_ASSERT ( ! p_fvterm_3.p_updateVTermCursor(vwin_3) );
+
+  // Direct changes of the window state require an invalidation
+  // of the cached coverage, as FWindow does it
+  vwin_4->position.x = 40;  // Move
+  finalcut::FVTerm::FTermRegion::invalidateCoverage();
+  vwin_3->setInputCursorPos (0, 4);
+  CPPUNIT_ASSERT ( p_fvterm_3.p_updateVTermCursor(vwin_3) );
+  vwin_3->setInputCursorPos (4, 4);
+  CPPUNIT_ASSERT ( ! p_fvterm_3.p_updateVTermCursor(vwin_3) );
+
+  vwin_4->position.x = 0;
+  finalcut::FVTerm::FTermRegion::invalidateCoverage();
+  vwin_3->setInputCursorPos (0, 4);
+  CPPUNIT_ASSERT ( ! p_fvterm_3.p_updateVTermCursor(vwin_3) );
+  vwin_4->visible = false;  // Hide
+  finalcut::FVTerm::FTermRegion::invalidateCoverage();
+  CPPUNIT_ASSERT ( p_fvterm_3.p_updateVTermCursor(vwin_3) );
+  vwin_4->visible = true;
+  finalcut::FVTerm::FTermRegion::invalidateCoverage();
+  CPPUNIT_ASSERT ( ! p_fvterm_3.p_updateVTermCursor(vwin_3) );
+
+  // The cursor query does not rebuild the cached coverage
+  const auto generation = finalcut::FVTerm::FTermRegion::coverage_generation;
+  const auto plane_generation = vwin_3->coverage_plane_generation;
+  CPPUNIT_ASSERT ( plane_generation != generation );
+  CPPUNIT_ASSERT ( ! p_fvterm_3.p_updateVTermCursor(vwin_3) );
+  CPPUNIT_ASSERT ( vwin_3->coverage_plane_generation == plane_generation );
+  CPPUNIT_ASSERT ( finalcut::FVTerm::FTermRegion::coverage_generation == generation );
+
+  // Lower vwin_4 below vwin_3
+  std::swap ( (*finalcut::FVTerm::getWindowList())[2]
+            , (*finalcut::FVTerm::getWindowList())[3] );
+  p_fvterm_1.p_determineWindowLayers();
+  CPPUNIT_ASSERT ( p_fvterm_3.p_updateVTermCursor(vwin_3) );
+  std::swap ( (*finalcut::FVTerm::getWindowList())[2]
+            , (*finalcut::FVTerm::getWindowList())[3] );
+  p_fvterm_1.p_determineWindowLayers();
+  CPPUNIT_ASSERT ( ! p_fvterm_3.p_updateVTermCursor(vwin_3) );
+
+  // Make "─" of vwin_4 transparent. The line with the pending
+  // change is already considered before vwin_4 is composited.
+  p_fvterm_4.print() << finalcut::FPoint{1, 5} << transparent << " " << reset;
+  CPPUNIT_ASSERT ( vwin_4->hasLineChanges(4) );
+  CPPUNIT_ASSERT ( p_fvterm_3.p_updateVTermCursor(vwin_3) );
+  p_fvterm_4.p_addLayer (vwin_4);
+  CPPUNIT_ASSERT ( ! vwin_4->hasLineChanges(4) );
+  CPPUNIT_ASSERT ( p_fvterm_3.p_updateVTermCursor(vwin_3) );
+
+  // An opaque character covers the cursor again before compositing
+  p_fvterm_4.print() << finalcut::FPoint{1, 5} << "x";
+  CPPUNIT_ASSERT ( vwin_4->hasLineChanges(4) );
+  CPPUNIT_ASSERT ( ! p_fvterm_3.p_updateVTermCursor(vwin_3) );
+  p_fvterm_4.p_addLayer (vwin_4);
+  p_fvterm_3.p_setActiveRegion (p_fvterm_3.p_getVirtualDesktop());
 }
 
 //----------------------------------------------------------------------
@@ -3275,6 +3667,178 @@ void FVTermTest::FVTermReduceUpdatesTest()
     CPPUNIT_ASSERT ( vterm->changes_in_line[i].xmax == 13 );
     CPPUNIT_ASSERT ( vterm->changes_in_line[i].trans_count == 0 );
   }
+
+  // Changes at both ends of a line are kept as separate damaged spans
+  for (auto y{0}; y < vterm->size.height; y++)
+  {
+    vterm->changes_in_line[y].xmin = uInt(vterm->size.width);
+    vterm->changes_in_line[y].xmax = 0;
+  }
+
+  vterm->resetDamage();
+  CPPUNIT_ASSERT ( vterm->damage.isEmpty() );
+  CPPUNIT_ASSERT ( vwin->damage.isEmpty() );
+
+  p_fvterm.print() << finalcut::FPoint{1, 1} << 'X';
+  p_fvterm.print() << finalcut::FPoint{15, 1} << 'Y';
+  finalcut::FDamageList::FSpanVec spans{};
+  CPPUNIT_ASSERT ( vwin->getDamagedSpans(0, spans) );
+  CPPUNIT_ASSERT ( spans.size() == 2 );
+  CPPUNIT_ASSERT ( ! vwin->getDamagedSpans(1, spans) );
+  CPPUNIT_ASSERT ( spans.empty() );
+
+  p_fvterm.p_addLayer(vwin);
+  CPPUNIT_ASSERT ( vwin->damage.isEmpty() );
+  CPPUNIT_ASSERT ( vterm->changes_in_line[0].xmin == 0 );
+  CPPUNIT_ASSERT ( vterm->changes_in_line[0].xmax == 14 );
+  CPPUNIT_ASSERT ( vterm->getDamagedSpans(0, spans) );
+  CPPUNIT_ASSERT ( spans.size() == 2 );
+  CPPUNIT_ASSERT ( spans[0].xmin == 0 );
+  CPPUNIT_ASSERT ( spans[0].xmax == 0 );
+  CPPUNIT_ASSERT ( spans[1].xmin == 14 );
+  CPPUNIT_ASSERT ( spans[1].xmax == 14 );
+  CPPUNIT_ASSERT ( vterm->getFChar(0, 0).ch[0] == L'X' );
+  CPPUNIT_ASSERT ( vterm->getFChar(14, 0).ch[0] == L'Y' );
+
+  // A direct change of the line boundaries falls back to one span
+  vterm->changes_in_line[0].xmax = 20;
+  CPPUNIT_ASSERT ( vterm->getDamagedSpans(0, spans) );
+  CPPUNIT_ASSERT ( spans.size() == 1 );
+  CPPUNIT_ASSERT ( spans[0].xmin == 0 );
+  CPPUNIT_ASSERT ( spans[0].xmax == 20 );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::FVTermParallelCompositingTest()
+{
+  FVTerm_protected p_fvterm_1(finalcut::outputClass<FTermOutputTest>{});
+  FVTerm_protected p_fvterm_2(finalcut::outputClass<FTermOutputTest>{});
+
+  // A large terminal (e.g. 4K resolution)
+  auto vterm = p_fvterm_1.p_getVirtualTerminal();
+  p_fvterm_1.resizeVTerm (finalcut::FSize{480, 135});
+  CPPUNIT_ASSERT ( vterm->size.width == 480 );
+  CPPUNIT_ASSERT ( vterm->size.height == 135 );
+  CPPUNIT_ASSERT ( finalcut::FVTerm::getCompositorThreads() == 1 );
+
+  // Two windows with identical content
+  finalcut::FRect geometry {finalcut::FPoint{6, 3}, finalcut::FSize{470, 130}};
+  auto vwin_1_ptr = p_fvterm_1.p_createRegion (geometry);
+  auto vwin_2_ptr = p_fvterm_2.p_createRegion (geometry);
+  auto vwin_1 = vwin_1_ptr.get();
+  auto vwin_2 = vwin_2_ptr.get();
+  p_fvterm_1.setVWin(std::move(vwin_1_ptr));
+  p_fvterm_2.setVWin(std::move(vwin_2_ptr));
+
+  auto fill = [] (FVTerm_protected& p_fvterm, int offset)
+  {
+    // Opaque, transparent, color overlay and inherit background lines
+    const std::array<finalcut::Style, 4> styles
+    {{
+      finalcut::Style::None,
+      finalcut::Style::Transparent,
+      finalcut::Style::ColorOverlay,
+      finalcut::Style::InheritBackground
+    }};
+
+    for (auto y{0}; y < 130; y++)
+    {
+      const auto ch = wchar_t(L'A' + (y + offset) % 26);
+      p_fvterm.print() << finalcut::FPoint{7, y + 4}
+                       << finalcut::FColorPair { finalcut::FColor((y + offset) % 8)
+                                               , finalcut::FColor(y % 16) }
+                       << finalcut::FStyle {styles[std::size_t((y + offset) % 4)]}
+                       << finalcut::FString(std::size_t(470), ch)
+                       << finalcut::FStyle {finalcut::Style::None};
+    }
+  };
+
+  auto setBackground = [&vterm] ()
+  {
+    for (auto y{0}; y < vterm->size.height; y++)
+    {
+      vterm->changes_in_line[y].xmin = uInt(vterm->size.width);
+      vterm->changes_in_line[y].xmax = 0;
+
+      for (auto x{0}; x < vterm->size.width; x++)
+      {
+        auto& fchar = vterm->getFChar(x, y);
+        fchar.ch[0] = wchar_t(L'a' + (x + y) % 26);
+        fchar.color.setFgColor(finalcut::FColor(x % 16));
+        fchar.color.setBgColor(finalcut::FColor(y % 8));
+      }
+    }
+
+    vterm->resetDamage();
+  };
+
+  fill (p_fvterm_1, 0);
+  fill (p_fvterm_2, 0);
+  vwin_1->visible = true;
+  vwin_2->visible = true;
+
+  for (auto run{0}; run < 2; run++)
+  {
+    // Serial compositing
+    finalcut::FVTerm::setCompositorThreads(1);
+    setBackground();
+    const auto revision_1 = vwin_1->flag_revision;
+    p_fvterm_1.p_addLayer(vwin_1);
+    const auto serial_data = vterm->data;
+    const auto serial_changes = vterm->changes_in_line;
+    const finalcut::FDamageList serial_damage = vterm->damage;
+
+    // Parallel compositing
+    finalcut::FVTerm::setCompositorThreads(4);
+    CPPUNIT_ASSERT ( finalcut::FVTerm::getCompositorThreads() == 4 );
+    setBackground();
+    const auto revision_2 = vwin_2->flag_revision;
+    p_fvterm_2.p_addLayer(vwin_2);
+
+    // The results are identical
+    CPPUNIT_ASSERT ( vterm->data == serial_data );
+    // Opaque first line in run 0, transparent first line in run 1
+    CPPUNIT_ASSERT ( vterm->getFChar(6, 3).ch[0] == ( run == 0 ? L'A' : L'j' ) );
+    CPPUNIT_ASSERT ( vwin_2->flag_revision - revision_2
+                  == vwin_1->flag_revision - revision_1 );
+    CPPUNIT_ASSERT ( vwin_2->flag_plane == vwin_1->flag_plane );
+    CPPUNIT_ASSERT ( vterm->damage.getCount() == serial_damage.getCount() );
+    CPPUNIT_ASSERT ( std::equal ( vterm->damage.begin(), vterm->damage.end()
+                                , serial_damage.begin() ) );
+
+    for (auto y{0}; y < vterm->size.height; y++)
+    {
+      CPPUNIT_ASSERT ( vterm->changes_in_line[y].xmin == serial_changes[y].xmin );
+      CPPUNIT_ASSERT ( vterm->changes_in_line[y].xmax == serial_changes[y].xmax );
+    }
+
+    // All changes of the windows are processed
+    for (auto y{0}; y < vwin_2->size.height; y++)
+    {
+      CPPUNIT_ASSERT ( ! vwin_1->hasLineChanges(y) );
+      CPPUNIT_ASSERT ( ! vwin_2->hasLineChanges(y) );
+    }
+
+    CPPUNIT_ASSERT ( vwin_1->damage.isEmpty() );
+    CPPUNIT_ASSERT ( vwin_2->damage.isEmpty() );
+
+    // Next run with changed styles
+    fill (p_fvterm_1, 1);
+    fill (p_fvterm_2, 1);
+  }
+
+  // Small changes are composited serially
+  p_fvterm_2.print() << finalcut::FPoint{7, 4} << "XYZ";
+  p_fvterm_2.p_addLayer(vwin_2);
+  CPPUNIT_ASSERT ( vterm->getFChar(6, 3).ch[0] == L'X' );
+  CPPUNIT_ASSERT ( vterm->getFChar(8, 3).ch[0] == L'Z' );
+
+  // One thread per CPU core
+  finalcut::FVTerm::setCompositorThreads(0);
+  CPPUNIT_ASSERT ( finalcut::FVTerm::getCompositorThreads() >= 1 );
+
+  finalcut::FVTerm::setCompositorThreads(1);
+  CPPUNIT_ASSERT ( finalcut::FVTerm::getCompositorThreads() == 1 );
 }
 
 //----------------------------------------------------------------------
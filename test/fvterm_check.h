@@ -76,17 +76,19 @@ void showFCharData (const finalcut::FChar& fchar)
 {
   std::wcout << L"FChar data\n" << std::boolalpha;
   std::wcout << L"                         ch: '" <<  fchar.ch.data();
-  std::wcout << L"' {" << uInt32(fchar.ch.unicode_data[0]) << L", " <<
-                          uInt32(fchar.ch.unicode_data[1]) << L", " <<
-                          uInt32(fchar.ch.unicode_data[2]) << L", " <<
-                          uInt32(fchar.ch.unicode_data[3]) << L", " <<
-                          uInt32(fchar.ch.unicode_data[4]) << L"}\n";
+  std::wcout << L"' {" << uInt32(fchar.ch[0]) << L", " <<
+                          uInt32(fchar.ch[1]) << L", " <<
+                          uInt32(fchar.ch[2]) << L", " <<
+                          uInt32(fchar.ch[3]) << L", " <<
+                          uInt32(fchar.ch[4]) << L"}\n";
+#if !defined(F_COMPACT_FCHAR)
   std::wcout << L"               encoded_char: '" <<  fchar.encoded_char.data();
   std::wcout << L"' {" << uInt32(fchar.encoded_char.unicode_data[0]) << L", " <<
                           uInt32(fchar.encoded_char.unicode_data[1]) << L", " <<
                           uInt32(fchar.encoded_char.unicode_data[2]) << L", " <<
                           uInt32(fchar.encoded_char.unicode_data[3]) << L", " <<
                           uInt32(fchar.encoded_char.unicode_data[4]) << L"}\n";
+#endif
   std::wcout << L"              color.pair.fg: " << int(fchar.color.getFgColor()) << L'\n';
   std::wcout << L"              color.pair.bg: " << int(fchar.color.getBgColor()) << L'\n';
   std::wcout << L"                    attr[0]: " << int(fchar.attr.byte()->at(0)) << L'\n';
@@ -144,13 +146,21 @@ auto isRegionEqual ( finalcut::FVTerm::FTermRegion* region1
     || region1->shadow.height != region2->shadow.height )
     return false;
 
+  const auto width = std::size_t(region1->size.width + region1->shadow.width);
+
   for (std::size_t i{0U}; i < size1; i++)
   {
-    if ( ! isFCharEqual (region1->data[i], region2->data[i]) )
+    // Compare line by line, because lines can be rotated (row_table)
+    const auto x = int(i % width);
+    const auto y = int(i / width);
+    const auto& fchar1 = region1->getFChar(x, y);
+    const auto& fchar2 = region2->getFChar(x, y);
+
+    if ( ! isFCharEqual (fchar1, fchar2) )
     {
       std::wcout << L"differ: char " << i << L" '"
-                 << region1->data[i].ch[0] << L"' != '"
-                 << region2->data[i].ch[0] << L"'\n";
+                 << fchar1.ch[0] << L"' != '"
+                 << fchar2.ch[0] << L"'\n";
       return false;
     }
   }
@@ -167,7 +177,9 @@ auto isFCharEqual ( const finalcut::FChar& lhs
   attr.bit()->printed = true;
 
   return lhs.ch == rhs.ch
+#if !defined(F_COMPACT_FCHAR)
       && lhs.encoded_char == rhs.encoded_char
+#endif
       && lhs.color.data   == rhs.color.data
       && lhs.attr.byte()->at(0) == rhs.attr.byte()->at(0)
       && lhs.attr.byte()->at(1) == rhs.attr.byte()->at(1)
@@ -261,7 +273,9 @@ void printRegion ( finalcut::FVTerm::FTermRegion* region )
 
   for (std::size_t i{0U}; i < size; i++)
   {
-    if ( region->data[i].attr.bit()->fullwidth_padding )
+    const auto& fchar = region->getFChar(int(i % std::size_t(width)), int(i / std::size_t(width)));
+
+    if ( fchar.attr.bit()->fullwidth_padding )
       continue;
 
     auto col = (i + 1) % width ;
@@ -270,7 +284,7 @@ void printRegion ( finalcut::FVTerm::FTermRegion* region )
     if ( col == 1 && line < std::size_t(height) )
       std::wcout << L"│";
 
-    auto ch = region->data[i].ch;
+    auto ch = fchar.ch;
 
     if ( ch[0] == L'\0' )
       ch[0] = L' ';
@@ -0,0 +1,294 @@
+/***********************************************************************
+* fvterm_kernels-test.cpp - Vectorized character cell scanning tests   *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <array>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace
+{
+
+// Constants
+constexpr std::array<finalcut::FKernelType, 3> kernel_types
+{{
+  finalcut::FKernelType::Scalar,
+  finalcut::FKernelType::SSE2,
+  finalcut::FKernelType::AVX2
+}};
+
+//----------------------------------------------------------------------
+auto createLine (std::size_t length) -> std::vector<finalcut::FChar>
+{
+  std::vector<finalcut::FChar> line(length);
+
+  for (std::size_t i{0}; i < length; i++)
+  {
+    line[i].ch[0] = wchar_t(L'A' + wchar_t(i % 26));
+    line[i].color.setPair({finalcut::FColor::Blue, finalcut::FColor::White});
+    line[i].setCharWidth(1);
+  }
+
+  return line;
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------
+// class FVTermKernelsTest
+//----------------------------------------------------------------------
+
+class FVTermKernelsTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FVTermKernelsTest() = default;
+
+  protected:
+    void kernelTypeTest();
+    void findFirstChangeTest();
+    void findLastChangeTest();
+    void ignoredAttributeTest();
+    void attributeRunLengthTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FVTermKernelsTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (kernelTypeTest);
+    CPPUNIT_TEST (findFirstChangeTest);
+    CPPUNIT_TEST (findLastChangeTest);
+    CPPUNIT_TEST (ignoredAttributeTest);
+    CPPUNIT_TEST (attributeRunLengthTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FVTermKernelsTest::kernelTypeTest()
+{
+  const auto supported = finalcut::getSupportedKernelType();
+  CPPUNIT_ASSERT ( finalcut::getKernelType() == supported );
+
+  finalcut::setKernelType (finalcut::FKernelType::Scalar);
+  CPPUNIT_ASSERT ( finalcut::getKernelType() == finalcut::FKernelType::Scalar );
+
+  // Unsupported instruction sets fall back to the supported one
+  finalcut::setKernelType (finalcut::FKernelType::AVX2);
+  CPPUNIT_ASSERT ( finalcut::getKernelType() == supported );
+}
+
+//----------------------------------------------------------------------
+void FVTermKernelsTest::findFirstChangeTest()
+{
+  for (const auto type : kernel_types)
+  {
+    finalcut::setKernelType (type);
+
+    for (std::size_t length{0}; length < 40; length++)
+    {
+      const auto line = createLine(length);
+      auto other = line;
+
+      // Equal lines
+      CPPUNIT_ASSERT ( finalcut::findFirstChange(line.data(), other.data(), length) == length );
+
+      for (std::size_t pos{0}; pos < length; pos++)
+      {
+        // Character change
+        other = line;
+        other[pos].ch[0] = L'#';
+        CPPUNIT_ASSERT ( finalcut::findFirstChange(line.data(), other.data(), length) == pos );
+
+        // Color change
+        other = line;
+        other[pos].color.setFgColor(finalcut::FColor::Red);
+        CPPUNIT_ASSERT ( finalcut::findFirstChange(line.data(), other.data(), length) == pos );
+
+        // Attribute change
+        other = line;
+        other[pos].attr.setBit(finalcut::FAttribute::set::bold);
+        CPPUNIT_ASSERT ( finalcut::findFirstChange(line.data(), other.data(), length) == pos );
+
+        // Two changes
+        if ( pos + 1 < length )
+        {
+          other[length - 1].attr.setBit(finalcut::FAttribute::set::transparent);
+          CPPUNIT_ASSERT ( finalcut::findFirstChange(line.data(), other.data(), length) == pos );
+        }
+      }
+    }
+  }
+
+  finalcut::setKernelType (finalcut::getSupportedKernelType());
+}
+
+//----------------------------------------------------------------------
+void FVTermKernelsTest::findLastChangeTest()
+{
+  for (const auto type : kernel_types)
+  {
+    finalcut::setKernelType (type);
+
+    for (std::size_t length{0}; length < 40; length++)
+    {
+      const auto line = createLine(length);
+      auto other = line;
+
+      // Equal lines
+      CPPUNIT_ASSERT ( finalcut::findLastChange(line.data(), other.data(), length) == 0 );
+
+      for (std::size_t pos{0}; pos < length; pos++)
+      {
+        // Character change
+        other = line;
+        other[pos].ch[1] = L'\U00000301';
+        CPPUNIT_ASSERT ( finalcut::findLastChange(line.data(), other.data(), length) == pos + 1 );
+
+        // Color change
+        other = line;
+        other[pos].color.setBgColor(finalcut::FColor::Black);
+        CPPUNIT_ASSERT ( finalcut::findLastChange(line.data(), other.data(), length) == pos + 1 );
+
+        // Attribute change
+        other = line;
+        other[pos].attr.setBit(finalcut::FAttribute::set::inherit_background);
+        CPPUNIT_ASSERT ( finalcut::findLastChange(line.data(), other.data(), length) == pos + 1 );
+
+        // Two changes
+        if ( pos > 0 )
+        {
+          other[0].ch[0] = L'#';
+          CPPUNIT_ASSERT ( finalcut::findLastChange(line.data(), other.data(), length) == pos + 1 );
+        }
+      }
+    }
+  }
+
+  finalcut::setKernelType (finalcut::getSupportedKernelType());
+}
+
+//----------------------------------------------------------------------
+void FVTermKernelsTest::ignoredAttributeTest()
+{
+  // The state bits are not part of the character comparison
+
+  for (const auto type : kernel_types)
+  {
+    finalcut::setKernelType (type);
+    constexpr std::size_t length{21};
+    const auto line = createLine(length);
+    auto other = line;
+
+    for (auto& fchar : other)
+    {
+      fchar.attr.setBit(finalcut::FAttribute::set::no_changes);
+      fchar.attr.setBit(finalcut::FAttribute::set::printed);
+    }
+
+    CPPUNIT_ASSERT ( finalcut::findFirstChange(line.data(), other.data(), length) == length );
+    CPPUNIT_ASSERT ( finalcut::findLastChange(line.data(), other.data(), length) == 0 );
+
+    other[10].attr.setBit(finalcut::FAttribute::set::fullwidth_padding);
+    CPPUNIT_ASSERT ( finalcut::findFirstChange(line.data(), other.data(), length) == 10 );
+    CPPUNIT_ASSERT ( finalcut::findLastChange(line.data(), other.data(), length) == 11 );
+  }
+
+  finalcut::setKernelType (finalcut::getSupportedKernelType());
+}
+
+//----------------------------------------------------------------------
+void FVTermKernelsTest::attributeRunLengthTest()
+{
+  constexpr auto trans_mask = finalcut::FAttribute::set::transparent
+                            | finalcut::FAttribute::set::color_overlay
+                            | finalcut::FAttribute::set::inherit_background;
+
+  for (const auto type : kernel_types)
+  {
+    finalcut::setKernelType (type);
+
+    for (std::size_t length{0}; length < 40; length++)
+    {
+      auto line = createLine(length);
+      CPPUNIT_ASSERT ( finalcut::getAttributeRunLength(line.data(), length, trans_mask, false) == length );
+      CPPUNIT_ASSERT ( finalcut::getAttributeRunLength(line.data(), length, trans_mask, true) == 0 );
+
+      for (std::size_t pos{0}; pos < length; pos++)
+      {
+        // Every transparency bit ends an opaque run
+        const std::array<uInt32, 3> bits
+        {{
+          finalcut::FAttribute::set::transparent,
+          finalcut::FAttribute::set::color_overlay,
+          finalcut::FAttribute::set::inherit_background
+        }};
+
+        for (const auto bit : bits)
+        {
+          auto opaque = line;
+          opaque[pos].attr.setBit(bit);
+          CPPUNIT_ASSERT ( finalcut::getAttributeRunLength(opaque.data(), length, trans_mask, false) == pos );
+        }
+
+        // An opaque character ends a transparent run
+        auto transparent = line;
+
+        for (auto& fchar : transparent)
+          fchar.attr.setBit(finalcut::FAttribute::set::transparent);
+
+        transparent[pos].attr.clearBit(finalcut::FAttribute::set::transparent);
+        CPPUNIT_ASSERT ( finalcut::getAttributeRunLength(transparent.data(), length, trans_mask, true) == pos );
+      }
+
+      // Unchanged character runs
+      for (std::size_t i{0}; i < length; i++)
+        line[i].attr.setBit(finalcut::FAttribute::set::no_changes);
+
+      constexpr auto no_changes = finalcut::FAttribute::set::no_changes;
+      CPPUNIT_ASSERT ( finalcut::getAttributeRunLength(line.data(), length, no_changes, true) == length );
+
+      if ( length > 5 )
+      {
+        line[5].attr.clearBit(no_changes);
+        CPPUNIT_ASSERT ( finalcut::getAttributeRunLength(line.data(), length, no_changes, true) == 5 );
+      }
+    }
+  }
+
+  finalcut::setKernelType (finalcut::getSupportedKernelType());
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FVTermKernelsTest);
+
+// The general unit test main part
+#include <main-test.inc>
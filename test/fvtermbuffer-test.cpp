@@ -120,11 +120,13 @@ void FVTermBufferTest::writeTest()
   CPPUNIT_ASSERT ( vterm_buf.front().ch[2] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().ch[3] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().ch[4] == L'\0' );
+#if !defined(F_COMPACT_FCHAR)
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[0] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[1] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[2] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[3] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[4] == L'\0' );
+#endif
   CPPUNIT_ASSERT ( vterm_buf.front().color.getFgColor() == finalcut::FColor::Default );
   CPPUNIT_ASSERT ( vterm_buf.front().color.getBgColor() == finalcut::FColor::Default );
   CPPUNIT_ASSERT ( vterm_buf.front().attr.byte()->at(0) == 0 );
@@ -156,11 +158,13 @@ void FVTermBufferTest::writeTest()
   CPPUNIT_ASSERT ( vterm_buf.front().ch[2] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().ch[3] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().ch[4] == L'\0' );
+#if !defined(F_COMPACT_FCHAR)
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[0] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[1] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[2] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[3] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[4] == L'\0' );
+#endif
   CPPUNIT_ASSERT ( vterm_buf.front().color.getFgColor() == finalcut::FColor::Default );
   CPPUNIT_ASSERT ( vterm_buf.front().color.getBgColor() == finalcut::FColor::Default );
   CPPUNIT_ASSERT ( vterm_buf.front().attr.byte()->at(0) == 0 );
@@ -200,15 +204,17 @@ void FVTermBufferTest::writeTest()
 
   for (std::size_t i{0}; i < 7; i++)
   {
-    CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch.unicode_data[1] == L'\0' );
-    CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch.unicode_data[2] == L'\0' );
-    CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch.unicode_data[3] == L'\0' );
-    CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch.unicode_data[4] == L'\0' );
+    CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[1] == L'\0' );
+    CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[2] == L'\0' );
+    CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[3] == L'\0' );
+    CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[4] == L'\0' );
+#if !defined(F_COMPACT_FCHAR)
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char.unicode_data[0] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char.unicode_data[1] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char.unicode_data[2] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char.unicode_data[3] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char.unicode_data[4] == L'\0' );
+#endif
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].color.getFgColor() == finalcut::FColor::Default );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].color.getBgColor() == finalcut::FColor::Default );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].attr.byte()->at(0) == 0 );
@@ -238,11 +244,13 @@ void FVTermBufferTest::writeTest()
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[2] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[3] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[4] == L'\0' );
+#if !defined(F_COMPACT_FCHAR)
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[0] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[1] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[2] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[3] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[4] == L'\0' );
+#endif
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].color.getFgColor() == finalcut::FColor::Default );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].color.getBgColor() == finalcut::FColor::Default );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].attr.byte()->at(0) == 0 );
@@ -288,11 +296,13 @@ void FVTermBufferTest::writeTest()
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[2] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[3] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[4] == L'\0' );
+#if !defined(F_COMPACT_FCHAR)
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[0] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[1] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[2] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[3] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[4] == L'\0' );
+#endif
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].attr.byte()->at(0) == 0 );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].attr.byte()->at(1) == 0 );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].attr.byte()->at(2) != 0 );
@@ -349,11 +359,13 @@ void FVTermBufferTest::writeTest()
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[2] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[3] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[4] == L'\0' );
+#if !defined(F_COMPACT_FCHAR)
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[0] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[1] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[2] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[3] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[4] == L'\0' );
+#endif
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].attr.byte()->at(3) == 0 );
 
     if ( multi_color_emojis )
@@ -376,11 +388,13 @@ void FVTermBufferTest::writeTest()
   CPPUNIT_ASSERT ( vterm_buf.front().ch[2] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().ch[3] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().ch[4] == L'\0' );
+#if !defined(F_COMPACT_FCHAR)
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[0] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[1] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[2] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[3] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.front().encoded_char[4] == L'\0' );
+#endif
   CPPUNIT_ASSERT ( vterm_buf.front().color.getFgColor() == finalcut::FColor::Default );
   CPPUNIT_ASSERT ( vterm_buf.front().color.getBgColor() == finalcut::FColor::Default );
   CPPUNIT_ASSERT ( vterm_buf.front().attr.byte()->at(0) == 0 );
@@ -487,11 +501,13 @@ void FVTermBufferTest::streamTest()
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[2] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[3] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].ch[4] == L'\0' );
+#if !defined(F_COMPACT_FCHAR)
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[0] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[1] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[2] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[3] == L'\0' );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].encoded_char[4] == L'\0' );
+#endif
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].attr.byte()->at(2) != 0 );
     CPPUNIT_ASSERT ( vterm_buf.getBuffer()[i].attr.byte()->at(3) == 0 );
   }
@@ -1036,6 +1052,31 @@ void FVTermBufferTest::combiningCharacterTest()
   CPPUNIT_ASSERT ( vterm_buf.back().ch[1] == L'\0' );
   CPPUNIT_ASSERT ( vterm_buf.toString() == combining );
   CPPUNIT_ASSERT ( vterm_buf.toString() == L"पन्ह पन्ह त्र र्च कृकृ ड्ड न्ह" );
+
+#if defined(F_COMPACT_FCHAR)
+  // A full combining sequence table keeps only
+  // the first code point of new sequences
+  const finalcut::FUnicode interned{ L'o', L'\U0000031b', L'\U00000323' };
+
+  for (std::size_t n{0}; n < finalcut::internal::COMBINING_SEQUENCE_MAX; n++)
+  {
+    const std::array<wchar_t, finalcut::UNICODE_MAX> seq
+    {{ wchar_t(0x4e00 + n), L'\U00000300', L'\0', L'\0', L'\0' }};
+    finalcut::internal::internCombiningSequence(seq);
+  }
+
+  const finalcut::FUnicode dropped{ L'x', L'\U00000301', L'\U00000302' };
+  CPPUNIT_ASSERT ( dropped[0] == L'x' );
+  CPPUNIT_ASSERT ( dropped[1] == L'\0' );
+  CPPUNIT_ASSERT ( interned[1] == L'\U0000031b' );
+  CPPUNIT_ASSERT ( interned[2] == L'\U00000323' );
+  const finalcut::FUnicode reused{ L'o', L'\U0000031b', L'\U00000323' };
+  CPPUNIT_ASSERT ( reused == interned );
+
+  // An unknown table index has no combining characters
+  const auto unknown = uInt32(finalcut::internal::COMBINING_SEQUENCE_MAX + 1);
+  CPPUNIT_ASSERT ( finalcut::internal::getCombiningSequence(unknown)[0] == L'\0' );
+#endif
 }
 
 
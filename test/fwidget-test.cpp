@@ -508,6 +508,11 @@ class FWidgetTest::FSystemTest : public finalcut::FSystem
       return std::fwrite(str, 1, len, stdout);
     }
 
+    auto writev (int fd, const struct iovec* iov, int iovcnt) noexcept -> ssize_t override
+    {
+      return ::writev(fd, iov, iovcnt);
+    }
+
     auto sigaction (int, const struct sigaction*, struct sigaction*) noexcept -> int override
     {
       return 0;
@@ -0,0 +1,269 @@
+/***********************************************************************
+* fwindowindex-test.cpp - FWindowIndex unit tests                      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace
+{
+
+using FTermRegion = finalcut::FWindowIndex::FTermRegion;
+using FTermRegionList = finalcut::FWindowIndex::FTermRegionList;
+
+//----------------------------------------------------------------------
+void setRegion (FTermRegion& region, int x, int y, int width, int height)
+{
+  region.position.x = x;
+  region.position.y = y;
+  region.size.width = width;
+  region.size.height = height;
+}
+
+//----------------------------------------------------------------------
+auto hasRegion (const FTermRegionList& list, const FTermRegion* region) -> bool
+{
+  return std::find(list.cbegin(), list.cend(), region) != list.cend();
+}
+
+}  // namespace
+
+//----------------------------------------------------------------------
+// class FWindowIndexTest
+//----------------------------------------------------------------------
+
+class FWindowIndexTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FWindowIndexTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void insertTest();
+    void updateTest();
+    void removeTest();
+    void resizeTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FWindowIndexTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (insertTest);
+    CPPUNIT_TEST (updateTest);
+    CPPUNIT_TEST (removeTest);
+    CPPUNIT_TEST (resizeTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FWindowIndexTest::classNameTest()
+{
+  const finalcut::FWindowIndex index;
+  const finalcut::FString& classname = index.getClassName();
+  CPPUNIT_ASSERT ( classname == "FWindowIndex" );
+}
+
+//----------------------------------------------------------------------
+void FWindowIndexTest::noArgumentTest()
+{
+  finalcut::FWindowIndex index{};
+  CPPUNIT_ASSERT ( index.getCount() == 0 );
+  CPPUNIT_ASSERT ( index.getRegionsAt(0, 0).empty() );
+  CPPUNIT_ASSERT ( index.getRegionsAt(-5, 1000).empty() );
+  CPPUNIT_ASSERT ( ! index.contains(nullptr) );
+  CPPUNIT_ASSERT ( index.getOwner(nullptr) == nullptr );
+
+  // A null region is not indexed
+  index.insert(nullptr);
+  CPPUNIT_ASSERT ( index.getCount() == 0 );
+
+  FTermRegionList list{};
+  index.getRegionsIn (finalcut::FRect{0, 0, 80, 24}, list);
+  CPPUNIT_ASSERT ( list.empty() );
+}
+
+//----------------------------------------------------------------------
+void FWindowIndexTest::insertTest()
+{
+  finalcut::FWindowIndex index{};
+  index.setSize (finalcut::FSize{80, 24});
+
+  FTermRegion r1{};
+  FTermRegion r2{};
+  setRegion (r1, 2, 1, 10, 5);    // Tiles (0, 0)
+  setRegion (r2, 30, 10, 20, 8);  // Tiles (1..3, 1..2)
+  r2.shadow.width = 2;
+  r2.shadow.height = 1;
+  index.insert (&r1);
+  index.insert (&r2);
+  CPPUNIT_ASSERT ( index.getCount() == 2 );
+  CPPUNIT_ASSERT ( index.contains(&r1) );
+  CPPUNIT_ASSERT ( index.contains(&r2) );
+
+  CPPUNIT_ASSERT ( hasRegion(index.getRegionsAt(5, 3), &r1) );
+  CPPUNIT_ASSERT ( ! hasRegion(index.getRegionsAt(5, 3), &r2) );
+  CPPUNIT_ASSERT ( hasRegion(index.getRegionsAt(35, 12), &r2) );
+  CPPUNIT_ASSERT ( ! hasRegion(index.getRegionsAt(35, 12), &r1) );
+  CPPUNIT_ASSERT ( index.getRegionsAt(79, 0).empty() );
+
+  // The shadow is part of the indexed area
+  CPPUNIT_ASSERT ( hasRegion(index.getRegionsAt(51, 18), &r2) );
+
+  // Regions of several tiles are reported only once
+  FTermRegionList list{};
+  index.getRegionsIn (finalcut::FRect{0, 0, 80, 24}, list);
+  CPPUNIT_ASSERT ( list.size() == 2 );
+  CPPUNIT_ASSERT ( hasRegion(list, &r1) );
+  CPPUNIT_ASSERT ( hasRegion(list, &r2) );
+
+  index.getRegionsIn (finalcut::FRect{64, 16, 16, 8}, list);
+  CPPUNIT_ASSERT ( list.empty() );
+
+  // A second insert replaces the entry
+  index.insert (&r1);
+  CPPUNIT_ASSERT ( index.getCount() == 2 );
+  CPPUNIT_ASSERT ( index.getRegionsAt(5, 3).size() == 1 );
+}
+
+//----------------------------------------------------------------------
+void FWindowIndexTest::updateTest()
+{
+  finalcut::FWindowIndex index{};
+  index.setSize (finalcut::FSize{80, 24});
+
+  FTermRegion r1{};
+  setRegion (r1, 0, 0, 4, 2);
+  index.insert (&r1);
+  CPPUNIT_ASSERT ( hasRegion(index.getRegionsAt(0, 0), &r1) );
+
+  // Move
+  r1.position.x = 70;
+  r1.position.y = 20;
+  index.update (&r1);
+  CPPUNIT_ASSERT ( ! hasRegion(index.getRegionsAt(0, 0), &r1) );
+  CPPUNIT_ASSERT ( hasRegion(index.getRegionsAt(72, 21), &r1) );
+
+  // Resize
+  setRegion (r1, 0, 0, 80, 24);
+  index.update (&r1);
+
+  for (int y{0}; y < 24; y += finalcut::FWindowIndex::TILE_HEIGHT)
+    for (int x{0}; x < 80; x += finalcut::FWindowIndex::TILE_WIDTH)
+      CPPUNIT_ASSERT ( index.getRegionsAt(x, y).size() == 1 );
+
+  // Regions that are not indexed are ignored
+  FTermRegion r2{};
+  setRegion (r2, 0, 0, 10, 10);
+  index.update (&r2);
+  CPPUNIT_ASSERT ( index.getCount() == 1 );
+  CPPUNIT_ASSERT ( ! index.contains(&r2) );
+
+  // Positions outside of the terminal
+  setRegion (r1, -20, -5, 10, 3);
+  index.update (&r1);
+  CPPUNIT_ASSERT ( hasRegion(index.getRegionsAt(-15, -4), &r1) );
+  CPPUNIT_ASSERT ( hasRegion(index.getRegionsAt(0, 0), &r1) );
+  CPPUNIT_ASSERT ( ! hasRegion(index.getRegionsAt(40, 12), &r1) );
+}
+
+//----------------------------------------------------------------------
+void FWindowIndexTest::removeTest()
+{
+  finalcut::FWindowIndex index{};
+  index.setSize (finalcut::FSize{80, 24});
+
+  FTermRegion r1{};
+  FTermRegion r2{};
+  FTermRegion r3{};
+  setRegion (r1, 0, 0, 40, 12);
+  setRegion (r2, 10, 5, 40, 12);
+  setRegion (r3, 20, 10, 40, 12);
+  finalcut::FVTerm* owner = reinterpret_cast<finalcut::FVTerm*>(&r3);
+  index.insert (&r1);
+  index.insert (&r2, owner);
+  index.insert (&r3, owner);
+  CPPUNIT_ASSERT ( index.getCount() == 3 );
+  CPPUNIT_ASSERT ( index.getOwner(&r1) == nullptr );
+  CPPUNIT_ASSERT ( index.getOwner(&r2) == owner );
+  CPPUNIT_ASSERT ( index.getRegionsAt(20, 10).size() == 3 );
+
+  index.remove (&r1);
+  CPPUNIT_ASSERT ( index.getCount() == 2 );
+  CPPUNIT_ASSERT ( ! index.contains(&r1) );
+  CPPUNIT_ASSERT ( index.getRegionsAt(20, 10).size() == 2 );
+  CPPUNIT_ASSERT ( ! hasRegion(index.getRegionsAt(0, 0), &r1) );
+
+  // Removes all regions of the owner
+  index.remove (static_cast<const finalcut::FVTerm*>(owner));
+  CPPUNIT_ASSERT ( index.getCount() == 0 );
+  CPPUNIT_ASSERT ( index.getRegionsAt(20, 10).empty() );
+
+  index.insert (&r1);
+  index.insert (&r2);
+  index.clear();
+  CPPUNIT_ASSERT ( index.getCount() == 0 );
+  CPPUNIT_ASSERT ( index.getRegionsAt(0, 0).empty() );
+  CPPUNIT_ASSERT ( index.getRegionsAt(20, 10).empty() );
+}
+
+//----------------------------------------------------------------------
+void FWindowIndexTest::resizeTest()
+{
+  finalcut::FWindowIndex index{};
+  FTermRegion r1{};
+  setRegion (r1, 100, 40, 10, 5);
+
+  // Before the first resize all positions share one tile
+  index.insert (&r1);
+  CPPUNIT_ASSERT ( hasRegion(index.getRegionsAt(0, 0), &r1) );
+
+  // Existing regions are re-indexed on a size change
+  index.setSize (finalcut::FSize{160, 50});
+  CPPUNIT_ASSERT ( index.getCount() == 1 );
+  CPPUNIT_ASSERT ( ! hasRegion(index.getRegionsAt(0, 0), &r1) );
+  CPPUNIT_ASSERT ( hasRegion(index.getRegionsAt(105, 42), &r1) );
+
+  // A smaller terminal assigns the region to the border tile
+  index.setSize (finalcut::FSize{80, 24});
+  CPPUNIT_ASSERT ( hasRegion(index.getRegionsAt(79, 23), &r1) );
+  CPPUNIT_ASSERT ( ! hasRegion(index.getRegionsAt(0, 0), &r1) );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FWindowIndexTest);
+
+// The general unit test main part
+#include <main-test.inc>
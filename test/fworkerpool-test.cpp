@@ -0,0 +1,137 @@
+/***********************************************************************
+* fworkerpool-test.cpp - FWorkerPool unit tests                        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2026 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FWorkerPoolTest
+//----------------------------------------------------------------------
+
+class FWorkerPoolTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FWorkerPoolTest() = default;
+
+  protected:
+    void classNameTest();
+    void serialTest();
+    void runTest();
+    void repeatTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FWorkerPoolTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (serialTest);
+    CPPUNIT_TEST (runTest);
+    CPPUNIT_TEST (repeatTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::classNameTest()
+{
+  const finalcut::FWorkerPool pool{1};
+  const finalcut::FString& classname = pool.getClassName();
+  CPPUNIT_ASSERT ( classname == "FWorkerPool" );
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::serialTest()
+{
+  // Without worker threads, the tasks run in order on the caller thread
+  finalcut::FWorkerPool pool{1};
+  CPPUNIT_ASSERT ( pool.getThreadCount() == 1 );
+
+  const auto caller = std::this_thread::get_id();
+  std::vector<std::size_t> order{};
+  bool same_thread{true};
+
+  pool.run ( 5
+           , [&order, &same_thread, caller] (std::size_t index)
+             {
+               order.push_back(index);
+               same_thread &= ( std::this_thread::get_id() == caller );
+             } );
+
+  CPPUNIT_ASSERT ( same_thread );
+  CPPUNIT_ASSERT ( order == (std::vector<std::size_t>{0, 1, 2, 3, 4}) );
+
+  // No tasks
+  pool.run (0, [&order] (std::size_t) { order.clear(); });
+  CPPUNIT_ASSERT ( order.size() == 5 );
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::runTest()
+{
+  // Every task is called exactly once
+  for (const std::size_t threads : {2, 3, 4, 8})
+  {
+    finalcut::FWorkerPool pool{threads};
+    CPPUNIT_ASSERT ( pool.getThreadCount() == threads );
+
+    for (const std::size_t count : {1, 2, 7, 100})
+    {
+      std::vector<int> calls(count, 0);  // Each task owns one element
+      pool.run (count, [&calls] (std::size_t index) { calls[index]++; });
+
+      for (const auto& c : calls)
+        CPPUNIT_ASSERT ( c == 1 );
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void FWorkerPoolTest::repeatTest()
+{
+  // Many short fork-join cycles on the same pool
+  finalcut::FWorkerPool pool{4};
+  std::atomic<std::size_t> sum{0};
+
+  for (std::size_t n{0}; n < 1000; n++)
+    pool.run (8, [&sum] (std::size_t index) { sum += index + 1; });
+
+  CPPUNIT_ASSERT ( sum == 1000 * 36 );
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FWorkerPoolTest);
+
+// The general unit test main part
+#include <main-test.inc>